@@ -28,10 +28,10 @@
 #include "ngraph_bridge/ngraph_api.h"
 #include "ngraph_bridge/ngraph_assign_clusters.h"
 #include "ngraph_bridge/ngraph_capture_variables.h"
-#include "ngraph_bridge/ngraph_cluster_manager.h"
 #include "ngraph_bridge/ngraph_deassign_clusters.h"
 #include "ngraph_bridge/ngraph_encapsulate_clusters.h"
 #include "ngraph_bridge/ngraph_enter_prefetch_in_catalog.h"
+#include "ngraph_bridge/ngraph_flatten_control_flow.h"
 #include "ngraph_bridge/ngraph_mark_for_clustering.h"
 #include "ngraph_bridge/ngraph_utils.h"
 
@@ -98,7 +98,6 @@ class NGraphVariableCapturePass : public NGraphRewritePass {
       NGRAPH_VLOG(1) << "Not running through nGraph. nGraph not enabled: "
                      << ngraph_not_enabled
                      << " Already processed: " << already_processed;
-      NGraphClusterManager::EvictAllClusters();
       return Status::OK();
     }
 
@@ -185,7 +184,6 @@ class NGraphEncapsulationPass : public NGraphRewritePass {
       NGRAPH_VLOG(1) << std::string("Rewrite pass will not run because ") +
                             (already_processed ? "graph is already preprocessed"
                                                : "ngraph is disabled");
-      NGraphClusterManager::EvictAllClusters();
       return Status::OK();
     }
 
@@ -214,7 +212,11 @@ class NGraphEncapsulationPass : public NGraphRewritePass {
     }
 
     // 1. Mark for clustering then, if requested, dump the graphs.
+    // Structured control flow is first rewritten into data flow when
+    // NGRAPH_TF_CLUSTER_CONTROL_FLOW is set.
     std::set<string> skip_these_nodes = {};
+    TF_RETURN_IF_ERROR(
+        FlattenControlFlow(options.graph->get(), skip_these_nodes));
     TF_RETURN_IF_ERROR(MarkForClustering(options.graph->get(), skip_these_nodes,
                                          backend_name));
     if (DumpMarkedGraphs()) {
@@ -16,6 +16,7 @@
 
 #include <iomanip>
 
+#include "tensorflow/core/common_runtime/device_set.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/grappler/clusters/cluster.h"
@@ -28,6 +29,7 @@
 #include "ngraph_bridge/grappler/ngraph_optimizer.h"
 #include "ngraph_bridge/ngraph_backend_manager.h"
 #include "ngraph_bridge/ngraph_cluster_manager.h"
+#include "ngraph_bridge/ngraph_flatten_control_flow.h"
 
 #if defined NGRAPH_DISTRIBUTED
 #include "ngraph/distributed.hpp"
@@ -122,7 +124,6 @@ Status NgraphOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
     NGRAPH_VLOG(1) << std::string("Rewrite pass will not run because ") +
                           (already_processed ? "graph is already preprocessed"
                                              : "ngraph is disabled");
-    NGraphClusterManager::EvictAllClusters();
     graph.ToGraphDef(output);
     return Status::OK();
   }
@@ -182,7 +183,8 @@ Status NgraphOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
   //
   // The part has several phases, each executed in sequence:
   //
-  //   1. Marking [ngraph_mark_for_clustering.cc]
+  //   0. Control Flow Flattening, opt-in [ngraph_flatten_control_flow.cc]
+//   1. Marking [ngraph_mark_for_clustering.cc]
   //   2. Cluster Assignment [ngraph_assign_clusters.cc]
   //   3. Cluster Deassignment [ngraph_deassign_clusters.cc]
   //   4. Cluster Encapsulation [ngraph_encapsulate_clusters.cc] - currently
@@ -220,6 +222,9 @@ Status NgraphOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
 
   NGRAPH_VLOG(0) << "NGraph using backend: " << backend_creation_string;
 
+  // 0. Flatten control flow (only if NGRAPH_TF_CLUSTER_CONTROL_FLOW is set)
+  TF_RETURN_IF_ERROR(FlattenControlFlow(&graph, skip_these_nodes));
+
   // 1. Mark for clustering then, if requested, dump the graphs.
   TF_RETURN_IF_ERROR(
       MarkForClustering(&graph, skip_these_nodes, backend_creation_string));
@@ -259,6 +264,13 @@ Status NgraphOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
   // https://developers.google.com/protocol-buffers/docs/reference/cpp-generated#proto3_string
   // Hence no need to free fdeflib_new
   output->set_allocated_library(fdeflib_new);
+
+  // Ties the clusters to the session the graph is optimized for, if any
+  const DeviceSet* device_set = cluster ? cluster->GetDeviceSet() : nullptr;
+  if (device_set != nullptr && device_set->client_device() != nullptr) {
+    TF_RETURN_IF_ERROR(NGraphClusterManager::HoldClusters(
+        &graph, device_set->client_device()->resource_manager()));
+  }
   return Status::OK();
 }
 
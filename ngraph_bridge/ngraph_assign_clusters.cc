@@ -14,9 +14,16 @@
  * limitations under the License.
  *******************************************************************************/
 #include <algorithm>
+#include <atomic>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <set>
 #include <sstream>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "tensorflow/core/framework/attr_value_util.h"
 #include "tensorflow/core/framework/graph.pb.h"
@@ -29,8 +36,11 @@
 #include "logging/ngraph_log.h"
 #include "ngraph_bridge/ngraph_api.h"
 #include "ngraph_bridge/ngraph_assign_clusters.h"
+#include "ngraph_bridge/ngraph_cluster_cost_model.h"
 #include "ngraph_bridge/ngraph_cluster_manager.h"
+#include "ngraph_bridge/ngraph_fragmentation_report.h"
 #include "ngraph_bridge/ngraph_mark_for_clustering.h"
+#include "ngraph_bridge/ngraph_propagate_shapes.h"
 #include "ngraph_bridge/ngraph_utils.h"
 #include "ngraph_bridge/tf_deadness_analysis.h"
 #include "ngraph_bridge/tf_graphcycles.h"
@@ -89,14 +99,78 @@ namespace ngraph_bridge {
 //
 
 namespace {
+// Orders edges by id, so that the pending edges of a cluster are requeued in
+// the same order on every run
+struct EdgeIdLess {
+  bool operator()(const Edge* a, const Edge* b) const {
+    return a->id() < b->id();
+  }
+};
+
 struct Cluster {
   int index;
-  std::set<tensorflow::Node*> nodes;
+  std::vector<tensorflow::Node*> nodes;
   std::string backend;
 #if !defined(NGRAPH_TF_DISABLE_DEADNESS_CHECK)
-  std::string predicate_string;
+  DeadnessAnalysis::PredicateId predicate;
   std::set<const Edge*> outgoing_edges;
 #endif
+  // Edges touching this cluster that could not be contracted yet, but might
+  // become contractible once this cluster grows. A parked edge is in the set
+  // of both its end clusters until it is requeued from either.
+  std::set<Edge*, EdgeIdLess> pending_edges;
+};
+
+// Cluster membership of the graph nodes, kept as a union-find forest over the
+// node ids. The root of every set owns the Cluster describing the whole set,
+// so looking up the cluster of a node is (amortized) constant time and merging
+// two clusters never has to touch the nodes of the larger one.
+class ClusterMap {
+ public:
+  explicit ClusterMap(int num_node_ids)
+      : parent_(num_node_ids), size_(num_node_ids, 1), clusters_(num_node_ids) {
+    for (int i = 0; i < num_node_ids; i++) {
+      parent_[i] = i;
+    }
+  }
+
+  void Init(const Node* node, std::unique_ptr<Cluster> cluster) {
+    clusters_[node->id()] = std::move(cluster);
+  }
+
+  Cluster* at(const Node* node) const {
+    return clusters_[Find(node->id())].get();
+  }
+
+  // Joins the sets of a and b. The Cluster of the larger set survives and is
+  // returned, the other one is handed back in *absorbed so that the caller can
+  // fold its contents into the survivor.
+  Cluster* Link(const Node* a, const Node* b,
+                std::unique_ptr<Cluster>* absorbed) {
+    int root_a = Find(a->id());
+    int root_b = Find(b->id());
+    if (size_[root_a] < size_[root_b]) {
+      std::swap(root_a, root_b);
+    }
+    parent_[root_b] = root_a;
+    size_[root_a] += size_[root_b];
+    *absorbed = std::move(clusters_[root_b]);
+    return clusters_[root_a].get();
+  }
+
+ private:
+  int Find(int id) const {
+    while (parent_[id] != id) {
+      // path halving
+      parent_[id] = parent_[parent_[id]];
+      id = parent_[id];
+    }
+    return id;
+  }
+
+  mutable std::vector<int> parent_;
+  std::vector<int> size_;
+  std::vector<std::unique_ptr<Cluster>> clusters_;
 };
 
 Status InitialiseNodeBackend(Node* node, string* backend) {
@@ -111,14 +185,13 @@ Status InitialiseNodeBackend(Node* node, string* backend) {
   return Status::OK();
 }
 
-Status CanContractEdgeBackendCheck(
-    Edge* edge, const std::map<Node*, std::shared_ptr<Cluster>>& cluster_map,
-    bool& is_backend_ok) {
+Status CanContractEdgeBackendCheck(Edge* edge, const ClusterMap& cluster_map,
+                                   bool& is_backend_ok) {
   Node* src = edge->src();
   Node* dst = edge->dst();
 
-  string src_backend = cluster_map.at(src)->backend;
-  string dst_backend = cluster_map.at(dst)->backend;
+  const string& src_backend = cluster_map.at(src)->backend;
+  const string& dst_backend = cluster_map.at(dst)->backend;
 
   if (src_backend == dst_backend) {
     is_backend_ok = true;
@@ -133,35 +206,35 @@ Status CanContractEdgeBackendCheck(
 // If Src Predicate is TRUE then merged cluster gets the dst predicate
 // WARNING : This function does not do any checks
 // Use this function when ready to merge
-inline string GetMergedClusterPred(const string& src_predicate,
-                                   const string& dst_predicate) {
-  return DeadnessAnalysis::IsTruePredString(src_predicate) ? dst_predicate
-                                                           : src_predicate;
+inline DeadnessAnalysis::PredicateId GetMergedClusterPred(
+    DeadnessAnalysis::PredicateId src_predicate,
+    DeadnessAnalysis::PredicateId dst_predicate) {
+  return DeadnessAnalysis::IsTruePred(src_predicate) ? dst_predicate
+                                                     : src_predicate;
 }
 
 // Checks whether it's ok to contract the edge as far as deadness is concerned
 // Source and Dst Predicates of the edge should match
-Status CanContractEdgeDeadnessCheck(
-    Edge* edge, const std::map<Node*, std::shared_ptr<Cluster>>& cluster_map,
-    bool& is_deadness_ok) {
+Status CanContractEdgeDeadnessCheck(Edge* edge, const ClusterMap& cluster_map,
+                                    bool& is_deadness_ok) {
   Node* src = edge->src();
   Node* dst = edge->dst();
 
-  string src_predicate = cluster_map.at(src)->predicate_string;
-  string dst_predicate = cluster_map.at(dst)->predicate_string;
+  DeadnessAnalysis::PredicateId src_predicate = cluster_map.at(src)->predicate;
+  DeadnessAnalysis::PredicateId dst_predicate = cluster_map.at(dst)->predicate;
 
-  // If the node marked for clustering has CONTROL_FLOW_PRED_STRING, it
+  // If the node marked for clustering has CONTROL_FLOW_PRED_ID, it
   // breaks our assumption that all supported ops are data flow ops
-  if (DeadnessAnalysis::IsControlFlowPredString(src_predicate) ||
-      DeadnessAnalysis::IsControlFlowPredString(dst_predicate)) {
+  if (DeadnessAnalysis::IsControlFlowPred(src_predicate) ||
+      DeadnessAnalysis::IsControlFlowPred(dst_predicate)) {
     return errors::Internal(
         "Attempting to contract edge with control flow ops : ",
         edge->DebugString());
   }
 
   // Case src X , dst Y , X!=Y // cannot be contracted
-  if (!DeadnessAnalysis::IsTruePredString(src_predicate) &&
-      !DeadnessAnalysis::IsTruePredString(dst_predicate) &&
+  if (!DeadnessAnalysis::IsTruePred(src_predicate) &&
+      !DeadnessAnalysis::IsTruePred(dst_predicate) &&
       src_predicate != dst_predicate) {
     is_deadness_ok = false;
     return Status::OK();
@@ -170,8 +243,8 @@ Status CanContractEdgeDeadnessCheck(
   // Case src X , dst True // invalid scenario
   // If src has Non-True Predicate and dst has True Predicate, it implies that
   // the dst node is control flow
-  if (!DeadnessAnalysis::IsTruePredString(src_predicate) &&
-      DeadnessAnalysis::IsTruePredString(dst_predicate)) {
+  if (!DeadnessAnalysis::IsTruePred(src_predicate) &&
+      DeadnessAnalysis::IsTruePred(dst_predicate)) {
     return errors::Internal("Attempting to cluster control-flow node ",
                             dst->name(), "[", dst->type_string(), "]");
   }
@@ -181,23 +254,23 @@ Status CanContractEdgeDeadnessCheck(
   // have the predicate Y (True & Y = Y). Hence contraction is possible only
   // when, all outputs of the src cluster (other than the current edge) have the
   // predicate Y
-  if (DeadnessAnalysis::IsTruePredString(src_predicate)) {
-    auto src_cluster_out_edges = cluster_map.at(src)->outgoing_edges;
+  if (DeadnessAnalysis::IsTruePred(src_predicate)) {
+    const auto& src_cluster_out_edges = cluster_map.at(src)->outgoing_edges;
     bool found_same_out_preds = true;
-    std::string pred_check = dst_predicate;
+    DeadnessAnalysis::PredicateId pred_check = dst_predicate;
 
     for (const Edge* src_cluster_edge : src_cluster_out_edges) {
       if (src_cluster_edge == edge) {
         continue;
       }
       Node* src_cluster_dst = src_cluster_edge->dst();
-      std::string src_cluster_dst_pred =
-          cluster_map.at(src_cluster_dst)->predicate_string;
+      DeadnessAnalysis::PredicateId src_cluster_dst_pred =
+          cluster_map.at(src_cluster_dst)->predicate;
       // Note that if dst predicate is True, then it does not matter what the
       // src_cluster_dst_pred is; After merge the merged cluster will always
       // have a less strict predicate, True (since True is the least strict
       // predicate)
-      if (!DeadnessAnalysis::IsTruePredString(pred_check) &&
+      if (!DeadnessAnalysis::IsTruePred(pred_check) &&
           pred_check != src_cluster_dst_pred) {
         found_same_out_preds = false;
         break;
@@ -220,51 +293,48 @@ Status CanContractEdgeDeadnessCheck(
 
 // Some sanity checks for Node's cluster assignment wrt Deadness
 Status CheckNodeClusterAssignmentWRTDeadness(
-    Node* node, const std::map<Node*, string>& nodes_predicate_map,
-    const std::map<Node*, std::shared_ptr<Cluster>>& cluster_map) {
-  auto itr = nodes_predicate_map.find(node);
-  if (itr == nodes_predicate_map.end()) {
-    return errors::Internal("Node ", node->name(), " [", node->type_string(),
-                            "]", " not found in predicate map");
-  }
-  std::string node_pred_string = itr->second;
+    Node* node,
+    const std::vector<DeadnessAnalysis::PredicateId>& nodes_predicate,
+    const ClusterMap& cluster_map, const DeadnessAnalysis& deadness_analyzer) {
+  DeadnessAnalysis::PredicateId node_pred = nodes_predicate[node->id()];
 
-  if (DeadnessAnalysis::IsControlFlowPredString(node_pred_string)) {
+  if (DeadnessAnalysis::IsControlFlowPred(node_pred)) {
     return errors::Internal(
         "Node ", node->name(), " [", node->type_string(), "]",
         " should not be clustered as it is a control flow op");
   }
 
-  std::string cluster_pred_string = cluster_map.at(node)->predicate_string;
-  int node_cluster_index = cluster_map.at(node)->index;
+  const Cluster* node_cluster = cluster_map.at(node);
+  DeadnessAnalysis::PredicateId cluster_pred = node_cluster->predicate;
 
   // If the node has Non-True Pred (P1) it can only be placed in a cluster with
   // the same pred
-  if (!DeadnessAnalysis::IsTruePredString(node_pred_string) &&
-      node_pred_string != cluster_pred_string) {
+  if (!DeadnessAnalysis::IsTruePred(node_pred) && node_pred != cluster_pred) {
     return errors::Internal(
         "Node ", node->name(), " [", node->type_string(), "]", " Predicate : ",
-        node_pred_string, "should not be clustered in cluster with predicate ",
-        cluster_pred_string);
+        deadness_analyzer.PredicateToString(node_pred),
+        "should not be clustered in cluster with predicate ",
+        deadness_analyzer.PredicateToString(cluster_pred));
   }
 
   // If the node has True Pred (T1) and its cluster pred is non-true (P1)
   // Then all outgoing edges from node which are not in the same cluster should
   // be connected to clusters with pred P1
-  if (DeadnessAnalysis::IsTruePredString(node_pred_string) &&
-      !DeadnessAnalysis::IsTruePredString(cluster_pred_string)) {
+  if (DeadnessAnalysis::IsTruePred(node_pred) &&
+      !DeadnessAnalysis::IsTruePred(cluster_pred)) {
     for (auto e : node->out_edges()) {
-      Node* e_dst = e->dst();
-      if (cluster_map.at(e_dst)->index != node_cluster_index) {
-        string e_dst_cluster_pred = cluster_map.at(e_dst)->predicate_string;
-        if (e_dst_cluster_pred != cluster_pred_string) {
+      const Cluster* e_dst_cluster = cluster_map.at(e->dst());
+      if (e_dst_cluster != node_cluster) {
+        DeadnessAnalysis::PredicateId e_dst_cluster_pred =
+            e_dst_cluster->predicate;
+        if (e_dst_cluster_pred != cluster_pred) {
           return errors::Internal(
               "Node ", node->name(), " [", node->type_string(), "]",
-              " Predicate : ", node_pred_string,
+              " Predicate : ", deadness_analyzer.PredicateToString(node_pred),
               " cannot not be clustered in cluster with predicate ",
-              cluster_pred_string,
+              deadness_analyzer.PredicateToString(cluster_pred),
               " as it has outgoing edge to a cluster with predicate ",
-              e_dst_cluster_pred);
+              deadness_analyzer.PredicateToString(e_dst_cluster_pred));
         }
       }
     }
@@ -277,13 +347,17 @@ Status CheckNodeClusterAssignmentWRTDeadness(
 // Merges src and dst clusters of the edge
 // This function does not do any checks for merging, but rather implements the
 // merge, i.e. updates the properties of the merged cluster
+// Returns the merged cluster. Edges that were pending on either of the two
+// clusters are moved to *requeue so that they can be tried again.
 // WARNING : Use this function when ready to merge
-void MergeClusters(Edge* edge,
-                   std::map<Node*, std::shared_ptr<Cluster>>& cluster_map) {
+Cluster* MergeClusters(Edge* edge, ClusterMap& cluster_map,
+                       std::vector<Edge*>* requeue) {
   Node* src = edge->src();
   Node* dst = edge->dst();
-  int src_index = cluster_map[src]->index;
-  int dst_index = cluster_map[dst]->index;
+  Cluster* src_cluster = cluster_map.at(src);
+  Cluster* dst_cluster = cluster_map.at(dst);
+  int src_index = src_cluster->index;
+  int dst_index = dst_cluster->index;
 
   // Merge dst cluster into src cluster
   NGRAPH_VLOG(5) << "Contracting: " << src->name() << "[" << src->type_string()
@@ -292,29 +366,52 @@ void MergeClusters(Edge* edge,
                  << edge->dst_input() << "]@" << dst_index;
 
 #if !defined(NGRAPH_TF_DISABLE_DEADNESS_CHECK)
-  string src_predicate = cluster_map[src]->predicate_string;
-  string dst_predicate = cluster_map[dst]->predicate_string;
-  NGRAPH_VLOG(5) << "Src pred: " << src_predicate
-                 << ", Dst pred: " << dst_predicate;
+  NGRAPH_VLOG(5) << "Src pred: " << src_cluster->predicate
+                 << ", Dst pred: " << dst_cluster->predicate;
+
+  DeadnessAnalysis::PredicateId cluster_pred =
+      GetMergedClusterPred(src_cluster->predicate, dst_cluster->predicate);
+#endif
 
-  std::string cluster_pred = GetMergedClusterPred(src_predicate, dst_predicate);
+  // GraphCycles::ContractEdge keeps the src index for the merged node, but
+  // the Cluster object that survives is the one of the bigger set, so that
+  // only the smaller one's contents are moved
+  std::unique_ptr<Cluster> absorbed;
+  Cluster* merged = cluster_map.Link(src, dst, &absorbed);
+  merged->index = src_index;
+  merged->nodes.insert(merged->nodes.end(), absorbed->nodes.begin(),
+                       absorbed->nodes.end());
 
-  cluster_map[src]->predicate_string = cluster_pred;
+#if !defined(NGRAPH_TF_DISABLE_DEADNESS_CHECK)
+  merged->predicate = cluster_pred;
   // Update outgoing edges of the merged cluster
-  cluster_map[src]->outgoing_edges.insert(
-      cluster_map[dst]->outgoing_edges.begin(),
-      cluster_map[dst]->outgoing_edges.end());
-  cluster_map[src]->outgoing_edges.erase(edge);
+  if (merged->outgoing_edges.size() < absorbed->outgoing_edges.size()) {
+    merged->outgoing_edges.swap(absorbed->outgoing_edges);
+  }
+  merged->outgoing_edges.insert(absorbed->outgoing_edges.begin(),
+                                absorbed->outgoing_edges.end());
+  merged->outgoing_edges.erase(edge);
 #endif
 
-  auto cluster_dst = cluster_map[dst];
-  // using cluster_map[dst]->nodes in the loop directly appears to
-  // invalidate the iterator when `node` == `dst`
-  // this happens with clang but not gcc
-  for (auto node : cluster_dst->nodes) {
-    cluster_map[src]->nodes.insert(node);
-    cluster_map[node] = cluster_map[src];
-  }
+  // An edge pending on both clusters is requeued once
+  std::set<Edge*, EdgeIdLess> pending;
+  pending.swap(merged->pending_edges);
+  pending.insert(absorbed->pending_edges.begin(),
+                 absorbed->pending_edges.end());
+  requeue->insert(requeue->end(), pending.begin(), pending.end());
+  return merged;
+}
+
+// A (src cluster id, dst cluster id) pair packed into a single integer key
+inline uint64 GetClusterPairKey(int src_index, int dst_index) {
+  return (static_cast<uint64>(static_cast<uint32>(src_index)) << 32) |
+         static_cast<uint32>(dst_index);
+}
+
+inline int GetClusterPairSrc(uint64 key) { return static_cast<int>(key >> 32); }
+
+inline int GetClusterPairDst(uint64 key) {
+  return static_cast<int>(key & 0xffffffff);
 }
 
 }  // namespace
@@ -322,14 +419,15 @@ void MergeClusters(Edge* edge,
 // Main Entry point for Cluster Assignment to the Node
 // Adds an attribute "_ngraph_cluster" (cluster_id) to each Node that can be
 // encapsulated
-Status AssignClusters(Graph* graph) {
-  std::map<Node*, std::shared_ptr<Cluster>> cluster_map;
+Status AssignClusters(Graph* graph, AssignClustersStats* stats) {
+  ClusterMap cluster_map(graph->num_node_ids());
 
 #if !defined(NGRAPH_TF_DISABLE_DEADNESS_CHECK)
   std::unique_ptr<DeadnessAnalysis> deadness_analyzer;
   TF_RETURN_IF_ERROR(DeadnessAnalysis::Run(*graph, &deadness_analyzer));
-  // This map is used only for error checking
-  std::map<Node*, std::string> nodes_predicate_map;
+  // Predicate of each node, indexed by node id. Used only for error checking
+  std::vector<DeadnessAnalysis::PredicateId> nodes_predicate(
+      graph->num_node_ids(), DeadnessAnalysis::CONTROL_FLOW_PRED_ID);
 #endif
 
   GraphCycles gc;
@@ -337,29 +435,31 @@ Status AssignClusters(Graph* graph) {
   // Initial Step: Each node is a cluster of its own
   for (auto node : graph->nodes()) {
     int new_index = gc.NewNode();
-    cluster_map[node] = std::make_shared<Cluster>();
-    cluster_map[node]->index = new_index;
+    std::unique_ptr<Cluster> cluster(new Cluster());
+    cluster->index = new_index;
     string backend;
     TF_RETURN_IF_ERROR(InitialiseNodeBackend(node, &backend));
 
-    cluster_map[node]->backend = backend;
-    cluster_map[node]->nodes.insert(node);
+    cluster->backend = backend;
+    cluster->nodes.push_back(node);
     NGRAPH_VLOG(5) << "Creating graphcycle Node: " << new_index << " for "
                    << node->name() << "[" << node->type_string() << "]"
                    << " backend " << backend;
 
 #if !defined(NGRAPH_TF_DISABLE_DEADNESS_CHECK)
-    // get predicate string for the node
-    string pred_string;
-    TF_RETURN_IF_ERROR(deadness_analyzer->GetNodePredicate(*node, pred_string));
-    nodes_predicate_map[node] = pred_string;
-    cluster_map[node]->predicate_string = pred_string;
-
-    cluster_map[node]->outgoing_edges = std::set<const Edge*>(
-        node->out_edges().begin(), node->out_edges().end());
+    // get predicate for the node
+    DeadnessAnalysis::PredicateId pred_id;
+    TF_RETURN_IF_ERROR(deadness_analyzer->GetNodePredicate(*node, &pred_id));
+    nodes_predicate[node->id()] = pred_id;
+    cluster->predicate = pred_id;
+
+    cluster->outgoing_edges = std::set<const Edge*>(node->out_edges().begin(),
+                                                    node->out_edges().end());
     NGRAPH_VLOG(5) << node->name() << "[" << node->type_string() << "]"
-                   << "  : Predicate " << pred_string;
+                   << "  : Predicate " << pred_id << " "
+                   << deadness_analyzer->PredicateToString(pred_id);
 #endif
+    cluster_map.Init(node, std::move(cluster));
   }
 
   // Check for existing cyclicity in the graph
@@ -377,7 +477,8 @@ Status AssignClusters(Graph* graph) {
       continue;
     }
 
-    if (!gc.InsertEdge(cluster_map[src]->index, cluster_map[dst]->index)) {
+    if (!gc.InsertEdge(cluster_map.at(src)->index,
+                       cluster_map.at(dst)->index)) {
       NGRAPH_VLOG(5) << "Failing due to cycle";
       return errors::Unimplemented(
           "Input graph has a cycle (inserting an edge from ",
@@ -423,9 +524,9 @@ Status AssignClusters(Graph* graph) {
         if (static_edge->src()->type_string() != "Const") {
           int shadow_node_index = gc.NewNode();
           bool gc_success = gc.InsertEdge(
-              cluster_map[static_edge->src()]->index, shadow_node_index);
-          gc_success &= gc.InsertEdge(shadow_node_index,
-                                      cluster_map[static_edge->dst()]->index);
+              cluster_map.at(static_edge->src())->index, shadow_node_index);
+          gc_success &= gc.InsertEdge(
+              shadow_node_index, cluster_map.at(static_edge->dst())->index);
           if (!gc_success)
             return errors::Internal(
                 "Unable to create shadow edges in GraphCycles");
@@ -435,7 +536,6 @@ Status AssignClusters(Graph* graph) {
   }
 
   NGRAPH_VLOG(2) << "Starting contraction";
-  bool changed;
   bool collect_non_contracting_edge_info = false;  // Must init with false
 
   // 7 exhaustive reasons why edges might non contract
@@ -453,167 +553,314 @@ Status AssignClusters(Graph* graph) {
   static std::vector<string> reason_string(  // to convert the enum to string
       {"NOTANOP", "UNSUPPORTED", "DEADNESS", "BACKEND", "SAMECLUSTER",
        "STATICINPUT", "PATHEXISTS"});
-  // a cluster pair is the string "cluster1_id, cluster2_id"
-  // Using string, because a pair won't hash unless implemented
+  // a cluster pair (cluster1_id, cluster2_id) is packed into one integer key
+  // (see GetClusterPairKey)
   // Note that we store a vector of "reasons", because there could be multiple
   // reasons
   using ClusterPairToReason =
-      std::unordered_map<std::string, std::vector<EdgeNonContractionReasons>>;
+      std::unordered_map<uint64, std::vector<EdgeNonContractionReasons>>;
   ClusterPairToReason cluster_separation_reason;
-  auto get_string_key = [](int x, int y) {
-    return to_string(x) + "," + to_string(y);
-  };
   // (src id, dst id) -> (src predicate, dst predicate, other neighbours
   // predicates)
-  std::unordered_map<std::string, tuple<string, string, vector<string>>>
+  std::unordered_map<uint64, tuple<string, string, vector<string>>>
       deadness_info;
+  // Only set for the last pass over the edges, when a fragmentation report
+  // is requested (NGRAPH_TF_FRAGMENTATION_REPORT)
+  std::unique_ptr<FragmentationReport> fragmentation_report;
+
+  auto log_reason = [](EdgeNonContractionReasons reason, Edge* edge) {
+    NGRAPH_VLOG(0) << "NONCONTRACTION: " << reason_string[reason] << ": "
+                   << edge->src()->name() << "<" << edge->src()->type_string()
+                   << ">"
+                   << "[" << edge->src_output() << "] -> "
+                   << edge->dst()->name() << "<" << edge->dst()->type_string()
+                   << ">"
+                   << "[" << edge->dst_input() << "]";
+  };
+  auto record_reason = [&](EdgeNonContractionReasons reason, Edge* edge,
+                           int src_index, int dst_index) {
+    if (collect_non_contracting_edge_info) {
+      log_reason(reason, edge);
+      cluster_separation_reason[GetClusterPairKey(src_index, dst_index)]
+          .push_back(reason);
+    }
+    if (fragmentation_report != nullptr) {
+      fragmentation_report->AddBreak(edge, reason_string[reason], src_index,
+                                     dst_index);
+    }
+  };
 
-  do {
-    changed = false;
-
-    auto log_reason = [](EdgeNonContractionReasons reason, Edge* edge) {
-      NGRAPH_VLOG(0) << "NONCONTRACTION: " << reason_string[reason] << ": "
-                     << edge->src()->name() << "<" << edge->src()->type_string()
-                     << ">"
-                     << "[" << edge->src_output() << "] -> "
-                     << edge->dst()->name() << "<" << edge->dst()->type_string()
-                     << ">"
-                     << "[" << edge->dst_input() << "]";
-    };
+  // The contraction is driven by a worklist of edges instead of sweeping over
+  // all the edges of the graph until nothing changes. Every edge starts on the
+  // worklist (in graph order). An edge that is refused for a reason that is
+  // permanent (not an op, unsupported, backend, same cluster, static input) is
+  // dropped for good. An edge that is refused because of deadness or because a
+  // longer path exists between its ends is parked on the pending list of both
+  // its end clusters, and goes back on the worklist once one of them is merged
+  // with some other cluster.
+  enum EdgeState { IDLE, QUEUED, PARKED, DONE };
+  std::vector<EdgeState> edge_state(graph->num_edge_ids(), IDLE);
+  // Whether a parked edge was refused because a longer path exists (as
+  // opposed to deadness)
+  std::vector<bool> parked_on_path(graph->num_edge_ids(), false);
+  // The parked edges, each listed once, so that they can be retried without
+  // going over all the edges of the graph. An edge that was requeued since it
+  // was parked stays listed until the next retry drops it.
+  std::vector<Edge*> parked_edges;
+  std::vector<bool> is_listed(graph->num_edge_ids(), false);
+  std::deque<Edge*> worklist;
+  auto enqueue = [&](Edge* edge) {
+    if (edge_state[edge->id()] == PARKED) {
+      // Off the pending set of the other end too, so that its merges do not
+      // requeue the edge again
+      cluster_map.at(edge->src())->pending_edges.erase(edge);
+      cluster_map.at(edge->dst())->pending_edges.erase(edge);
+    }
+    if (edge_state[edge->id()] == IDLE || edge_state[edge->id()] == PARKED) {
+      edge_state[edge->id()] = QUEUED;
+      worklist.push_back(edge);
+    }
+  };
+  for (auto edge : graph->edges()) {
+    enqueue(edge);
+  }
 
-    for (auto edge : graph->edges()) {
-      Node* src = edge->src();
-      Node* dst = edge->dst();
+  // Tries to contract the edge. Sets *retry when the edge was not contracted
+  // but may become contractible as the clusters around it grow.
+  size_t num_contractions = 0;
+  std::vector<Edge*> requeue;
+  auto try_contract = [&](Edge* edge, bool* retry) -> Status {
+    *retry = false;
+    parked_on_path[edge->id()] = false;
+    Node* src = edge->src();
+    Node* dst = edge->dst();
 
-      int src_index = cluster_map[src]->index;
-      int dst_index = cluster_map[dst]->index;
+    int src_index = cluster_map.at(src)->index;
+    int dst_index = cluster_map.at(dst)->index;
 
-      if (!src->IsOp() || !dst->IsOp()) {
-        if (collect_non_contracting_edge_info) {
-          log_reason(EdgeNonContractionReasons::NOTANOP, edge);
-          cluster_separation_reason[get_string_key(src_index, dst_index)]
-              .push_back(EdgeNonContractionReasons::NOTANOP);
-        }
-        continue;
-      }
+    if (!src->IsOp() || !dst->IsOp()) {
+      record_reason(EdgeNonContractionReasons::NOTANOP, edge, src_index,
+                    dst_index);
+      return Status::OK();
+    }
 
-      if (!NodeIsMarkedForClustering(src) || !NodeIsMarkedForClustering(dst)) {
-        NGRAPH_VLOG(5) << "Skipping (not marked): " << src->name() << "["
-                       << edge->src_output() << "]@" << src_index << " -> "
-                       << dst->name() << "[" << edge->dst_input() << "]@"
-                       << dst_index;
-        if (collect_non_contracting_edge_info) {
-          log_reason(EdgeNonContractionReasons::UNSUPPORTED, edge);
-          cluster_separation_reason[get_string_key(src_index, dst_index)]
-              .push_back(EdgeNonContractionReasons::UNSUPPORTED);
-        }
-        continue;
-      }
+    if (!NodeIsMarkedForClustering(src) || !NodeIsMarkedForClustering(dst)) {
+      NGRAPH_VLOG(5) << "Skipping (not marked): " << src->name() << "["
+                     << edge->src_output() << "]@" << src_index << " -> "
+                     << dst->name() << "[" << edge->dst_input() << "]@"
+                     << dst_index;
+      record_reason(EdgeNonContractionReasons::UNSUPPORTED, edge, src_index,
+                    dst_index);
+      return Status::OK();
+    }
 
 #if !defined(NGRAPH_TF_DISABLE_DEADNESS_CHECK)
-      // check if the edge can be contracted with respect to deadness
-      bool is_deadness_ok = false;
-      TF_RETURN_IF_ERROR(
-          CanContractEdgeDeadnessCheck(edge, cluster_map, is_deadness_ok));
-      if (!is_deadness_ok) {
-        // do not contract, src and dst node cannot be in the same cluster
-        NGRAPH_VLOG(5) << "Skipping (deadness not ok): " << src->name() << "["
-                       << edge->src_output() << "]@" << src_index << " -> "
-                       << dst->name() << "[" << edge->dst_input() << "]@"
-                       << dst_index;
-        if (collect_non_contracting_edge_info) {
-          log_reason(EdgeNonContractionReasons::DEADNESS, edge);
-          cluster_separation_reason[get_string_key(src_index, dst_index)]
-              .push_back(EdgeNonContractionReasons::DEADNESS);
-
-          auto src_cluster = cluster_map[src];
-          auto dst_cluster = cluster_map[dst];
-          vector<string> neighbours_predicate;
-          // Collect predicates of src's neighbours (except dst)
-          for (const Edge* src_cluster_edge : src_cluster->outgoing_edges) {
-            if (src_cluster_edge != edge) {
-              neighbours_predicate.push_back(
-                  cluster_map[src_cluster_edge->dst()]->predicate_string);
-            }
+    // check if the edge can be contracted with respect to deadness
+    bool is_deadness_ok = false;
+    TF_RETURN_IF_ERROR(
+        CanContractEdgeDeadnessCheck(edge, cluster_map, is_deadness_ok));
+    if (!is_deadness_ok) {
+      // do not contract, src and dst node cannot be in the same cluster
+      NGRAPH_VLOG(5) << "Skipping (deadness not ok): " << src->name() << "["
+                     << edge->src_output() << "]@" << src_index << " -> "
+                     << dst->name() << "[" << edge->dst_input() << "]@"
+                     << dst_index;
+      record_reason(EdgeNonContractionReasons::DEADNESS, edge, src_index,
+                    dst_index);
+      if (collect_non_contracting_edge_info) {
+        const Cluster* src_cluster = cluster_map.at(src);
+        const Cluster* dst_cluster = cluster_map.at(dst);
+        vector<string> neighbours_predicate;
+        // Collect predicates of src's neighbours (except dst)
+        for (const Edge* src_cluster_edge : src_cluster->outgoing_edges) {
+          if (src_cluster_edge != edge) {
+            neighbours_predicate.push_back(deadness_analyzer->PredicateToString(
+                cluster_map.at(src_cluster_edge->dst())->predicate));
           }
-          deadness_info[get_string_key(src_index, dst_index)] = make_tuple(
-              cluster_map.at(src)->predicate_string,
-              cluster_map.at(dst)->predicate_string, neighbours_predicate);
         }
-        continue;
+        deadness_info[GetClusterPairKey(src_index, dst_index)] = make_tuple(
+            deadness_analyzer->PredicateToString(src_cluster->predicate),
+            deadness_analyzer->PredicateToString(dst_cluster->predicate),
+            neighbours_predicate);
       }
+      *retry = true;
+      return Status::OK();
+    }
 #endif
 
-      // check if the edge can be constracted with respect to backend
-      bool is_backend_ok = false;
-      TF_RETURN_IF_ERROR(
-          CanContractEdgeBackendCheck(edge, cluster_map, is_backend_ok));
-      if (!is_backend_ok) {
-        NGRAPH_VLOG(5) << "Skipping (backend not ok): " << src->name() << "["
-                       << edge->src_output() << "]@" << src_index << " -> "
-                       << dst->name() << "[" << edge->dst_input() << "]@"
-                       << dst_index;
-        if (collect_non_contracting_edge_info) {
-          log_reason(EdgeNonContractionReasons::BACKEND, edge);
-          cluster_separation_reason[get_string_key(src_index, dst_index)]
-              .push_back(EdgeNonContractionReasons::BACKEND);
+    // check if the edge can be constracted with respect to backend
+    bool is_backend_ok = false;
+    TF_RETURN_IF_ERROR(
+        CanContractEdgeBackendCheck(edge, cluster_map, is_backend_ok));
+    if (!is_backend_ok) {
+      NGRAPH_VLOG(5) << "Skipping (backend not ok): " << src->name() << "["
+                     << edge->src_output() << "]@" << src_index << " -> "
+                     << dst->name() << "[" << edge->dst_input() << "]@"
+                     << dst_index;
+      record_reason(EdgeNonContractionReasons::BACKEND, edge, src_index,
+                    dst_index);
+      // do not contract, src and dst node cannot be in the same cluster
+      return Status::OK();
+    }
+
+    // Check if contracting the edge will lead to cycles
+    // if not, MergeClusters
+    if (gc.HasEdge(src_index, dst_index) &&
+        gc.ContractEdge(src_index, dst_index)) {
+      MergeClusters(edge, cluster_map, &requeue);
+      num_contractions++;
+      return Status::OK();
+    }
+
+    // 3 possible reasons here:
+    // src dst lies in same cluster, so nothing to do (trivial cycle
+    // induced in graphcycles)
+    // dst has static input
+    // a longer irreducible path exists
+    if (src_index == dst_index) {
+      record_reason(EdgeNonContractionReasons::SAMECLUSTER, edge, src_index,
+                    dst_index);
+      return Status::OK();
+    }
+    bool is_static = InputIsStatic(dst, edge->dst_input());
+    bool is_not_const = src->type_string() != "Const";
+    if (is_not_const && is_static) {
+      record_reason(EdgeNonContractionReasons::STATICINPUT, edge, src_index,
+                    dst_index);
+      return Status::OK();
+    }
+    record_reason(EdgeNonContractionReasons::PATHEXISTS, edge, src_index,
+                  dst_index);
+    *retry = true;
+    parked_on_path[edge->id()] = true;
+    return Status::OK();
+  };
+
+  size_t contractions_before;
+  do {
+    contractions_before = num_contractions;
+    while (!worklist.empty()) {
+      Edge* edge = worklist.front();
+      worklist.pop_front();
+
+      bool retry;
+      TF_RETURN_IF_ERROR(try_contract(edge, &retry));
+      if (retry) {
+        edge_state[edge->id()] = PARKED;
+        if (!is_listed[edge->id()]) {
+          is_listed[edge->id()] = true;
+          parked_edges.push_back(edge);
         }
-        // do not contract, src and dst node cannot be in the same cluster
-        continue;
+        cluster_map.at(edge->src())->pending_edges.insert(edge);
+        cluster_map.at(edge->dst())->pending_edges.insert(edge);
+        if (stats != nullptr) {
+          stats->num_parked++;
+        }
+      } else {
+        edge_state[edge->id()] = DONE;
       }
 
-      // Check if contracting the edge will lead to cycles
-      // if not, MergeClusters
-      if (gc.HasEdge(src_index, dst_index) &&
-          gc.ContractEdge(src_index, dst_index)) {
-        MergeClusters(edge, cluster_map);
-        // something changed
-        changed = true;
-      } else {
-        if (collect_non_contracting_edge_info) {
-          // either static input
-          // or there exists a longer path, so contracting this edge causes
-          // cycles
-          std::vector<int32> static_inputs;
-          GetStaticInputs(dst, &static_inputs);
-          bool is_static = std::find(static_inputs.begin(), static_inputs.end(),
-                                     edge->dst_input()) != static_inputs.end();
-          bool is_not_const = src->type_string() != "Const";
-          // 3 possible reasons here:
-          // src dst lies in same cluster, so nothing to do (trivial cycle
-          // induced in graphcycles)
-          // dst has static input
-          // a longer irreducible path exists
-          auto reason = (src_index == dst_index
-                             ? EdgeNonContractionReasons::SAMECLUSTER
-                             : ((is_not_const && is_static)
-                                    ? EdgeNonContractionReasons::STATICINPUT
-                                    : EdgeNonContractionReasons::PATHEXISTS));
-          log_reason(reason, edge);
-          cluster_separation_reason[get_string_key(src_index, dst_index)]
-              .push_back(reason);
-        }
+      if (stats != nullptr) {
+        stats->num_requeued += requeue.size();
+      }
+      for (auto pending_edge : requeue) {
+        enqueue(pending_edge);
       }
+      requeue.clear();
     }
 
-    if (!changed && config::IsLoggingPlacement()) {
-      // This will be entered only once if logging is enabled
-      // When entered, it will force the do-while to run one last time,
-      // collecting information
-      if (!collect_non_contracting_edge_info) {
-        changed = true;
-        collect_non_contracting_edge_info = true;
+    // Whether an edge passes the deadness check also depends on the
+    // predicates of the clusters that its src cluster feeds, which can change
+    // without either end of the edge being merged. So before calling it a
+    // fixed point, give all the parked edges one more try. The edges that
+    // were parked because of a longer path are first checked against the
+    // current GraphCycles in one batch, and only requeued if that path is
+    // gone.
+    if (num_contractions != contractions_before) {
+      std::vector<Edge*> path_edges;
+      std::vector<std::pair<int32, int32>> path_queries;
+      std::vector<Edge*> still_parked;
+      for (auto edge : parked_edges) {
+        if (edge_state[edge->id()] != PARKED) {
+          is_listed[edge->id()] = false;
+          continue;
+        }
+        int src_index = cluster_map.at(edge->src())->index;
+        int dst_index = cluster_map.at(edge->dst())->index;
+        if (parked_on_path[edge->id()] && src_index != dst_index &&
+            gc.HasEdge(src_index, dst_index)) {
+          path_edges.push_back(edge);
+          path_queries.push_back(std::make_pair(src_index, dst_index));
+        } else {
+          is_listed[edge->id()] = false;
+          enqueue(edge);
+        }
+      }
+      std::vector<bool> can_contract = gc.CanContractEdges(path_queries);
+      for (size_t i = 0; i < path_edges.size(); i++) {
+        if (can_contract[i]) {
+          is_listed[path_edges[i]->id()] = false;
+          enqueue(path_edges[i]);
+        } else {
+          still_parked.push_back(path_edges[i]);
+        }
       }
+      parked_edges.swap(still_parked);
     }
-  } while (changed);
+  } while (!worklist.empty());
 
-  NGRAPH_VLOG(2) << "Contraction done";
+  NGRAPH_VLOG(2) << "Contraction done, contracted " << num_contractions
+                 << " edges";
+  if (stats != nullptr) {
+    stats->num_contractions = num_contractions;
+  }
+
+  static std::atomic<int> s_fragmentation_report_index(0);
+  string report_file_name = FragmentationReport::GetFileName(
+      s_fragmentation_report_index.fetch_add(1));
+  if (!report_file_name.empty()) {
+    auto cost_model =
+        dynamic_cast<DefaultClusterCostModel*>(GetClusterCostModel());
+    // For the tensors crossing breaks that "_output_shapes" says nothing of
+    GraphShapes graph_shapes;
+    if (IsShapePropagationEnabled()) {
+      InferGraphShapes(*graph, &graph_shapes);
+    }
+    fragmentation_report.reset(new FragmentationReport(
+        cost_model != nullptr ? cost_model->GetParameters()
+                              : DefaultClusterCostModel::Parameters(),
+        std::move(graph_shapes)));
+  }
+
+  if (config::IsLoggingPlacement() || fragmentation_report != nullptr) {
+    // Nothing can be contracted any more, so one last pass over all the edges
+    // only collects the non-contraction information
+    collect_non_contracting_edge_info = config::IsLoggingPlacement();
+    for (auto edge : graph->edges()) {
+      bool retry;
+      TF_RETURN_IF_ERROR(try_contract(edge, &retry));
+    }
+  }
+
+  if (fragmentation_report != nullptr) {
+    // The report is a diagnostic, failing to write it does not fail the pass
+    Status status = StringToFile(report_file_name,
+                                 fragmentation_report->ToJson(), false);
+    if (status.ok()) {
+      NGRAPH_VLOG(1) << "Wrote the " << fragmentation_report->NumBreaks()
+                     << " cluster breaks to " << report_file_name;
+    } else {
+      NGRAPH_VLOG(0) << "Could not write the fragmentation report: "
+                     << status.error_message();
+    }
+    fragmentation_report.reset();
+  }
 
   NGRAPH_VLOG(2) << "Starting tagging";
-  std::set<Cluster*> seen;
+  std::unordered_set<const Cluster*> seen;
   unordered_map<int, int> cluster_to_encapsulate;
-  for (auto kv : cluster_map) {
-    auto cluster = kv.second.get();
+  for (auto graph_node : graph->nodes()) {
+    auto cluster = cluster_map.at(graph_node);
     if (seen.count(cluster) != 0) {
       continue;
     }
@@ -628,7 +875,7 @@ Status AssignClusters(Graph* graph) {
 // Some sanity checks for deadness
 #if !defined(NGRAPH_TF_DISABLE_DEADNESS_CHECK)
         TF_RETURN_IF_ERROR(CheckNodeClusterAssignmentWRTDeadness(
-            node, nodes_predicate_map, cluster_map));
+            node, nodes_predicate, cluster_map, *deadness_analyzer));
 #endif
       } else {
         has_non_ngraph_ops = true;
@@ -705,15 +952,14 @@ Status AssignClusters(Graph* graph) {
            "assigned an encapsulate)\n";
     for (auto it : cluster_separation_reason) {
       num_non_contracted += it.second.size();
-      auto cluster_id_vector = ng::split(it.first, ',');
       // function to find if this cluster became an ngraph_cluster
       // returns ngraph_cluster id if yes, else returns -1
-      auto find_in_map = [&cluster_to_encapsulate, &cluster_id_vector](int x) {
-        auto itr = cluster_to_encapsulate.find(stoi(cluster_id_vector[x]));
+      auto find_in_map = [&cluster_to_encapsulate](int x) {
+        auto itr = cluster_to_encapsulate.find(x);
         return itr == cluster_to_encapsulate.end() ? -1 : itr->second;
       };
-      int src_encapsulate = find_in_map(0);
-      int dst_encapsulate = find_in_map(1);
+      int src_encapsulate = find_in_map(GetClusterPairSrc(it.first));
+      int dst_encapsulate = find_in_map(GetClusterPairDst(it.first));
       bool both_src_dst_are_encapsulates =
           src_encapsulate >= 0 && dst_encapsulate >= 0;
       bool src_dst_are_distinct = src_encapsulate != dst_encapsulate;
@@ -24,7 +24,18 @@ namespace tensorflow {
 
 namespace ngraph_bridge {
 
-Status AssignClusters(Graph* graph);
+// Counters of the edge contraction done by AssignClusters
+struct AssignClustersStats {
+  // Edges contracted
+  size_t num_contractions = 0;
+  // Times an edge was parked, to be retried once one of its end clusters
+  // grows
+  size_t num_parked = 0;
+  // Parked edges put back on the worklist by cluster merges
+  size_t num_requeued = 0;
+};
+
+Status AssignClusters(Graph* graph, AssignClustersStats* stats = nullptr);
 // reset the effect of AssignClusters
 void ResetAssignClusters(Graph* graph);
 Status GetNodeCluster(const Node* node, int* cluster);
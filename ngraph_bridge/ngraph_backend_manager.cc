@@ -33,6 +33,10 @@ mutex BackendManager::ng_backend_name_mutex_;
 map<string, std::unique_ptr<Backend>> BackendManager::ng_backend_map_;
 mutex BackendManager::ng_backend_map_mutex_;
 map<std::string, int> BackendManager::ref_count_each_backend_;
+map<string, std::map<string, string>> BackendManager::ng_backend_config_map_;
+unordered_map<string, unordered_map<string, bool>>
+    BackendManager::ng_op_support_cache_;
+mutex BackendManager::ng_op_support_cache_mutex_;
 
 Status BackendManager::SetBackendName(const string& backend_name) {
   std::lock_guard<std::mutex> lock(BackendManager::ng_backend_name_mutex_);
@@ -69,6 +73,10 @@ Status BackendManager::CreateBackend(const string& backend_name) {
       return errors::Internal("Could not create backend of type ", backend_name,
                               " got nullptr");
     }
+    // The last config set on a previous instance of the backend is kept, so
+    // that a session setting the same config again keeps the cached op
+    // support answers
+
     std::unique_ptr<Backend> bend = std::unique_ptr<Backend>(new Backend);
     bend->backend_ptr = std::move(bend_ptr);
     BackendManager::ng_backend_map_[backend_name] = std::move(bend);
@@ -115,6 +123,15 @@ void BackendManager::SetConfig(
     NGRAPH_VLOG(2) << "BackendManager::SetConfig(): Could not set config. "
                    << error;
   }
+
+  // SetConfig is called for every encapsulate op, usually with the same
+  // config, so the op support cache is only dropped on an actual change
+  auto config_itr = BackendManager::ng_backend_config_map_.find(backend_name);
+  if (config_itr == BackendManager::ng_backend_config_map_.end() ||
+      config_itr->second != device_config_map) {
+    BackendManager::ClearOpSupportCache(backend_name);
+    BackendManager::ng_backend_config_map_[backend_name] = device_config_map;
+  }
 }
 
 // Returns a backend pointer of the type specified by the backend name
@@ -222,5 +239,36 @@ string BackendManager::GetBackendCreationString(const string& backend_name,
   }
 }
 
+bool BackendManager::GetCachedOpSupport(const string& backend_name,
+                                        const string& op_type,
+                                        bool* is_supported) {
+  std::lock_guard<std::mutex> lock(
+      BackendManager::ng_op_support_cache_mutex_);
+  auto backend_itr = BackendManager::ng_op_support_cache_.find(backend_name);
+  if (backend_itr == BackendManager::ng_op_support_cache_.end()) {
+    return false;
+  }
+  auto op_itr = backend_itr->second.find(op_type);
+  if (op_itr == backend_itr->second.end()) {
+    return false;
+  }
+  *is_supported = op_itr->second;
+  return true;
+}
+
+void BackendManager::CacheOpSupport(const string& backend_name,
+                                    const string& op_type, bool is_supported) {
+  std::lock_guard<std::mutex> lock(
+      BackendManager::ng_op_support_cache_mutex_);
+  BackendManager::ng_op_support_cache_[backend_name][op_type] = is_supported;
+}
+
+void BackendManager::ClearOpSupportCache(const string& backend_name) {
+  std::lock_guard<std::mutex> lock(
+      BackendManager::ng_op_support_cache_mutex_);
+  NGRAPH_VLOG(2) << "BackendManager::ClearOpSupportCache(): " << backend_name;
+  BackendManager::ng_op_support_cache_.erase(backend_name);
+}
+
 }  // namespace ngraph_bridge
 }  // namespace tensorflow
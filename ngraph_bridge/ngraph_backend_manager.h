@@ -122,6 +122,19 @@ class BackendManager {
   static string GetBackendCreationString(const string& backend_name,
                                          const string& device_id);
 
+  // Process wide cache of the backends' answers to is_supported, keyed by
+  // the backend creation string and the TF op type. The answer only depends
+  // on those two (and on the backend config), so it is computed once and
+  // shared by all sessions and graph rewrites.
+  // Returns true and sets is_supported if the answer is cached
+  static bool GetCachedOpSupport(const string& backend_name,
+                                 const string& op_type, bool* is_supported);
+  static void CacheOpSupport(const string& backend_name, const string& op_type,
+                             bool is_supported);
+  // Drops all cached answers for the backend. Called when the config of the
+  // backend changes
+  static void ClearOpSupportCache(const string& backend_name);
+
   ~BackendManager();
 
  private:
@@ -134,6 +147,15 @@ class BackendManager {
 
   // Map of backends and their reference counts
   static std::map<std::string, int> ref_count_each_backend_;
+
+  // Map of backends to the last config set on them with SetConfig. Entries
+  // outlive the backends, which may be re-created by the next session.
+  static map<string, std::map<string, string>> ng_backend_config_map_;
+
+  // backend creation string -> TF op type -> is supported
+  static unordered_map<string, unordered_map<string, bool>>
+      ng_op_support_cache_;
+  static mutex ng_op_support_cache_mutex_;
 };
 
 }  // namespace ngraph_bridge
@@ -20,6 +20,7 @@
 #include "tensorflow/core/graph/algorithm.h"
 #include "tensorflow/core/graph/edgeset.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 
 #include "ngraph/builder/autobroadcast.hpp"
 #include "ngraph/builder/dequantize_builder.hpp"
@@ -28,6 +29,8 @@
 #include "ngraph/op/argmax.hpp"
 #include "ngraph/op/argmin.hpp"
 #include "ngraph/op/experimental/layers/interpolate.hpp"
+#include "ngraph/op/fused/gelu.hpp"
+#include "ngraph/op/fused/layer_norm.hpp"
 #include "ngraph/op/util/logical_reduction.hpp"
 #include "ngraph/slice_plan.hpp"
 
@@ -35,8 +38,15 @@
 #include "ngraph_bridge/ngraph_api.h"
 #include "ngraph_bridge/ngraph_backend_manager.h"
 #include "ngraph_bridge/ngraph_builder.h"
+#include "ngraph_bridge/ngraph_compile_pool.h"
+#include "ngraph_bridge/ngraph_constant_folding.h"
 #include "ngraph_bridge/ngraph_conversions.h"
+#include "ngraph_bridge/ngraph_fused_patterns.h"
 #include "ngraph_bridge/ngraph_mark_for_clustering.h"
+#include "ngraph_bridge/ngraph_mixed_precision.h"
+#include "ngraph_bridge/ngraph_quantization_propagation.h"
+#include "ngraph_bridge/ngraph_sparse_updates.h"
+#include "ngraph_bridge/ngraph_transpose_sinking.h"
 #include "ngraph_bridge/ngraph_utils.h"
 
 #if defined(NGRAPH_DISTRIBUTED)
@@ -76,23 +86,22 @@ static Status ValidateInputCountMin(const Node* op, tensorflow::int32 count) {
 //
 // Helper for storing ops in ng_op_map.
 // For most of the cases, op would have one output so
-// vector ng_op_map[op_name] would contain one element.
+// vector ng_op_map[op->id()] would contain one element.
 //
 // If storing more than one output_nodes, make sure it's in
 // the same order as tensorflow would do that.
 //
 // Parameters:
 //    Builder::OpMap& ng_op_map        - The TF-to-nGraph op map.
-//    std::string op_name              - Name of the op.
+//    const Node* op                   - TF op being translated.
 //
 //    shared_ptr<ng::Node> output_node - ng::Node to store
 //
 
-static void SaveNgOp(Builder::OpMap& ng_op_map, const std::string& op_name,
+static void SaveNgOp(Builder::OpMap& ng_op_map, const Node* op,
                      const shared_ptr<ng::Node>& output_node) {
-  // no need to try-catch, map[key] will create vector object
-  // if not exists
-  ng_op_map[op_name].push_back(output_node);
+  // The map is sized for all the nodes of the graph by TranslateGraph
+  ng_op_map[op->id()].push_back(output_node);
 }
 
 void Builder::SetTracingInfo(const std::string& op_name,
@@ -112,6 +121,26 @@ std::shared_ptr<TOpType> ConstructNgNode(const std::string& op_name,
   return ng_node;
 }
 
+// The nGraph node for the source of a data edge
+static Status GetEdgeNode(const Builder::OpMap& ng_op_map, const Edge* edge,
+                          shared_ptr<ng::Node>* result) {
+  size_t src_output_idx = edge->src_output();
+
+  const Node* tf_input = edge->src();
+  if (tf_input->id() >= ng_op_map.size() ||
+      ng_op_map[tf_input->id()].empty()) {
+    return Status(error::NOT_FOUND,
+                  string("Ngraph op not found for ") + tf_input->name());
+  }
+  const Builder::OpMapEntry& ng_op = ng_op_map[tf_input->id()];
+  if (src_output_idx >= ng_op.size()) {
+    return Status(error::NOT_FOUND, string("Input node not found at index ") +
+                                        to_string(src_output_idx));
+  }
+  *result = ng_op[src_output_idx];
+  return Status::OK();
+}
+
 // Helper for fetching correct input node from ng_op_map.
 // Handles edge checking to make sure correct input node is
 // fetched.
@@ -123,7 +152,7 @@ std::shared_ptr<TOpType> ConstructNgNode(const std::string& op_name,
 //
 //      shared_ptr<ng::Node> ng_input;
 //      try {
-//        ng_input = ng_op_map.at(tf_input->name());
+//        ng_input = ng_op_map.at(tf_input->id());
 //      } catch (const std::out_of_range&) {
 //        return errors::NotFound(tf_input->name(),
 //                                    " is not found in the ng_op_map");
@@ -150,31 +179,12 @@ static Status GetInputNode(const Builder::OpMap& ng_op_map, const Node* op,
                            size_t input_idx, shared_ptr<ng::Node>* result) {
   // input op may have resulted in more than one ng::Node (eg. Split)
   // we need to look at Edge to check index of the input op
-  std::vector<const Edge*> edges;
-  TF_RETURN_IF_ERROR(op->input_edges(&edges));
-  size_t src_output_idx;
-  try {
-    src_output_idx = edges.at(input_idx)->src_output();
-  } catch (const out_of_range&) {
+  if (input_idx >= op->num_inputs()) {
     return Status(error::NOT_FOUND, "Edge not found");
   }
-
-  Node* tf_input;
-  TF_RETURN_IF_ERROR(op->input_node(input_idx, &tf_input));
-  const std::vector<shared_ptr<ng::Node>>* ng_op = nullptr;
-  try {
-    ng_op = &ng_op_map.at(tf_input->name());
-  } catch (const out_of_range&) {
-    return Status(error::NOT_FOUND,
-                  string("Ngraph op not found for ") + tf_input->name());
-  }
-  try {
-    *result = ng_op->at(src_output_idx);
-  } catch (const out_of_range&) {
-    return Status(error::NOT_FOUND, string("Input node not found at index ") +
-                                        to_string(src_output_idx));
-  }
-  return Status::OK();
+  const Edge* edge;
+  TF_RETURN_IF_ERROR(op->input_edge(input_idx, &edge));
+  return GetEdgeNode(ng_op_map, edge, result);
 }
 
 namespace detail {
@@ -307,34 +317,40 @@ static Status GetStaticInputVector(
 }
 
 // Helper for Builder::TranslateGraph ("Const" op)
-template <typename T, typename VecT = T>
-static Status MakeConstOp(const Node* op, ng::element::Type et,
+template <typename T>
+static Status MakeConstOp(const Node* op, const Tensor& const_tensor,
+                          ng::element::Type et,
                           std::shared_ptr<ng::Node>* ng_node) {
-  vector<VecT> const_values;
-  TensorShapeProto shape_proto;
-
-  TF_RETURN_IF_ERROR(
-      ValuesFromConstNode<T, VecT>(op->def(), &shape_proto, &const_values));
-
-  TensorShape const_shape(shape_proto);
+  if (const_tensor.dtype() != DataTypeToEnum<T>::value) {
+    return errors::InvalidArgument(
+        "Invalid data type defined for Const. Defined: ",
+        DataType_Name(const_tensor.dtype()));
+  }
 
   ng::Shape ng_shape;
-  TF_RETURN_IF_ERROR(TFTensorShapeToNGraphShape(const_shape, &ng_shape));
+  TF_RETURN_IF_ERROR(
+      TFTensorShapeToNGraphShape(const_tensor.shape(), &ng_shape));
 
-  *ng_node =
-      ConstructNgNode<ng::op::Constant>(op->name(), et, ng_shape, const_values);
+  // The element types in the map below have the same layout as T, so the
+  // decoded tensor is copied as is
+  *ng_node = ConstructNgNode<ng::op::Constant>(
+      op->name(), et, ng_shape, const_tensor.tensor_data().data());
   return Status::OK();
 }
 
-const std::map<DataType,
-               std::pair<std::function<Status(const Node*, ng::element::Type,
-                                              std::shared_ptr<ng::Node>*)>,
-                         const ngraph::element::Type>>&
+const std::map<
+    DataType,
+    std::pair<std::function<Status(const Node*, const Tensor&,
+                                   ng::element::Type,
+                                   std::shared_ptr<ng::Node>*)>,
+              const ngraph::element::Type>>&
 Builder::TF_NGRAPH_CONST_MAP() {
   static const std::map<
-      DataType, std::pair<std::function<Status(const Node*, ng::element::Type,
-                                               std::shared_ptr<ng::Node>*)>,
-                          const ngraph::element::Type>>
+      DataType,
+      std::pair<std::function<Status(const Node*, const Tensor&,
+                                     ng::element::Type,
+                                     std::shared_ptr<ng::Node>*)>,
+                const ngraph::element::Type>>
       the_map = {
           {DataType::DT_FLOAT, make_pair(MakeConstOp<float>, ng::element::f32)},
           {DataType::DT_DOUBLE,
@@ -349,8 +365,12 @@ Builder::TF_NGRAPH_CONST_MAP() {
           {DataType::DT_UINT8, make_pair(MakeConstOp<uint8>, ng::element::u8)},
           {DataType::DT_UINT16,
            make_pair(MakeConstOp<uint16>, ng::element::u16)},
+          {DataType::DT_UINT32,
+           make_pair(MakeConstOp<uint32>, ng::element::u32)},
+          {DataType::DT_UINT64,
+           make_pair(MakeConstOp<uint64>, ng::element::u64)},
           {DataType::DT_BOOL,
-           make_pair(MakeConstOp<bool, char>, ng::element::boolean)}};
+           make_pair(MakeConstOp<bool>, ng::element::boolean)}};
   return the_map;
 }
 
@@ -481,7 +501,7 @@ static Status TranslateUnaryOp(
   if (ng_node != ng_input) {
     Builder::SetTracingInfo(op->name(), ng_node);
   }
-  SaveNgOp(ng_op_map, op->name(), ng_node);
+  SaveNgOp(ng_op_map, op, ng_node);
   return Status::OK();
 }
 
@@ -546,7 +566,7 @@ static Status TranslateBinaryOp(
     Builder::SetTracingInfo(op->name(), ng_node);
   }
 
-  SaveNgOp(ng_op_map, op->name(), ng_node);
+  SaveNgOp(ng_op_map, op, ng_node);
 
   return Status::OK();
 }
@@ -572,6 +592,20 @@ static Status TranslateBinaryOp(
       });
 }
 
+// Returns the scalar value, of type et, broadcast to shape
+static shared_ptr<ng::Node> ConstructScalarBroadcast(
+    const string& op_name, const ng::element::Type& et, const ng::Shape& shape,
+    double value) {
+  auto ng_scalar = ConstructNgNode<ng::op::Constant>(
+      op_name, et, ng::Shape{}, std::vector<double>{value});
+  ng::AxisSet broadcast_axes;
+  for (size_t i = 0; i < shape.size(); i++) {
+    broadcast_axes.insert(i);
+  }
+  return ConstructNgNode<ng::op::Broadcast>(op_name, ng_scalar, shape,
+                                            broadcast_axes);
+}
+
 // Helper function for translating QuantizedAvgPool and QuantizedMaxPool
 static Status TranslateQuantizedPoolOp(const Node* op,
                                        const std::vector<const Tensor*>&,
@@ -639,12 +673,12 @@ static Status TranslateQuantizedPoolOp(const Node* op,
   Builder::SetTracingInfo(op->name(), ng_quant_pool);
 
   BatchToTensorflow(op->name(), is_nhwc, ng_quant_pool);
-  SaveNgOp(ng_op_map, op->name(), ng_quant_pool);
+  SaveNgOp(ng_op_map, op, ng_quant_pool);
   // For QuantizedAvgPool and QuantizedMaxPool input min-max remains unchanged
   // and is just propagated along
   // https://github.com/tensorflow/tensorflow/blob/9590c4c32dd4346ea5c35673336f5912c6072bf2/tensorflow/core/kernels/quantized_pooling_ops.cc#L99
-  SaveNgOp(ng_op_map, op->name(), ng_min);
-  SaveNgOp(ng_op_map, op->name(), ng_max);
+  SaveNgOp(ng_op_map, op, ng_min);
+  SaveNgOp(ng_op_map, op, ng_max);
   return Status::OK();
 }
 
@@ -657,7 +691,7 @@ static Status TranslateAddNOp(const Node* op, const std::vector<const Tensor*>&,
         GetInputNode(ng_op_map, op, inp_idx, &ng_arg_vec[inp_idx]));
 
   SaveNgOp(
-      ng_op_map, op->name(),
+      ng_op_map, op,
       std::accumulate(std::next(ng_arg_vec.begin()), ng_arg_vec.end(),
                       ng_arg_vec.at(0),
                       [&op](shared_ptr<ng::Node> a, shared_ptr<ng::Node> b) {
@@ -705,7 +739,7 @@ static Status TranslateArgMinMaxOp(
   ng::element::Type ng_et;
   TF_RETURN_IF_ERROR(TFDataTypeToNGraphElementType(dtype, &ng_et));
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<T>(op->name(), ng_input, input_dims, ng_et));
   return Status::OK();
 }
@@ -766,7 +800,7 @@ static Status TranslateAvgPoolOp(const Node* op,
   NGRAPH_VLOG(3) << "avgpool outshape: {" << ng::join(ng_avgpool->get_shape())
                  << "}";
 
-  SaveNgOp(ng_op_map, op->name(), ng_avgpool);
+  SaveNgOp(ng_op_map, op, ng_avgpool);
   return Status::OK();
 }
 
@@ -842,7 +876,7 @@ static Status TranslateAvgPoolGradOp(
   NGRAPH_VLOG(3) << "avgpoolbackprop outshape: {"
                  << ng::join(ng_avgpool_backprop->get_shape()) << "}";
 
-  SaveNgOp(ng_op_map, op->name(), ng_avgpool_backprop);
+  SaveNgOp(ng_op_map, op, ng_avgpool_backprop);
 
   return Status::OK();
 }
@@ -889,11 +923,11 @@ static Status TranslateBatchMatMulOp(
   TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "adj_y", &tf_adj_y));
 
   if (n_dims == 2) {
-    SaveNgOp(ng_op_map, op->name(),
+    SaveNgOp(ng_op_map, op,
              ConstructNgNode<ngraph::op::MatMul>(op->name(), ng_lhs, ng_rhs,
                                                  tf_adj_x, tf_adj_y));
   } else if (n_dims == 3) {
-    SaveNgOp(ng_op_map, op->name(),
+    SaveNgOp(ng_op_map, op,
              ConstructNgNode<ngraph::op::BatchMatMulTranspose>(
                  op->name(), ng_lhs, ng_rhs, tf_adj_x, tf_adj_y));
   } else {
@@ -924,7 +958,7 @@ static Status TranslateBatchMatMulOp(
     std::shared_ptr<ng::Node> batchmatmul_transpose =
         ConstructNgNode<ngraph::op::BatchMatMulTranspose>(
             op->name(), lhs_reshape, rhs_reshape, tf_adj_x, tf_adj_y);
-    SaveNgOp(ng_op_map, op->name(),
+    SaveNgOp(ng_op_map, op,
              ConstructNgNode<ngraph::op::Reshape>(
                  op->name(), batchmatmul_transpose, tmp_axes, output_shape));
   }
@@ -1016,7 +1050,7 @@ static Status TranslateBiasAddOp(
   auto ng_add =
       ConstructNgNode<ng::op::Add>(op->name(), ng_input, ng_bias_broadcasted);
 
-  SaveNgOp(ng_op_map, op->name(), ng_add);
+  SaveNgOp(ng_op_map, op, ng_add);
   return Status::OK();
 }
 
@@ -1066,7 +1100,68 @@ static Status TranslateBiasAddGradOp(const Node* op,
   ng_biasadd_backprop =
       ConstructNgNode<ng::op::Sum>(op->name(), ng_input, reduction_axes);
 
-  SaveNgOp(ng_op_map, op->name(), ng_biasadd_backprop);
+  SaveNgOp(ng_op_map, op, ng_biasadd_backprop);
+  return Status::OK();
+}
+
+static Status TranslateBroadcastToOp(
+    const Node* op, const std::vector<const Tensor*>& static_input_map,
+    Builder::OpMap& ng_op_map) {
+  shared_ptr<ng::Node> ng_input, ng_shape_op;
+  TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, &ng_input, &ng_shape_op));
+
+  std::vector<int64> tf_shape;
+  TF_RETURN_IF_ERROR(GetStaticInputVector(op, 1, static_input_map, &tf_shape));
+
+  auto input_shape = ng_input->get_shape();
+  if (input_shape.size() > tf_shape.size()) {
+    return errors::InvalidArgument("Cannot broadcast a tensor of shape ",
+                                   ng::join(input_shape), " to the shape ",
+                                   ng::join(tf_shape), " of lower rank");
+  }
+  ng::Shape output_shape(tf_shape.size());
+  for (size_t i = 0; i < tf_shape.size(); i++) {
+    if (tf_shape[i] < 0) {
+      return errors::InvalidArgument("Negative dimension in BroadcastTo shape ",
+                                     ng::join(tf_shape));
+    }
+    output_shape[i] = tf_shape[i];
+  }
+
+  // The input is aligned with the trailing dimensions of the output. Its
+  // dimensions of size 1 that get broadcast are reshaped away.
+  size_t rank_offset = output_shape.size() - input_shape.size();
+  ng::AxisSet broadcast_axes;
+  for (size_t i = 0; i < rank_offset; i++) {
+    broadcast_axes.insert(i);
+  }
+  ng::Shape reshaped_shape;
+  for (size_t i = 0; i < input_shape.size(); i++) {
+    size_t output_dim = output_shape[rank_offset + i];
+    if (input_shape[i] == output_dim) {
+      reshaped_shape.push_back(output_dim);
+    } else if (input_shape[i] == 1) {
+      broadcast_axes.insert(rank_offset + i);
+    } else {
+      return errors::InvalidArgument("Cannot broadcast a tensor of shape ",
+                                     ng::join(input_shape), " to ",
+                                     ng::join(output_shape));
+    }
+  }
+
+  if (reshaped_shape != input_shape) {
+    ng::AxisVector ng_axis_order(input_shape.size());
+    std::iota(ng_axis_order.begin(), ng_axis_order.end(), 0);
+    ng_input = ConstructNgNode<ng::op::Reshape>(op->name(), ng_input,
+                                                ng_axis_order, reshaped_shape);
+  }
+  if (broadcast_axes.empty()) {
+    SaveNgOp(ng_op_map, op, ng_input);
+  } else {
+    SaveNgOp(ng_op_map, op,
+             ConstructNgNode<ng::op::Broadcast>(op->name(), ng_input,
+                                                output_shape, broadcast_axes));
+  }
   return Status::OK();
 }
 
@@ -1082,7 +1177,7 @@ static Status TranslateCastOp(const Node* op, const std::vector<const Tensor*>&,
   TF_RETURN_IF_ERROR(TFDataTypeToNGraphElementType(dtype, &ng_et));
 
   try {
-    SaveNgOp(ng_op_map, op->name(),
+    SaveNgOp(ng_op_map, op,
              ConstructNgNode<ng::op::Convert>(op->name(), ng_input, ng_et));
   } catch (const std::out_of_range&) {
     return errors::Unimplemented("Unsupported TensorFlow data type: ",
@@ -1091,6 +1186,25 @@ static Status TranslateCastOp(const Node* op, const std::vector<const Tensor*>&,
   return Status::OK();
 }
 
+static Status TranslateClipByValueOp(const Node* op,
+                                     const std::vector<const Tensor*>&,
+                                     Builder::OpMap& ng_op_map) {
+  shared_ptr<ng::Node> ng_input, ng_min, ng_max;
+  TF_RETURN_IF_ERROR(
+      GetInputNodes(ng_op_map, op, &ng_input, &ng_min, &ng_max));
+
+  // The bounds are scalars or have the shape of the input
+  std::tie(ng_input, ng_min) =
+      Builder::PerformNgBroadcast(op->name(), ng_input, ng_min);
+  shared_ptr<ng::Node> ng_lower_clipped =
+      ConstructNgNode<ng::op::Maximum>(op->name(), ng_input, ng_min);
+  std::tie(ng_lower_clipped, ng_max) =
+      Builder::PerformNgBroadcast(op->name(), ng_lower_clipped, ng_max);
+  SaveNgOp(ng_op_map, op, ConstructNgNode<ng::op::Minimum>(
+                              op->name(), ng_lower_clipped, ng_max));
+  return Status::OK();
+}
+
 static Status TranslateCombinedNonMaxSuppressionOp(
     const Node* op, const std::vector<const Tensor*>& static_input_map,
     Builder::OpMap& ng_op_map) {
@@ -1180,10 +1294,10 @@ static Status TranslateCombinedNonMaxSuppressionOp(
   shared_ptr<ngraph::Node> ng_valid_detections =
       ConstructNgNode<ngraph::op::GetOutputElement>(op->name(), ng_cnms, 3);
 
-  SaveNgOp(ng_op_map, op->name(), ng_nmsed_boxes);
-  SaveNgOp(ng_op_map, op->name(), ng_nmsed_scores);
-  SaveNgOp(ng_op_map, op->name(), ng_nmsed_classes);
-  SaveNgOp(ng_op_map, op->name(), ng_valid_detections);
+  SaveNgOp(ng_op_map, op, ng_nmsed_boxes);
+  SaveNgOp(ng_op_map, op, ng_nmsed_scores);
+  SaveNgOp(ng_op_map, op, ng_nmsed_classes);
+  SaveNgOp(ng_op_map, op, ng_valid_detections);
   return Status::OK();
 }
 static Status TranslateConcatV2Op(
@@ -1212,7 +1326,7 @@ static Status TranslateConcatV2Op(
     ng_args.push_back(ng_arg);
   }
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<ng::op::Concat>(op->name(), ng_args,
                                            size_t(concat_axis)));
   return Status::OK();
@@ -1224,27 +1338,27 @@ static Status TranslateConstOp(const Node* op,
   DataType dtype;
   TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "dtype", &dtype));
 
-  std::shared_ptr<ng::Node> ng_node;
+  // Decoded for this translation only: the Constant keeps its own copy, so
+  // the tensor is freed as soon as the Constant is built
+  Tensor const_tensor;
+  const TensorProto* proto;
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "value", &proto));
+  if (!const_tensor.FromProto(*proto)) {
+    return errors::Internal("Could not parse the tensor of Const ",
+                            op->name());
+  }
 
-  // For some reason the following do not work (no specialization of
-  // tensorflow::checkpoint::SavedTypeTraits...)
-  // case DataType::DT_UINT32:
-  //   TF_RETURN_IF_ERROR(MakeConstOp<uint32>(op, ng::element::u32,
-  //   &ng_node));
-  //   break;
-  // case DataType::DT_UINT64:
-  //   TF_RETURN_IF_ERROR(MakeConstOp<uint64>(op, ng::element::u64,
-  //   &ng_node));
-  //   break;
+  std::shared_ptr<ng::Node> ng_node;
   try {
     const auto& func_param = Builder::TF_NGRAPH_CONST_MAP().at(dtype);
-    TF_RETURN_IF_ERROR(func_param.first(op, func_param.second, &ng_node));
+    TF_RETURN_IF_ERROR(
+        func_param.first(op, const_tensor, func_param.second, &ng_node));
   } catch (const std::out_of_range&) {
     return errors::Unimplemented("Unsupported TensorFlow data type: ",
                                  DataType_Name(dtype));
   }
 
-  SaveNgOp(ng_op_map, op->name(), ng_node);
+  SaveNgOp(ng_op_map, op, ng_node);
   return Status::OK();
 }
 
@@ -1317,7 +1431,7 @@ static Status TranslateConv2DOp(const Node* op,
       ng_padding_below, ng_padding_above);
 
   BatchToTensorflow(op->name(), is_nhwc, ng_conv);
-  SaveNgOp(ng_op_map, op->name(), ng_conv);
+  SaveNgOp(ng_op_map, op, ng_conv);
   return Status::OK();
 }
 
@@ -1439,7 +1553,7 @@ static Status TranslateConv2DBackpropFilterOp(
   Reshape<2, 3, 1, 0>(ng_back_prop_filter);
   Builder::SetTracingInfo(op->name(), ng_back_prop_filter);
 
-  SaveNgOp(ng_op_map, op->name(), ng_back_prop_filter);
+  SaveNgOp(ng_op_map, op, ng_back_prop_filter);
   return Status::OK();
 }
 
@@ -1532,7 +1646,7 @@ static Status TranslateConv2DBackpropInputOp(
 
   BatchToTensorflow(op->name(), is_nhwc, ng_data);
 
-  SaveNgOp(ng_op_map, op->name(), ng_data);
+  SaveNgOp(ng_op_map, op, ng_data);
   return Status::OK();
 }
 
@@ -1608,7 +1722,7 @@ static Status TranslateConv3DOp(const Node* op,
       ng_padding_below, ng_padding_above);
 
   BatchToTensorflow3D(op->name(), is_ndhwc, ng_conv);
-  SaveNgOp(ng_op_map, op->name(), ng_conv);
+  SaveNgOp(ng_op_map, op, ng_conv);
   return Status::OK();
 }
 
@@ -1640,7 +1754,7 @@ static Status TranslateCropAndResizeOp(const Node* op,
         extrapolation_value, " in op ", op->name());
   }
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<ng::op::CropAndResize>(op->name(), image, boxes,
                                                   box_ind, crop_size, ng_method,
                                                   extrapolation_value));
@@ -1656,7 +1770,7 @@ static Status TranslateCumsumOp(const Node* op,
   TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "exclusive", &exclusive));
   TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "reverse", &reverse));
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<ng::op::CumSum>(op->name(), ng_x, ng_axis, exclusive,
                                            reverse));
   return Status::OK();
@@ -1818,7 +1932,7 @@ static Status TranslateDepthToSpaceOp(const Node* op,
             ng_axis_order_second_reshape.end(), 0);
   auto final_reshape = ConstructNgNode<ng::op::Reshape>(
       op->name(), transposed, ng_axis_order_second_reshape, ng_output_shape);
-  SaveNgOp(ng_op_map, op->name(), final_reshape);
+  SaveNgOp(ng_op_map, op, final_reshape);
 
   return Status::OK();
 }
@@ -1914,7 +2028,147 @@ static Status TranslateDepthwiseConv2dNativeOp(
       op->name(), ng_args, ng_concatenation_axis);
 
   BatchToTensorflow(op->name(), is_nhwc, ng_concat);
-  SaveNgOp(ng_op_map, op->name(), ng_concat);
+  SaveNgOp(ng_op_map, op, ng_concat);
+  return Status::OK();
+}
+
+// Translates the Einsums of one or two operands, as a transpose and sum for
+// one operand, and as a (batched) matrix multiplication of the transposed
+// and reshaped operands for two.
+static Status TranslateEinsumOp(const Node* op,
+                                const std::vector<const Tensor*>&,
+                                Builder::OpMap& ng_op_map) {
+  std::string equation;
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "equation", &equation));
+  std::vector<std::string> labels;
+  std::string output_labels;
+  TF_RETURN_IF_ERROR(ParseEinsumEquation(equation, &labels, &output_labels));
+  if (labels.size() != op->num_inputs() || labels.size() > 2) {
+    return errors::Unimplemented("Einsum ", op->name(), " has ",
+                                 op->num_inputs(), " inputs, equation ",
+                                 equation);
+  }
+
+  std::vector<shared_ptr<ng::Node>> ng_inputs(labels.size());
+  std::map<char, size_t> label_dims;
+  for (size_t i = 0; i < labels.size(); i++) {
+    TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, i, &ng_inputs[i]));
+    const ng::Shape& shape = ng_inputs[i]->get_shape();
+    if (shape.size() != labels[i].size()) {
+      return errors::InvalidArgument("Einsum input ", i, " of shape ",
+                                     ng::join(shape), " does not match ",
+                                     equation);
+    }
+    for (size_t j = 0; j < shape.size(); j++) {
+      auto itr = label_dims.emplace(labels[i][j], shape[j]).first;
+      if (itr->second != shape[j]) {
+        return errors::InvalidArgument("Einsum label ", labels[i][j],
+                                       " has different sizes in ", equation);
+      }
+    }
+  }
+
+  // Transposes node from the order of the labels from to those of to
+  auto transpose = [&op, &label_dims](shared_ptr<ng::Node> node,
+                                      const std::string& from,
+                                      const std::string& to) {
+    if (from == to) {
+      return node;
+    }
+    ng::AxisVector order(to.size());
+    ng::Shape shape(to.size());
+    for (size_t i = 0; i < to.size(); i++) {
+      order[i] = from.find(to[i]);
+      shape[i] = label_dims[to[i]];
+    }
+    return static_pointer_cast<ng::Node>(
+        ConstructNgNode<ng::op::Reshape>(op->name(), node, order, shape));
+  };
+  // Reshapes node, in the order of its labels, to shape
+  auto reshape = [&op](shared_ptr<ng::Node> node, const ng::Shape& shape) {
+    ng::AxisVector order(node->get_shape().size());
+    std::iota(order.begin(), order.end(), 0);
+    return static_pointer_cast<ng::Node>(
+        ConstructNgNode<ng::op::Reshape>(op->name(), node, order, shape));
+  };
+  auto dims = [&label_dims](const std::string& term) {
+    ng::Shape shape;
+    for (char label : term) {
+      shape.push_back(label_dims[label]);
+    }
+    return shape;
+  };
+
+  // Labels that appear in a single input and not in the output are summed
+  // over first
+  for (size_t i = 0; i < labels.size(); i++) {
+    const std::string& other = labels.size() == 2 ? labels[1 - i] : "";
+    ng::AxisSet summed_axes;
+    std::string kept_labels;
+    for (size_t j = 0; j < labels[i].size(); j++) {
+      char label = labels[i][j];
+      if (output_labels.find(label) == std::string::npos &&
+          other.find(label) == std::string::npos) {
+        summed_axes.insert(j);
+      } else {
+        kept_labels.push_back(label);
+      }
+    }
+    if (!summed_axes.empty()) {
+      ng_inputs[i] =
+          ConstructNgNode<ng::op::Sum>(op->name(), ng_inputs[i], summed_axes);
+      labels[i] = kept_labels;
+    }
+  }
+
+  shared_ptr<ng::Node> ng_result = ng_inputs[0];
+  std::string result_labels = labels[0];
+  if (labels.size() == 2) {
+    // Labels of both inputs are batch dimensions if they are in the output,
+    // and contracted otherwise. The others are the rows of the left operand
+    // and the columns of the right one.
+    const std::string& lhs_labels = labels[0];
+    const std::string& rhs_labels = labels[1];
+    std::string batch, contracted, rows, columns;
+    for (char label : lhs_labels) {
+      if (rhs_labels.find(label) == std::string::npos) {
+        rows.push_back(label);
+      } else if (output_labels.find(label) == std::string::npos) {
+        contracted.push_back(label);
+      } else {
+        batch.push_back(label);
+      }
+    }
+    for (char label : rhs_labels) {
+      if (lhs_labels.find(label) == std::string::npos) {
+        columns.push_back(label);
+      }
+    }
+
+    auto lhs = transpose(ng_inputs[0], lhs_labels, batch + rows + contracted);
+    auto rhs =
+        transpose(ng_inputs[1], rhs_labels, batch + contracted + columns);
+    size_t batch_size = ng::shape_size(dims(batch));
+    size_t n_rows = ng::shape_size(dims(rows));
+    size_t n_contracted = ng::shape_size(dims(contracted));
+    size_t n_columns = ng::shape_size(dims(columns));
+    shared_ptr<ng::Node> ng_product;
+    if (batch.empty()) {
+      ng_product = ConstructNgNode<ng::op::Dot>(
+          op->name(), reshape(lhs, ng::Shape{n_rows, n_contracted}),
+          reshape(rhs, ng::Shape{n_contracted, n_columns}));
+    } else {
+      ng_product = ConstructNgNode<ng::op::BatchMatMulTranspose>(
+          op->name(),
+          reshape(lhs, ng::Shape{batch_size, n_rows, n_contracted}),
+          reshape(rhs, ng::Shape{batch_size, n_contracted, n_columns}), false,
+          false);
+    }
+    result_labels = batch + rows + columns;
+    ng_result = reshape(ng_product, dims(result_labels));
+  }
+
+  SaveNgOp(ng_op_map, op, transpose(ng_result, result_labels, output_labels));
   return Status::OK();
 }
 
@@ -1946,7 +2200,7 @@ static Status TranslateExpandDimsOp(
   std::shared_ptr<ng::Node> ng_expand_dim = ConstructNgNode<ng::op::Reshape>(
       op->name(), ng_input, shape_dimensions, out_shape);
 
-  SaveNgOp(ng_op_map, op->name(), ng_expand_dim);
+  SaveNgOp(ng_op_map, op, ng_expand_dim);
   return Status::OK();
 }
 
@@ -1965,7 +2219,7 @@ static Status TranslateFillOp(
     ng_output_shape[i] = dims_vec[i];
     ng_axis_set.insert(i);
   }
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<ng::op::Broadcast>(op->name(), ng_value,
                                               ng_output_shape, ng_axis_set));
   return Status::OK();
@@ -2057,6 +2311,15 @@ static Status TranslateFusedBatchNormOp(
 
   BatchToNGraph(op->name(), is_nhwc, ng_input);
 
+  // FusedBatchNormV2 and V3 take half and bfloat16 inputs with float scale,
+  // offset, mean and variance. The input is normalized in float.
+  ng::element::Type ng_input_et = ng_input->get_element_type();
+  bool is_converted = ng_input_et != ng_scale->get_element_type();
+  if (is_converted) {
+    ng_input = ConstructNgNode<ng::op::Convert>(op->name(), ng_input,
+                                                ng_scale->get_element_type());
+  }
+
   std::shared_ptr<ng::Node> ng_batch_norm;
 
   if (tf_is_training) {
@@ -2083,43 +2346,50 @@ static Status TranslateFusedBatchNormOp(
     auto variance = ConstructNgNode<ng::op::Multiply>(op->name(), ng_variance,
                                                       Bessel_scale);
 
+    if (is_converted) {
+      ng_y = ConstructNgNode<ng::op::Convert>(op->name(), ng_y, ng_input_et);
+    }
     BatchToTensorflow(op->name(), is_nhwc, ng_y);
 
-    SaveNgOp(ng_op_map, op->name(), ng_y);
-    SaveNgOp(ng_op_map, op->name(), ng_mean);
-    SaveNgOp(ng_op_map, op->name(), variance);
+    SaveNgOp(ng_op_map, op, ng_y);
+    SaveNgOp(ng_op_map, op, ng_mean);
+    SaveNgOp(ng_op_map, op, variance);
     // Output reserve_space_1: A 1D Tensor for the computed batch mean, to be
     // reused in the gradient computation.
-    SaveNgOp(ng_op_map, op->name(), ng_mean);
+    SaveNgOp(ng_op_map, op, ng_mean);
     // Output reserve_space_2: A 1D Tensor for the computed batch variance
     //(inverted variance in the cuDNN case), to be reused in the gradient
     // computation.
-    SaveNgOp(ng_op_map, op->name(), ng_variance);
+    SaveNgOp(ng_op_map, op, ng_variance);
     if (is_v3) {
       // FusedBatchNormV3 has 6 outputs (reserve_space_3)
       shared_ptr<ng::Node> ng_reserved_3 =
           ConstructNgNode<ngraph::op::Constant>(
               op->name(), ng_mean->get_element_type(), ng::Shape{},
               std::vector<std::string>{""});
-      SaveNgOp(ng_op_map, op->name(), ng_reserved_3);
+      SaveNgOp(ng_op_map, op, ng_reserved_3);
     }
   } else {
     ng_batch_norm = ConstructNgNode<ng::op::BatchNormInference>(
         op->name(), tf_epsilon, ng_scale, ng_offset, ng_input, ng_mean,
         ng_variance);
+    if (is_converted) {
+      ng_batch_norm = ConstructNgNode<ng::op::Convert>(
+          op->name(), ng_batch_norm, ng_input_et);
+    }
     BatchToTensorflow(op->name(), is_nhwc, ng_batch_norm);
-    SaveNgOp(ng_op_map, op->name(), ng_batch_norm);
+    SaveNgOp(ng_op_map, op, ng_batch_norm);
     if (is_v3) {
-      SaveNgOp(ng_op_map, op->name(), ng_mean);
-      SaveNgOp(ng_op_map, op->name(), ng_variance);
-      SaveNgOp(ng_op_map, op->name(), ng_mean);
-      SaveNgOp(ng_op_map, op->name(), ng_variance);
+      SaveNgOp(ng_op_map, op, ng_mean);
+      SaveNgOp(ng_op_map, op, ng_variance);
+      SaveNgOp(ng_op_map, op, ng_mean);
+      SaveNgOp(ng_op_map, op, ng_variance);
       // FusedBatchNormV3 has 6 outputs (reserve_space_3)
       shared_ptr<ng::Node> ng_reserved_3 =
           ConstructNgNode<ngraph::op::Constant>(
               op->name(), ng_mean->get_element_type(), ng::Shape{},
               std::vector<std::string>{""});
-      SaveNgOp(ng_op_map, op->name(), ng_reserved_3);
+      SaveNgOp(ng_op_map, op, ng_reserved_3);
     }
   }
 
@@ -2207,22 +2477,22 @@ static Status TranslateFusedBatchNormGradOp(const Node* op,
 
   BatchToTensorflow(op->name(), is_nhwc, ng_input_delta_op);
 
-  SaveNgOp(ng_op_map, op->name(), ng_input_delta_op);
-  SaveNgOp(ng_op_map, op->name(), ng_scale_delta_op);
-  SaveNgOp(ng_op_map, op->name(), ng_beta_delta_op);
+  SaveNgOp(ng_op_map, op, ng_input_delta_op);
+  SaveNgOp(ng_op_map, op, ng_scale_delta_op);
+  SaveNgOp(ng_op_map, op, ng_beta_delta_op);
   // Output reserve_space_3: Unused placeholder to match the mean input
   // in FusedBatchNorm.
   std::shared_ptr<ng::Node> output_mean = ConstructNgNode<ngraph::op::Constant>(
       op->name(), ng_mean->get_element_type(), ng::Shape{},
       std::vector<std::string>{""});
-  SaveNgOp(ng_op_map, op->name(), output_mean);
+  SaveNgOp(ng_op_map, op, output_mean);
   // Output reserve_space_4: Unused placeholder to match the variance input
   // in FusedBatchNorm.
   std::shared_ptr<ng::Node> output_variance =
       ConstructNgNode<ngraph::op::Constant>(
           op->name(), ng_variance->get_element_type(), ng::Shape{},
           std::vector<std::string>{""});
-  SaveNgOp(ng_op_map, op->name(), output_variance);
+  SaveNgOp(ng_op_map, op, output_variance);
 
   return Status::OK();
 }
@@ -2253,7 +2523,7 @@ static Status TranslateGatherNdOp(const Node* op,
         "The last dimension of indices can be at most the rank of params");
   }
 
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<ng::op::GatherND>(
+  SaveNgOp(ng_op_map, op, ConstructNgNode<ng::op::GatherND>(
                                       op->name(), ng_params, ng_indices));
 
   return Status::OK();
@@ -2302,10 +2572,10 @@ static Status TranslateFusedMatMulOp(const Node* op,
   auto ng_add =
       ConstructNgNode<ng::op::Add>(op->name(), ng_matmul, ng_bias_broadcasted);
   if (fused_ops.size() == 1) {  // Only fusing BiasAdd
-    SaveNgOp(ng_op_map, op->name(), ng_add);
+    SaveNgOp(ng_op_map, op, ng_add);
   } else if (fused_ops.size() == 2) {  // Also has activation
     if (fused_ops[1] == "Relu") {
-      SaveNgOp(ng_op_map, op->name(),
+      SaveNgOp(ng_op_map, op,
                ConstructNgNode<ng::op::Relu>(op->name(), ng_add));
     } else if (fused_ops[1] == "Relu6") {
       // TODO fill
@@ -2315,7 +2585,7 @@ static Status TranslateFusedMatMulOp(const Node* op,
       auto relu6_op = ConstructNgNode<ng::op::Minimum>(
           op->name(), ConstructNgNode<ng::op::Relu>(op->name(), ng_add),
           constant_6);
-      SaveNgOp(ng_op_map, op->name(), relu6_op);
+      SaveNgOp(ng_op_map, op, relu6_op);
     } else {
       return errors::Internal(
           "Expected activation to be Relu or Relu6 but got ", fused_ops[1]);
@@ -2367,7 +2637,7 @@ static Status TranslateGatherV2Op(
     auto gather_op = ConstructNgNode<ng::op::Gather>(
         op->name(), ng_input, ng_input_coords, tf_axis[0]);
 
-    SaveNgOp(ng_op_map, op->name(), gather_op);
+    SaveNgOp(ng_op_map, op, gather_op);
   } else {
     ng::runtime::Backend* backend = BackendManager::GetBackend(backend_name);
 
@@ -2378,7 +2648,7 @@ static Status TranslateGatherV2Op(
                               " backend could not return valid ngraph node");
     }
     Builder::SetTracingInfo(op->name(), ng_gather);
-    SaveNgOp(ng_op_map, op->name(), ng_gather);
+    SaveNgOp(ng_op_map, op, ng_gather);
   }
 
   return Status::OK();
@@ -2517,13 +2787,13 @@ static Status TranslateFusedConv2DOp(const Node* op,
         op->name() + "_FusedConv2D_BiasAdd", ng_conv, ng_bias_broadcasted);
 
     if (VecStrCmp(fused_ops, {"BiasAdd", "Relu"})) {
-      SaveNgOp(ng_op_map, op->name(),
+      SaveNgOp(ng_op_map, op,
                ConstructNgNode<ng::op::Relu>(op->name() + "_FusedConv2D_Relu",
                                              ng_add));
     } else if (VecStrCmp(fused_ops, {"BiasAdd", "Relu6"})) {
-      SaveNgOp(ng_op_map, op->name(), create_relu6(op->name(), ng_add));
+      SaveNgOp(ng_op_map, op, create_relu6(op->name(), ng_add));
     } else {
-      SaveNgOp(ng_op_map, op->name(), ng_add);
+      SaveNgOp(ng_op_map, op, ng_add);
     }
   } else if (VecStrCmp(fused_ops, {"FusedBatchNorm"}) ||
              VecStrCmp(fused_ops, {"FusedBatchNorm", "Relu"}) ||
@@ -2551,13 +2821,13 @@ static Status TranslateFusedConv2DOp(const Node* op,
     BatchToTensorflow(op->name(), is_nhwc, ng_batch_norm);
 
     if (VecStrCmp(fused_ops, {"FusedBatchNorm", "Relu"})) {
-      SaveNgOp(ng_op_map, op->name(),
+      SaveNgOp(ng_op_map, op,
                ConstructNgNode<ng::op::Relu>(
                    op->name() + "_FusedConv2D_BatchNormRelu", ng_batch_norm));
     } else if (VecStrCmp(fused_ops, {"FusedBatchNorm", "Relu6"})) {
-      SaveNgOp(ng_op_map, op->name(), create_relu6(op->name(), ng_batch_norm));
+      SaveNgOp(ng_op_map, op, create_relu6(op->name(), ng_batch_norm));
     } else {
-      SaveNgOp(ng_op_map, op->name(), ng_batch_norm);
+      SaveNgOp(ng_op_map, op, ng_batch_norm);
     }
   } else {
     return errors::Unimplemented("Unsupported _FusedConv2D " +
@@ -2571,7 +2841,7 @@ static Status TranslateIdentityOp(const Node* op,
                                   Builder::OpMap& ng_op_map) {
   shared_ptr<ng::Node> ng_arg;
   TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, &ng_arg));
-  SaveNgOp(ng_op_map, op->name(), ng_arg);
+  SaveNgOp(ng_op_map, op, ng_arg);
   return Status::OK();
 }
 
@@ -2605,7 +2875,7 @@ static Status TranslateIsFiniteOp(
   auto is_finite =
       ConstructNgNode<ng::op::And>(op->name(), neq_inf_and_neq_neg_inf, eq_nan);
 
-  SaveNgOp(ng_op_map, op->name(), is_finite);
+  SaveNgOp(ng_op_map, op, is_finite);
   return Status::OK();
 }
 
@@ -2632,7 +2902,29 @@ static Status TranslateL2LossOp(const Node* op,
       ConstructNgNode<ng::op::Sum>(op->name(), ng_pow, axes);
   std::shared_ptr<ng::Node> ng_l2loss =
       ConstructNgNode<ng::op::Divide>(op->name(), ng_sum, const_2);
-  SaveNgOp(ng_op_map, op->name(), ng_l2loss);
+  SaveNgOp(ng_op_map, op, ng_l2loss);
+  return Status::OK();
+}
+
+static Status TranslateLeakyReluOp(const Node* op,
+                                   const std::vector<const Tensor*>&,
+                                   Builder::OpMap& ng_op_map) {
+  shared_ptr<ng::Node> ng_input;
+  TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, &ng_input));
+
+  float alpha;
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "alpha", &alpha));
+
+  auto et = ng_input->get_element_type();
+  auto shape = ng_input->get_shape();
+  auto ng_alpha = ConstructScalarBroadcast(op->name(), et, shape, alpha);
+  auto ng_zero = ConstructScalarBroadcast(op->name(), et, shape, 0);
+  auto ng_positive =
+      ConstructNgNode<ng::op::Greater>(op->name(), ng_input, ng_zero);
+  auto ng_scaled =
+      ConstructNgNode<ng::op::Multiply>(op->name(), ng_alpha, ng_input);
+  SaveNgOp(ng_op_map, op, ConstructNgNode<ng::op::Select>(
+                              op->name(), ng_positive, ng_input, ng_scaled));
   return Status::OK();
 }
 
@@ -2675,7 +2967,7 @@ static Status TranslateLogSoftmaxOp(const Node* op,
       op->name(), ng_log_sum, ng_inp->get_shape(), ng_axis);
   auto ng_output = ConstructNgNode<ng::op::Subtract>(
       op->name(), ng_inp_minus_max, ng_broadcast);
-  SaveNgOp(ng_op_map, op->name(), ng_output);
+  SaveNgOp(ng_op_map, op, ng_output);
   return Status::OK();
 }
 
@@ -2690,7 +2982,7 @@ static Status TranslateSoftplusOp(const Node* op,
       std::vector<std::string>(ng::shape_size(ng_inp->get_shape()), "1"));
   auto ng_output = ConstructNgNode<ng::op::Log>(
       op->name(), ConstructNgNode<ng::op::Add>(op->name(), ng_exp, constant_1));
-  SaveNgOp(ng_op_map, op->name(), ng_output);
+  SaveNgOp(ng_op_map, op, ng_output);
   return Status::OK();
 }
 
@@ -2707,7 +2999,7 @@ static Status TranslateMatMulOp(const Node* op,
   bool transpose_b = false;
   TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "transpose_b", &transpose_b));
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<ngraph::op::MatMul>(op->name(), ng_lhs, ng_rhs,
                                                transpose_a, transpose_b));
   return Status::OK();
@@ -2771,7 +3063,7 @@ static Status TranslateMaxPoolOp(const Node* op,
   NGRAPH_VLOG(3) << "maxpool outshape: {" << ng::join(ng_maxpool->get_shape())
                  << "}";
 
-  SaveNgOp(ng_op_map, op->name(), ng_maxpool);
+  SaveNgOp(ng_op_map, op, ng_maxpool);
   return Status::OK();
 }
 
@@ -2833,7 +3125,7 @@ static Status TranslateMaxPool3DOp(const Node* op,
   NGRAPH_VLOG(3) << "maxpool outshape: {" << ng::join(ng_maxpool->get_shape())
                  << "}";
 
-  SaveNgOp(ng_op_map, op->name(), ng_maxpool);
+  SaveNgOp(ng_op_map, op, ng_maxpool);
   return Status::OK();
 }
 
@@ -2891,7 +3183,7 @@ static Status TranslateMaxPoolGradOp(const Node* op,
   BatchToTensorflow(op->name(), is_nhwc, ng_maxpool_backprop);
   NGRAPH_VLOG(3) << "maxpoolbackprop outshape: {"
                  << ng::join(ng_maxpool_backprop->get_shape()) << "}";
-  SaveNgOp(ng_op_map, op->name(), ng_maxpool_backprop);
+  SaveNgOp(ng_op_map, op, ng_maxpool_backprop);
   return Status::OK();
 }
 
@@ -2965,8 +3257,8 @@ static Status TranslateNonMaxSuppressionV4Op(
   shared_ptr<ngraph::Node> ng_valid_output =
       ConstructNgNode<ngraph::op::GetOutputElement>(op->name(), ng_nmsv4, 1);
 
-  SaveNgOp(ng_op_map, op->name(), ng_selected_indices);
-  SaveNgOp(ng_op_map, op->name(), ng_valid_output);
+  SaveNgOp(ng_op_map, op, ng_selected_indices);
+  SaveNgOp(ng_op_map, op, ng_valid_output);
 
   return Status::OK();
 }
@@ -3019,7 +3311,7 @@ static Status TranslateReduceOp(
         op->name(), ng_node, ng_axis_order, ng_result_shape_with_keep);
   }
 
-  SaveNgOp(ng_op_map, op->name(), ng_node);
+  SaveNgOp(ng_op_map, op, ng_node);
   return Status::OK();
 }
 
@@ -3104,7 +3396,7 @@ static Status TranslateOneHotOp(
   auto ng_onehot = ConstructNgNode<ng::op::Select>(op->name(), ng_onehot_bool,
                                                    ng_on, ng_off);
 
-  SaveNgOp(ng_op_map, op->name(), ng_onehot);
+  SaveNgOp(ng_op_map, op, ng_onehot);
   return Status::OK();
 }
 
@@ -3156,7 +3448,7 @@ static Status TranslatePackOp(const Node* op, const std::vector<const Tensor*>&,
 
   auto concat = ConstructNgNode<ng::op::Concat>(op->name(), ng_concat_inputs,
                                                 concat_axis);
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<ng::op::Reshape>(op->name(), concat, ng_axis_order,
                                             output_shape));
   return Status::OK();
@@ -3183,6 +3475,19 @@ static Status TranslatePadOp(const Node* op,
   ng::CoordinateDiff padding_above(paddings.size() / 2);
   ng::Shape padding_interior(paddings.size() / 2);
   auto pad_mode = ng::op::PadMode::CONSTANT;
+  if (op->type_string() == "MirrorPad") {
+    std::string tf_mode;
+    TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "mode", &tf_mode));
+    if (tf_mode == "REFLECT") {
+      pad_mode = ng::op::PadMode::REFLECT;
+    } else if (tf_mode == "SYMMETRIC") {
+      pad_mode = ng::op::PadMode::SYMMETRIC;
+    } else {
+      return errors::InvalidArgument("MirrorPad mode must be REFLECT or "
+                                     "SYMMETRIC, got ",
+                                     tf_mode);
+    }
+  }
 
   for (size_t i = 0; i < paddings.size() / 2; i++) {
     padding_below[i] = paddings[2 * i];
@@ -3193,14 +3498,14 @@ static Status TranslatePadOp(const Node* op,
   NGRAPH_VLOG(3) << "{" << ng::join(padding_below) << "}";
   NGRAPH_VLOG(3) << "{" << ng::join(padding_above) << "}";
 
-  // For PadV1 it seems the value is always zero.
+  // For PadV1 it seems the value is always zero. MirrorPad does not use it.
   auto pad_val_op = ConstructNgNode<ng::op::Constant>(
       op->name(), ng_input->get_element_type(), ng::Shape{},
       std::vector<std::string>{"0"});
   auto pad_op = ConstructNgNode<ng::op::Pad>(
       op->name(), ng_input, pad_val_op, padding_below, padding_above, pad_mode);
 
-  SaveNgOp(ng_op_map, op->name(), pad_op);
+  SaveNgOp(ng_op_map, op, pad_op);
   return Status::OK();
 }
 
@@ -3217,7 +3522,7 @@ static Status TranslateRankOp(const Node* op, const std::vector<const Tensor*>&,
       op->name(), ng::element::i32, ng::Shape(),
       std::vector<int>({input_rank}));
 
-  SaveNgOp(ng_op_map, op->name(), ng_rank);
+  SaveNgOp(ng_op_map, op, ng_rank);
   return Status::OK();
 }
 
@@ -3249,7 +3554,7 @@ static Status TranslateRandomUniformOp(
       op->name(), const_min, const_max, const_shape, const_use_fixed_seed,
       seed);
 
-  SaveNgOp(ng_op_map, op->name(), random_uniform);
+  SaveNgOp(ng_op_map, op, random_uniform);
   return Status::OK();
 }
 
@@ -3405,7 +3710,7 @@ static Status TranslateQuantizeAndDequantizeV2Op(
   auto ng_quant = ConstructNgNode<ng::op::Quantize>(
       op->name(), ng_input, ng_scale, ng_offset, ng_q_et, ng::AxisSet(),
       ng_round_mode);
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<ng::op::Dequantize>(
+  SaveNgOp(ng_op_map, op, ConstructNgNode<ng::op::Dequantize>(
                                       op->name(), ng_quant, ng_scale, ng_offset,
                                       ng_r_et, ng::AxisSet()));
 
@@ -3517,9 +3822,9 @@ static Status TranslateQuantizedConcatOpHelper(
       ng_args, size_t(concat_axis), ng_all_mins, ng_all_maxs);
   Builder::SetTracingInfo(op->name(), ng_qconcat);
 
-  SaveNgOp(ng_op_map, op->name(), ng_qconcat);
-  SaveNgOp(ng_op_map, op->name(), ng_min_of_mins);
-  SaveNgOp(ng_op_map, op->name(), ng_max_of_maxs);
+  SaveNgOp(ng_op_map, op, ng_qconcat);
+  SaveNgOp(ng_op_map, op, ng_min_of_mins);
+  SaveNgOp(ng_op_map, op, ng_max_of_maxs);
   return Status::OK();
 }
 
@@ -3593,14 +3898,14 @@ static Status TranslateQuantizedConv(
   Builder::SetTracingInfo(op->name(), ng_quant_conv_bias);
 
   BatchToTensorflow(op->name(), is_nhwc, ng_quant_conv_bias);
-  SaveNgOp(ng_op_map, op->name(), ng_quant_conv_bias);
+  SaveNgOp(ng_op_map, op, ng_quant_conv_bias);
   // QconvBiasAdd variants have summand and its min/max as the last input
   // nodes
   auto adjust_idx = num_node_inputs == 12 ? 3 : 0;
   // Forward the min_freezed_output input to output min
-  SaveNgOp(ng_op_map, op->name(), node_inps[num_node_inputs - 2 - adjust_idx]);
+  SaveNgOp(ng_op_map, op, node_inps[num_node_inputs - 2 - adjust_idx]);
   // Forward the max_freezed_output input to output max
-  SaveNgOp(ng_op_map, op->name(), node_inps[num_node_inputs - 1 - adjust_idx]);
+  SaveNgOp(ng_op_map, op, node_inps[num_node_inputs - 1 - adjust_idx]);
   return Status::OK();
 }
 
@@ -3696,9 +4001,9 @@ static Status TranslateQuantizeV2Op(const Node* op,
   auto ng_node = ng::builder::QuantizeBuilder(ng_input, ng_min, ng_max, ng_et,
                                               ng::AxisSet(), ng_round_mode);
   Builder::SetTracingInfo(op->name(), ng_node);
-  SaveNgOp(ng_op_map, op->name(), ng_node);
-  SaveNgOp(ng_op_map, op->name(), ng_min);
-  SaveNgOp(ng_op_map, op->name(), ng_max);
+  SaveNgOp(ng_op_map, op, ng_node);
+  SaveNgOp(ng_op_map, op, ng_min);
+  SaveNgOp(ng_op_map, op, ng_max);
 
   return Status::OK();
 }
@@ -3713,7 +4018,7 @@ static Status TranslateDequantizeOp(const Node* op,
   auto ng_node = ng::builder::DequantizeBuilder(
       ng_input, ng_min, ng_max, ng::element::f32, ng::AxisSet());
   Builder::SetTracingInfo(op->name(), ng_node);
-  SaveNgOp(ng_op_map, op->name(), ng_node);
+  SaveNgOp(ng_op_map, op, ng_node);
   return Status::OK();
 }
 
@@ -3730,7 +4035,7 @@ static Status TranslateRelu6Op(const Node* op,
       op->name(), ConstructNgNode<ng::op::Relu>(op->name(), ng_input),
       constant_6);
 
-  SaveNgOp(ng_op_map, op->name(), relu6_op);
+  SaveNgOp(ng_op_map, op, relu6_op);
   return Status::OK();
 }
 
@@ -3742,7 +4047,7 @@ static Status TranslateReluGradOp(const Node* op,
 
   auto ng_relu_grad =
       ConstructNgNode<ng::op::ReluBackprop>(op->name(), ng_arg, ng_delta);
-  SaveNgOp(ng_op_map, op->name(), ng_relu_grad);
+  SaveNgOp(ng_op_map, op, ng_relu_grad);
   return Status::OK();
 }
 
@@ -3807,7 +4112,7 @@ static Status TranslateReshapeOp(
   ng::AxisVector ng_axis_order(ng_input->get_shape().size());
   std::iota(ng_axis_order.begin(), ng_axis_order.end(), 0);
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<ng::op::Reshape>(op->name(), ng_input, ng_axis_order,
                                             ng_shape));
   return Status::OK();
@@ -3833,18 +4138,137 @@ static Status TranslateResizeBilinearOp(
   attrs.align_corners = align_corners;
   attrs.mode = "linear";
   attrs.antialias = false;
-  // The TF "images" is has dimensions [batch, height, width, channels].
+  // The TF images have dimensions [batch, height, width, channels]
   // So 1 and 2 are the spatial axes
   // TODO check this parameter
   attrs.axes = {1, 2};
   // TODO: pads_begin and pads_end are not populated. Check correctness
 
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<ng::op::Interpolate>(
+  SaveNgOp(ng_op_map, op, ConstructNgNode<ng::op::Interpolate>(
                                       op->name(), images, size_int64, attrs));
 
   return Status::OK();
 }
 
+// Resizes by gathering, along the height and then the width, the input pixel
+// nearest to each output pixel
+static Status TranslateResizeNearestNeighborOp(
+    const Node* op, const std::vector<const Tensor*>& static_input_map,
+    Builder::OpMap& ng_op_map) {
+  shared_ptr<ng::Node> images, ng_size;
+  TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, &images, &ng_size));
+
+  std::vector<int64> size_vector;
+  TF_RETURN_IF_ERROR(
+      GetStaticInputVector(op, 1, static_input_map, &size_vector));
+  auto images_shape = images->get_shape();
+  if (size_vector.size() != 2 || images_shape.size() != 4) {
+    return errors::InvalidArgument(
+        "ResizeNearestNeighbor expects 4D images and 2 sizes, got images of "
+        "shape ",
+        ng::join(images_shape), " and size ", ng::join(size_vector));
+  }
+
+  bool align_corners;
+  TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "align_corners", &align_corners));
+  bool half_pixel_centers;
+  if (GetNodeAttr(op->attrs(), "half_pixel_centers", &half_pixel_centers) !=
+      Status::OK()) {
+    half_pixel_centers = false;
+  }
+
+  // The TF images have dimensions [batch, height, width, channels]
+  shared_ptr<ng::Node> ng_resized = images;
+  for (size_t axis : {1, 2}) {
+    int64 in_size = images_shape[axis];
+    int64 out_size = size_vector[axis - 1];
+    if (out_size <= 0) {
+      return errors::InvalidArgument("ResizeNearestNeighbor size must be "
+                                     "positive, got ",
+                                     ng::join(size_vector));
+    }
+    float scale = (align_corners && out_size > 1)
+                      ? (in_size - 1) / static_cast<float>(out_size - 1)
+                      : in_size / static_cast<float>(out_size);
+    std::vector<int64> indices(out_size);
+    for (int64 i = 0; i < out_size; i++) {
+      float in_coord = half_pixel_centers ? (i + 0.5f) * scale : i * scale;
+      int64 in_index = align_corners ? static_cast<int64>(std::round(in_coord))
+                                     : static_cast<int64>(std::floor(in_coord));
+      indices[i] = std::min(in_index, in_size - 1);
+    }
+    auto ng_indices = ConstructNgNode<ng::op::Constant>(
+        op->name(), ng::element::i64,
+        ng::Shape{static_cast<size_t>(out_size)}, indices);
+    ng_resized = ConstructNgNode<ng::op::Gather>(op->name(), ng_resized,
+                                                 ng_indices, axis);
+  }
+
+  SaveNgOp(ng_op_map, op, ng_resized);
+  return Status::OK();
+}
+
+static Status TranslateReverseV2Op(
+    const Node* op, const std::vector<const Tensor*>& static_input_map,
+    Builder::OpMap& ng_op_map) {
+  shared_ptr<ng::Node> ng_input, ng_axis_op;
+  TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, &ng_input, &ng_axis_op));
+
+  std::vector<int64> tf_axis;
+  TF_RETURN_IF_ERROR(GetStaticInputVector(op, 1, static_input_map, &tf_axis));
+
+  size_t rank = ng_input->get_shape().size();
+  TF_RETURN_IF_ERROR(CheckAxisDimInRange(tf_axis, rank));
+  ng::AxisSet ng_reversed_axes;
+  for (auto axis : tf_axis) {
+    ng_reversed_axes.insert(axis < 0 ? axis + rank : axis);
+  }
+
+  SaveNgOp(ng_op_map, op, ConstructNgNode<ng::op::Reverse>(
+                              op->name(), ng_input, ng_reversed_axes));
+  return Status::OK();
+}
+
+// Rounds halves to even, as TF does. Integers are left as they are.
+static Status TranslateRoundOp(
+    const Node* op, const std::vector<const Tensor*>& static_input_map,
+    Builder::OpMap& ng_op_map) {
+  return TranslateUnaryOp(
+      op, static_input_map, ng_op_map, [&op](std::shared_ptr<ng::Node> n) {
+        auto et = n->get_element_type();
+        if (!et.is_real()) {
+          return n;
+        }
+        auto shape = n->get_shape();
+        auto ng_half = ConstructScalarBroadcast(op->name(), et, shape, 0.5);
+        auto ng_one = ConstructScalarBroadcast(op->name(), et, shape, 1);
+
+        auto ng_floor = ConstructNgNode<ng::op::Floor>(op->name(), n);
+        auto ng_ceil =
+            ConstructNgNode<ng::op::Add>(op->name(), ng_floor, ng_one);
+        auto ng_fraction =
+            ConstructNgNode<ng::op::Subtract>(op->name(), n, ng_floor);
+        // The floor is even if half of it is an integer
+        auto ng_half_floor =
+            ConstructNgNode<ng::op::Multiply>(op->name(), ng_floor, ng_half);
+        auto ng_floor_is_even = ConstructNgNode<ng::op::Equal>(
+            op->name(),
+            ConstructNgNode<ng::op::Floor>(op->name(), ng_half_floor),
+            ng_half_floor);
+
+        auto ng_even = ConstructNgNode<ng::op::Select>(
+            op->name(), ng_floor_is_even, ng_floor, ng_ceil);
+        auto ng_nearest = ConstructNgNode<ng::op::Select>(
+            op->name(),
+            ConstructNgNode<ng::op::Less>(op->name(), ng_fraction, ng_half),
+            ng_floor, ng_ceil);
+        return static_pointer_cast<ng::Node>(ConstructNgNode<ng::op::Select>(
+            op->name(),
+            ConstructNgNode<ng::op::Equal>(op->name(), ng_fraction, ng_half),
+            ng_even, ng_nearest));
+      });
+}
+
 static Status TranslateRsqrtOp(
     const Node* op, const std::vector<const Tensor*>& static_input_map,
     Builder::OpMap& ng_op_map) {
@@ -3884,7 +4308,7 @@ static Status TranslateScatterNdOp(
   auto ng_inputs = ConstructNgNode<ng::op::Constant>(
       op->name(), et, ng::Shape(ng_shape_size_t), constant_values);
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<ng::op::ScatterNDAdd>(op->name(), ng_inputs,
                                                  ng_indices, ng_updates));
 
@@ -3918,7 +4342,7 @@ static Status TranslateRsqrtGradOp(const Node* op,
       op->name(),
       (ConstructNgNode<ng::op::Multiply>(op->name(), ng_pow, ng_delta)),
       ng_diff);
-  SaveNgOp(ng_op_map, op->name(), ng_result);
+  SaveNgOp(ng_op_map, op, ng_result);
   return Status::OK();
 }
 
@@ -3947,7 +4371,7 @@ static Status TranslateShapeOp(const Node* op,
   for (size_t i = 0; i < rank; i++) {
     values[i] = input_shape[i];
   }
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<ng::op::Constant>(op->name(), type, shape, values));
   return Status::OK();
 }
@@ -3969,7 +4393,7 @@ static Status TranslateSigmoidGradOp(const Node* op,
   auto ng_result =
       ConstructNgNode<ng::op::Multiply>(op->name(), ng_mul, ng_subtract);
 
-  SaveNgOp(ng_op_map, op->name(), ng_result);
+  SaveNgOp(ng_op_map, op, ng_result);
   return Status::OK();
 }
 
@@ -3988,7 +4412,7 @@ static Status TranslateSigmoidOp(const Node* op,
   auto denominator_op =
       ConstructNgNode<ng::op::Add>(op->name(), constant_1, exp_op);
 
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<ng::op::Divide>(
+  SaveNgOp(ng_op_map, op, ConstructNgNode<ng::op::Divide>(
                                       op->name(), constant_1, denominator_op));
   return Status::OK();
 }
@@ -4016,7 +4440,7 @@ static Status TranslateSizeOp(const Node* op, const std::vector<const Tensor*>&,
   auto ng_result = ConstructNgNode<ng::op::Constant>(
       op->name(), type, ng::Shape(0), std::vector<int64>({result}));
 
-  SaveNgOp(ng_op_map, op->name(), ng_result);
+  SaveNgOp(ng_op_map, op, ng_result);
   return Status::OK();
 }
 
@@ -4073,7 +4497,7 @@ static Status TranslateSliceOp(
   std::vector<size_t> l(lower_vec.begin(), lower_vec.end());
   std::vector<size_t> u(upper_vec.begin(), upper_vec.end());
   auto ng_slice = ConstructNgNode<ng::op::Slice>(op->name(), ng_input, l, u);
-  SaveNgOp(ng_op_map, op->name(), ng_slice);
+  SaveNgOp(ng_op_map, op, ng_slice);
   return Status::OK();
 }
 
@@ -4221,8 +4645,8 @@ static Status TranslateSoftmaxCrossEntropyWithLogitsOp(
   auto ng_backprop =
       ConstructNgNode<ng::op::Subtract>(op->name(), predicted_prob, ng_labels);
 
-  SaveNgOp(ng_op_map, op->name(), ng_loss);
-  SaveNgOp(ng_op_map, op->name(), ng_backprop);
+  SaveNgOp(ng_op_map, op, ng_loss);
+  SaveNgOp(ng_op_map, op, ng_backprop);
   return Status::OK();
 }
 
@@ -4240,7 +4664,7 @@ static Status TranslateSoftmaxOp(const Node* op,
   }
   auto rank = ng_input->get_shape().size();
   ng_axes_softmax.insert(rank - 1);
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<ng::op::Softmax>(
+  SaveNgOp(ng_op_map, op, ConstructNgNode<ng::op::Softmax>(
                                       op->name(), ng_input, ng_axes_softmax));
   return Status::OK();
 }
@@ -4320,7 +4744,7 @@ static Status TranslateSpaceToDepthOp(const Node* op,
     }
   }
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<ngraph::op::Concat>(op->name(), strided_slice_result,
                                                channel_index));
   return Status::OK();
@@ -4434,8 +4858,8 @@ static Status TranslateSparseSoftmaxCrossEntropyWithLogitsOp(
   auto ng_backprop = ConstructNgNode<ng::op::Subtract>(
       op->name(), predicted_prob, ng_onehot_labels_float);
 
-  SaveNgOp(ng_op_map, op->name(), ng_loss);
-  SaveNgOp(ng_op_map, op->name(), ng_backprop);
+  SaveNgOp(ng_op_map, op, ng_loss);
+  SaveNgOp(ng_op_map, op, ng_backprop);
   return Status::OK();
 }
 
@@ -4471,7 +4895,7 @@ static Status TranslateSplitOp(
     upper[split_dim] = cursor;
 
     std::string output_name = op->name();
-    SaveNgOp(ng_op_map, op->name(), ConstructNgNode<ng::op::Slice>(
+    SaveNgOp(ng_op_map, op, ConstructNgNode<ng::op::Slice>(
                                         op->name(), ng_input, lower, upper));
   }
   return Status::OK();
@@ -4548,11 +4972,11 @@ static Status TranslateSplitVOp(
       lower[split_dim] = cursor;
       cursor += lengths[i];
       upper[split_dim] = cursor;
-      SaveNgOp(ng_op_map, op->name(), ConstructNgNode<ng::op::Slice>(
+      SaveNgOp(ng_op_map, op, ConstructNgNode<ng::op::Slice>(
                                           op->name(), ng_input, lower, upper));
     }
   } else {
-    SaveNgOp(ng_op_map, op->name(), ng_input);
+    SaveNgOp(ng_op_map, op, ng_input);
   }
 
   return Status::OK();
@@ -4631,7 +5055,7 @@ static Status TranslateSqueezeOp(const Node* op,
   ng::AxisVector ng_axis_order(ng_input->get_shape().size());
   std::iota(ng_axis_order.begin(), ng_axis_order.end(), 0);
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<ng::op::Reshape>(op->name(), ng_input, ng_axis_order,
                                             output_shape));
   return Status::OK();
@@ -4657,7 +5081,7 @@ static Status TranslateStridedSliceOp(
       GetStaticInputVector(op, 3, static_input_map, &stride_vec));
 
   // Desired implementation ==>
-  // SaveNgOp(ng_op_map, op->name(),
+  // SaveNgOp(ng_op_map, op,
   //          ConstructNgNode<ng::op::StridedSlice>(op->name(), begin_vec,
   //          end_vec, stride_vec,
   //                             tf_begin_mask, tf_end_mask,
@@ -4719,7 +5143,7 @@ static Status TranslateStridedSliceOp(
                                                  sp.reverse_axes);
   }
 
-  SaveNgOp(ng_op_map, op->name(), ng_result);
+  SaveNgOp(ng_op_map, op, ng_result);
   return Status::OK();
 }
 
@@ -4783,7 +5207,7 @@ static Status TranslateStridedSliceGradOp(
 
   auto ng_result = ConstructNgNode<ng::op::ReplaceSlice>(
       op->name(), zeros, ng_delta, sp_begins, sp_ends, sp_strides);
-  SaveNgOp(ng_op_map, op->name(), ng_result);
+  SaveNgOp(ng_op_map, op, ng_result);
   return Status::OK();
 }
 
@@ -4806,7 +5230,7 @@ static Status TranslateTanhGradOp(const Node* op,
   auto ng_result =
       ConstructNgNode<ng::op::Multiply>(op->name(), ng_delta, ng_sub);
 
-  SaveNgOp(ng_op_map, op->name(), ng_result);
+  SaveNgOp(ng_op_map, op, ng_result);
   return Status::OK();
 }
 
@@ -4834,7 +5258,7 @@ static Status TranslateTileOp(
     output_shape[i] = ng_input_shape[i] * multiples[i];
   }
   if (is_empty) {
-    SaveNgOp(ng_op_map, op->name(),
+    SaveNgOp(ng_op_map, op,
              ConstructNgNode<ngraph::op::Constant>(
                  op->name(), ng_input->get_element_type(), output_shape,
                  std::vector<std::string>(ng::shape_size(output_shape), "0")));
@@ -4852,7 +5276,7 @@ static Status TranslateTileOp(
           ConstructNgNode<ngraph::op::Concat>(op->name(), tmp_tensors, i);
       ng_output = ng_concat;
     }
-    SaveNgOp(ng_op_map, op->name(), ng_output);
+    SaveNgOp(ng_op_map, op, ng_output);
   }
   return Status::OK();
 }
@@ -4889,8 +5313,8 @@ static Status TranslateTopKV2Op(
   shared_ptr<ngraph::Node> ng_indices =
       ConstructNgNode<ngraph::op::GetOutputElement>(op->name(), ng_result, 0);
 
-  SaveNgOp(ng_op_map, op->name(), ng_values);
-  SaveNgOp(ng_op_map, op->name(), ng_indices);
+  SaveNgOp(ng_op_map, op, ng_values);
+  SaveNgOp(ng_op_map, op, ng_indices);
 
   return Status::OK();
 }
@@ -4938,7 +5362,7 @@ static Status TranslateTransposeOp(
 
   auto ng_node = ng::builder::numpy_transpose(ng_input, ng_axis_order);
   Builder::SetTracingInfo(op->name(), ng_node);
-  SaveNgOp(ng_op_map, op->name(), ng_node);
+  SaveNgOp(ng_op_map, op, ng_node);
   return Status::OK();
 }
 
@@ -4990,7 +5414,7 @@ static Status TranslateUnpackOp(const Node* op,
                                                     lower_bound, upper_bound);
     auto reshaped = ConstructNgNode<ng::op::Reshape>(
         op->name(), slice, ng_axis_order, output_shape);
-    SaveNgOp(ng_op_map, op->name(), reshaped);
+    SaveNgOp(ng_op_map, op, reshaped);
   }
   return Status::OK();
 }
@@ -5031,7 +5455,7 @@ static Status TranslateUnsortedSegmentSumOp(
   auto unsorted_segment_sum = ConstructNgNode<ng::op::ScatterAdd>(
       op->name(), result, ng_segment_ids, ng_input);
 
-  SaveNgOp(ng_op_map, op->name(), unsorted_segment_sum);
+  SaveNgOp(ng_op_map, op, unsorted_segment_sum);
   return Status::OK();
 }
 
@@ -5092,7 +5516,29 @@ static Status TranslateSelectOp(const Node* op,
   ng_select = ConstructNgNode<ng::op::Select>(op->name(), ng_input1, ng_input2,
                                               ng_input3);
 
-  SaveNgOp(ng_op_map, op->name(), ng_select);
+  SaveNgOp(ng_op_map, op, ng_select);
+  return Status::OK();
+}
+
+// SelectV2 broadcasts its three inputs to a common shape, as numpy.where
+static Status TranslateSelectV2Op(const Node* op,
+                                  const std::vector<const Tensor*>&,
+                                  Builder::OpMap& ng_op_map) {
+  shared_ptr<ng::Node> ng_condition, ng_then, ng_else;
+  TF_RETURN_IF_ERROR(
+      GetInputNodes(ng_op_map, op, &ng_condition, &ng_then, &ng_else));
+
+  // The second round broadcasts the condition and the first input to the
+  // shape the inputs got in the first one
+  for (int i = 0; i < 2; i++) {
+    std::tie(ng_condition, ng_then) =
+        Builder::PerformNgBroadcast(op->name(), ng_condition, ng_then);
+    std::tie(ng_then, ng_else) =
+        Builder::PerformNgBroadcast(op->name(), ng_then, ng_else);
+  }
+
+  SaveNgOp(ng_op_map, op, ConstructNgNode<ng::op::Select>(
+                              op->name(), ng_condition, ng_then, ng_else));
   return Status::OK();
 }
 
@@ -5107,7 +5553,7 @@ static Status TranslateZerosLikeOp(const Node* op,
   auto ng_result = ConstructNgNode<ng::op::Constant>(
       op->name(), ng_input->get_element_type(), input_shape, const_values);
 
-  SaveNgOp(ng_op_map, op->name(), ng_result);
+  SaveNgOp(ng_op_map, op, ng_result);
   return Status::OK();
 }
 
@@ -5128,7 +5574,8 @@ const static std::map<
       {"BatchMatMul", TranslateBatchMatMulOp},
       {"BatchMatMulV2", TranslateBatchMatMulV2Op},
       {"BiasAdd", TranslateBiasAddOp}, {"BiasAddGrad", TranslateBiasAddGradOp},
-      {"Cast", TranslateCastOp},
+      {"BroadcastTo", TranslateBroadcastToOp},
+      {"Cast", TranslateCastOp}, {"ClipByValue", TranslateClipByValueOp},
       {"CombinedNonMaxSuppression", TranslateCombinedNonMaxSuppressionOp},
       {"ConcatV2", TranslateConcatV2Op}, {"Const", TranslateConstOp},
       {"Conv2D", TranslateConv2DOp},
@@ -5138,8 +5585,9 @@ const static std::map<
       {"CropAndResize", TranslateCropAndResizeOp},
       {"Cumsum", TranslateCumsumOp}, {"DepthToSpace", TranslateDepthToSpaceOp},
       {"DepthwiseConv2dNative", TranslateDepthwiseConv2dNativeOp},
-      {"Dequantize", TranslateDequantizeOp},
+      {"Dequantize", TranslateDequantizeOp}, {"Einsum", TranslateEinsumOp},
       {"Equal", TranslateBinaryOp<ngraph::op::Equal>},
+      {"Erf", TranslateUnaryOp<ngraph::op::Erf>},
       {"Exp", TranslateUnaryOp<ngraph::op::Exp>},
       {"ExpandDims", TranslateExpandDimsOp}, {"Fill", TranslateFillOp},
       {"Floor", TranslateUnaryOp<ngraph::op::Floor>},
@@ -5161,6 +5609,7 @@ const static std::map<
 #endif
       {"Identity", TranslateIdentityOp}, {"IsFinite", TranslateIsFiniteOp},
       {"L2Loss", TranslateL2LossOp}, {"LogSoftmax", TranslateLogSoftmaxOp},
+      {"LeakyRelu", TranslateLeakyReluOp},
       {"Less", TranslateBinaryOp<ngraph::op::Less>},
       {"LessEqual", TranslateBinaryOp<ngraph::op::LessEq>},
       {"Log", TranslateUnaryOp<ngraph::op::Log>}, {"Log1p", TranslateLog1pOp},
@@ -5172,6 +5621,7 @@ const static std::map<
       {"Maximum", TranslateBinaryOp<ngraph::op::Maximum>},
       {"MaxPool", TranslateMaxPoolOp}, {"MaxPool3D", TranslateMaxPool3DOp},
       {"MaxPoolGrad", TranslateMaxPoolGradOp},
+      {"MirrorPad", TranslatePadOp},
       {"NonMaxSuppressionV4", TranslateNonMaxSuppressionV4Op},
       {"Mean", TranslateMeanOp}, {"Min", TranslateDirectReduceOp<ng::op::Min>},
       {"Minimum", TranslateBinaryOp<ngraph::op::Minimum>},
@@ -5206,8 +5656,11 @@ const static std::map<
       {"Relu", TranslateUnaryOp<ngraph::op::Relu>}, {"Relu6", TranslateRelu6Op},
       {"ReluGrad", TranslateReluGradOp}, {"Reshape", TranslateReshapeOp},
       {"ResizeBilinear", TranslateResizeBilinearOp},
+      {"ResizeNearestNeighbor", TranslateResizeNearestNeighborOp},
+      {"ReverseV2", TranslateReverseV2Op}, {"Round", TranslateRoundOp},
       {"Rsqrt", TranslateRsqrtOp}, {"RsqrtGrad", TranslateRsqrtGradOp},
       {"ScatterNd", TranslateScatterNdOp}, {"Select", TranslateSelectOp},
+      {"SelectV2", TranslateSelectV2Op},
       {"Shape", TranslateShapeOp}, {"Sigmoid", TranslateSigmoidOp},
       {"SigmoidGrad", TranslateSigmoidGradOp},
       {"Sin", TranslateUnaryOp<ngraph::op::Sin>}, {"Size", TranslateSizeOp},
@@ -5224,6 +5677,8 @@ const static std::map<
       {"Square", TranslateSquareOp},
       {"SquaredDifference", TranslateSquaredDifferenceOp},
       {"Squeeze", TranslateSqueezeOp},
+      // StopGradient is just Identity in data-flow terms, like PreventGradient
+      {"StopGradient", TranslateIdentityOp},
       {"StridedSlice", TranslateStridedSliceOp},
       {"StridedSliceGrad", TranslateStridedSliceGradOp},
       {"Sub", TranslateBinaryOp<ngraph::op::Subtract>},
@@ -5237,6 +5692,122 @@ const static std::map<
   }
 };
 
+// Translates a LayerNorm or GELU pattern to the fused nGraph op, if the
+// shapes allow it. Sets *fused to false (and translates nothing) otherwise.
+static Status TranslateFusedPattern(const FusedPattern& pattern,
+                                    Builder::OpMap& ng_op_map, bool* fused) {
+  *fused = false;
+  shared_ptr<ng::Node> ng_input;
+  TF_RETURN_IF_ERROR(GetEdgeNode(ng_op_map, pattern.inputs[0], &ng_input));
+  const string& op_name = pattern.anchor->name();
+
+  if (pattern.type == FusedPattern::Type::GELU) {
+    SaveNgOp(ng_op_map, pattern.anchor,
+             ConstructNgNode<ng::op::Gelu>(op_name, ng_input));
+    *fused = true;
+    return Status::OK();
+  }
+
+  // ng::op::LayerNorm normalizes over the trailing axes, with one scale and
+  // one bias element per normalized element. Only the last axis is handled,
+  // which is what the Python layers use by default.
+  shared_ptr<ng::Node> ng_gamma, ng_beta;
+  TF_RETURN_IF_ERROR(GetEdgeNode(ng_op_map, pattern.inputs[1], &ng_gamma));
+  TF_RETURN_IF_ERROR(GetEdgeNode(ng_op_map, pattern.inputs[2], &ng_beta));
+  const ng::Shape& shape = ng_input->get_shape();
+  int64 rank = shape.size();
+  if (rank == 0 || pattern.axes.size() != 1 ||
+      (pattern.axes[0] != -1 && pattern.axes[0] != rank - 1)) {
+    return Status::OK();
+  }
+  ng::Shape param_shape{shape.back()};
+  if (ng_gamma->get_shape() != param_shape ||
+      ng_beta->get_shape() != param_shape) {
+    return Status::OK();
+  }
+
+  SaveNgOp(ng_op_map, pattern.anchor,
+           ConstructNgNode<ng::op::LayerNorm>(op_name, ng_input, ng_gamma,
+                                              ng_beta, false, rank - 1,
+                                              pattern.epsilon));
+  *fused = true;
+  return Status::OK();
+}
+
+// Clusters with fewer ops are translated on the calling thread
+static const size_t MIN_OPS_FOR_PARALLEL_TRANSLATION = 256;
+
+void Builder::GetIndependentSubgraphs(const Graph* graph,
+                                      vector<vector<const Node*>>* subgraphs) {
+  vector<Node*> ordered;
+  GetReversePostOrder(*graph, &ordered, NodeComparatorName());
+  vector<const Node*> tf_ops;
+  for (auto n : ordered) {
+    if (n->IsOp() && n->type_string() != "_Arg" &&
+        n->type_string() != "_Retval") {
+      tf_ops.push_back(n);
+    }
+  }
+
+  // The sources that subgraphs may share. The Consts of a fused pattern are
+  // translated with it, so they are not.
+  vector<bool> is_shared(graph->num_node_ids(), false);
+  for (auto n : ordered) {
+    is_shared[n->id()] =
+        n->type_string() == "_Arg" || n->type_string() == "Const";
+  }
+  vector<FusedPattern> fused_patterns;
+  if (std::getenv("NGRAPH_TF_DISABLE_FUSED_PATTERNS") == nullptr) {
+    FindFusedPatterns(tf_ops, &fused_patterns);
+  }
+  for (const auto& pattern : fused_patterns) {
+    for (auto node : pattern.interior) {
+      is_shared[node->id()] = false;
+    }
+  }
+
+  vector<int> parent(graph->num_node_ids());
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find_root = [&parent](int id) {
+    while (parent[id] != id) {
+      parent[id] = parent[parent[id]];
+      id = parent[id];
+    }
+    return id;
+  };
+
+  for (auto op : tf_ops) {
+    for (auto edge : op->in_edges()) {
+      if (edge->IsControlEdge() || edge->src()->IsSource() ||
+          is_shared[edge->src()->id()]) {
+        continue;
+      }
+      parent[find_root(edge->src()->id())] = find_root(op->id());
+    }
+  }
+
+  std::unordered_map<int, size_t> subgraph_of_root;
+  for (auto op : tf_ops) {
+    if (is_shared[op->id()]) {
+      continue;
+    }
+    int root = find_root(op->id());
+    auto it = subgraph_of_root.find(root);
+    if (it == subgraph_of_root.end()) {
+      it = subgraph_of_root.emplace(root, subgraphs->size()).first;
+      subgraphs->emplace_back();
+    }
+    (*subgraphs)[it->second].push_back(op);
+  }
+
+  // Larger subgraphs first, so that they do not end up last on one thread
+  std::stable_sort(subgraphs->begin(), subgraphs->end(),
+                   [](const vector<const Node*>& a,
+                      const vector<const Node*>& b) {
+                     return a.size() > b.size();
+                   });
+}
+
 Status Builder::TranslateGraph(
     const std::vector<TensorShape>& inputs,
     const std::vector<const Tensor*>& static_input_map,
@@ -5287,7 +5858,7 @@ Status Builder::TranslateGraph(
   // The op map holds a mapping from TensorFlow op names (strings) to
   // vector of generated nGraph nodes.
   //
-  Builder::OpMap ng_op_map;
+  Builder::OpMap ng_op_map(input_graph->num_node_ids());
 
   //
   // Populate the parameter list, and also put parameters into the op map.
@@ -5314,14 +5885,33 @@ Status Builder::TranslateGraph(
     GetNodeAttr(parm->attrs(), "_prov_tag", &prov_tag);
     auto ng_param =
         ConstructNgNode<ng::op::Parameter>(prov_tag, ng_et, ng_shape);
-    SaveNgOp(ng_op_map, parm->name(), ng_param);
+    SaveNgOp(ng_op_map, parm, ng_param);
     ng_parameter_list[index] = ng_param;
   }
 
+  //
+  // Find the LayerNorm and GELU subgraphs. Their ops are translated to a
+  // single fused op when their anchor is reached.
+  //
+  vector<FusedPattern> fused_patterns;
+  if (std::getenv("NGRAPH_TF_DISABLE_FUSED_PATTERNS") == nullptr) {
+    FindFusedPatterns(tf_ops, &fused_patterns);
+  }
+  vector<const FusedPattern*> pattern_at(input_graph->num_node_ids(), nullptr);
+  vector<bool> in_pattern(input_graph->num_node_ids(), false);
+  for (const auto& pattern : fused_patterns) {
+    pattern_at[pattern.anchor->id()] = &pattern;
+    for (auto node : pattern.interior) {
+      in_pattern[node->id()] = true;
+    }
+  }
+
   //
   // Now create the nGraph ops from TensorFlow ops.
   //
-  for (auto op : tf_ops) {
+  auto translate_single_op = [&static_input_map](const Node* op,
+                                                 Builder::OpMap& op_map)
+      -> Status {
     NGRAPH_VLOG(2) << "Constructing op " << op->name() << " which is "
                    << op->type_string();
 
@@ -5343,13 +5933,137 @@ Status Builder::TranslateGraph(
     }
 
     try {
-      TF_RETURN_IF_ERROR((*op_fun)(op, static_input_map, ng_op_map));
+      TF_RETURN_IF_ERROR((*op_fun)(op, static_input_map, op_map));
     } catch (const std::exception& e) {
       return errors::Internal("Unhandled exception in op handler: ", op->name(),
                               " (", op->type_string(), ")\n",
                               op->def().DebugString(), "\n", "what(): ",
                               e.what());
     }
+    return Status::OK();
+  };
+
+  auto translate_op = [&pattern_at, &in_pattern, &translate_single_op](
+      const Node* op, Builder::OpMap& op_map) -> Status {
+    if (in_pattern[op->id()]) {
+      return Status::OK();
+    }
+    const FusedPattern* pattern = pattern_at[op->id()];
+    if (pattern != nullptr) {
+      bool fused;
+      TF_RETURN_IF_ERROR(TranslateFusedPattern(*pattern, op_map, &fused));
+      if (fused) {
+        NGRAPH_VLOG(2) << "Fused " << pattern->interior.size() + 1
+                       << " ops into " << op->name();
+        return Status::OK();
+      }
+      // The ops of the pattern were skipped, translate them now
+      for (auto interior_op : pattern->interior) {
+        TF_RETURN_IF_ERROR(translate_single_op(interior_op, op_map));
+      }
+    }
+    return translate_single_op(op, op_map);
+  };
+
+  // Large clusters are translated on the compile thread pool, if there is
+  // one. Translations started from one of its threads (precompiles, say) run
+  // serially, the other threads being busy with the other encapsulates.
+  thread::ThreadPool* pool = GetCompileThreadPool();
+  vector<vector<const Node*>> subgraphs;
+  if (pool != nullptr && pool->CurrentThreadId() < 0 &&
+      tf_ops.size() >= MIN_OPS_FOR_PARALLEL_TRANSLATION) {
+    GetIndependentSubgraphs(input_graph, &subgraphs);
+  }
+  if (subgraphs.size() < 2) {
+    for (auto op : tf_ops) {
+      TF_RETURN_IF_ERROR(translate_op(op, ng_op_map));
+    }
+  } else {
+    // The subgraphs are spread over one partition per thread
+    int num_partitions = std::min<int>(subgraphs.size(), pool->NumThreads());
+    vector<vector<const Node*>> partitions(num_partitions);
+    for (const auto& subgraph : subgraphs) {
+      auto smallest = std::min_element(
+          partitions.begin(), partitions.end(),
+          [](const vector<const Node*>& a, const vector<const Node*>& b) {
+            return a.size() < b.size();
+          });
+      smallest->insert(smallest->end(), subgraph.begin(), subgraph.end());
+    }
+    vector<int> partition_of(input_graph->num_node_ids(), -1);
+    for (int p = 0; p < num_partitions; p++) {
+      for (auto op : partitions[p]) {
+        partition_of[op->id()] = p;
+      }
+    }
+
+    // The Consts shared by the subgraphs are translated first, here
+    for (auto op : tf_ops) {
+      if (partition_of[op->id()] < 0) {
+        TF_RETURN_IF_ERROR(translate_op(op, ng_op_map));
+      }
+    }
+
+    // Each partition is translated into an op map of its own. Constructing
+    // an nGraph node registers it with the outputs of its arguments, which
+    // is not thread safe, so a source used by several partitions is given a
+    // stand-in Parameter in each of them. The stand-ins are replaced by the
+    // source once all the partitions are translated.
+    std::map<const Node*, std::set<int>> source_partitions;
+    for (int p = 0; p < num_partitions; p++) {
+      for (auto op : partitions[p]) {
+        for (auto edge : op->in_edges()) {
+          if (!edge->IsControlEdge() && edge->src()->IsOp() &&
+              partition_of[edge->src()->id()] < 0) {
+            source_partitions[edge->src()].insert(p);
+          }
+        }
+      }
+    }
+    vector<Builder::OpMap> partition_maps(
+        num_partitions, Builder::OpMap(input_graph->num_node_ids()));
+    vector<std::pair<shared_ptr<ng::Node>, shared_ptr<ng::Node>>> stand_ins;
+    for (const auto& source : source_partitions) {
+      const auto& entry = ng_op_map[source.first->id()];
+      for (int p : source.second) {
+        if (source.second.size() == 1) {
+          partition_maps[p][source.first->id()] = entry;
+          continue;
+        }
+        for (const auto& ng_node : entry) {
+          shared_ptr<ng::Node> stand_in;
+          if (ng_node != nullptr) {
+            stand_in = make_shared<ng::op::Parameter>(
+                ng_node->get_element_type(), ng_node->get_shape());
+            stand_ins.push_back(std::make_pair(stand_in, ng_node));
+          }
+          partition_maps[p][source.first->id()].push_back(stand_in);
+        }
+      }
+    }
+
+    NGRAPH_VLOG(2) << "Translating " << subgraphs.size()
+                   << " independent subgraphs in " << num_partitions
+                   << " partitions";
+    vector<std::function<Status()>> tasks;
+    for (int p = 0; p < num_partitions; p++) {
+      tasks.push_back([&partitions, &partition_maps, &translate_op, p]() {
+        for (auto op : partitions[p]) {
+          TF_RETURN_IF_ERROR(translate_op(op, partition_maps[p]));
+        }
+        return Status::OK();
+      });
+    }
+    TF_RETURN_IF_ERROR(RunCompileTasks(tasks));
+
+    for (int p = 0; p < num_partitions; p++) {
+      for (auto op : partitions[p]) {
+        ng_op_map[op->id()] = std::move(partition_maps[p][op->id()]);
+      }
+    }
+    for (const auto& stand_in : stand_ins) {
+      ng::replace_node(stand_in.first, stand_in.second);
+    }
   }
 
   //
@@ -5385,6 +6099,46 @@ Status Builder::TranslateGraph(
   OpControlOrder(ng_function, "BroadcastDistributed");
 #endif
 
+  //
+  // Drop the NHWC <-> NCHW transposes between consecutive layers.
+  //
+  if (std::getenv("NGRAPH_TF_DISABLE_TRANSPOSE_SINKING") == nullptr) {
+    SinkTransposes(ng_function);
+  }
+
+  //
+  // Compute the matrix multiplications and convolutions in bf16 or f16, if
+  // requested.
+  //
+  ng::element::Type ng_mixed_precision_et;
+  TF_RETURN_IF_ERROR(GetMixedPrecisionType(&ng_mixed_precision_et));
+  if (ng_mixed_precision_et.is_static()) {
+    LowerPrecision(ng_function, ng_mixed_precision_et);
+  }
+
+  //
+  // Evaluate the ops that only depend on constants (including the constant
+  // transposes left by SinkTransposes and the conversions of weights left by
+  // LowerPrecision) once, here.
+  //
+  if (std::getenv("NGRAPH_TF_DISABLE_CONSTANT_FOLDING") == nullptr) {
+    FoldConstants(ng_function);
+  }
+
+  //
+  // Apply the gradients of embedding lookups to the looked up rows only.
+  //
+  if (std::getenv("NGRAPH_TF_DISABLE_SPARSE_UPDATES") == nullptr) {
+    FuseSparseUpdates(ng_function);
+  }
+
+  //
+  // Keep int8 tensors quantized across the ops between quantized kernels.
+  //
+  if (std::getenv("NGRAPH_TF_DISABLE_QUANTIZATION_PROPAGATION") == nullptr) {
+    PropagateQuantization(ng_function);
+  }
+
   //
   // Request row-major layout on results.
   //
@@ -19,8 +19,10 @@
 #include <ostream>
 #include <vector>
 
+#include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/gtl/inlined_vector.h"
 
 #include "ngraph/ngraph.hpp"
 
@@ -37,8 +39,19 @@ class Builder {
       const std::vector<const Tensor*>& static_input_map, const Graph* tf_graph,
       std::shared_ptr<ngraph::Function>& ng_function);
 
-  using OpMap = std::unordered_map<std::string,
-                                   std::vector<std::shared_ptr<ngraph::Node>>>;
+  // Splits the ops of the cluster graph (in topological order) into the
+  // subgraphs that TranslateGraph may translate concurrently: the weakly
+  // connected components of the graph of data edges, leaving out the _Args
+  // and Consts they share. Each subgraph keeps the topological order of its
+  // ops, and the subgraphs are sorted by decreasing size.
+  static void GetIndependentSubgraphs(
+      const Graph* graph, std::vector<std::vector<const Node*>>* subgraphs);
+
+  // The nGraph nodes generated for each TF node (one per output), indexed
+  // by Node::id(). Nodes in different slots can be written concurrently.
+  // Most ops have a single output, which is stored inline.
+  using OpMapEntry = gtl::InlinedVector<std::shared_ptr<ngraph::Node>, 1>;
+  using OpMap = std::vector<OpMapEntry>;
 
   template <typename T>
   static void MakePadding(const std::string& tf_padding_type,
@@ -143,7 +156,8 @@ class Builder {
 
   static const std::map<
       DataType,
-      std::pair<std::function<Status(const Node*, ngraph::element::Type,
+      std::pair<std::function<Status(const Node*, const Tensor&,
+                                     ngraph::element::Type,
                                      std::shared_ptr<ngraph::Node>*)>,
                 const ngraph::element::Type>>&
   TF_NGRAPH_CONST_MAP();
@@ -0,0 +1,314 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+
+#include "logging/ngraph_log.h"
+#include "ngraph_bridge/ngraph_cluster_cost_model.h"
+
+using namespace std;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Gets the shape of the index-th output of the node, from its
+// "_output_shapes", its value for a Const, or else the inferred shapes if
+// any. Returns false if it is not known.
+static bool GetOutputShape(const Node* node, int index, TensorShape* shape,
+                           const GraphShapes* shapes = nullptr) {
+  std::vector<PartialTensorShape> output_shapes;
+  if (GetNodeAttr(node->attrs(), "_output_shapes", &output_shapes).ok() &&
+      index < output_shapes.size() &&
+      output_shapes[index].AsTensorShape(shape)) {
+    return true;
+  }
+
+  const TensorProto* value;
+  if (node->type_string() == "Const" && index == 0 &&
+      GetNodeAttr(node->attrs(), "value", &value).ok() &&
+      TensorShape::IsValid(value->tensor_shape())) {
+    *shape = TensorShape(value->tensor_shape());
+    return true;
+  }
+
+  if (shapes != nullptr && node->id() < shapes->size() &&
+      index < (*shapes)[node->id()].size()) {
+    return (*shapes)[node->id()][index].AsTensorShape(shape);
+  }
+  return false;
+}
+
+// Gets the shape of the tensor feeding the index-th input of the node
+static bool GetInputShape(const Node* node, int index, TensorShape* shape,
+                          const GraphShapes* shapes) {
+  const Edge* edge;
+  if (!node->input_edge(index, &edge).ok()) {
+    return false;
+  }
+  return GetOutputShape(edge->src(), edge->src_output(), shape, shapes);
+}
+
+// Estimates the number of floating point operations done by the node. Returns
+// false if the shapes needed for the estimate are not known.
+static bool EstimateNodeFlops(const Node* node, const GraphShapes* shapes,
+                              double* flops) {
+  *flops = 0;
+  const string& op_type = node->type_string();
+  if (node->num_outputs() == 0 || op_type == "Const" ||
+      op_type == "Identity" || op_type == "Reshape" || op_type == "Shape") {
+    return true;
+  }
+
+  TensorShape out_shape;
+  if (!GetOutputShape(node, 0, &out_shape, shapes)) {
+    return false;
+  }
+  double out_elements = out_shape.num_elements();
+
+  if (op_type == "MatMul" || op_type == "BatchMatMul" ||
+      op_type == "BatchMatMulV2") {
+    // 2 * M * N * K, K being the contracted dimension of the first input
+    TensorShape a_shape;
+    if (!GetInputShape(node, 0, &a_shape, shapes) || a_shape.dims() < 2) {
+      return false;
+    }
+    bool transpose_a = false;
+    if (!GetNodeAttr(node->attrs(),
+                     op_type == "MatMul" ? "transpose_a" : "adj_x",
+                     &transpose_a)
+             .ok()) {
+      return false;
+    }
+    int64 k = a_shape.dim_size(transpose_a ? a_shape.dims() - 2
+                                           : a_shape.dims() - 1);
+    *flops = 2 * out_elements * k;
+  } else if (op_type == "Conv2D" || op_type == "Conv3D" ||
+             op_type == "Conv2DBackpropInput") {
+    // 2 * output elements * filter window * input channels, the filter being
+    // [spatial dims..., in channels, out channels]
+    TensorShape filter_shape;
+    if (!GetInputShape(node, 1, &filter_shape, shapes) ||
+        filter_shape.dims() < 2) {
+      return false;
+    }
+    double window = 1;
+    for (int i = 0; i < filter_shape.dims() - 1; i++) {
+      window *= filter_shape.dim_size(i);
+    }
+    *flops = 2 * out_elements * window;
+  } else {
+    // elementwise ops, reductions, data movement
+    *flops = out_elements;
+  }
+  return true;
+}
+
+bool ClusterCostModel::EstimateOutputBytes(const Node* node, int index,
+                                           double* bytes,
+                                           const GraphShapes* shapes) {
+  TensorShape shape;
+  if (!GetOutputShape(node, index, &shape, shapes)) {
+    return false;
+  }
+  *bytes = double(shape.num_elements()) *
+           DataTypeSize(BaseType(node->output_type(index)));
+  return true;
+}
+
+ClusterCostEstimate ClusterCostModel::EstimateCluster(
+    const std::set<Node*>& cluster_nodes, const GraphShapes* shapes) {
+  ClusterCostEstimate estimate;
+  // Each tensor crossing the boundary is transferred once, however many
+  // edges consume it
+  std::set<std::pair<const Node*, int>> inputs;
+  std::set<std::pair<const Node*, int>> outputs;
+
+  for (auto node : cluster_nodes) {
+    if (node->type_string() != "Const") {
+      estimate.num_ops++;
+    }
+
+    double flops;
+    if (EstimateNodeFlops(node, shapes, &flops)) {
+      estimate.flops += flops;
+    } else {
+      estimate.is_complete = false;
+      estimate.num_unknown_ops++;
+    }
+
+    for (auto edge : node->in_edges()) {
+      if (edge->IsControlEdge() ||
+          cluster_nodes.find(edge->src()) != cluster_nodes.end()) {
+        continue;
+      }
+      inputs.insert(std::make_pair(edge->src(), edge->src_output()));
+    }
+    for (auto edge : node->out_edges()) {
+      if (edge->IsControlEdge() ||
+          cluster_nodes.find(edge->dst()) != cluster_nodes.end()) {
+        continue;
+      }
+      outputs.insert(std::make_pair(node, edge->src_output()));
+    }
+  }
+
+  for (auto& input : inputs) {
+    double bytes;
+    if (EstimateOutputBytes(input.first, input.second, &bytes, shapes)) {
+      estimate.bytes_in += bytes;
+    } else {
+      estimate.is_complete = false;
+      estimate.num_unknown_tensors++;
+    }
+  }
+  for (auto& output : outputs) {
+    double bytes;
+    if (EstimateOutputBytes(output.first, output.second, &bytes, shapes)) {
+      estimate.bytes_out += bytes;
+    } else {
+      estimate.is_complete = false;
+      estimate.num_unknown_tensors++;
+    }
+  }
+  return estimate;
+}
+
+DefaultClusterCostModel::DefaultClusterCostModel() {}
+
+DefaultClusterCostModel::DefaultClusterCostModel(const Parameters& parameters)
+    : m_parameters(parameters) {}
+
+Status DefaultClusterCostModel::ShouldDeassign(
+    const std::set<Node*>& cluster_nodes, const GraphShapes* shapes,
+    bool* deassign) {
+  ClusterCostEstimate estimate = EstimateCluster(cluster_nodes, shapes);
+
+  // What is not known is assumed to cost the defaults
+  double flops = estimate.flops +
+                 estimate.num_unknown_ops * m_parameters.unknown_op_flops;
+  double bytes =
+      estimate.bytes_in + estimate.bytes_out +
+      estimate.num_unknown_tensors * m_parameters.unknown_tensor_bytes;
+  double tf_time_us = estimate.num_ops * m_parameters.tf_op_overhead_us +
+                      flops / m_parameters.tf_flops_per_us;
+  double ng_time_us = m_parameters.encapsulate_overhead_us +
+                      bytes / m_parameters.transfer_bytes_per_us +
+                      flops / m_parameters.ng_flops_per_us;
+
+  NGRAPH_VLOG(3) << "Cluster cost model: ops: " << estimate.num_ops
+                 << " flops: " << estimate.flops
+                 << " bytes in: " << estimate.bytes_in
+                 << " bytes out: " << estimate.bytes_out
+                 << " unknown ops: " << estimate.num_unknown_ops
+                 << " unknown tensors: " << estimate.num_unknown_tensors
+                 << " TF time (us): " << tf_time_us
+                 << " nGraph time (us): " << ng_time_us;
+
+  *deassign = ng_time_us > tf_time_us;
+  return Status::OK();
+}
+
+Status DefaultClusterCostModel::LoadTimingProfile(
+    const std::string& log_file_name) {
+  std::ifstream log_file(log_file_name);
+  if (!log_file) {
+    return errors::NotFound("Could not open timing profile ", log_file_name);
+  }
+
+  // NGRAPH_TF_TIMING_PROFILE: OP_ID: 0 Step_ID: 5 Cluster: ngraph_cluster_0
+  // Time-Compute: 10 Function-Create-or-Lookup: 0 Create-and-copy-tensors: 1
+  // Execute: 7 Copy-outputs-to-host: 1
+  // (all times in ms)
+  double total_overhead_ms = 0;
+  int num_calls = 0;
+  std::string line;
+  while (std::getline(log_file, line)) {
+    if (line.find("NGRAPH_TF_TIMING_PROFILE:") == std::string::npos) {
+      continue;
+    }
+    std::istringstream tokens(line);
+    std::string token;
+    int compute = -1, create_or_lookup = -1, execute = -1;
+    while (tokens >> token) {
+      if (token == "Time-Compute:") {
+        tokens >> compute;
+      } else if (token == "Function-Create-or-Lookup:") {
+        tokens >> create_or_lookup;
+      } else if (token == "Execute:") {
+        tokens >> execute;
+      }
+    }
+    if (compute < 0 || create_or_lookup < 0 || execute < 0) {
+      continue;
+    }
+    // Function creation (compilation) is a one time cost, not a per call one
+    total_overhead_ms += std::max(compute - create_or_lookup - execute, 0);
+    num_calls++;
+  }
+
+  if (num_calls == 0) {
+    return errors::InvalidArgument("No NGRAPH_TF_TIMING_PROFILE entries in ",
+                                   log_file_name);
+  }
+
+  // The profile has ms resolution, so do not let it drive the overhead to 0
+  m_parameters.encapsulate_overhead_us =
+      std::max(1000.0 * total_overhead_ms / num_calls, 1.0);
+  NGRAPH_VLOG(1) << "Cluster cost model: encapsulate overhead "
+                 << m_parameters.encapsulate_overhead_us << " us from "
+                 << num_calls << " calls in " << log_file_name;
+  return Status::OK();
+}
+
+static std::unique_ptr<ClusterCostModel> s_cluster_cost_model;
+static std::mutex s_cluster_cost_model_mutex;
+
+ClusterCostModel* GetClusterCostModel() {
+  std::lock_guard<std::mutex> lock(s_cluster_cost_model_mutex);
+  if (s_cluster_cost_model == nullptr) {
+    std::unique_ptr<DefaultClusterCostModel> cost_model(
+        new DefaultClusterCostModel());
+    const char* profile = std::getenv("NGRAPH_TF_CLUSTER_COST_PROFILE");
+    if (profile != nullptr) {
+      Status status = cost_model->LoadTimingProfile(profile);
+      if (!status.ok()) {
+        NGRAPH_VLOG(0) << "Ignoring NGRAPH_TF_CLUSTER_COST_PROFILE: "
+                       << status.error_message();
+      }
+    }
+    s_cluster_cost_model = std::move(cost_model);
+  }
+  return s_cluster_cost_model.get();
+}
+
+void SetClusterCostModel(std::unique_ptr<ClusterCostModel> cost_model) {
+  std::lock_guard<std::mutex> lock(s_cluster_cost_model_mutex);
+  s_cluster_cost_model = std::move(cost_model);
+}
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef NGRAPH_TF_BRIDGE_CLUSTER_COST_MODEL_H_
+#define NGRAPH_TF_BRIDGE_CLUSTER_COST_MODEL_H_
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include "tensorflow/core/graph/graph.h"
+
+#include "ngraph_bridge/ngraph_propagate_shapes.h"
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Static estimate of the work done by a cluster and of the data crossing its
+// boundary
+struct ClusterCostEstimate {
+  // false if some shape needed for the estimate is not known
+  bool is_complete = true;
+  int num_ops = 0;
+  double flops = 0;
+  // bytes fed into the encapsulate from outside the cluster
+  double bytes_in = 0;
+  // bytes produced by the encapsulate for consumers outside the cluster
+  double bytes_out = 0;
+  // ops whose flops, and tensors crossing the boundary whose bytes, are left
+  // out of the above because their shapes are not known
+  int num_unknown_ops = 0;
+  int num_unknown_tensors = 0;
+};
+
+// Decides whether a cluster is worth running as an nGraph encapsulate, or
+// should be handed back to TF. Implementations can be plugged in with
+// SetClusterCostModel.
+class ClusterCostModel {
+ public:
+  virtual ~ClusterCostModel() {}
+
+  // Sets *deassign to true if the nodes are expected to run slower in an
+  // encapsulate than they would as individual TF ops. shapes, if not null,
+  // are the shapes inferred for the graph of the nodes.
+  virtual Status ShouldDeassign(const std::set<Node*>& cluster_nodes,
+                                const GraphShapes* shapes, bool* deassign) = 0;
+
+  // Estimates flops and bytes transferred for the cluster, from the shapes
+  // available in the graph ("_output_shapes" attributes and Const values)
+  // or else from shapes, if given
+  static ClusterCostEstimate EstimateCluster(
+      const std::set<Node*>& cluster_nodes,
+      const GraphShapes* shapes = nullptr);
+
+  // Estimates the size in bytes of the index-th output of the node. Shapes
+  // missing from the graph are taken from shapes, if given. Returns false if
+  // the shape is not known.
+  static bool EstimateOutputBytes(const Node* node, int index, double* bytes,
+                                  const GraphShapes* shapes = nullptr);
+};
+
+// Compares the estimated TF time (per op overhead + compute) against the
+// estimated encapsulate time (fixed per call overhead + host transfers +
+// compute), all in microseconds
+class DefaultClusterCostModel : public ClusterCostModel {
+ public:
+  struct Parameters {
+    // fixed cost of one NGraphEncapsulate call
+    double encapsulate_overhead_us = 50;
+    // cost TF pays for scheduling each op it runs
+    double tf_op_overhead_us = 2;
+    // throughput of the data copied into and out of the encapsulate
+    double transfer_bytes_per_us = 4000;
+    // compute throughput of TF kernels and of the nGraph backend
+    double tf_flops_per_us = 2000;
+    double ng_flops_per_us = 4000;
+    // assumed for the ops and the tensors whose shapes are not known
+    double unknown_op_flops = 10000;
+    double unknown_tensor_bytes = 40000;
+  };
+
+  DefaultClusterCostModel();
+  explicit DefaultClusterCostModel(const Parameters& parameters);
+
+  Status ShouldDeassign(const std::set<Node*>& cluster_nodes,
+                        const GraphShapes* shapes, bool* deassign) override;
+
+  const Parameters& GetParameters() const { return m_parameters; }
+
+  // Seeds the encapsulate overhead from a log captured with the bridge's
+  // timing profile (NGRAPH_TF_TIMING_PROFILE lines, NGRAPH_TF_VLOG_LEVEL=1):
+  // the time spent in Compute outside of the backend call is the per call
+  // overhead
+  Status LoadTimingProfile(const std::string& log_file_name);
+
+ private:
+  Parameters m_parameters;
+};
+
+// Returns the cost model used by DeassignClusters. Unless one has been set, it
+// is a DefaultClusterCostModel, seeded from the timing log named by
+// NGRAPH_TF_CLUSTER_COST_PROFILE if that is set.
+ClusterCostModel* GetClusterCostModel();
+void SetClusterCostModel(std::unique_ptr<ClusterCostModel> cost_model);
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
+
+#endif  // NGRAPH_TF_BRIDGE_CLUSTER_COST_MODEL_H_
@@ -15,29 +15,149 @@
  *******************************************************************************/
 #include "ngraph_bridge/ngraph_cluster_manager.h"
 
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/graph/graph_constructor.h"
+
+#include "logging/ngraph_log.h"
+
 using namespace std;
 
 namespace tensorflow {
 
 namespace ngraph_bridge {
 // Static initializers
-std::vector<GraphDef*> NGraphClusterManager::s_cluster_graphs;
-std::mutex NGraphClusterManager::s_cluster_graphs_mutex;
+std::map<size_t, std::shared_ptr<NGraphClusterManager::Cluster>>
+    NGraphClusterManager::s_clusters;
+size_t NGraphClusterManager::s_next_cluster_idx = 0;
+std::mutex NGraphClusterManager::s_clusters_mutex;
 
 size_t NGraphClusterManager::NewCluster() {
-  std::lock_guard<std::mutex> guard(s_cluster_graphs_mutex);
+  std::lock_guard<std::mutex> guard(s_clusters_mutex);
 
-  size_t new_idx = s_cluster_graphs.size();
-  s_cluster_graphs.push_back(new GraphDef());
+  size_t new_idx = s_next_cluster_idx++;
+  s_clusters[new_idx] = std::make_shared<Cluster>();
   return new_idx;
 }
 
 GraphDef* NGraphClusterManager::GetClusterGraph(size_t idx) {
-  std::lock_guard<std::mutex> guard(s_cluster_graphs_mutex);
-  return idx < s_cluster_graphs.size() ? s_cluster_graphs[idx] : nullptr;
+  std::shared_ptr<Cluster> cluster;
+  {
+    std::lock_guard<std::mutex> guard(s_clusters_mutex);
+    auto itr = s_clusters.find(idx);
+    if (itr == s_clusters.end()) {
+      return nullptr;
+    }
+    cluster = itr->second;
+  }
+  std::lock_guard<std::mutex> guard(cluster->graph_mutex);
+  return cluster->graph == nullptr ? &cluster->graph_def : nullptr;
+}
+
+Status NGraphClusterManager::GetClusterTFGraph(
+    size_t idx, std::shared_ptr<const Graph>* graph) {
+  // Keeps the cluster alive if it is dropped meanwhile
+  std::shared_ptr<Cluster> cluster;
+  {
+    std::lock_guard<std::mutex> guard(s_clusters_mutex);
+    auto itr = s_clusters.find(idx);
+    if (itr == s_clusters.end()) {
+      *graph = nullptr;
+      return Status::OK();
+    }
+    cluster = itr->second;
+  }
+
+  // Only this cluster is locked while converting, so the kernels of
+  // different clusters can be created in parallel
+  std::lock_guard<std::mutex> guard(cluster->graph_mutex);
+  if (cluster->graph == nullptr) {
+    NGRAPH_VLOG(5) << "Building graph for cluster " << idx;
+    std::shared_ptr<Graph> new_graph =
+        std::make_shared<Graph>(OpRegistry::Global());
+    GraphConstructorOptions opts;
+    opts.allow_internal_ops = true;
+    TF_RETURN_IF_ERROR(
+        ConvertGraphDefToGraph(opts, cluster->graph_def, new_graph.get()));
+    cluster->graph = new_graph;
+    // The Graph has its own copy of the nodes
+    GraphDef().Swap(&cluster->graph_def);
+  }
+  *graph = cluster->graph;
+  return Status::OK();
+}
+
+std::unique_ptr<NGraphClusterManager::ClusterHandle>
+NGraphClusterManager::HoldCluster(size_t idx) {
+  std::lock_guard<std::mutex> guard(s_clusters_mutex);
+  auto itr = s_clusters.find(idx);
+  if (itr == s_clusters.end()) {
+    return nullptr;
+  }
+  itr->second->num_holders++;
+  return std::unique_ptr<ClusterHandle>(new ClusterHandle(idx, itr->second));
 }
 
-void NGraphClusterManager::EvictAllClusters() { s_cluster_graphs.clear(); }
+NGraphClusterManager::ClusterHandle::~ClusterHandle() {
+  std::lock_guard<std::mutex> guard(s_clusters_mutex);
+  if (--m_cluster->num_holders > 0) {
+    return;
+  }
+  // The cluster may have been evicted meanwhile
+  auto itr = s_clusters.find(m_idx);
+  if (itr != s_clusters.end() && itr->second == m_cluster) {
+    NGRAPH_VLOG(5) << "Dropping cluster " << m_idx;
+    s_clusters.erase(itr);
+  }
+}
+
+size_t NGraphClusterManager::NumClusters() {
+  std::lock_guard<std::mutex> guard(s_clusters_mutex);
+  return s_clusters.size();
+}
+
+namespace {
+// The handles on the clusters of one graph, owned by a ResourceMgr
+class ClusterHolder : public ResourceBase {
+ public:
+  std::vector<std::unique_ptr<NGraphClusterManager::ClusterHandle>> handles;
+  string DebugString() const override {
+    return "nGraph clusters: " + to_string(handles.size());
+  }
+};
+}  // namespace
+
+Status NGraphClusterManager::HoldClusters(const Graph* graph,
+                                          ResourceMgr* resource_mgr) {
+  std::vector<std::unique_ptr<ClusterHandle>> handles;
+  string name;
+  for (auto node : graph->op_nodes()) {
+    if (node->type_string() != "NGraphEncapsulate") {
+      continue;
+    }
+    int cluster_idx;
+    TF_RETURN_IF_ERROR(
+        GetNodeAttr(node->attrs(), "ngraph_cluster", &cluster_idx));
+    auto handle = HoldCluster(cluster_idx);
+    if (handle != nullptr) {
+      handles.push_back(std::move(handle));
+      // Indices are never reused, so neither are the names
+      name += (name.empty() ? "" : "_") + to_string(cluster_idx);
+    }
+  }
+  if (handles.empty()) {
+    return Status::OK();
+  }
+  NGRAPH_VLOG(5) << "Holding clusters " << name << " until the session ends";
+  ClusterHolder* holder = new ClusterHolder();
+  holder->handles = std::move(handles);
+  // Takes ownership of holder, even on failure
+  return resource_mgr->Create("ngraph_clusters", name, holder);
+}
+
+void NGraphClusterManager::EvictAllClusters() {
+  std::lock_guard<std::mutex> guard(s_clusters_mutex);
+  s_clusters.clear();
+}
 
 }  // namespace ngraph_bridge
 
@@ -16,24 +16,79 @@
 #ifndef NGRAPH_LIBRARY_MANAGER_H_
 #define NGRAPH_LIBRARY_MANAGER_H_
 
+#include <map>
+#include <memory>
 #include <mutex>
-#include <vector>
 
 #include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/resource_mgr.h"
+#include "tensorflow/core/graph/graph.h"
 
 namespace tensorflow {
 
 namespace ngraph_bridge {
 
+// Owns the clusters created by the encapsulation pass. The pass fills the
+// GraphDef of a cluster, which is converted to a tensorflow::Graph the first
+// time the Graph is asked for; the GraphDef is freed then, and the Graph is
+// shared read-only by all the kernels of the cluster.
+//
+// A cluster is held with ClusterHandles: by its kernels, and by the session
+// whose graph it was created for (see HoldClusters). It is dropped from the
+// store when the last of them goes away, whether or not a kernel was ever
+// created for it. Cluster indices are never reused.
 class NGraphClusterManager {
+ private:
+  struct Cluster;
+
  public:
+  // Keeps a cluster in the store while it exists
+  class ClusterHandle {
+   public:
+    ~ClusterHandle();
+
+   private:
+    friend class NGraphClusterManager;
+    ClusterHandle(size_t idx, std::shared_ptr<Cluster> cluster)
+        : m_idx(idx), m_cluster(cluster) {}
+    ClusterHandle(const ClusterHandle&) = delete;
+    ClusterHandle& operator=(const ClusterHandle&) = delete;
+
+    size_t m_idx;
+    std::shared_ptr<Cluster> m_cluster;
+  };
+
   static size_t NewCluster();
+  // Returns nullptr if there is no such cluster, or if it has already been
+  // converted to a Graph. The GraphDef stays valid until then.
   static tensorflow::GraphDef* GetClusterGraph(size_t idx);
+  // Sets *graph to the cluster converted to a Graph, or to nullptr if there
+  // is no such cluster
+  static Status GetClusterTFGraph(size_t idx,
+                                  std::shared_ptr<const Graph>* graph);
+  // Returns nullptr if there is no such cluster
+  static std::unique_ptr<ClusterHandle> HoldCluster(size_t idx);
+  // Holds the clusters encapsulated in graph in resource_mgr, so that they
+  // are dropped when it is, with the devices of the session running graph.
+  // Clusters no handle is ever taken on stay until evicted.
+  static Status HoldClusters(const Graph* graph, ResourceMgr* resource_mgr);
+  // Number of clusters in the store
+  static size_t NumClusters();
   static void EvictAllClusters();
 
  private:
-  static std::vector<tensorflow::GraphDef*> s_cluster_graphs;
-  static std::mutex s_cluster_graphs_mutex;
+  struct Cluster {
+    // Cleared once graph is built
+    tensorflow::GraphDef graph_def;
+    // Built on first use by GetClusterTFGraph
+    std::shared_ptr<const Graph> graph;
+    std::mutex graph_mutex;
+    // Number of ClusterHandles on the cluster, guarded by s_clusters_mutex
+    int num_holders = 0;
+  };
+  static std::map<size_t, std::shared_ptr<Cluster>> s_clusters;
+  static size_t s_next_cluster_idx;
+  static std::mutex s_clusters_mutex;
 };
 
 }  // namespace ngraph_bridge
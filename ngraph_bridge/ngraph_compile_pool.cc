@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <cstdlib>
+
+#include "tensorflow/core/lib/core/blocking_counter.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
+
+#include "logging/ngraph_log.h"
+#include "ngraph_bridge/ngraph_compile_pool.h"
+
+using namespace std;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Number of compile threads requested with NGRAPH_TF_PARALLEL_COMPILE,
+// 0 if parallel compilation is disabled
+static int GetNumCompileThreads() {
+  const char* env = std::getenv("NGRAPH_TF_PARALLEL_COMPILE");
+  if (env == nullptr) {
+    return 0;
+  }
+  char* end;
+  long num_threads = std::strtol(env, &end, 10);
+  if (end == env || *end != '\0') {
+    return port::NumSchedulableCPUs();
+  }
+  return num_threads > 0 ? static_cast<int>(num_threads) : 0;
+}
+
+thread::ThreadPool* GetCompileThreadPool() {
+  // Never destroyed: compiles may still be queued when the process exits
+  static thread::ThreadPool* pool = []() -> thread::ThreadPool* {
+    int num_threads = GetNumCompileThreads();
+    if (num_threads == 0) {
+      return nullptr;
+    }
+    NGRAPH_VLOG(1) << "Compiling encapsulates using " << num_threads
+                   << " threads";
+    return new thread::ThreadPool(Env::Default(), "ngraph_compile",
+                                  num_threads);
+  }();
+  return pool;
+}
+
+Status RunCompileTasks(const std::vector<std::function<Status()>>& tasks) {
+  thread::ThreadPool* pool = GetCompileThreadPool();
+  if (pool == nullptr || tasks.size() < 2) {
+    for (const auto& task : tasks) {
+      TF_RETURN_IF_ERROR(task());
+    }
+    return Status::OK();
+  }
+
+  std::vector<Status> task_status(tasks.size());
+  BlockingCounter counter(tasks.size());
+  for (size_t i = 0; i < tasks.size(); i++) {
+    pool->Schedule([&tasks, &task_status, &counter, i]() {
+      task_status[i] = tasks[i]();
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+
+  for (const auto& status : task_status) {
+    TF_RETURN_IF_ERROR(status);
+  }
+  return Status::OK();
+}
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef NGRAPH_TF_BRIDGE_COMPILE_POOL_H_
+#define NGRAPH_TF_BRIDGE_COMPILE_POOL_H_
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/threadpool.h"
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Process wide thread pool on which the encapsulates are translated and
+// compiled ahead of their first run. Parallel compilation is opt-in: it is
+// enabled by setting NGRAPH_TF_PARALLEL_COMPILE to the number of threads
+// to use (or to any non-numeric value, for one thread per core). Returns
+// nullptr when it is disabled, in which case everything compiles serially
+// as before.
+//
+// Only the translation (and serialization) of the clusters runs
+// concurrently: the compilation itself is still done under
+// BackendManager::LockBackend, since the nGraph backends do not promise
+// that compile is thread safe.
+thread::ThreadPool* GetCompileThreadPool();
+
+// Runs the tasks on the compile thread pool, or serially if there is none,
+// and waits for all of them. Returns the first error.
+Status RunCompileTasks(const std::vector<std::function<Status()>>& tasks);
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
+
+#endif  // NGRAPH_TF_BRIDGE_COMPILE_POOL_H_
@@ -0,0 +1,223 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <set>
+#include <unordered_map>
+
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/status.h"
+
+#include "ngraph/graph_util.hpp"
+#include "ngraph/runtime/backend.hpp"
+
+#include "logging/ngraph_log.h"
+#include "ngraph_bridge/ngraph_backend_manager.h"
+#include "ngraph_bridge/ngraph_builder.h"
+#include "ngraph_bridge/ngraph_constant_folding.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Results up to this size are always folded. Larger ones only if they are
+// no larger than the constants they are computed from.
+static const size_t MAX_EXPANDED_CONSTANT_BYTES = 64 * 1024;
+
+// Total size of the results folded in one function. Folding is redone for
+// every signature, and each folded result is held by the backend as well, so
+// the transposes and casts of large weights are left to run time.
+static const size_t MAX_FOLDED_BYTES = 4 * 1024 * 1024;
+
+static const char* const FOLDING_BACKEND = "INTERPRETER";
+
+static size_t OutputBytes(const shared_ptr<ng::Node>& node) {
+  return ng::shape_size(node->get_shape()) *
+         node->get_element_type().size();
+}
+
+// Whether the op could be evaluated once if its arguments are constants
+static bool IsFoldable(const shared_ptr<ng::Node>& node) {
+  // Random ops are not folded, and neither are ops communicating with other
+  // processes
+  static const set<string> unfoldable{
+      "AllReduce", "BroadcastDistributed", "GenerateMask", "Parameter",
+      "RandomUniform", "Result"};
+  return node->get_output_size() == 1 && node->get_input_size() > 0 &&
+         node->get_control_dependencies().empty() &&
+         node->get_output_partial_shape(0).is_static() &&
+         node->get_output_element_type(0).is_static() &&
+         unfoldable.count(node->description()) == 0;
+}
+
+// The folding backend is created on first use and kept for the lifetime of
+// the process, rather than created and torn down on every fold
+static Status AcquireFoldingBackend() {
+  static Status status = BackendManager::CreateBackend(FOLDING_BACKEND);
+  return status;
+}
+
+// Evaluates the nodes in roots, which only depend on the nodes of cone (in
+// topological order), and returns their values
+static Status Evaluate(const ng::NodeVector& cone, const ng::NodeVector& roots,
+                       vector<vector<char>>* values) {
+  // The ops are cloned, so that the function being folded does not get the
+  // Results of the evaluated one as users. The Constants are not: the clones
+  // use them as they are, instead of copying every weight in the cone.
+  ng::NodeMap node_map;
+  for (auto node : cone) {
+    if (node->is_constant()) {
+      node_map.add(node, node);
+    }
+  }
+  ng::clone_nodes(cone, node_map);
+  ng::NodeVector outputs;
+  for (auto root : roots) {
+    outputs.push_back(node_map.get(root));
+  }
+  auto ng_function =
+      make_shared<ng::Function>(outputs, ng::ParameterVector{}, "fold");
+
+  TF_RETURN_IF_ERROR(AcquireFoldingBackend());
+  ng::runtime::Backend* backend = BackendManager::GetBackend(FOLDING_BACKEND);
+  Status status = Status::OK();
+  BackendManager::LockBackend(FOLDING_BACKEND);
+  try {
+    auto exec = backend->compile(ng_function);
+    // The results are written straight into values
+    values->resize(roots.size());
+    vector<shared_ptr<ng::runtime::Tensor>> ng_outputs;
+    for (size_t i = 0; i < roots.size(); i++) {
+      (*values)[i].resize(OutputBytes(roots[i]));
+      ng_outputs.push_back(backend->create_tensor(
+          roots[i]->get_element_type(), roots[i]->get_shape(),
+          (*values)[i].data()));
+    }
+    exec->call(ng_outputs, {});
+    backend->remove_compiled_function(exec);
+  } catch (const std::exception& e) {
+    status = errors::Internal("Failed to evaluate constants: ", e.what());
+  }
+  BackendManager::UnlockBackend(FOLDING_BACKEND);
+  return status;
+}
+
+int FoldConstants(const shared_ptr<ng::Function>& ng_function) {
+  auto ordered = ng_function->get_ordered_ops();
+
+  // Whether each node only depends on constants, and the total size of
+  // those constants
+  unordered_map<ng::Node*, bool> is_constant;
+  unordered_map<ng::Node*, size_t> constant_bytes;
+  for (auto node : ordered) {
+    if (node->is_constant()) {
+      is_constant[node.get()] = true;
+      constant_bytes[node.get()] = OutputBytes(node);
+      continue;
+    }
+    bool constant = IsFoldable(node);
+    size_t bytes = 0;
+    for (auto arg : node->get_arguments()) {
+      constant = constant && is_constant[arg.get()];
+      bytes += constant_bytes[arg.get()];
+    }
+    is_constant[node.get()] = constant;
+    constant_bytes[node.get()] = bytes;
+  }
+
+  // The constant ops whose value is used by ops computed at run time are
+  // folded, from the last one up, unless their value is too large or the
+  // budget of the function is spent: then they are computed at run time as
+  // well
+  unordered_map<ng::Node*, bool> at_run_time;
+  ng::NodeVector roots;
+  size_t folded_bytes = 0;
+  for (auto itr = ordered.rbegin(); itr != ordered.rend(); ++itr) {
+    auto node = *itr;
+    if (!is_constant[node.get()]) {
+      at_run_time[node.get()] = true;
+      continue;
+    }
+    if (node->is_constant()) {
+      continue;
+    }
+    bool used_at_run_time = false;
+    for (auto user : node->get_users()) {
+      used_at_run_time |= at_run_time[user.get()];
+    }
+    if (!used_at_run_time) {
+      continue;
+    }
+    size_t bytes = OutputBytes(node);
+    if ((bytes <= MAX_EXPANDED_CONSTANT_BYTES ||
+         bytes <= constant_bytes[node.get()]) &&
+        folded_bytes + bytes <= MAX_FOLDED_BYTES) {
+      roots.push_back(node);
+      folded_bytes += bytes;
+    } else {
+      at_run_time[node.get()] = true;
+    }
+  }
+  if (roots.empty()) {
+    return 0;
+  }
+
+  // The ops the roots are computed from
+  set<ng::Node*> in_cone;
+  for (auto root : roots) {
+    in_cone.insert(root.get());
+  }
+  for (auto itr = ordered.rbegin(); itr != ordered.rend(); ++itr) {
+    if (in_cone.count(itr->get()) != 0) {
+      for (auto arg : (*itr)->get_arguments()) {
+        in_cone.insert(arg.get());
+      }
+    }
+  }
+  ng::NodeVector cone;
+  int num_folded = 0;
+  for (auto node : ordered) {
+    if (in_cone.count(node.get()) != 0) {
+      cone.push_back(node);
+      num_folded += node->is_constant() ? 0 : 1;
+    }
+  }
+
+  vector<vector<char>> values;
+  Status status = Evaluate(cone, roots, &values);
+  if (!status.ok()) {
+    NGRAPH_VLOG(1) << "Not folding constants of "
+                   << ng_function->get_friendly_name() << ": "
+                   << status.error_message();
+    return 0;
+  }
+  for (size_t i = 0; i < roots.size(); i++) {
+    auto constant = make_shared<ng::op::Constant>(
+        roots[i]->get_element_type(), roots[i]->get_shape(),
+        values[i].data());
+    Builder::SetTracingInfo(roots[i]->get_friendly_name(), constant);
+    ng::replace_node(roots[i], constant);
+  }
+  NGRAPH_VLOG(3) << "Folded " << num_folded << " ops into " << roots.size()
+                 << " constants in " << ng_function->get_friendly_name();
+  return num_folded;
+}
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
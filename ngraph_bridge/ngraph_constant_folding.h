@@ -0,0 +1,48 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef NGRAPH_TF_BRIDGE_CONSTANT_FOLDING_H_
+#define NGRAPH_TF_BRIDGE_CONSTANT_FOLDING_H_
+#pragma once
+
+#include <memory>
+
+#include "ngraph/ngraph.hpp"
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Replaces the ops of the function that only depend on constants (shape
+// arithmetic, the broadcasts of Fill, casts and transposes of weights, ...)
+// with the Constants they compute, so that the backend does not compute them
+// on every call. They are evaluated all at once on the INTERPRETER backend,
+// which has a reference implementation of every op. If it is not available,
+// nothing is folded.
+//
+// Results that would be much larger than the constants they are computed
+// from (a broadcast of a scalar, say) are not folded, to keep the executable
+// small, and neither are results past a few MB in total, so that large
+// weights are not copied again for every signature.
+//
+// Returns the number of ops folded.
+int FoldConstants(const std::shared_ptr<ngraph::Function>& ng_function);
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
+
+#endif  // NGRAPH_TF_BRIDGE_CONSTANT_FOLDING_H_
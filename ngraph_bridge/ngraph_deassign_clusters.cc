@@ -30,8 +30,10 @@
 #include "logging/ngraph_log.h"
 #include "ngraph_bridge/ngraph_api.h"
 #include "ngraph_bridge/ngraph_assign_clusters.h"
+#include "ngraph_bridge/ngraph_cluster_cost_model.h"
 #include "ngraph_bridge/ngraph_deassign_clusters.h"
 #include "ngraph_bridge/ngraph_mark_for_clustering.h"
+#include "ngraph_bridge/ngraph_propagate_shapes.h"
 #include "ngraph_bridge/ngraph_utils.h"
 
 using namespace std;
@@ -48,6 +50,12 @@ namespace ngraph_bridge {
 // two non-trivial ops in the graph, where a "trivial op" means "Const" or
 // "Identity".
 //
+// When NGRAPH_TF_CLUSTER_COST_MODEL is set, the clusters that pass this check
+// are also run through the cluster cost model (ngraph_cluster_cost_model.h),
+// which deassigns clusters whose estimated encapsulate overhead (fixed per
+// call cost and host transfers) outweighs the benefit of running them on
+// nGraph.
+//
 // For unit testing purposes, this pass can be bypassed by setting
 // NGRAPH_TF_DISABLE_DEASSIGN_CLUSTERS=1.
 //
@@ -179,6 +187,16 @@ Status DeassignClusters(Graph* graph) {
     cluster_map[cluster_idx].insert(node);
   }
 
+  ClusterCostModel* cost_model = nullptr;
+  // For the shapes the cost model needs that "_output_shapes" does not give
+  GraphShapes graph_shapes;
+  if (std::getenv("NGRAPH_TF_CLUSTER_COST_MODEL") != nullptr) {
+    cost_model = GetClusterCostModel();
+    if (IsShapePropagationEnabled()) {
+      InferGraphShapes(*graph, &graph_shapes);
+    }
+  }
+
   for (auto& kv : cluster_map) {
     int cluster_idx = kv.first;
     std::set<Node*>& nodes = kv.second;
@@ -192,7 +210,18 @@ Status DeassignClusters(Graph* graph) {
       }
     }
 
-    if (non_trivial_count < MIN_NONTRIVIAL_NODES) {
+    bool deassign = non_trivial_count < MIN_NONTRIVIAL_NODES;
+    if (!deassign && cost_model != nullptr) {
+      TF_RETURN_IF_ERROR(
+          cost_model->ShouldDeassign(nodes, &graph_shapes, &deassign));
+      if (deassign) {
+        NGRAPH_VLOG(2) << "Cluster " << cluster_idx
+                       << " is not worth running on nGraph according to the "
+                          "cost model";
+      }
+    }
+
+    if (deassign) {
       NGRAPH_VLOG(2) << "Busting cluster " << cluster_idx;
       for (auto node : nodes) {
         NGRAPH_VLOG(2) << "Busting node: " << node->name() << " ["
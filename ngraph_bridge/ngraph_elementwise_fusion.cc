@@ -0,0 +1,202 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <cstdlib>
+#include <set>
+#include <unordered_map>
+
+#include "ngraph/op/experimental/compiled_kernel.hpp"
+#include "ngraph/op/util/binary_elementwise_arithmetic.hpp"
+#include "ngraph/op/util/binary_elementwise_comparison.hpp"
+#include "ngraph/op/util/binary_elementwise_logical.hpp"
+#include "ngraph/op/util/unary_elementwise_arithmetic.hpp"
+
+#include "logging/ngraph_log.h"
+#include "ngraph_bridge/ngraph_builder.h"
+#include "ngraph_bridge/ngraph_elementwise_fusion.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+bool IsElementwiseFusionEnabled(const ng::runtime::Backend* backend) {
+  if (std::getenv("NGRAPH_TF_FUSE_ELEMENTWISE") == nullptr) {
+    return false;
+  }
+  auto param = make_shared<ng::op::Parameter>(ng::element::f32, ng::Shape{1});
+  auto relu = make_shared<ng::op::Relu>(param);
+  auto kernel = make_shared<ng::op::CompiledKernel>(
+      ng::NodeVector{relu}, ng::NodeVector{relu}, ng::NodeVector{param});
+  return backend->is_supported(*kernel);
+}
+
+static bool IsFusible(const shared_ptr<ng::Node>& node) {
+  if (node->get_output_size() != 1 ||
+      !node->get_control_dependencies().empty()) {
+    return false;
+  }
+  // CompiledKernel only takes single output arguments
+  for (auto arg : node->get_arguments()) {
+    if (arg->get_output_size() != 1) {
+      return false;
+    }
+  }
+  return dynamic_pointer_cast<ng::op::util::UnaryElementwiseArithmetic>(
+             node) != nullptr ||
+         dynamic_pointer_cast<ng::op::util::BinaryElementwiseArithmetic>(
+             node) != nullptr ||
+         dynamic_pointer_cast<ng::op::util::BinaryElementwiseComparison>(
+             node) != nullptr ||
+         dynamic_pointer_cast<ng::op::util::BinaryElementwiseLogical>(node) !=
+             nullptr ||
+         dynamic_pointer_cast<ng::op::Broadcast>(node) != nullptr;
+}
+
+// Replaces the nodes of group (in topological order) with a CompiledKernel
+static void MakeKernel(const ng::NodeVector& group) {
+  set<ng::Node*> in_group;
+  for (auto node : group) {
+    in_group.insert(node.get());
+  }
+
+  ng::NodeVector args;
+  set<ng::Node*> seen_args;
+  ng::NodeVector outputs;
+  for (auto node : group) {
+    for (auto arg : node->get_arguments()) {
+      if (in_group.count(arg.get()) == 0 &&
+          seen_args.insert(arg.get()).second) {
+        args.push_back(arg);
+      }
+    }
+    for (auto user : node->get_users()) {
+      if (in_group.count(user.get()) == 0) {
+        outputs.push_back(node);
+        break;
+      }
+    }
+  }
+
+  auto kernel = make_shared<ng::op::CompiledKernel>(group, outputs, args);
+  Builder::SetTracingInfo(outputs.back()->get_friendly_name(), kernel);
+  for (size_t i = 0; i < outputs.size(); i++) {
+    for (auto input : outputs[i]->output(0).get_target_inputs()) {
+      if (in_group.count(input.get_node()) == 0) {
+        input.replace_source_output(kernel->output(i));
+      }
+    }
+  }
+}
+
+// Whether any of groups, or any group they depend on through their members,
+// is group
+static bool DependsOn(const vector<set<int>>& group_upstream,
+                      const set<int>& groups, int group) {
+  set<int> visited;
+  vector<int> stack(groups.begin(), groups.end());
+  while (!stack.empty()) {
+    int current = stack.back();
+    stack.pop_back();
+    if (current == group) {
+      return true;
+    }
+    if (visited.insert(current).second) {
+      stack.insert(stack.end(), group_upstream[current].begin(),
+                   group_upstream[current].end());
+    }
+  }
+  return false;
+}
+
+int FuseElementwise(const shared_ptr<ng::Function>& ng_function) {
+  // Group of each fused node, and the groups each node depends on (its own
+  // included). A kernel needs all the arguments of its group, so a group
+  // depends on the groups any of its members depends on.
+  unordered_map<ng::Node*, int> group_of;
+  unordered_map<ng::Node*, set<int>> upstream_groups;
+  vector<ng::NodeVector> groups;
+  vector<set<int>> group_upstream;
+
+  for (auto node : ng_function->get_ordered_ops()) {
+    set<int>& upstream = upstream_groups[node.get()];
+    for (auto arg : node->get_arguments()) {
+      const set<int>& arg_upstream = upstream_groups[arg.get()];
+      upstream.insert(arg_upstream.begin(), arg_upstream.end());
+    }
+    if (!IsFusible(node)) {
+      continue;
+    }
+
+    // Join the group of an argument, unless one of the other arguments is
+    // computed from that group outside of it, directly or through another
+    // group
+    int group = -1;
+    for (auto arg : node->get_arguments()) {
+      auto itr = group_of.find(arg.get());
+      if (itr == group_of.end()) {
+        continue;
+      }
+      bool convex = true;
+      for (auto other : node->get_arguments()) {
+        auto other_itr = group_of.find(other.get());
+        bool other_in_group =
+            other_itr != group_of.end() && other_itr->second == itr->second;
+        if (!other_in_group &&
+            DependsOn(group_upstream, upstream_groups[other.get()],
+                      itr->second)) {
+          convex = false;
+          break;
+        }
+      }
+      if (convex) {
+        group = itr->second;
+        break;
+      }
+    }
+    if (group == -1) {
+      group = groups.size();
+      groups.emplace_back();
+      group_upstream.emplace_back();
+    }
+    groups[group].push_back(node);
+    group_of[node.get()] = group;
+    for (int upstream_group : upstream) {
+      if (upstream_group != group) {
+        group_upstream[group].insert(upstream_group);
+      }
+    }
+    upstream.insert(group);
+  }
+
+  int num_kernels = 0;
+  for (const auto& group : groups) {
+    if (group.size() < 2) {
+      continue;
+    }
+    MakeKernel(group);
+    num_kernels++;
+  }
+  NGRAPH_VLOG(3) << "Fused " << num_kernels << " elementwise kernels in "
+                 << ng_function->get_friendly_name();
+  return num_kernels;
+}
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
@@ -0,0 +1,49 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef NGRAPH_TF_BRIDGE_ELEMENTWISE_FUSION_H_
+#define NGRAPH_TF_BRIDGE_ELEMENTWISE_FUSION_H_
+#pragma once
+
+#include <memory>
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/backend.hpp"
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Whether the translated functions compiled on backend go through
+// FuseElementwise. Fusion is opt-in: it is enabled by setting
+// NGRAPH_TF_FUSE_ELEMENTWISE, and only for backends that report
+// CompiledKernel as supported.
+bool IsElementwiseFusionEnabled(const ngraph::runtime::Backend* backend);
+
+// Replaces each maximal group of connected elementwise ops (and the
+// broadcasts feeding them) with a single CompiledKernel, which the backend
+// can generate as one loop over the output, instead of materializing every
+// intermediate tensor. Only groups that can be computed without leaving
+// them are formed, so the function stays acyclic.
+//
+// Returns the number of kernels created.
+int FuseElementwise(const std::shared_ptr<ngraph::Function>& ng_function);
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
+
+#endif  // NGRAPH_TF_BRIDGE_ELEMENTWISE_FUSION_H_
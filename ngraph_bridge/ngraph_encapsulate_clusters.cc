@@ -29,7 +29,6 @@
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/graph/graph_constructor.h"
 #include "tensorflow/core/graph/node_builder.h"
-#include "tensorflow/core/graph/tensor_id.h"
 #include "tensorflow/core/graph/validate.h"
 #include "tensorflow/core/platform/default/logging.h"
 #include "tensorflow/core/platform/protobuf.h"
@@ -41,9 +40,11 @@
 #include "ngraph_bridge/ngraph_assign_clusters.h"
 #include "ngraph_bridge/ngraph_builder.h"
 #include "ngraph_bridge/ngraph_cluster_manager.h"
+#include "ngraph_bridge/ngraph_compile_pool.h"
 #include "ngraph_bridge/ngraph_encapsulate_clusters.h"
 #include "ngraph_bridge/ngraph_mark_for_clustering.h"
 #include "ngraph_bridge/ngraph_partial_shapes.h"
+#include "ngraph_bridge/ngraph_propagate_shapes.h"
 #include "ngraph_bridge/ngraph_utils.h"
 #include "ngraph_bridge/version.h"
 
@@ -82,6 +83,10 @@ Status EncapsulateClusters(
   TF_RETURN_IF_ERROR(enc.AnalysisPass());
   NGRAPH_VLOG(3) << "Running RewritePass in EncapsulateClusters";
   TF_RETURN_IF_ERROR(enc.RewritePass(fdeflib, graph_id, device_config));
+  if (IsShapePropagationEnabled()) {
+    NGRAPH_VLOG(3) << "Propagating static shapes in EncapsulateClusters";
+    TF_RETURN_IF_ERROR(PropagateStaticShapes(graph));
+  }
   NGRAPH_VLOG(3) << "Performing AOT in EncapsulateClusters";
   TF_RETURN_IF_ERROR(PerformAOTOnEncapsulates(graph, aot_info));
 
@@ -93,22 +98,24 @@ Status EncapsulateClusters(
   // make sure we can construct a graph from it.
   if (std::getenv("NGRAPH_TF_DUMP_CLUSTERS")) {
     for (auto& cluster_idx : newly_created_cluster_ids) {
-      TF_RETURN_IF_ERROR(graph::ValidateGraphDef(
-          *NGraphClusterManager::GetClusterGraph(cluster_idx),
-          *OpRegistry::Global()));
-
-      Graph g(OpRegistry::Global());
-      GraphConstructorOptions opts;
-      opts.allow_internal_ops = true;
-      TF_RETURN_IF_ERROR(ConvertGraphDefToGraph(
-          opts, *NGraphClusterManager::GetClusterGraph(cluster_idx), &g));
+      std::shared_ptr<const Graph> g;
+      TF_RETURN_IF_ERROR(
+          NGraphClusterManager::GetClusterTFGraph(cluster_idx, &g));
+      if (g == nullptr) {
+        return errors::Internal("Did not find cluster ", cluster_idx,
+                                " in cluster manager");
+      }
+      GraphDef gdef;
+      g->ToGraphDef(&gdef);
+      TF_RETURN_IF_ERROR(
+          graph::ValidateGraphDef(gdef, *OpRegistry::Global()));
 
       std::stringstream ss;
       ss << "ngraph_cluster_" << cluster_idx;
       std::string filename_prefix = ss.str();
 
-      GraphToPbTextFile(&g, filename_prefix + ".pbtxt");
-      GraphToDotFile(&g, filename_prefix + ".dot",
+      GraphToPbTextFile(g.get(), filename_prefix + ".pbtxt");
+      GraphToDotFile(g.get(), filename_prefix + ".dot",
                      "nGraph Cluster Dump: " + filename_prefix);
     }
   }
@@ -116,6 +123,65 @@ Status EncapsulateClusters(
   return Status::OK();
 }
 
+// An encapsulate to AOT, with the results of its translation and compilation
+struct AOTItem {
+  Node* node;
+  string op_backend_name;
+  // Passed to SetConfig before compiling
+  std::unordered_map<std::string, std::string> backend_config;
+  string signature;
+  string serialized_ngfunc;
+  string serialized_exec;
+};
+
+// Translates and compiles one encapsulate for AOT. Runs concurrently with
+// the other encapsulates when parallel compilation is enabled, so it only
+// touches its own item; the node attributes are added by the caller.
+static Status TranslateAndCompileForAOT(
+    const std::map<std::string, vector<int>>& inputs_node_shapes,
+    AOTItem* item) {
+  std::shared_ptr<ngraph::Function> ng_function;
+  TF_RETURN_IF_ERROR(PerformTranslation(item->node, inputs_node_shapes,
+                                        item->signature, ng_function));
+  int json_indentation = 4;
+  item->serialized_ngfunc = ngraph::serialize(ng_function, json_indentation);
+
+  // Translation done, now compile
+  ng::runtime::Backend* op_backend = nullptr;
+  try {
+    op_backend = BackendManager::GetBackend(item->op_backend_name);
+  } catch (const std::out_of_range& e) {
+    NGRAPH_VLOG(5) << "Exception: " << e.what();
+    return errors::Internal("Backend not available: ",
+                            item->op_backend_name);
+  }
+  // Encapsulates sharing a backend may have different configs, so the config
+  // is set under the same lock as the compile it applies to
+  BackendManager::LockBackend(item->op_backend_name);
+  BackendManager::SetConfig(item->op_backend_name, item->backend_config);
+  std::shared_ptr<ngraph::runtime::Executable> ng_exec;
+  try {
+    ng_exec = op_backend->compile(ng_function);
+  } catch (...) {
+    BackendManager::UnlockBackend(item->op_backend_name);
+    Status st = NgraphSerialize(
+        "tf_function_error_aot_" + item->node->name() + ".json", ng_function);
+    string message = "Failed to compile ng_function for AOT.";
+    if (!st.ok()) {
+      message += " Failed to serialize as well with error: " +
+                 st.error_message();
+    }
+    return errors::Internal(message);
+  }
+  BackendManager::UnlockBackend(item->op_backend_name);
+
+  // Compilation done, now serialize
+  stringstream exec_dump;
+  ng_exec->save(exec_dump);
+  item->serialized_exec = exec_dump.str();
+  return Status::OK();
+}
+
 Status PerformAOTOnEncapsulates(Graph* graph, const AOTInfo& aot_info) {
   bool aot_requested;
   set<string> performed_aot_on_enc;
@@ -216,7 +282,10 @@ Status PerformAOTOnEncapsulates(Graph* graph, const AOTInfo& aot_info) {
       }
 
       // At this point we have collected all the AOT information and now we are
-      // ready to translate and compile
+      // ready to translate and compile. The backends are created serially,
+      // the encapsulates are then translated and compiled as compile tasks,
+      // concurrently if NGRAPH_TF_PARALLEL_COMPILE is set
+      std::vector<AOTItem> aot_items;
       for (auto node : graph->op_nodes()) {
         if (node->type_string() == "NGraphEncapsulate") {
           // Check inputs of the encapsulates. They can only be fed by fully
@@ -252,7 +321,9 @@ Status PerformAOTOnEncapsulates(Graph* graph, const AOTInfo& aot_info) {
               op_backend_name));  // Created a backend here. must free it
           // TranslateGraph must be called AFTER CreateBackend because some TF
           // ops like CNMS and gather use backend specific nodes
-          std::unordered_map<std::string, std::string> additional_attribute_map;
+          AOTItem item;
+          item.node = node;
+          item.op_backend_name = op_backend_name;
           for (auto itr : node->attrs()) {
             // Find the optional attributes to be sent to the backend.
             // The optional attributes have '_ngraph_' appended to the start
@@ -265,67 +336,43 @@ Status PerformAOTOnEncapsulates(Graph* graph, const AOTInfo& aot_info) {
               // leave out _ngraph_aot_requested
               if (itr.first.find("_ngraph_aot_requested") ==
                   std::string::npos) {
-                additional_attribute_map.insert(
+                item.backend_config.insert(
                     {itr.first.substr(strlen("_ngraph_")), itr.second.s()});
               }
             }
           }
-          BackendManager::SetConfig(op_backend_name, additional_attribute_map);
-
-          // Backend has been created and setup. Now translate
-          string signature;
-          std::shared_ptr<ngraph::Function> ng_function;
-          TF_RETURN_IF_ERROR(
-              PerformTranslation(node, inputs_node_shapes_for_compilation,
-                                 signature, ng_function));
-          int json_indentation = 4;
-          string serialized_ngfunc(
-              ngraph::serialize(ng_function, json_indentation));
-
-          // Translation done, now compile
-          ng::runtime::Backend* op_backend = nullptr;
-          try {
-            op_backend = BackendManager::GetBackend(op_backend_name);
-          } catch (const std::out_of_range& e) {
-            NGRAPH_VLOG(5) << "Exception: " << e.what();
-            BackendManager::ReleaseBackend(op_backend_name);
-            throw;
-          }
-          BackendManager::LockBackend(op_backend_name);
-          std::shared_ptr<ngraph::runtime::Executable> ng_exec;
-          try {
-            ng_exec = op_backend->compile(ng_function);
-          } catch (...) {
-            BackendManager::UnlockBackend(op_backend_name);
-            Status st =
-                NgraphSerialize("tf_function_error_aot.json", ng_function);
-            BackendManager::ReleaseBackend(op_backend_name);
-            return errors::Internal(
-                "Failed to compile ng_function for AOT.",
-                (st.ok() ? ""
-                         : " Failed to serialize as well with error: " +
-                               st.error_message()));
-          }
-          BackendManager::UnlockBackend(op_backend_name);
-          BackendManager::ReleaseBackend(op_backend_name);
-
-          // Compilation done, now serialize and attach as attribute
-          stringstream exec_dump;
-          ng_exec->save(exec_dump);
-          // ng function attached as debugging information
-          node->AddAttr("_ngraph_aot_ngfunction_" + signature,
-                        serialized_ngfunc);
-          // Compute will use this ngexec
-          node->AddAttr("_ngraph_aot_ngexec_" + signature, exec_dump.str());
-          // We do not need to add "_ngraph_aot_requested" attribute since it
-          // already is already present in device_config and inserted into the
-          // currently created NGraphEncapsulate
-          // TODO: create a separate namespace of node attributes for backend
-          // and for bridge
-          performed_aot_on_enc.insert(node->name());
-          NGRAPH_VLOG(5) << "Performed AOT on " << node->name();
+          aot_items.push_back(item);
         }
       }
+
+      std::vector<std::function<Status()>> aot_tasks;
+      for (auto& item : aot_items) {
+        aot_tasks.push_back([&item, &inputs_node_shapes_for_compilation]() {
+          return TranslateAndCompileForAOT(
+              inputs_node_shapes_for_compilation, &item);
+        });
+      }
+      Status aot_status = RunCompileTasks(aot_tasks);
+      for (const auto& item : aot_items) {
+        BackendManager::ReleaseBackend(item.op_backend_name);
+      }
+      TF_RETURN_IF_ERROR(aot_status);
+
+      for (const auto& item : aot_items) {
+        // ng function attached as debugging information
+        item.node->AddAttr("_ngraph_aot_ngfunction_" + item.signature,
+                           item.serialized_ngfunc);
+        // Compute will use this ngexec
+        item.node->AddAttr("_ngraph_aot_ngexec_" + item.signature,
+                           item.serialized_exec);
+        // We do not need to add "_ngraph_aot_requested" attribute since it
+        // already is already present in device_config and inserted into the
+        // currently created NGraphEncapsulate
+        // TODO: create a separate namespace of node attributes for backend
+        // and for bridge
+        performed_aot_on_enc.insert(item.node->name());
+        NGRAPH_VLOG(5) << "Performed AOT on " << item.node->name();
+      }
     }  // end of for (ShapeHintMap single_hint : node_shapes_hints_sets)
 
     // In the end assert that all encapsulates have performed AOT
@@ -356,8 +403,12 @@ Status Encapsulator::AnalysisPass() {
     return errors::Internal(
         "In Encapsulator, AnalysisPass called more than once");
   }
-  // Pass 1: Populate the cluster-index-to-device name map for each existing
-  // cluster. PIGGYBACKING BACKEND TEST HERE, THEY WILL GET COMBINED INTO ONE
+  // Pass 1: Find the cluster of every node and populate the device and
+  // backend of each cluster. PIGGYBACKING BACKEND TEST HERE, THEY WILL GET
+  // COMBINED INTO ONE
+  // The cluster of each node is looked up once here and kept in node_slot,
+  // the later passes only index into it.
+  node_slot.assign(graph->num_node_ids(), -1);
   for (auto node : graph->op_nodes()) {
     int cluster_idx;
 
@@ -365,68 +416,79 @@ Status Encapsulator::AnalysisPass() {
       continue;
     }
 
+    auto slot_it = cluster_slot_map.find(cluster_idx);
+    bool new_cluster = (slot_it == cluster_slot_map.end());
+    if (new_cluster) {
+      slot_it =
+          cluster_slot_map.insert({cluster_idx, int(clusters.size())}).first;
+      clusters.emplace_back();
+      clusters.back().cluster_idx = cluster_idx;
+    }
+    node_slot[node->id()] = slot_it->second;
+    ClusterInfo& cluster = clusters[slot_it->second];
+    cluster.num_nodes++;
+
     string node_backend;
     if (GetNodeBackend(node, &node_backend) != Status::OK()) {
       continue;
     }
 
-    auto it = device_name_map.find(cluster_idx);
-
-    if (it != device_name_map.end()) {
-      if (it->second != node->assigned_device_name()) {
+    if (!new_cluster) {
+      if (cluster.device_name != node->assigned_device_name()) {
         std::stringstream ss_err;
         ss_err << "Node " << node->name() << " in cluster " << cluster_idx
                << " has assigned device " << node->assigned_device_name()
-               << " but another node with assigned device " << it->second
+               << " but another node with assigned device "
+               << cluster.device_name
                << " has already been seen in the same cluster";
 
         return errors::Internal(ss_err.str());
       }
-    } else {
-      NGRAPH_VLOG(3) << "setting cluster " << cluster_idx
-                     << " requested device to '" << node->assigned_device_name()
-                     << "'";
-      device_name_map[cluster_idx] = node->assigned_device_name();
-    }
-
-    auto itr = backend_name_map.find(cluster_idx);
-
-    if (itr != backend_name_map.end()) {
-      if (itr->second != node_backend) {
+      if (cluster.backend_name != node_backend) {
         std::stringstream ss_err;
         ss_err << "Node " << node->name() << " in cluster " << cluster_idx
                << " has assigned backend " << node_backend
-               << " but another node with assigned backend " << it->second
+               << " but another node with assigned backend "
+               << cluster.backend_name
                << " has already been seen in the same cluster";
 
         return errors::Internal(ss_err.str());
       }
     } else {
+      NGRAPH_VLOG(3) << "setting cluster " << cluster_idx
+                     << " requested device to '" << node->assigned_device_name()
+                     << "'";
+      cluster.device_name = node->assigned_device_name();
       NGRAPH_VLOG(3) << "setting cluster " << cluster_idx
                      << " requested backend to '" << node_backend << "'";
-      backend_name_map[cluster_idx] = node_backend;
+      cluster.backend_name = node_backend;
     }
   }
 
-  // Pass 2: Find all nodes that are feeding into/out of each cluster, and
-  // add inputs for them to the corresponding FunctionDef(s).
-  std::map<int, int> retval_index_count;
-  std::map<int, int> arg_index_count;
+  // Pass 2: Find all values that are flowing into/out of each cluster, and
+  // number the inputs and outputs of the corresponding FunctionDef(s). This
+  // is the only pass over the edges of the graph: the edges RewritePass has
+  // to rewire are remembered in boundary_edge_ids.
   int count_arg = 0, count_retval = 0, count_both_arg_retval = 0,
       count_free = 0, count_encapsulated = 0, count_tot = 0;
   for (auto edge : graph->edges()) {
     count_tot++;
+    Node* src = edge->src();
+    Node* dst = edge->dst();
+    int src_slot = node_slot[src->id()];
+    int dst_slot = node_slot[dst->id()];
+
     // TODO(amprocte): should actually keep of these. During clustering we
     // will already have identified any intra-cluster control deps. Should
     // maintain inter-cluster control deps.
     if (edge->IsControlEdge()) {
       count_free++;
+      if (src_slot != dst_slot) {
+        boundary_edge_ids.push_back(edge->id());
+      }
       continue;
     }
 
-    Node* src = edge->src();
-    Node* dst = edge->dst();
-
     // TODO(amprocte): the following rejects edges involving source/sink. Is
     // that what we want to do?
     if (!src->IsOp() || !dst->IsOp()) {
@@ -434,102 +496,65 @@ Status Encapsulator::AnalysisPass() {
       continue;
     }
 
-    int dst_cluster_idx;
-    bool dst_clustered =
-        (GetNodeCluster(dst, &dst_cluster_idx) == Status::OK());
-
-    int src_cluster_idx;
-    bool src_clustered =
-        (GetNodeCluster(src, &src_cluster_idx) == Status::OK());
-
     // Ignore edges within a cluster. (Note that this test also works when
-    // both nodes are unclustered; GetNodeCluster gives us -1 in that case.
-    if (dst_cluster_idx == src_cluster_idx) {
+    // both nodes are unclustered; node_slot is -1 for both in that case.
+    if (src_slot == dst_slot) {
       count_encapsulated++;
       continue;
     }
 
+    bool src_clustered = (src_slot >= 0);
+    bool dst_clustered = (dst_slot >= 0);
+
     // Some debug logging...
     DataType dt = dst->input_type(edge->dst_input());
-    std::string flow_kind = dst_clustered && src_clustered
-                                ? "cross-flow"
-                                : dst_clustered ? "in-flow" : "out-flow";
-
-    NGRAPH_VLOG(4) << "found " << flow_kind << ": " << src->name() << "["
-                   << edge->src_output() << "] in " << src_cluster_idx << " to "
-                   << dst->name() << "[" << edge->dst_input() << "] in "
-                   << dst_cluster_idx << ", datatype: " << dt;
+    if (NGRAPH_VLOG_IS_ON(4)) {
+      std::string flow_kind = dst_clustered && src_clustered
+                                  ? "cross-flow"
+                                  : dst_clustered ? "in-flow" : "out-flow";
+      NGRAPH_VLOG(4) << "found " << flow_kind << ": " << src->name() << "["
+                     << edge->src_output() << "] in "
+                     << (src_clustered ? clusters[src_slot].cluster_idx : -1)
+                     << " to " << dst->name() << "[" << edge->dst_input()
+                     << "] in "
+                     << (dst_clustered ? clusters[dst_slot].cluster_idx : -1)
+                     << ", datatype: " << dt;
+    }
 
     bool edge_is_retval = false, edge_is_arg = false;
+    int64 key = OutputKey(src->id(), edge->src_output());
 
     // If the source node lies within a cluster, we must create an output for
-    // it from the source cluster. For the moment we will just store this
-    // fact in the output_remap_map.
-    if (src_clustered &&
-        output_remap_map.find(std::make_tuple(src->id(), edge->src_output())) ==
-            output_remap_map.end()) {
-      output_remap_map[std::make_tuple(src->id(), edge->src_output())] =
-          std::make_tuple(src_cluster_idx,
-                          cluster_output_dt_map[src_cluster_idx].size());
-
-      std::stringstream ss;
-      ss << "ngraph_output_" << cluster_output_dt_map[src_cluster_idx].size();
-      string output_name = ss.str();
-      auto new_output_node_def =
-          NGraphClusterManager::GetClusterGraph(src_cluster_idx)->add_node();
-      new_output_node_def->set_name(output_name);
-      new_output_node_def->set_op("_Retval");
-      edge_is_retval = true;
-
-      std::stringstream ss_input_to_retval;
-      ss_input_to_retval << src->name() << ":" << edge->src_output();
-
-      new_output_node_def->add_input(ss_input_to_retval.str());
-
-      SetAttrValue(dt, &((*(new_output_node_def->mutable_attr()))["T"]));
-      SetAttrValue(retval_index_count[src_cluster_idx],
-                   &((*(new_output_node_def->mutable_attr()))["index"]));
-
-      retval_index_count[src_cluster_idx]++;
-
-      cluster_output_dt_map[src_cluster_idx].push_back(dt);
+    // it from the source cluster. The _Retval itself is added once all the
+    // outputs of the cluster are known.
+    if (src_clustered) {
+      ClusterInfo& src_cluster = clusters[src_slot];
+      if (output_remap_map
+              .insert({key, std::make_pair(src_slot,
+                                           int(src_cluster.outputs.size()))})
+              .second) {
+        src_cluster.outputs.push_back(
+            std::make_tuple(src->id(), edge->src_output(), dt));
+        edge_is_retval = true;
+      }
+      // Edges into other clusters get rewired when their encapsulate is
+      // created, only edges into TF nodes are left for Pass 4
+      if (!dst_clustered) {
+        boundary_edge_ids.push_back(edge->id());
+      }
     }
 
     // If the destination node lies within a cluster, we must create an input
-    // for the source node to the destination cluster. For the moment we will
-    // just store this fact in the input_remap_map.
-    if (dst_clustered &&
-        input_remap_map.find(
-            std::make_tuple(dst_cluster_idx, src->id(), edge->src_output())) ==
-            input_remap_map.end()) {
-      input_remap_map[std::make_tuple(dst_cluster_idx, src->id(),
-                                      edge->src_output())] =
-          cluster_input_map[dst_cluster_idx].size();
-
-      std::stringstream ss;
-      ss << "ngraph_input_" << cluster_input_map[dst_cluster_idx].size();
-      std::string new_input_name = ss.str();
-
-      input_rename_map[std::make_tuple(dst_cluster_idx, src->name(),
-                                       edge->src_output())] = new_input_name;
-      string input_prov_tag = src->name();
-
-      auto new_input_node_def =
-          NGraphClusterManager::GetClusterGraph(dst_cluster_idx)->add_node();
-      new_input_node_def->set_name(new_input_name);
-      new_input_node_def->set_op("_Arg");
-      edge_is_arg = true;
-
-      SetAttrValue(dt, &((*(new_input_node_def->mutable_attr()))["T"]));
-      SetAttrValue(arg_index_count[dst_cluster_idx],
-                   &((*(new_input_node_def->mutable_attr()))["index"]));
-      SetAttrValue(input_prov_tag,
-                   &((*(new_input_node_def->mutable_attr()))["_prov_tag"]));
-
-      arg_index_count[dst_cluster_idx]++;
-
-      cluster_input_map[dst_cluster_idx].push_back(
-          std::make_tuple(src->id(), edge->src_output(), dt));
+    // for the source node to the destination cluster.
+    if (dst_clustered) {
+      ClusterInfo& dst_cluster = clusters[dst_slot];
+      if (dst_cluster.input_index
+              .insert({key, int(dst_cluster.inputs.size())})
+              .second) {
+        dst_cluster.inputs.push_back(
+            std::make_tuple(src->id(), edge->src_output(), dt));
+        edge_is_arg = true;
+      }
     }
 
     if (config::IsLoggingPlacement()) {
@@ -566,6 +591,51 @@ Status Encapsulator::AnalysisPass() {
     }
   }
 
+  // Now that the inputs and outputs of every cluster are known, add their
+  // _Arg and _Retval nodes, reserving room for the clustered nodes copied in
+  // Pass 5 as well.
+  for (auto& cluster : clusters) {
+    GraphDef* gdef = NGraphClusterManager::GetClusterGraph(cluster.cluster_idx);
+    if (gdef == nullptr) {
+      return errors::Internal("Did not find cluster ", cluster.cluster_idx,
+                              " in cluster manager");
+    }
+    gdef->mutable_node()->Reserve(gdef->node_size() + cluster.num_nodes +
+                                  cluster.inputs.size() +
+                                  cluster.outputs.size());
+
+    for (int i = 0; i < cluster.inputs.size(); i++) {
+      int src_node_id;
+      int src_output_idx;
+      DataType dt;
+      std::tie(src_node_id, src_output_idx, dt) = cluster.inputs[i];
+
+      auto new_input_node_def = gdef->add_node();
+      new_input_node_def->set_name(strings::StrCat("ngraph_input_", i));
+      new_input_node_def->set_op("_Arg");
+      auto& attr = *(new_input_node_def->mutable_attr());
+      SetAttrValue(dt, &attr["T"]);
+      SetAttrValue(i, &attr["index"]);
+      SetAttrValue(graph->FindNodeId(src_node_id)->name(), &attr["_prov_tag"]);
+    }
+
+    for (int i = 0; i < cluster.outputs.size(); i++) {
+      int src_node_id;
+      int src_output_idx;
+      DataType dt;
+      std::tie(src_node_id, src_output_idx, dt) = cluster.outputs[i];
+
+      auto new_output_node_def = gdef->add_node();
+      new_output_node_def->set_name(strings::StrCat("ngraph_output_", i));
+      new_output_node_def->set_op("_Retval");
+      new_output_node_def->add_input(strings::StrCat(
+          graph->FindNodeId(src_node_id)->name(), ":", src_output_idx));
+      auto& attr = *(new_output_node_def->mutable_attr());
+      SetAttrValue(dt, &attr["T"]);
+      SetAttrValue(i, &attr["index"]);
+    }
+  }
+
   // Pass 5: Make copies of all clustered nodes inside the cluster graphs,
   // rewiring the inputs in their NodeDefs as we go.
 
@@ -578,34 +648,26 @@ Status Encapsulator::AnalysisPass() {
   // copy into the ClusterManager
   // This is taken care of in the "if (edge->IsControlEdge())" line in the for
   // loop over all edges
+  std::vector<const Edge*> inputs;
   for (auto node : graph->op_nodes()) {
-    int cluster_idx;
-
-    if (GetNodeAttr(node->attrs(), "_ngraph_cluster", &cluster_idx) !=
-        Status::OK()) {
+    int slot = node_slot[node->id()];
+    if (slot < 0) {
       continue;
     }
+    const ClusterInfo& cluster = clusters[slot];
 
     // Because the input names may have changed from the original node def,
     // we will need to borrow some code from Graph::ToGraphDefSubRange in
     // tensorflow/core/graph/graph.cc that rewrites the node's input list.
 
     // begin code copied and pasted (and modified) from graph.cc...
-    NodeDef original_def = node->def();
-
     // Get the inputs for this Node.  We make sure control inputs are
     // after data inputs, as required by GraphDef.
-    std::vector<const Edge*> inputs;
-    inputs.resize(node->num_inputs(), nullptr);
+    inputs.assign(node->num_inputs(), nullptr);
     for (const Edge* edge : node->in_edges()) {
       if (edge->IsControlEdge()) {
-        int src_cluster_idx;
-        auto ctrl_src = edge->src();
-        auto st = GetNodeCluster(ctrl_src, &src_cluster_idx);
-        if (st.ok()) {
-          if (src_cluster_idx == cluster_idx) {
-            inputs.push_back(edge);
-          }
+        if (node_slot[edge->src()->id()] == slot) {
+          inputs.push_back(edge);
         }
       } else {
         CHECK(inputs[edge->dst_input()] == nullptr)
@@ -618,41 +680,38 @@ Status Encapsulator::AnalysisPass() {
         inputs[edge->dst_input()] = edge;
       }
     }
-    original_def.clear_input();
-    original_def.mutable_input()->Reserve(inputs.size());
+
+    auto node_def =
+        NGraphClusterManager::GetClusterGraph(cluster.cluster_idx)->add_node();
+    *node_def = node->def();
+    node_def->clear_input();
+    node_def->mutable_input()->Reserve(inputs.size());
 
     for (size_t i = 0; i < inputs.size(); ++i) {
       const Edge* edge = inputs[i];
       if (edge == nullptr) {
         if (i < node->requested_inputs().size()) {
-          original_def.add_input(node->requested_inputs()[i]);
+          node_def->add_input(node->requested_inputs()[i]);
         } else {
-          original_def.add_input("");
+          node_def->add_input("");
         }
-      } else {
-        const Node* src = edge->src();
-        if (!src->IsOp()) continue;
-        AddInput(&original_def, src->name(), edge->src_output());
+        continue;
       }
-    }
-    // ...end code copied and pasted (and modified) from graph.cc
-
-    auto node_def =
-        NGraphClusterManager::GetClusterGraph(cluster_idx)->add_node();
-    cluster_indices_for_this_graph.insert(cluster_idx);
-    *node_def = original_def;
-
-    for (auto& input : *(node_def->mutable_input())) {
-      TensorId tensor_id = ParseTensorName(input);
-
-      string tensor_name(tensor_id.first);
-      auto it = input_rename_map.find(
-          std::make_tuple(cluster_idx, tensor_name, tensor_id.second));
-
-      if (it != input_rename_map.end()) {
-        input = it->second;
+      const Node* src = edge->src();
+      if (!src->IsOp()) continue;
+      // Values coming from outside the cluster are read from its _Arg
+      // nodes
+      if (!edge->IsControlEdge() && node_slot[src->id()] != slot) {
+        auto it = cluster.input_index.find(
+            OutputKey(src->id(), edge->src_output()));
+        if (it != cluster.input_index.end()) {
+          node_def->add_input(strings::StrCat("ngraph_input_", it->second));
+          continue;
+        }
       }
+      AddInput(node_def, src->name(), edge->src_output());
     }
+    // ...end code copied and pasted (and modified) from graph.cc
   }
 
   analysis_done = true;
@@ -672,18 +731,17 @@ Status Encapsulator::RewritePass(
         "In Encapsulator, called RewritePass more than once");
   }
   // Pass 3: Create encapsulation nodes for all clusters.
-  for (auto& kv : device_name_map) {
+  for (auto& kv : cluster_slot_map) {
     int cluster_idx = kv.first;
-    string cluster_backend = backend_name_map[cluster_idx];
-
-    std::stringstream ss;
-    ss << "ngraph_cluster_" << cluster_idx;
+    ClusterInfo& cluster = clusters[kv.second];
 
-    string encap_node_name = ss.str();
+    string encap_node_name = strings::StrCat("ngraph_cluster_", cluster_idx);
     std::vector<DataType> input_types;
     std::vector<NodeBuilder::NodeOut> inputs;
+    input_types.reserve(cluster.inputs.size());
+    inputs.reserve(cluster.inputs.size());
 
-    for (auto& tup : cluster_input_map[cluster_idx]) {
+    for (auto& tup : cluster.inputs) {
       int src_node_id;
       int src_output_idx;
       DataType dt;
@@ -695,17 +753,24 @@ Status Encapsulator::RewritePass(
           NodeBuilder::NodeOut(graph->FindNodeId(src_node_id), src_output_idx));
     }
 
+    std::vector<DataType> output_types;
+    output_types.reserve(cluster.outputs.size());
+    for (auto& tup : cluster.outputs) {
+      output_types.push_back(std::get<2>(tup));
+    }
+
     Node* n;
     NodeBuilder nb =
         NodeBuilder(encap_node_name, "NGraphEncapsulate")
             .Attr("ngraph_cluster", cluster_idx)
             .Attr("ngraph_backend",
-                  BackendManager::GetBackendAttributeValues(cluster_backend)
+                  BackendManager::GetBackendAttributeValues(
+                      cluster.backend_name)
                       .at("ngraph_backend"))
             .Attr("Targuments", input_types)
-            .Attr("Tresults", cluster_output_dt_map[cluster_idx])
+            .Attr("Tresults", output_types)
             .Attr("ngraph_graph_id", graph_id)
-            .Device(device_name_map[cluster_idx])
+            .Device(cluster.device_name)
             .Input(inputs);
     if (!device_config.empty()) {
       NGRAPH_VLOG(3) << "Device config is not empty";
@@ -717,88 +782,84 @@ Status Encapsulator::RewritePass(
       }
     }
 
-    // Find Static Inputs And Add as an attribute
+    // Find Static Inputs And Add as an attribute. The cluster graph is
+    // complete at this point, so the Graph built here is the one the kernels
+    // will use.
     vector<int> static_input_indexes;
-    GraphDef* gdef_for_current_encapsulate;
-    gdef_for_current_encapsulate =
-        NGraphClusterManager::GetClusterGraph(cluster_idx);
-    if (gdef_for_current_encapsulate == nullptr) {
+    std::shared_ptr<const Graph> graph_for_current_encapsulate;
+    TF_RETURN_IF_ERROR(NGraphClusterManager::GetClusterTFGraph(
+        cluster_idx, &graph_for_current_encapsulate));
+    if (graph_for_current_encapsulate == nullptr) {
       return errors::Internal(
           "Did not find encapsulated graph in cluster manager for node ",
           encap_node_name);
     }
-    GraphConstructorOptions opts;
-    opts.allow_internal_ops = true;
-    Graph graph_for_current_encapsulate(OpRegistry::Global());
-    TF_RETURN_IF_ERROR(ConvertGraphDefToGraph(
-        opts, *gdef_for_current_encapsulate, &graph_for_current_encapsulate));
 
-    TF_RETURN_IF_ERROR(
-        GetStaticInputs(&graph_for_current_encapsulate, &static_input_indexes));
+    TF_RETURN_IF_ERROR(GetStaticInputs(graph_for_current_encapsulate.get(),
+                                       &static_input_indexes));
     nb.Attr("_ngraph_static_inputs", static_input_indexes);
 
     Status status = nb.Finalize(graph, &n);
     TF_RETURN_IF_ERROR(status);
-    n->set_assigned_device_name(device_name_map[cluster_idx]);
+    n->set_assigned_device_name(cluster.device_name);
 
-    cluster_node_map[cluster_idx] = n;
+    cluster.encap_node = n;
   }
 
-  // Pass 4: Remap all non-clustered inputs that are reading from
-  // encapsulated edges, and all control edges that cross cluster
-  // boundaries.
-
-  // Copy the edge pointers, so as not to invalidate the iterator.
-  std::vector<Edge*> edges;
-  for (auto edge : graph->edges()) {
-    edges.push_back(edge);
+  // Pass 4: Remap all inputs that are reading from encapsulated edges, and
+  // all control edges that cross cluster boundaries.
+
+  // The encapsulates created above still read values produced in other
+  // clusters from the original nodes.
+  std::vector<const Edge*> in_edges;
+  for (auto& cluster : clusters) {
+    Node* encap_node = cluster.encap_node;
+    in_edges.assign(encap_node->in_edges().begin(),
+                    encap_node->in_edges().end());
+    for (auto edge : in_edges) {
+      if (edge->IsControlEdge()) {
+        continue;
+      }
+      auto it = output_remap_map.find(
+          OutputKey(edge->src()->id(), edge->src_output()));
+      if (it == output_remap_map.end()) {
+        continue;
+      }
+      TF_RETURN_IF_ERROR(graph->UpdateEdge(
+          clusters[it->second.first].encap_node, it->second.second,
+          encap_node, edge->dst_input()));
+    }
   }
 
-  for (auto edge : edges) {
-    int src_cluster_idx;
-    bool src_clustered =
-        (GetNodeCluster(edge->src(), &src_cluster_idx) == Status::OK());
-    int dst_cluster_idx;
-    bool dst_clustered =
-        (GetNodeCluster(edge->dst(), &dst_cluster_idx) == Status::OK());
-
-    if (src_cluster_idx == dst_cluster_idx) {
+  // The remaining edges to rewire were all found by AnalysisPass
+  for (int edge_id : boundary_edge_ids) {
+    const Edge* edge = graph->FindEdgeId(edge_id);
+    if (edge == nullptr) {
       continue;
     }
+    int src_slot = node_slot[edge->src()->id()];
+    int dst_slot = node_slot[edge->dst()->id()];
 
     if (edge->IsControlEdge()) {
-      if (src_clustered && dst_clustered) {
-        graph->RemoveControlEdge(edge);
-        graph->AddControlEdge(cluster_node_map[src_cluster_idx],
-                              cluster_node_map[dst_cluster_idx]);
-      } else if (src_clustered) {
-        Node* dst = edge->dst();
-        graph->RemoveControlEdge(edge);
-        graph->AddControlEdge(cluster_node_map[src_cluster_idx], dst);
-      } else if (dst_clustered) {
-        Node* src = edge->src();
-        graph->RemoveControlEdge(edge);
-        graph->AddControlEdge(src, cluster_node_map[dst_cluster_idx]);
-      }
+      Node* src =
+          src_slot >= 0 ? clusters[src_slot].encap_node : edge->src();
+      Node* dst =
+          dst_slot >= 0 ? clusters[dst_slot].encap_node : edge->dst();
+      graph->RemoveControlEdge(edge);
+      graph->AddControlEdge(src, dst);
     } else {
-      // This is handled at a later stage (TODO(amprocte): explain)
-      if (dst_clustered) {
-        continue;
-      }
-
       auto it = output_remap_map.find(
-          std::make_tuple(edge->src()->id(), edge->src_output()));
+          OutputKey(edge->src()->id(), edge->src_output()));
 
       if (it == output_remap_map.end()) {
         continue;
       }
 
-      int cluster_idx;
       int cluster_output;
-      std::tie(cluster_idx, cluster_output) = it->second;
+      std::tie(src_slot, cluster_output) = it->second;
 
       Status status =
-          graph->UpdateEdge(cluster_node_map[cluster_idx], cluster_output,
+          graph->UpdateEdge(clusters[src_slot].encap_node, cluster_output,
                             edge->dst(), edge->dst_input());
       TF_RETURN_IF_ERROR(status);
     }
@@ -807,10 +868,7 @@ Status Encapsulator::RewritePass(
   // Pass 6: Remove clustered nodes from the graph.
   std::vector<Node*> nodes_to_remove;
   for (auto node : graph->op_nodes()) {
-    int cluster_idx;
-
-    if (GetNodeAttr(node->attrs(), "_ngraph_cluster", &cluster_idx) !=
-        Status::OK()) {
+    if (node->id() >= node_slot.size() || node_slot[node->id()] < 0) {
       continue;
     }
     nodes_to_remove.push_back(node);
@@ -822,22 +880,25 @@ Status Encapsulator::RewritePass(
   }
 
   // Pass 7: Insert to function library
-  // Note: We loop over cluster_indices_for_this_graph and not all the
+  // Note: We loop over the clusters of this graph and not all the
   // contents of ClusterManager
-  for (const auto& cluster_idx : cluster_indices_for_this_graph) {
+  for (const auto& kv : cluster_slot_map) {
+    int cluster_idx = kv.first;
     // The transformation happening inside this loop is:
-    // graphdef --> graph --> functiondef
-    // NGraphClusterManager::GetClusterGraph(cluster_idx)-->subgraph-->fdef
-    // TODO: whats the right flib to use in subgraph's constructor?
-    Graph subgraph(graph->flib_def());
+    // NGraphClusterManager::GetClusterTFGraph(cluster_idx)-->fdef
+    // The Graph was built in Pass 3, which dropped the GraphDef
+    std::shared_ptr<const Graph> subgraph;
+    TF_RETURN_IF_ERROR(
+        NGraphClusterManager::GetClusterTFGraph(cluster_idx, &subgraph));
+    if (subgraph == nullptr) {
+      return errors::Internal("Did not find cluster ", cluster_idx,
+                              " in cluster manager");
+    }
     // TODO: When this works, NGraphClusterManager can go away
-    TF_RETURN_IF_ERROR(ConvertGraphDefToGraph(
-        GraphConstructorOptions(),
-        *(NGraphClusterManager::GetClusterGraph(cluster_idx)), &subgraph));
     FunctionDef* fdef = fdeflib->add_function();
     // TODO: if func lib has func with same name etc?
     TF_RETURN_IF_ERROR(GraphToFunctionDef(
-        subgraph, strings::StrCat("ngraph_cluster_", to_string(cluster_idx)),
+        *subgraph, strings::StrCat("ngraph_cluster_", to_string(cluster_idx)),
         fdef));
   }
   rewrite_done = true;
@@ -851,8 +912,8 @@ Status Encapsulator::GetNewClusterIDs(set<int>& result) {
         "AnalysisPass");
   }
   result.clear();
-  for (auto it = device_name_map.begin(); it != device_name_map.end(); ++it) {
-    result.insert(it->first);
+  for (auto& kv : cluster_slot_map) {
+    result.insert(kv.first);
   }
   return Status::OK();
 }
@@ -1002,23 +1063,23 @@ Status PerformTranslation(Node* node, const std::map<std::string, vector<int>>&
   int cluster_idx;
   TF_RETURN_IF_ERROR(
       GetNodeAttr(node->attrs(), "ngraph_cluster", &cluster_idx));
-  GraphDef* gdef_for_current_encapsulate;
-  gdef_for_current_encapsulate =
-      NGraphClusterManager::GetClusterGraph(cluster_idx);
-  GraphConstructorOptions opts;
-  opts.allow_internal_ops = true;
-  Graph graph_for_current_encapsulate(OpRegistry::Global());
-  TF_RETURN_IF_ERROR(ConvertGraphDefToGraph(opts, *gdef_for_current_encapsulate,
-                                            &graph_for_current_encapsulate));
+  std::shared_ptr<const Graph> graph_for_current_encapsulate;
+  TF_RETURN_IF_ERROR(NGraphClusterManager::GetClusterTFGraph(
+      cluster_idx, &graph_for_current_encapsulate));
+  if (graph_for_current_encapsulate == nullptr) {
+    return errors::Internal(
+        "Did not find encapsulated graph in cluster manager for node ",
+        node->name());
+  }
 
   // TODO: Note that this is code duplication of some stuff present
   // in NGraphEncapsulateOp
   // Once NGraphEncapsulateOp is refactored, this code should be
   // removed and a common function should be used
 
-  TF_RETURN_IF_ERROR(Builder::TranslateGraph(input_shapes, static_input_map,
-                                             &graph_for_current_encapsulate,
-                                             ng_function));
+  TF_RETURN_IF_ERROR(Builder::TranslateGraph(
+      input_shapes, static_input_map, graph_for_current_encapsulate.get(),
+      ng_function));
 
   return Status::OK();
 }
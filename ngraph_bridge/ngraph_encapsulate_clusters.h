@@ -21,6 +21,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <iostream>
@@ -91,30 +92,43 @@ class Encapsulator {
   bool analysis_done;
   // boolean to indicate that rewrite is done;
   bool rewrite_done;
-  // A map from cluster indices to the expected device name for nodes
-  // in that cluster.
-  std::map<int, std::string> device_name_map;
-
-  // We *should* eventually have a way of monitoring the device and the backend
-  // together
-  std::map<int, std::string> backend_name_map;
-
-  // As we build the graph we will be tracking the.. TODO(amprocte): finish
-  // this comment.
-  std::map<std::tuple<int, int>, std::tuple<int, int>> output_remap_map;
-  std::map<std::tuple<int, int, int>, int> input_remap_map;
-  std::map<std::tuple<int, std::string, int>, string> input_rename_map;
-
-  // A map from cluster indices to a vector of input data types.
-  std::map<int, std::vector<std::tuple<int, int, DataType>>> cluster_input_map;
-  // A map from cluster indices to a vector of output data types.
-  std::map<int, std::vector<DataType>> cluster_output_dt_map;
-
-  // A map from cluster indices to corresponding NGraphEncapsulate nodes.
-  std::map<int, Node*> cluster_node_map;
-
-  std::set<int> cluster_indices_for_this_graph;
-
+  // Everything AnalysisPass finds out about a cluster, so that RewritePass
+  // does not have to scan the whole graph again
+  struct ClusterInfo {
+    int cluster_idx;
+    // Expected device and backend for the nodes of the cluster
+    std::string device_name;
+    std::string backend_name;
+    int num_nodes = 0;
+    // Values read by the cluster, in _Arg index order: (src node id, src
+    // output, data type)
+    std::vector<std::tuple<int, int, DataType>> inputs;
+    // (src node id, src output) packed with OutputKey -> _Arg index
+    std::unordered_map<int64, int> input_index;
+    // Values the cluster produces for the rest of the graph, in _Retval
+    // index order
+    std::vector<std::tuple<int, int, DataType>> outputs;
+    // The NGraphEncapsulate node, once RewritePass has created it
+    Node* encap_node = nullptr;
+  };
+  std::vector<ClusterInfo> clusters;
+  // A map from cluster indices to positions in clusters
+  std::map<int, int> cluster_slot_map;
+  // Position in clusters of each node, indexed by node id. -1 for nodes that
+  // are not clustered.
+  std::vector<int> node_slot;
+
+  // (src node id, src output) packed with OutputKey -> (position in clusters,
+  // _Retval index)
+  std::unordered_map<int64, std::pair<int, int>> output_remap_map;
+
+  // Ids of the edges of the original graph that cross a cluster boundary and
+  // need to be rewired to an encapsulate node
+  std::vector<int> boundary_edge_ids;
+
+  static int64 OutputKey(int node_id, int output) {
+    return (static_cast<int64>(node_id) << 32) | static_cast<uint32>(output);
+  }
   static void AddInput(NodeDef* dst, StringPiece src_name, int src_slot);
 };
 
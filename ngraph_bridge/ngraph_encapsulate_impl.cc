@@ -60,7 +60,8 @@ namespace ngraph_bridge {
 //---------------------------------------------------------------------------
 //  NGraphEncapsulateImpl::ctor
 //---------------------------------------------------------------------------
-NGraphEncapsulateImpl::NGraphEncapsulateImpl() : m_graph(OpRegistry::Global()) {
+NGraphEncapsulateImpl::NGraphEncapsulateImpl()
+    : m_graph(std::make_shared<Graph>(OpRegistry::Global())) {
   my_instance_id = s_instance_count;
   s_instance_count++;
 }
@@ -135,7 +136,7 @@ Status NGraphEncapsulateImpl::GetNgExecutable(
     string serialized_ng_func;
     if (!m_do_aot) {
       TF_RETURN_IF_ERROR(Builder::TranslateGraph(input_shapes, static_input_map,
-                                                 &m_graph, ng_function));
+                                                 m_graph.get(), ng_function));
       ng_function->set_friendly_name(m_name);
       int json_indentation = 4;
       serialized_ng_func = ngraph::serialize(ng_function, json_indentation);
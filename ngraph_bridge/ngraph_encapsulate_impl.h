@@ -201,8 +201,9 @@ class NGraphEncapsulateImpl {
     m_executable_pipelined_tensors_map.clear();
   }
 
-  // TF Graph for the cluster
-  Graph m_graph;
+  // TF Graph for the cluster, possibly shared with other kernels of the
+  // cluster
+  std::shared_ptr<const Graph> m_graph;
 
  private:
   int number_of_copies = 0;
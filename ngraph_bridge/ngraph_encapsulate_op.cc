@@ -39,6 +39,7 @@
 #include "ngraph_bridge/ngraph_backend_manager.h"
 #include "ngraph_bridge/ngraph_builder.h"
 #include "ngraph_bridge/ngraph_cluster_manager.h"
+#include "ngraph_bridge/ngraph_compile_pool.h"
 #include "ngraph_bridge/ngraph_encapsulate_impl.h"
 #include "ngraph_bridge/ngraph_encapsulate_op.h"
 #include "ngraph_bridge/ngraph_encapsulate_op_utils.h"
@@ -108,14 +109,15 @@ NGraphEncapsulateOp::NGraphEncapsulateOp(OpKernelConstruction* ctx)
 void NGraphEncapsulateOp::CreateParallelExecutor(OpKernelConstruction* ctx,
                                                  const string& backend_name) {
   NGRAPH_VLOG(1) << "Create Parallel Executor " << name();
-  GraphDef* graph_def;
-  unique_ptr<Graph> encap_subgraph(new Graph(OpRegistry::Global()));
+  std::shared_ptr<const Graph> encap_subgraph;
 
   int cluster_id{-1};
   OP_REQUIRES_OK(ctx, ctx->GetAttr<int>("ngraph_cluster", &cluster_id));
-  graph_def = NGraphClusterManager::GetClusterGraph(cluster_id);
+  m_cluster_handle = NGraphClusterManager::HoldCluster(cluster_id);
+  OP_REQUIRES_OK(ctx, NGraphClusterManager::GetClusterTFGraph(cluster_id,
+                                                              &encap_subgraph));
 
-  if (graph_def == nullptr) {
+  if (encap_subgraph == nullptr) {
     string flib_key = "ngraph_cluster_" + to_string(cluster_id);
     // Read graphdef from function library
     const FunctionLibraryDefinition flib =
@@ -132,12 +134,10 @@ void NGraphEncapsulateOp::CreateParallelExecutor(OpKernelConstruction* ctx,
     };
     OP_REQUIRES_OK(
         ctx, FunctionDefToBodyHelper(*fdef, {}, &flib, get_func_sig, &fnbody));
-    CopyGraph(*fnbody->graph, encap_subgraph.get());
-  } else {
-    GraphConstructorOptions opts;
-    opts.allow_internal_ops = true;
-    OP_REQUIRES_OK(
-        ctx, ConvertGraphDefToGraph(opts, *graph_def, encap_subgraph.get()));
+    std::shared_ptr<Graph> graph =
+        std::make_shared<Graph>(OpRegistry::Global());
+    CopyGraph(*fnbody->graph, graph.get());
+    encap_subgraph = graph;
   }
 
   int graph_id{-1};
@@ -165,6 +165,14 @@ void NGraphEncapsulateOp::CreateParallelExecutor(OpKernelConstruction* ctx,
                   "Num of outputs from TensorManager and Ctx do not match"));
   s_instance_id++;
 
+  // The element types TensorFlow expects of the outputs, checked against
+  // those of the executables on every Compute
+  m_output_element_types.resize(ctx->num_outputs());
+  for (int i = 0; i < ctx->num_outputs(); i++) {
+    OP_REQUIRES_OK(ctx, TFDataTypeToNGraphElementType(
+                            ctx->output_type(i), &m_output_element_types[i]));
+  }
+
   // Get the optional attributes
   std::unordered_map<std::string, std::string> additional_attribute_map;
   auto node_def = ctx->def();
@@ -172,6 +180,36 @@ void NGraphEncapsulateOp::CreateParallelExecutor(OpKernelConstruction* ctx,
                           node_def.attr(), &additional_attribute_map));
   // SetConfig will be called for each EncapsulateOp
   BackendManager::SetConfig(backend_name, additional_attribute_map);
+
+  // With parallel compilation, if the encapsulation pass could infer all the
+  // input shapes, compile on the pool now rather than on the first Compute.
+  // The kernels of all the encapsulates are created (serially, by TF) before
+  // their compiles finish.
+  thread::ThreadPool* pool = GetCompileThreadPool();
+  std::vector<PartialTensorShape> input_shapes;
+  if (pool != nullptr &&
+      GetNodeAttr(node_def, "_input_shapes", &input_shapes).ok()) {
+    std::vector<TensorShape> concrete_shapes(input_shapes.size());
+    bool all_concrete = true;
+    for (int i = 0; i < input_shapes.size() && all_concrete; i++) {
+      all_concrete = input_shapes[i].AsTensorShape(&concrete_shapes[i]);
+    }
+    if (all_concrete) {
+      auto precompile = [this, concrete_shapes]() {
+        Status status = m_parallel_executor->Precompile(concrete_shapes);
+        if (!status.ok()) {
+          // Compute will try again, and report the error then
+          NGRAPH_VLOG(1) << "Precompiling " << name()
+                         << " failed: " << status.error_message();
+        }
+      };
+      m_precompile_done.reset(new Notification);
+      pool->Schedule([this, precompile]() {
+        precompile();
+        m_precompile_done->Notify();
+      });
+    }
+  }
 }
 
 //---------------------------------------------------------------------------
@@ -190,15 +228,15 @@ void NGraphEncapsulateOp::CreateLegacyExecutor(OpKernelConstruction* ctx,
   NGRAPH_VLOG(1) << "NGraphEncapsulateOp: " << ng_encap_impl_.GetInstanceId()
                  << " Name: " << name();
 
-  GraphDef* graph_def;
-
   int cluster{-1};
   OP_REQUIRES_OK(ctx, ctx->GetAttr<int>("ngraph_cluster", &cluster));
   ng_encap_impl_.SetNgraphCluster(cluster);
-  graph_def =
-      NGraphClusterManager::GetClusterGraph(ng_encap_impl_.GetNgraphCluster());
+  m_cluster_handle = NGraphClusterManager::HoldCluster(cluster);
+  std::shared_ptr<const Graph> encap_subgraph;
+  OP_REQUIRES_OK(ctx, NGraphClusterManager::GetClusterTFGraph(
+                          ng_encap_impl_.GetNgraphCluster(), &encap_subgraph));
 
-  if (graph_def == nullptr) {
+  if (encap_subgraph == nullptr) {
     string flib_key =
         "ngraph_cluster_" + to_string(ng_encap_impl_.GetNgraphCluster());
     // Read graphdef from function library
@@ -219,13 +257,12 @@ void NGraphEncapsulateOp::CreateLegacyExecutor(OpKernelConstruction* ctx,
     if (!status.ok()) {
       NGRAPH_VLOG(2) << "FunctionDefToBodyHelper returned a not ok status.";
     }
-    CopyGraph(*fnbody->graph, &ng_encap_impl_.m_graph);
-  } else {
-    GraphConstructorOptions opts;
-    opts.allow_internal_ops = true;
-    OP_REQUIRES_OK(
-        ctx, ConvertGraphDefToGraph(opts, *graph_def, &ng_encap_impl_.m_graph));
+    std::shared_ptr<Graph> graph =
+        std::make_shared<Graph>(OpRegistry::Global());
+    CopyGraph(*fnbody->graph, graph.get());
+    encap_subgraph = graph;
   }
+  ng_encap_impl_.m_graph = encap_subgraph;
 
   int graph_id{-1};
   OP_REQUIRES_OK(ctx, ctx->GetAttr("ngraph_graph_id", &graph_id));
@@ -242,7 +279,7 @@ void NGraphEncapsulateOp::CreateLegacyExecutor(OpKernelConstruction* ctx,
   int32 max_arg_index = -1;
   std::vector<const Node*> arg_nodes;
 
-  for (auto node : ng_encap_impl_.m_graph.nodes()) {
+  for (auto node : ng_encap_impl_.m_graph->nodes()) {
     if (node->type_string() == "_Arg") {
       arg_nodes.push_back(node);
 
@@ -318,6 +355,9 @@ NGraphEncapsulateOp::~NGraphEncapsulateOp() {
   NGRAPH_VLOG(2) << "~NGraphEncapsulateOp::" << name();
 
   if (m_use_parallel_executor) {
+    if (m_precompile_done != nullptr) {
+      m_precompile_done->WaitForNotification();
+    }
     NGRAPH_VLOG(2)
         << "~NGraphEncapsulateOp():: ParallelExecutor: ReleaseBackend";
     // The sequence of termination is important as some backends do not
@@ -393,6 +433,10 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
 //---------------------------------------------------------------------------
 void NGraphEncapsulateOp::ComputeUsingParallelExecutor(OpKernelContext* ctx) {
   NGRAPH_VLOG(1) << "Compute using Parallel Executor " << name();
+  if (m_precompile_done != nullptr) {
+    NG_TRACE("WaitForPrecompile", name(), "");
+    m_precompile_done->WaitForNotification();
+  }
   // TF input tensors
   std::vector<Tensor> tf_input_tensors;
 
@@ -401,6 +445,7 @@ void NGraphEncapsulateOp::ComputeUsingParallelExecutor(OpKernelContext* ctx) {
   // hit/miss
   // This results in duplicate Tensors but ok as we are not memory limited
   // (The prefetching applies for inputs)
+  tf_input_tensors.reserve(ctx->num_inputs());
   for (int i = 0; i < ctx->num_inputs(); i++) {
     tf_input_tensors.push_back(ctx->input(i));
   }
@@ -410,12 +455,13 @@ void NGraphEncapsulateOp::ComputeUsingParallelExecutor(OpKernelContext* ctx) {
   std::shared_ptr<ngraph::runtime::Executable> ng_exec;
   std::string serialized_ng_function;
   shared_ptr<PipelinedTensorsStore> pipelined_tensor_store;
+  shared_ptr<const NGraphExecutionPlan> plan;
   bool cache_hit;
   {
     NG_TRACE("GetExecutableAndTensors", "", "");
     OP_REQUIRES_OK(ctx, m_parallel_executor->GetExecutableFunctionAndTensors(
                             tf_input_tensors, ng_exec, serialized_ng_function,
-                            pipelined_tensor_store, cache_hit));
+                            pipelined_tensor_store, plan, cache_hit));
     NGRAPH_VLOG(2) << "CACHE HIT: " << PrintBool(cache_hit) << endl;
     NGRAPH_VLOG(2) << " Step_ID: " << ctx->step_id();
 
@@ -428,7 +474,8 @@ void NGraphEncapsulateOp::ComputeUsingParallelExecutor(OpKernelContext* ctx) {
               errors::Internal("Pipeline Depth is not 2, got ",
                                m_parallel_executor->GetTensorPipelineDepth()));
 
-  // Get Tensor Manager and some error checking
+  // Get Tensor Manager and some error checking. The executable was checked
+  // against the tensor manager when its plan was made.
   int current_iter_pipeline_depth;
   vector<shared_ptr<ng::runtime::Tensor>> ng_inputs;
   vector<shared_ptr<ng::runtime::Tensor>> ng_outputs;
@@ -448,29 +495,18 @@ void NGraphEncapsulateOp::ComputeUsingParallelExecutor(OpKernelContext* ctx) {
                          " and num of "
                          "input tensors from ctxt ",
                          tf_input_tensors.size(), " do not match"));
-    OP_REQUIRES(
-        ctx, num_of_inputs == ng_exec->get_parameters().size(),
-        errors::Internal("Num of inputs from TensorManager ", num_of_inputs,
-                         " and num of "
-                         "parameters from exec ",
-                         ng_exec->get_parameters().size(), " do not match"));
 
     OP_REQUIRES(ctx, num_of_outputs == ctx->num_outputs(),
                 errors::Internal("Num of outputs from TensorManager ",
                                  num_of_outputs, " and Ctx->num_outputs()",
                                  ctx->num_outputs(), " do not match"));
-    OP_REQUIRES(
-        ctx, num_of_outputs == ng_exec->get_results().size(),
-        errors::Internal("Num of outputs from TensorManager ", num_of_outputs,
-                         "and number of exec outputs ",
-                         ng_exec->get_results().size(), " do not match"));
 
     // Get pipelined input output tensors for this iteration
     std::tuple<int, PipelinedTensorVector, PipelinedTensorVector>
         pipelined_io_tensors;
     OP_REQUIRES_OK(ctx, GetPipelinedIOTensorsReadyForExecution(
                             ctx, tf_input_tensors, pipelined_tensor_store,
-                            tensor_manager, pipelined_io_tensors));
+                            tensor_manager, *plan, pipelined_io_tensors));
 
     current_iter_pipeline_depth = get<0>(pipelined_io_tensors);
     ng_inputs.resize(num_of_inputs);
@@ -527,38 +563,24 @@ void NGraphEncapsulateOp::ComputeUsingParallelExecutor(OpKernelContext* ctx) {
 
   {
     NG_TRACE("Prepare TF Output Tensor", "", "");
-    vector<Tensor*> tf_output_tensors;
-    for (auto i = 0; i < ng_exec->get_results().size(); i++) {
-      auto ng_element = ng_exec->get_results()[i];
-      auto ng_shape = ng_element->get_shape();
-      auto ng_element_type = ng_element->get_element_type();
-
-      // Create the TF output tensor
-      vector<int64> dims;
-      for (auto dim : ng_shape) {
-        dims.push_back(dim);
-      }
-      TensorShape tf_shape(dims);
-      Tensor* tf_output_tensor = nullptr;
-      OP_REQUIRES_OK(ctx, ctx->allocate_output(i, tf_shape, &tf_output_tensor));
-      tf_output_tensors.push_back(tf_output_tensor);
+    vector<Tensor*> tf_output_tensors(ctx->num_outputs());
+    for (auto i = 0; i < ctx->num_outputs(); i++) {
       // Make sure the nGraph-inferred element type agrees with what TensorFlow
       // expected.
-      ng::element::Type expected_elem_type;
-      OP_REQUIRES_OK(
-          ctx, TFDataTypeToNGraphElementType(ctx->expected_output_dtype(i),
-                                             &expected_elem_type));
       OP_REQUIRES(
-          ctx, ng_element_type == expected_elem_type,
+          ctx, plan->output_element_types[i] == m_output_element_types[i],
           errors::Internal("Element type inferred by nGraph does not match "
                            "the element type expected by TensorFlow"));
+      // Create the TF output tensor
+      OP_REQUIRES_OK(ctx, ctx->allocate_output(i, plan->output_shapes[i],
+                                               &tf_output_tensors[i]));
     }
 
     // Copy Tensors that are required
     NGRAPH_VLOG(4) << "NGraphEncapsulateOp::Compute Read NG Output Tensors "
                    << m_parallel_executor->GetNgraphClusterId();
 
-    auto output_indexes_to_be_copied =
+    const auto& output_indexes_to_be_copied =
         tensor_manager->GetOutputIndexesThatNeedCopy();
     for (auto output_index : output_indexes_to_be_copied) {
       // Copy the nGraph Tensor to Host Tensor
@@ -23,9 +23,11 @@
 
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/notification.h"
 
 #include "logging/ngraph_log.h"
 #include "ngraph/ngraph.hpp"
+#include "ngraph_bridge/ngraph_cluster_manager.h"
 #include "ngraph_bridge/ngraph_encapsulate_impl.h"
 #include "ngraph_executor.h"
 
@@ -52,6 +54,13 @@ class NGraphEncapsulateOp : public OpKernel {
   bool m_use_parallel_executor = false;
   std::mutex m_compute_lock_;
   unique_ptr<NGraphExecutor> m_parallel_executor;
+  // Element types of the outputs, as TensorFlow expects them
+  std::vector<ng::element::Type> m_output_element_types;
+  // Set when the executor is precompiled on the compile thread pool, notified
+  // once that is done
+  unique_ptr<Notification> m_precompile_done;
+  // Keeps the cluster in NGraphClusterManager while this kernel exists
+  unique_ptr<NGraphClusterManager::ClusterHandle> m_cluster_handle;
 };
 
 }  // namespace ngraph_bridge
@@ -26,6 +26,18 @@ namespace tensorflow {
 
 namespace ngraph_bridge {
 
+// The executable of the signature was compiled for inputs of these sizes, so
+// this only differs if the element types do
+static Status CheckInputBytes(const Tensor& tf_tensor, int tf_index,
+                              size_t expected_bytes) {
+  if (tf_tensor.TotalBytes() != expected_bytes) {
+    return errors::Internal("Input ", tf_index, " has ", tf_tensor.TotalBytes(),
+                            " bytes, but the executable expects ",
+                            expected_bytes);
+  }
+  return Status::OK();
+}
+
 //---------------------------------------------------------------------------
 //  GetPipelinedIOTensorsReadyForExecution
 //---------------------------------------------------------------------------
@@ -33,15 +45,18 @@ Status GetPipelinedIOTensorsReadyForExecution(
     OpKernelContext* ctx, const vector<Tensor>& tf_input_tensors,
     const shared_ptr<PipelinedTensorsStore>& pipelined_tensor_store,
     const shared_ptr<NGraphTensorManager>& tensor_manager,
+    const NGraphExecutionPlan& plan,
     tuple<int, PipelinedTensorVector, PipelinedTensorVector>&
         pipelined_io_tensors) {
   auto io_tensors = pipelined_tensor_store->get_tensors();
 
   int current_iter_pipeline_depth = get<0>(io_tensors);
-  PipelinedTensorVector ng_pipelined_inputs = get<1>(io_tensors);
-  PipelinedTensorVector ng_pipelined_outputs = get<2>(io_tensors);
-  auto pipelined_input_indexes = tensor_manager->GetPipelinedInputIndexes();
-  auto pipelined_output_indexes = tensor_manager->GetPipelinedOutputIndexes();
+  PipelinedTensorVector ng_pipelined_inputs = move(get<1>(io_tensors));
+  PipelinedTensorVector ng_pipelined_outputs = move(get<2>(io_tensors));
+  const auto& pipelined_input_indexes =
+      tensor_manager->GetPipelinedInputIndexes();
+  const auto& pipelined_output_indexes =
+      tensor_manager->GetPipelinedOutputIndexes();
 
   if (current_iter_pipeline_depth < 0) {
     return errors::Internal("No free tensor available");
@@ -165,18 +180,16 @@ Status GetPipelinedIOTensorsReadyForExecution(
 
     for (auto i = 0; i < pipelined_input_indexes.size(); i++) {
       int tf_index = pipelined_input_indexes[i];
-      ng::element::Type ng_element_type;
-      TF_RETURN_IF_ERROR(TFDataTypeToNGraphElementType(
-          tf_input_tensors[tf_index].dtype(), &ng_element_type));
+      TF_RETURN_IF_ERROR(CheckInputBytes(tf_input_tensors[tf_index], tf_index,
+                                         plan.pipelined_input_bytes[i]));
       void* current_src_ptr =
           (void*)DMAHelper::base(&tf_input_tensors[tf_index]);
 
       NG_TRACE("H2D_Input_" + std::to_string(tf_index), "", "");
 
       try {
-        ng_pipelined_inputs[i]->write(
-            current_src_ptr, ng_pipelined_inputs[i]->get_element_count() *
-                                 ng_element_type.size());
+        ng_pipelined_inputs[i]->write(current_src_ptr,
+                                      plan.pipelined_input_bytes[i]);
       } catch (const std::exception& exp) {
         return errors::Internal("Error copying TF tensor to device tensor: ",
                                 exp.what());
@@ -190,28 +203,25 @@ Status GetPipelinedIOTensorsReadyForExecution(
     // flag
 
     // Gives the TF input index : wrt to all inputs
-    auto pipelined_not_prefetched_input_indexes =
+    const auto& pipelined_not_prefetched_input_indexes =
         tensor_manager->GetPipelinedButNotPrefetchedInputIndexes();
 
     // Gives the corresponding pipelined input index : wrt pipelined
-    auto pipelined_input_indexes_not_prefetched =
+    const auto& pipelined_input_indexes_not_prefetched =
         tensor_manager->GetPipelinedInputIndexesThatAreNotPrefetched();
 
     // Gives the mapping for corresponding
     for (auto i = 0; i < pipelined_input_indexes_not_prefetched.size(); i++) {
       int tf_index = pipelined_not_prefetched_input_indexes[i];
       int ng_index = pipelined_input_indexes_not_prefetched[i];
-      ng::element::Type ng_element_type;
-      TF_RETURN_IF_ERROR(TFDataTypeToNGraphElementType(
-          tf_input_tensors[tf_index].dtype(), &ng_element_type));
+      TF_RETURN_IF_ERROR(CheckInputBytes(tf_input_tensors[tf_index], tf_index,
+                                         plan.pipelined_input_bytes[ng_index]));
       void* current_src_ptr =
           (void*)DMAHelper::base(&tf_input_tensors[tf_index]);
       NG_TRACE("H2D_Input_" + to_string(tf_index), "", "");
       try {
         ng_pipelined_inputs[ng_index]->write(
-            current_src_ptr,
-            ng_pipelined_inputs[ng_index]->get_element_count() *
-                ng_element_type.size());
+            current_src_ptr, plan.pipelined_input_bytes[ng_index]);
       } catch (const exception& exp) {
         return errors::Internal("Error copying TF tensor to device tensor: ",
                                 exp.what());
@@ -220,8 +230,9 @@ Status GetPipelinedIOTensorsReadyForExecution(
       }
     }
   }
-  pipelined_io_tensors = make_tuple(current_iter_pipeline_depth,
-                                    ng_pipelined_inputs, ng_pipelined_outputs);
+  pipelined_io_tensors =
+      make_tuple(current_iter_pipeline_depth, move(ng_pipelined_inputs),
+                 move(ng_pipelined_outputs));
 
   return Status::OK();
 }
@@ -251,35 +262,36 @@ Status GetIOTensorsReadyForExecution(
     vector<shared_ptr<ng::runtime::Tensor>>& ng_inputs,
     vector<shared_ptr<ng::runtime::Tensor>>& ng_outputs) {
   // Get Variables that are inputs
-  auto var_input_indexes = tensor_manager->GetInputIndexesFedByVariables();
-  for (int input_index : var_input_indexes) {
-    string shared_name;
-    TF_RETURN_IF_ERROR(
-        tensor_manager->GetInputVariableSharedName(input_index, &shared_name));
-    TF_RETURN_IF_ERROR(
-        GetTensorFromContext(ctx, shared_name, ng_inputs[input_index]));
+  const auto& var_input_indexes =
+      tensor_manager->GetInputIndexesFedByVariables();
+  const auto& var_input_shared_names =
+      tensor_manager->GetInputVariableSharedNames();
+  for (int i = 0; i < var_input_indexes.size(); i++) {
+    TF_RETURN_IF_ERROR(GetTensorFromContext(ctx, var_input_shared_names[i],
+                                            ng_inputs[var_input_indexes[i]]));
   }
 
   // Get Variables that are outputs
-  auto var_output_indexes =
+  const auto& var_output_indexes =
       tensor_manager->GetOutputIndexesAssigningVariables();
-  for (int output_index : var_output_indexes) {
-    string shared_name;
-    TF_RETURN_IF_ERROR(tensor_manager->GetOutputVariableSharedName(
-        output_index, &shared_name));
-    TF_RETURN_IF_ERROR(
-        GetTensorFromContext(ctx, shared_name, ng_outputs[output_index]));
+  const auto& var_output_shared_names =
+      tensor_manager->GetOutputVariableSharedNames();
+  for (int i = 0; i < var_output_indexes.size(); i++) {
+    TF_RETURN_IF_ERROR(GetTensorFromContext(ctx, var_output_shared_names[i],
+                                            ng_outputs[var_output_indexes[i]]));
   }
 
   // Fit Pipelined Input Tensors
-  auto pipelined_input_indexes = tensor_manager->GetPipelinedInputIndexes();
+  const auto& pipelined_input_indexes =
+      tensor_manager->GetPipelinedInputIndexes();
   for (int i = 0; i < pipelined_input_indexes.size(); i++) {
     int input_index = pipelined_input_indexes[i];
     ng_inputs[input_index] = pipelined_in_tensors[i];
   }
 
   // Fit Pipelined Output Tensors
-  auto pipelined_output_indexes = tensor_manager->GetPipelinedOutputIndexes();
+  const auto& pipelined_output_indexes =
+      tensor_manager->GetPipelinedOutputIndexes();
   for (int i = 0; i < pipelined_output_indexes.size(); i++) {
     int output_index = pipelined_output_indexes[i];
     ng_outputs[output_index] = pipelined_out_tensors[i];
@@ -295,24 +307,22 @@ Status SyncOutputVarTensors(
     const OpKernelContext* ctx,
     const shared_ptr<NGraphTensorManager>& tensor_manager) {
   // Get Variables that are outputs
-  auto var_output_indexes =
+  const auto& var_output_indexes =
       tensor_manager->GetOutputIndexesAssigningVariables();
+  const auto& var_output_shared_names =
+      tensor_manager->GetOutputVariableSharedNames();
+  const auto& var_output_update_tf_tensor =
+      tensor_manager->GetOutputVariablesUpdateTFTensor();
   NGRAPH_VLOG(4) << "output indexes size " << var_output_indexes.size();
 
-  for (int output_index : var_output_indexes) {
-    bool update_tf_tensor;
-    TF_RETURN_IF_ERROR(tensor_manager->GetOutputVariableUpdateTFTensor(
-        output_index, &update_tf_tensor));
-
-    if (update_tf_tensor) {
+  for (int i = 0; i < var_output_indexes.size(); i++) {
+    int output_index = var_output_indexes[i];
+    if (var_output_update_tf_tensor[i]) {
       NGRAPH_VLOG(4) << "Sync NG Output Variable Tensors " << output_index;
-      // Get shared name from tensor manager
-      string shared_name;
-      TF_RETURN_IF_ERROR(tensor_manager->GetOutputVariableSharedName(
-          output_index, &shared_name));
       NGraphVar* var;
       TF_RETURN_IF_ERROR(ctx->resource_manager()->Lookup<NGraphVar>(
-          ctx->resource_manager()->default_container(), shared_name, &var));
+          ctx->resource_manager()->default_container(),
+          var_output_shared_names[i], &var));
       // update tensor
       var->copy_ng_to_tf();
       var->Unref();
@@ -42,13 +42,14 @@ namespace ngraph_bridge {
 //               gets the tensors from prefetch object and adds the tensors from
 //               step 1 to the prefetch object
 // 3. Copies the tf input tensors that are not prefetched to the ngraph
-// pipelined input tensors
+// pipelined input tensors, sized by the execution plan
 //
 
 Status GetPipelinedIOTensorsReadyForExecution(
     OpKernelContext* ctx, const vector<Tensor>& tf_input_tensors,
     const shared_ptr<PipelinedTensorsStore>& pipelined_tensor_store,
     const shared_ptr<NGraphTensorManager>& tensor_manager,
+    const NGraphExecutionPlan& plan,
     tuple<int, PipelinedTensorVector, PipelinedTensorVector>&
         pipelined_io_tensors);
 
@@ -0,0 +1,271 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include "tensorflow/core/framework/attr_value_util.h"
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+
+#include "logging/ngraph_log.h"
+#include "ngraph_bridge/ngraph_executable_cache.h"
+
+using namespace std;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// The attributes of the node that make up its structure, sorted by name
+// (protobuf maps are not ordered)
+static std::vector<std::pair<string, const AttrValue*>> SortedAttrs(
+    const Node* node) {
+  std::vector<std::pair<string, const AttrValue*>> sorted_attrs;
+  for (const auto& attr : node->def().attr()) {
+    if (attr.first.empty() || attr.first[0] == '_') {
+      continue;
+    }
+    sorted_attrs.push_back(std::make_pair(attr.first, &attr.second));
+  }
+  std::sort(sorted_attrs.begin(), sorted_attrs.end());
+  return sorted_attrs;
+}
+
+// Hashes the op nodes of the graph, which are returned in reverse post
+// order. The hash of a node covers its op, its attributes and the hashes of
+// the nodes feeding it, so it stands for the whole subgraph above the node.
+static void HashOpNodes(const Graph* graph, std::vector<Node*>* op_nodes,
+                        std::vector<uint64>* node_hash) {
+  std::vector<Node*> order;
+  GetReversePostOrder(*graph, &order);
+
+  node_hash->assign(graph->num_node_ids(), 0);
+  std::vector<const Edge*> data_inputs;
+  std::vector<uint64> control_inputs;
+  for (auto node : order) {
+    if (!node->IsOp()) {
+      continue;
+    }
+    uint64 h = Hash64(node->type_string());
+
+    for (const auto& attr : SortedAttrs(node)) {
+      h = Hash64Combine(h, Hash64(attr.first));
+      h = Hash64Combine(h, AttrValueHash(*attr.second));
+    }
+
+    data_inputs.assign(node->num_inputs(), nullptr);
+    control_inputs.clear();
+    for (auto edge : node->in_edges()) {
+      if (edge->IsControlEdge()) {
+        control_inputs.push_back((*node_hash)[edge->src()->id()]);
+      } else {
+        data_inputs[edge->dst_input()] = edge;
+      }
+    }
+    for (auto edge : data_inputs) {
+      if (edge == nullptr) {
+        h = Hash64Combine(h, 0);
+        continue;
+      }
+      h = Hash64Combine(h, (*node_hash)[edge->src()->id()]);
+      h = Hash64Combine(h, edge->src_output());
+    }
+    std::sort(control_inputs.begin(), control_inputs.end());
+    for (auto control_hash : control_inputs) {
+      h = Hash64Combine(h, control_hash);
+    }
+
+    (*node_hash)[node->id()] = h;
+    op_nodes->push_back(node);
+  }
+}
+
+uint64 ComputeClusterHash(const Graph* graph) {
+  std::vector<Node*> op_nodes;
+  std::vector<uint64> node_hash;
+  HashOpNodes(graph, &op_nodes, &node_hash);
+
+  std::vector<uint64> op_node_hashes;
+  for (auto node : op_nodes) {
+    op_node_hashes.push_back(node_hash[node->id()]);
+  }
+  std::sort(op_node_hashes.begin(), op_node_hashes.end());
+  uint64 graph_hash = op_node_hashes.size();
+  for (auto h : op_node_hashes) {
+    graph_hash = Hash64Combine(graph_hash, h);
+  }
+  return graph_hash;
+}
+
+// The op nodes of the graph ordered by hash, and the position of each node
+// (by id) in that order
+static void CanonicalOrder(const Graph* graph, std::vector<Node*>* op_nodes,
+                           std::vector<int>* position) {
+  std::vector<uint64> node_hash;
+  HashOpNodes(graph, op_nodes, &node_hash);
+  std::stable_sort(op_nodes->begin(), op_nodes->end(),
+                   [&node_hash](const Node* a, const Node* b) {
+                     return node_hash[a->id()] < node_hash[b->id()];
+                   });
+  position->assign(graph->num_node_ids(), -1);
+  for (size_t i = 0; i < op_nodes->size(); i++) {
+    (*position)[(*op_nodes)[i]->id()] = i;
+  }
+}
+
+// Position of the source of each data input (-1 if missing) and its output,
+// and the sorted positions of the control inputs
+static void CanonicalInputs(const Node* node, const std::vector<int>& position,
+                            std::vector<std::pair<int, int>>* data_inputs,
+                            std::vector<int>* control_inputs) {
+  data_inputs->assign(node->num_inputs(), std::make_pair(-1, -1));
+  control_inputs->clear();
+  for (auto edge : node->in_edges()) {
+    if (edge->IsControlEdge()) {
+      control_inputs->push_back(position[edge->src()->id()]);
+    } else {
+      (*data_inputs)[edge->dst_input()] =
+          std::make_pair(position[edge->src()->id()], edge->src_output());
+    }
+  }
+  std::sort(control_inputs->begin(), control_inputs->end());
+}
+
+bool ClusterGraphsEqual(const Graph* a, const Graph* b) {
+  if (a == b) {
+    return true;
+  }
+  std::vector<Node*> a_nodes, b_nodes;
+  std::vector<int> a_position, b_position;
+  CanonicalOrder(a, &a_nodes, &a_position);
+  CanonicalOrder(b, &b_nodes, &b_position);
+  if (a_nodes.size() != b_nodes.size()) {
+    return false;
+  }
+
+  std::vector<std::pair<int, int>> a_data, b_data;
+  std::vector<int> a_control, b_control;
+  for (size_t i = 0; i < a_nodes.size(); i++) {
+    const Node* a_node = a_nodes[i];
+    const Node* b_node = b_nodes[i];
+    if (a_node->type_string() != b_node->type_string()) {
+      return false;
+    }
+    auto a_attrs = SortedAttrs(a_node);
+    auto b_attrs = SortedAttrs(b_node);
+    if (a_attrs.size() != b_attrs.size()) {
+      return false;
+    }
+    for (size_t j = 0; j < a_attrs.size(); j++) {
+      if (a_attrs[j].first != b_attrs[j].first ||
+          !AreAttrValuesEqual(*a_attrs[j].second, *b_attrs[j].second)) {
+        return false;
+      }
+    }
+    CanonicalInputs(a_node, a_position, &a_data, &a_control);
+    CanonicalInputs(b_node, b_position, &b_data, &b_control);
+    if (a_data != b_data || a_control != b_control) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Static initializers
+std::unordered_map<std::string, NGraphExecutableCache::Entry>
+    NGraphExecutableCache::s_entries;
+std::unordered_map<const ngraph::runtime::Executable*, std::string>
+    NGraphExecutableCache::s_keys;
+std::mutex NGraphExecutableCache::s_mutex;
+
+std::string NGraphExecutableCache::MakeKey(
+    const std::string& backend_name,
+    const std::map<std::string, std::string>& backend_config,
+    uint64 cluster_hash, const std::string& signature) {
+  // The config entries are length prefixed, so that no choice of names and
+  // values makes two configs look the same
+  std::string key = strings::StrCat(backend_name, "/");
+  for (const auto& config : backend_config) {
+    strings::StrAppend(&key, config.first.size(), ":", config.first,
+                       config.second.size(), ":", config.second);
+  }
+  strings::StrAppend(&key, "/", cluster_hash, "/", signature);
+  return key;
+}
+
+bool NGraphExecutableCache::Acquire(const std::string& key,
+                                    const Graph* graph, Item* item) {
+  std::lock_guard<std::mutex> guard(s_mutex);
+  auto it = s_entries.find(key);
+  if (it == s_entries.end()) {
+    return false;
+  }
+  if (!ClusterGraphsEqual(it->second.graph.get(), graph)) {
+    NGRAPH_VLOG(1) << "Cluster hash collision on " << key;
+    return false;
+  }
+  it->second.num_users++;
+  *item = it->second.item;
+  return true;
+}
+
+bool NGraphExecutableCache::Insert(const std::string& key,
+                                   std::shared_ptr<const Graph> graph,
+                                   Item* item) {
+  std::lock_guard<std::mutex> guard(s_mutex);
+  auto it = s_entries.find(key);
+  if (it != s_entries.end()) {
+    if (!ClusterGraphsEqual(it->second.graph.get(), graph.get())) {
+      // Another structure holds the key, this executable is not shared
+      NGRAPH_VLOG(1) << "Cluster hash collision on " << key;
+      return true;
+    }
+    it->second.num_users++;
+    *item = it->second.item;
+    return false;
+  }
+  s_entries[key] = Entry{*item, std::move(graph), 1};
+  s_keys[item->first.get()] = key;
+  return true;
+}
+
+bool NGraphExecutableCache::Release(
+    const std::shared_ptr<ngraph::runtime::Executable>& exec) {
+  std::lock_guard<std::mutex> guard(s_mutex);
+  auto key_it = s_keys.find(exec.get());
+  if (key_it == s_keys.end()) {
+    return true;
+  }
+  auto it = s_entries.find(key_it->second);
+  if (--it->second.num_users > 0) {
+    return false;
+  }
+  NGRAPH_VLOG(3) << "Evicting shared executable " << key_it->second;
+  s_entries.erase(it);
+  s_keys.erase(key_it);
+  return true;
+}
+
+size_t NGraphExecutableCache::Size() {
+  std::lock_guard<std::mutex> guard(s_mutex);
+  return s_entries.size();
+}
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
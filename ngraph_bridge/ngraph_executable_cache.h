@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef NGRAPH_TF_BRIDGE_EXECUTABLE_CACHE_H_
+#define NGRAPH_TF_BRIDGE_EXECUTABLE_CACHE_H_
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "tensorflow/core/graph/graph.h"
+
+#include "ngraph/ngraph.hpp"
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Hash of the structure of a cluster graph. Node names (and attributes
+// starting with '_', like _ngraph_cluster or _prov_tag) are ignored; op
+// types, the other attributes (data types, Const values, ...), the _Arg and
+// _Retval indices and the way the nodes are connected are not. Clusters
+// that hash the same translate to the same nGraph function.
+uint64 ComputeClusterHash(const Graph* graph);
+
+// Whether the graphs have the same structure, in the sense of
+// ComputeClusterHash, so that a hash collision is not taken for a match.
+// Graphs with several identical nodes may be found different even if they
+// are not, which only costs sharing.
+bool ClusterGraphsEqual(const Graph* a, const Graph* b);
+
+// Process wide cache of the executables compiled by the NGraphExecutors, so
+// that encapsulates of structurally identical clusters (repeated layers of a
+// model) compile once and share the executable. Entries are keyed by
+// backend, backend config, cluster hash and input signature (see MakeKey),
+// keep the cluster graph they were compiled from to check hits against, and
+// are reference counted by the executors using them.
+class NGraphExecutableCache {
+ public:
+  // Executable and serialized nGraph function
+  typedef std::pair<std::shared_ptr<ngraph::runtime::Executable>, std::string>
+      Item;
+
+  // backend_config is what the encapsulate passes to SetConfig
+  static std::string MakeKey(
+      const std::string& backend_name,
+      const std::map<std::string, std::string>& backend_config,
+      uint64 cluster_hash, const std::string& signature);
+
+  // If an executable has been compiled for key from a graph equal to graph,
+  // returns true and the cached item in *item, and counts one more user of
+  // it
+  static bool Acquire(const std::string& key, const Graph* graph, Item* item);
+
+  // Adds a newly compiled item. If another executor has added one for the
+  // same key and an equal graph in the meantime, *item is replaced by the
+  // cached one and false is returned: the caller then owns (and must remove)
+  // its own executable. If the key is taken by a different graph, the item
+  // is not cached.
+  static bool Insert(const std::string& key, std::shared_ptr<const Graph> graph,
+                     Item* item);
+
+  // Drops one user of the executable. Returns true if it was the last one
+  // (or if the executable was never shared), in which case the caller has
+  // to remove it from the backend.
+  static bool Release(const std::shared_ptr<ngraph::runtime::Executable>& exec);
+
+  // Number of executables currently cached
+  static size_t Size();
+
+ private:
+  struct Entry {
+    Item item;
+    std::shared_ptr<const Graph> graph;
+    int num_users;
+  };
+  static std::unordered_map<std::string, Entry> s_entries;
+  // Key of each cached executable, for Release
+  static std::unordered_map<const ngraph::runtime::Executable*, std::string>
+      s_keys;
+  static std::mutex s_mutex;
+};
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
+
+#endif  // NGRAPH_TF_BRIDGE_EXECUTABLE_CACHE_H_
@@ -38,6 +38,8 @@
 #include "ngraph_bridge/ngraph_builder.h"
 #include "ngraph_bridge/ngraph_cluster_manager.h"
 #include "ngraph_bridge/ngraph_data_cache.h"
+#include "ngraph_bridge/ngraph_elementwise_fusion.h"
+#include "ngraph_bridge/ngraph_executable_cache.h"
 #include "ngraph_bridge/ngraph_executor.h"
 #include "ngraph_bridge/ngraph_mark_for_clustering.h"
 #include "ngraph_bridge/ngraph_timer.h"
@@ -62,6 +64,14 @@ NGraphExecutor::NGraphExecutor(int instance_id, int cluster_id, int graph_id,
                                unique_ptr<tensorflow::Graph>& graph,
                                const string& backend_name,
                                const string& node_name, const int cache_depth)
+    : NGraphExecutor(instance_id, cluster_id, graph_id,
+                     std::shared_ptr<const Graph>(std::move(graph)),
+                     backend_name, node_name, cache_depth) {}
+
+NGraphExecutor::NGraphExecutor(int instance_id, int cluster_id, int graph_id,
+                               std::shared_ptr<const tensorflow::Graph> graph,
+                               const string& backend_name,
+                               const string& node_name, const int cache_depth)
     : m_instance_id(instance_id),
       m_ngraph_cluster_id(cluster_id),
       m_graph_id(graph_id),
@@ -101,6 +111,15 @@ NGraphExecutor::NGraphExecutor(int instance_id, int cluster_id, int graph_id,
   for (auto inp_index : static_input_indexes) {
     m_input_is_static[inp_index] = true;
   }
+
+  // Structurally identical clusters share their compiled executables
+  m_share_executables =
+      std::getenv("NGRAPH_TF_DISABLE_EXECUTABLE_SHARING") == nullptr;
+  if (m_share_executables) {
+    m_cluster_hash = ComputeClusterHash(m_graph.get());
+    NGRAPH_VLOG(3) << "NGraphExecutor(): " << instance_id
+                   << " Cluster hash: " << m_cluster_hash;
+  }
 }
 
 //---------------------------------------------------------------------------
@@ -115,6 +134,19 @@ NGraphExecutor::~NGraphExecutor() {
   m_tensor_manager.reset();
 }
 
+// Writes the part of the signature that depends on the input shapes, which
+// is all of it for graphs without static inputs
+static void WriteShapesSignature(const std::vector<TensorShape>& input_shapes,
+                                 std::stringstream& signature_ss) {
+  for (const auto& shape : input_shapes) {
+    for (const auto& x : shape) {
+      signature_ss << x.size << ",";
+    }
+    signature_ss << ";";
+  }
+  signature_ss << "/";
+}
+
 //---------------------------------------------------------------------------
 //  NGraphExecutor::ComputeSignature
 //---------------------------------------------------------------------------
@@ -126,15 +158,9 @@ Status NGraphExecutor::ComputeSignature(
   // Use tensorflow input tensors to get input_shapes, static_input_map
   // and compute the signature
   for (int i = 0; i < tf_input_tensors.size(); i++) {
-    const Tensor& input_tensor = tf_input_tensors[i];
-    input_shapes.push_back(input_tensor.shape());
-    for (const auto& x : input_tensor.shape()) {
-      signature_ss << x.size << ",";
-    }
-    signature_ss << ";";
+    input_shapes.push_back(tf_input_tensors[i].shape());
   }
-
-  signature_ss << "/";
+  WriteShapesSignature(input_shapes, signature_ss);
 
   static_input_map.resize(tf_input_tensors.size());
   for (int i = 0; i < tf_input_tensors.size(); i++) {
@@ -156,6 +182,17 @@ Status NGraphExecutor::GetExecutableFunctionAndTensors(
     std::shared_ptr<ngraph::runtime::Executable>& ng_exec,
     std::string& serialized_ng_func, shared_ptr<PipelinedTensorsStore>& pts,
     bool& cache_hit) {
+  shared_ptr<const NGraphExecutionPlan> plan;
+  return GetExecutableFunctionAndTensors(tf_input_tensors, ng_exec,
+                                         serialized_ng_func, pts, plan,
+                                         cache_hit);
+}
+
+Status NGraphExecutor::GetExecutableFunctionAndTensors(
+    const std::vector<Tensor>& tf_input_tensors,
+    std::shared_ptr<ngraph::runtime::Executable>& ng_exec,
+    std::string& serialized_ng_func, shared_ptr<PipelinedTensorsStore>& pts,
+    shared_ptr<const NGraphExecutionPlan>& plan, bool& cache_hit) {
   std::stringstream signature_ss;
   std::vector<TensorShape> input_shapes;
   std::vector<const Tensor*> static_input_map;
@@ -165,7 +202,57 @@ Status NGraphExecutor::GetExecutableFunctionAndTensors(
   signature = signature_ss.str();
 
   NGRAPH_VLOG(5) << "Computed signature: " << signature;
+  return LookUpOrCreateItem(signature, input_shapes, static_input_map, ng_exec,
+                            serialized_ng_func, pts, plan, cache_hit);
+}
 
+//---------------------------------------------------------------------------
+//  NGraphExecutor::Precompile
+//---------------------------------------------------------------------------
+Status NGraphExecutor::Precompile(
+    const std::vector<TensorShape>& input_shapes) {
+  if (m_do_aot) {
+    return Status::OK();
+  }
+  if (input_shapes.size() != m_input_is_static.size()) {
+    return errors::Internal("Precompile got ", input_shapes.size(),
+                            " input shapes for ", m_input_is_static.size(),
+                            " inputs");
+  }
+  // The signature of graphs with static inputs depends on the input values
+  for (auto is_static : m_input_is_static) {
+    if (is_static) {
+      NGRAPH_VLOG(3) << "Not precompiling " << m_node_name
+                     << ", it has static inputs";
+      return Status::OK();
+    }
+  }
+
+  // Same signature as ComputeSignature gives for tensors of these shapes
+  std::stringstream signature_ss;
+  WriteShapesSignature(input_shapes, signature_ss);
+
+  NGRAPH_VLOG(3) << "Precompiling " << m_node_name
+                 << " for signature: " << signature_ss.str();
+  std::vector<const Tensor*> static_input_map(input_shapes.size(), nullptr);
+  std::shared_ptr<ngraph::runtime::Executable> ng_exec;
+  std::string serialized_ng_func;
+  shared_ptr<PipelinedTensorsStore> pts;
+  shared_ptr<const NGraphExecutionPlan> plan;
+  bool cache_hit;
+  return LookUpOrCreateItem(signature_ss.str(), input_shapes, static_input_map,
+                            ng_exec, serialized_ng_func, pts, plan, cache_hit);
+}
+
+//---------------------------------------------------------------------------
+//  NGraphExecutor::LookUpOrCreateItem
+//---------------------------------------------------------------------------
+Status NGraphExecutor::LookUpOrCreateItem(
+    const std::string& signature, const std::vector<TensorShape>& input_shapes,
+    const std::vector<const Tensor*>& static_input_map,
+    std::shared_ptr<ngraph::runtime::Executable>& ng_exec,
+    std::string& serialized_ng_func, shared_ptr<PipelinedTensorsStore>& pts,
+    shared_ptr<const NGraphExecutionPlan>& plan, bool& cache_hit) {
   NGRAPH_VLOG(4) << "GetNgExecutable: Got backend of type: "
                  << m_op_backend_name;
   // Get the backend. Note that the backend may not be available
@@ -191,7 +278,8 @@ Status NGraphExecutor::GetExecutableFunctionAndTensors(
                                      destroy_ng_items_callback, cache_hit);
 
   if (status_ng_item_pair.first == Status::OK()) {
-    std::tie(ng_exec, serialized_ng_func, pts) = status_ng_item_pair.second;
+    std::tie(ng_exec, serialized_ng_func, pts, plan) =
+        status_ng_item_pair.second;
   }
   return status_ng_item_pair.first;
 }
@@ -200,7 +288,8 @@ Status NGraphExecutor::GetExecutableFunctionAndTensors(
 //  NGraphExecutor::CallbackCreateItem
 //---------------------------------------------------------------------------
 std::pair<Status, std::tuple<std::shared_ptr<ngraph::runtime::Executable>,
-                             std::string, shared_ptr<PipelinedTensorsStore>>>
+                             std::string, shared_ptr<PipelinedTensorsStore>,
+                             shared_ptr<const NGraphExecutionPlan>>>
 NGraphExecutor::CreateCallback(const std::string signature,
                                std::vector<TensorShape> input_shapes,
                                std::vector<const Tensor*> static_input_map,
@@ -209,13 +298,39 @@ NGraphExecutor::CreateCallback(const std::string signature,
   std::shared_ptr<ngraph::runtime::Executable> ng_exec;
   std::shared_ptr<ngraph::Function> ng_function;
   shared_ptr<PipelinedTensorsStore> pts;
+  shared_ptr<const NGraphExecutionPlan> plan;
   NGRAPH_VLOG(1) << "Compilation cache miss: " << m_node_name;
+
+  // Another encapsulate of the same structure may already have compiled
+  // this signature
+  bool share_executable = m_share_executables && !m_do_aot;
+  string shared_key;
+  if (share_executable) {
+    shared_key = NGraphExecutableCache::MakeKey(
+        m_op_backend_name, m_backend_config, m_cluster_hash, signature);
+    NGraphExecutableCache::Item item;
+    if (NGraphExecutableCache::Acquire(shared_key, m_graph.get(), &item)) {
+      NGRAPH_VLOG(1) << "Using shared executable for " << m_node_name;
+      std::tie(ng_exec, serialized_ng_func) = item;
+      auto status_ng_pts_pair = InitializeIOTensorPipeline(
+          ng_exec, m_tensor_manager->GetPipelinedInputIndexes(),
+          m_tensor_manager->GetPipelinedOutputIndexes());
+      pts = status_ng_pts_pair.second;
+      Status status = status_ng_pts_pair.first;
+      if (status.ok()) {
+        status = m_tensor_manager->MakeExecutionPlan(ng_exec, &plan);
+      }
+      return std::make_pair(
+          status, std::make_tuple(ng_exec, serialized_ng_func, pts, plan));
+    }
+  }
+
   if (!m_do_aot) {
     auto status = Builder::TranslateGraph(input_shapes, static_input_map,
                                           m_graph.get(), ng_function);
     if (status != Status::OK()) {
-      return std::make_pair(status,
-                            std::make_tuple(ng_exec, serialized_ng_func, pts));
+      return std::make_pair(
+          status, std::make_tuple(ng_exec, serialized_ng_func, pts, plan));
     }
     ng_function->set_friendly_name(m_node_name);
     int json_indentation = 4;
@@ -227,7 +342,7 @@ NGraphExecutor::CreateCallback(const std::string signature,
           errors::Internal(
               "Expected to find AOT precompiled ng function of signature: ",
               signature),
-          std::make_tuple(ng_exec, serialized_ng_func, pts));
+          std::make_tuple(ng_exec, serialized_ng_func, pts, plan));
     }
     serialized_ng_func = itr->second;
   }
@@ -241,30 +356,49 @@ NGraphExecutor::CreateCallback(const std::string signature,
         "tf_function_" + m_node_name + "_" + to_string(rank_id) + ".json",
         serialized_ng_func);
     if (status != Status::OK()) {
-      return std::make_pair(status,
-                            std::make_tuple(ng_exec, serialized_ng_func, pts));
+      return std::make_pair(
+          status, std::make_tuple(ng_exec, serialized_ng_func, pts, plan));
     }
 #else
     auto status_ser = StringToFile("tf_function_" + m_node_name + ".json",
                                    serialized_ng_func);
     if (status_ser != Status::OK()) {
-      return std::make_pair(status_ser,
-                            std::make_tuple(ng_exec, serialized_ng_func, pts));
+      return std::make_pair(
+          status_ser, std::make_tuple(ng_exec, serialized_ng_func, pts, plan));
     }
 #endif
   }
+  // Fuse after serializing: the serialized function stays loadable on any
+  // backend
+  if (!m_do_aot && IsElementwiseFusionEnabled(op_backend)) {
+    FuseElementwise(ng_function);
+  }
+
   // Get NgExecutable
   auto status_ng_exec_pair =
       GetNgExecutable(signature, ng_function, op_backend);
   // Create PipelinedTensorStore
   if (status_ng_exec_pair.first == Status::OK()) {
     ng_exec = status_ng_exec_pair.second;
+    if (share_executable) {
+      NGraphExecutableCache::Item item =
+          std::make_pair(ng_exec, serialized_ng_func);
+      if (!NGraphExecutableCache::Insert(shared_key, m_graph, &item)) {
+        // Compiled concurrently by another encapsulate, use that one
+        op_backend->remove_compiled_function(ng_exec);
+        std::tie(ng_exec, serialized_ng_func) = item;
+      }
+    }
     auto status_ng_pts_pair = InitializeIOTensorPipeline(
         ng_exec, m_tensor_manager->GetPipelinedInputIndexes(),
         m_tensor_manager->GetPipelinedOutputIndexes());
     pts = status_ng_pts_pair.second;
-    return std::make_pair(status_ng_pts_pair.first,
-                          std::make_tuple(ng_exec, serialized_ng_func, pts));
+    Status status = status_ng_pts_pair.first;
+    if (status.ok()) {
+      status = m_tensor_manager->MakeExecutionPlan(ng_exec, &plan);
+    }
+    return std::make_pair(
+        status, std::make_tuple(ng_exec, serialized_ng_func, pts, plan));
   } else {
     Status st = StringToFile("tf_function_error_" + m_node_name + ".json",
                              serialized_ng_func);
@@ -273,8 +407,9 @@ NGraphExecutor::CreateCallback(const std::string signature,
         status_ng_exec_pair.first.error_message() +
         (st.ok() ? "" : (" Also error in dumping serialized function: " +
                          st.error_message()));
-    return std::make_pair(errors::Internal(status_string),
-                          std::make_tuple(ng_exec, serialized_ng_func, pts));
+    return std::make_pair(
+        errors::Internal(status_string),
+        std::make_tuple(ng_exec, serialized_ng_func, pts, plan));
   }
 }
 
@@ -327,13 +462,18 @@ NGraphExecutor::GetNgExecutable(std::string signature,
 //---------------------------------------------------------------------------
 void NGraphExecutor::DestroyCallback(
     std::tuple<std::shared_ptr<ngraph::runtime::Executable>, std::string,
-               shared_ptr<PipelinedTensorsStore>>
+               shared_ptr<PipelinedTensorsStore>,
+               shared_ptr<const NGraphExecutionPlan>>
         evicted_ng_item,
     ng::runtime::Backend*& op_backend) {
   std::shared_ptr<ngraph::runtime::Executable> evicted_ng_exec;
-  std::tie(evicted_ng_exec, std::ignore, std::ignore) = evicted_ng_item;
-  // Call delete function here for the erased func
-  op_backend->remove_compiled_function(evicted_ng_exec);
+  std::tie(evicted_ng_exec, std::ignore, std::ignore, std::ignore) =
+      evicted_ng_item;
+  // Call delete function here for the erased func, unless other encapsulates
+  // are still using it
+  if (NGraphExecutableCache::Release(evicted_ng_exec)) {
+    op_backend->remove_compiled_function(evicted_ng_exec);
+  }
   evicted_ng_exec.reset();
 }
 
@@ -388,6 +528,7 @@ Status NGraphExecutor::ParseNodeAttributes(
                        << " Value: " << attr_value;
         additional_attribute_map->insert(
             {attr_name.substr(strlen("_ngraph_")), attr_value});
+        m_backend_config[attr_name.substr(strlen("_ngraph_"))] = attr_value;
       }
     }
   }
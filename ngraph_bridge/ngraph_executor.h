@@ -28,6 +28,7 @@
 #include "ngraph/ngraph.hpp"
 
 #include "logging/ngraph_log.h"
+#include "ngraph_bridge/ngraph_builder.h"
 #include "ngraph_bridge/ngraph_data_cache.h"
 #include "ngraph_bridge/ngraph_pipelined_tensors.h"
 #include "ngraph_bridge/ngraph_tensor_manager.h"
@@ -44,6 +45,13 @@ class NGraphExecutor {
                           const string& backend_name, const string& node_name,
                           const int cache_depth);
 
+  // The graph is only read, so it can be shared with the other kernels of
+  // the cluster (see NGraphClusterManager::GetClusterTFGraph)
+  explicit NGraphExecutor(int instance_id, int cluster_id, int graph_id,
+                          std::shared_ptr<const tensorflow::Graph> graph,
+                          const string& backend_name, const string& node_name,
+                          const int cache_depth);
+
   ~NGraphExecutor();
 
   // Calls Compute Signature and gets ngraph executable
@@ -55,16 +63,30 @@ class NGraphExecutor {
       std::string& serialized_ng_function,
       shared_ptr<PipelinedTensorsStore>& pts, bool& cache_hit);
 
+  // Also gets the execution plan of the executable
+  Status GetExecutableFunctionAndTensors(
+      const std::vector<Tensor>& tf_input_tensors,
+      std::shared_ptr<ngraph::runtime::Executable>& ng_exec,
+      std::string& serialized_ng_function,
+      shared_ptr<PipelinedTensorsStore>& pts,
+      shared_ptr<const NGraphExecutionPlan>& plan, bool& cache_hit);
+
+  // Compiles the graph for inputs of the given shapes ahead of the first
+  // GetExecutableFunctionAndTensors call for them, and allocates the
+  // pipelined tensors. Does nothing for graphs with static inputs.
+  Status Precompile(const std::vector<TensorShape>& input_shapes);
+
   // TODO Rename this to DecodeAttributes
   Status ParseNodeAttributes(
       const google::protobuf::Map<string, AttrValue>& additional_attributes,
       std::unordered_map<std::string, std::string>* additional_attribute_map);
 
   // Callback function called from NgraphDataCache's LookUpOrCreateItem() method
-  // Creates ng_executable, serialized_ng_function, and initializes I/O
-  // TensorPipeline
+  // Creates ng_executable, serialized_ng_function, initializes I/O
+  // TensorPipeline and makes the execution plan
   std::pair<Status, std::tuple<std::shared_ptr<ngraph::runtime::Executable>,
-                               std::string, shared_ptr<PipelinedTensorsStore>>>
+                               std::string, shared_ptr<PipelinedTensorsStore>,
+                               shared_ptr<const NGraphExecutionPlan>>>
   CreateCallback(std::string signature, std::vector<TensorShape> input_shapes,
                  std::vector<const Tensor*> static_input_map,
                  ng::runtime::Backend*& op_backend);
@@ -73,7 +95,8 @@ class NGraphExecutor {
 
   void DestroyCallback(
       std::tuple<std::shared_ptr<ngraph::runtime::Executable>, std::string,
-                 shared_ptr<PipelinedTensorsStore>>
+                 shared_ptr<PipelinedTensorsStore>,
+                 shared_ptr<const NGraphExecutionPlan>>
           evicted_ng_item,
       ng::runtime::Backend*& op_backend);
   const string& GetNgraphClusterName() { return m_node_name; }
@@ -107,6 +130,16 @@ class NGraphExecutor {
       const vector<int>& pipelined_input_indexes,
       const vector<int>& pipelined_output_indexes);
 
+  // Looks up the items for the signature in m_ng_data_cache, creating them
+  // on a miss
+  Status LookUpOrCreateItem(
+      const std::string& signature,
+      const std::vector<TensorShape>& input_shapes,
+      const std::vector<const Tensor*>& static_input_map,
+      std::shared_ptr<ngraph::runtime::Executable>& ng_exec,
+      std::string& serialized_ng_func, shared_ptr<PipelinedTensorsStore>& pts,
+      shared_ptr<const NGraphExecutionPlan>& plan, bool& cache_hit);
+
   // Get tensorflow input tensors, input shapes, static_inputs to Compute
   // Signature
   Status ComputeSignature(const std::vector<Tensor>& tf_input_tensors,
@@ -118,7 +151,7 @@ class NGraphExecutor {
   const int m_instance_id;
   const int m_ngraph_cluster_id{-1};
   const int m_graph_id{-1};
-  const unique_ptr<Graph> m_graph;
+  const std::shared_ptr<const Graph> m_graph;
 
   const string m_op_backend_name;
   string m_node_name;
@@ -129,14 +162,25 @@ class NGraphExecutor {
   map<string, string> m_aot_execs;
 
   // NgraphDataCache<Key, Value> where key is signature, and value is a tuple
-  // of ng_executable, serialized_ng_function and PipelinedTensorsStore
+  // of ng_executable, serialized_ng_function, PipelinedTensorsStore and
+  // NGraphExecutionPlan
   NgraphDataCache<std::string,
                   std::tuple<std::shared_ptr<ngraph::runtime::Executable>,
-                             std::string, shared_ptr<PipelinedTensorsStore>>>
+                             std::string, shared_ptr<PipelinedTensorsStore>,
+                             shared_ptr<const NGraphExecutionPlan>>>
       m_ng_data_cache;
 
   bool m_executable_can_create_tensor;
 
+  // Whether executables are shared with the executors of structurally
+  // identical clusters (see NGraphExecutableCache), and the hash of m_graph
+  // identifying them
+  bool m_share_executables = false;
+  uint64 m_cluster_hash = 0;
+  // The backend config of the encapsulate (see ParseNodeAttributes), which
+  // the executables are compiled under
+  std::map<std::string, std::string> m_backend_config;
+
   mutex m_mutex;
   int m_depth{2};  // TODO make this settable
 
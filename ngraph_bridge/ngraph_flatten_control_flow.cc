@@ -0,0 +1,844 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+
+#include "logging/ngraph_log.h"
+#include "ngraph_bridge/ngraph_flatten_control_flow.h"
+
+using namespace std;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Loops with more iterations (or that would create more nodes) are left alone
+static const int64 MAX_UNROLLED_ITERATIONS = 256;
+static const int64 MAX_UNROLLED_NODES = 50000;
+
+namespace {
+
+// (node, output index)
+using TensorSource = std::pair<Node*, int>;
+
+bool IsRefOp(const Node* node) {
+  return node->type_string().compare(0, 3, "Ref") == 0;
+}
+
+// Whether the node can be executed unconditionally (if-conversion) or cloned
+// (unrolling) without changing what the graph does
+bool CanSpeculate(const Node* node, const std::set<string>& skip_these_nodes) {
+  return node->IsOp() && !node->IsControlFlow() && !node->IsLoopCond() &&
+         !node->IsControlTrigger() && !node->op_def().is_stateful() &&
+         skip_these_nodes.find(node->name()) == skip_these_nodes.end();
+}
+
+// True if the node has control inputs other than the source node
+bool HasControlInputs(const Node* node) {
+  for (const Edge* edge : node->in_edges()) {
+    if (edge->IsControlEdge() && !edge->src()->IsSource()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Moves the out edges of `node` to `replacement`: data edges of output i to
+// output i of the replacement, control edges to control edges
+void ReplaceOutEdges(Graph* graph, Node* node, Node* replacement) {
+  std::vector<const Edge*> out_edges(node->out_edges().begin(),
+                                     node->out_edges().end());
+  for (const Edge* edge : out_edges) {
+    if (edge->IsControlEdge()) {
+      graph->AddControlEdge(replacement, edge->dst());
+    } else {
+      graph->AddEdge(replacement, edge->src_output(), edge->dst(),
+                     edge->dst_input());
+    }
+    graph->RemoveEdge(edge);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Conditionals
+//------------------------------------------------------------------------------
+
+// A tf.cond: the Switch nodes sharing one predicate tensor, the ops of its two
+// branches and the Merge nodes joining them
+struct CondRegion {
+  TensorSource predicate;
+  std::vector<Node*> switches;
+  // indexed by the Switch output feeding the branch: 0 false, 1 true
+  std::set<Node*> branch[2];
+  std::vector<Node*> merges;
+  // for each Merge, its input edges from the false and true branches
+  std::vector<std::pair<const Edge*, const Edge*>> merge_inputs;
+};
+
+// Collects the branches and Merge nodes of region->switches. Returns false if
+// the region cannot be if-converted.
+bool CollectCondRegion(const std::set<string>& skip_these_nodes,
+                       CondRegion* region) {
+  std::set<Node*> switches(region->switches.begin(), region->switches.end());
+  std::set<Node*> merges;
+
+  for (int port = 0; port < 2; port++) {
+    std::deque<Node*> queue;
+    auto visit = [&](Node* node) {
+      if (node->IsSink()) {
+        return true;
+      }
+      if (node->IsMerge()) {
+        merges.insert(node);
+        return true;
+      }
+      if (!CanSpeculate(node, skip_these_nodes)) {
+        return false;
+      }
+      if (region->branch[port].insert(node).second) {
+        queue.push_back(node);
+      }
+      return true;
+    };
+
+    // The control output of a Switch is alive whenever its input is, so only
+    // the data edges start a branch
+    for (Node* node : region->switches) {
+      for (const Edge* edge : node->out_edges()) {
+        if (!edge->IsControlEdge() && edge->src_output() == port &&
+            !visit(edge->dst())) {
+          return false;
+        }
+      }
+    }
+    while (!queue.empty()) {
+      Node* node = queue.front();
+      queue.pop_front();
+      for (const Edge* edge : node->out_edges()) {
+        if (!visit(edge->dst())) {
+          return false;
+        }
+      }
+    }
+  }
+
+  // A node in both branches would be dead whichever branch is taken
+  for (Node* node : region->branch[0]) {
+    if (region->branch[1].count(node)) {
+      return false;
+    }
+  }
+
+  // Branch of the tensor feeding a Merge, -1 if it is not from this region
+  auto get_branch = [&](const Edge* edge) {
+    if (switches.count(edge->src())) {
+      return edge->src_output();
+    }
+    for (int port = 0; port < 2; port++) {
+      if (region->branch[port].count(edge->src())) {
+        return port;
+      }
+    }
+    return -1;
+  };
+
+  for (Node* merge : merges) {
+    if (IsRefOp(merge) || HasControlInputs(merge)) {
+      return false;
+    }
+    const Edge* inputs[2] = {nullptr, nullptr};
+    for (const Edge* edge : merge->in_edges()) {
+      if (edge->IsControlEdge()) {
+        continue;
+      }
+      int port = get_branch(edge);
+      if (port < 0 || inputs[port] != nullptr) {
+        return false;
+      }
+      inputs[port] = edge;
+    }
+    if (inputs[0] == nullptr || inputs[1] == nullptr) {
+      return false;
+    }
+    // value_index has no equivalent once both branches are computed
+    for (const Edge* edge : merge->out_edges()) {
+      if (!edge->IsControlEdge() && edge->src_output() == 1) {
+        return false;
+      }
+    }
+    region->merges.push_back(merge);
+    region->merge_inputs.push_back(std::make_pair(inputs[0], inputs[1]));
+  }
+  return !region->merges.empty();
+}
+
+// Replaces the Merge nodes of the region with Select nodes and bypasses its
+// Switch nodes
+Status ConvertCondRegion(Graph* graph, const CondRegion& region) {
+  std::set<Node*> switches(region.switches.begin(), region.switches.end());
+  // A Switch forwards its data input on either output
+  auto get_source = [&](const Edge* edge, TensorSource* source) -> Status {
+    if (switches.count(edge->src())) {
+      const Edge* data_edge;
+      TF_RETURN_IF_ERROR(edge->src()->input_edge(0, &data_edge));
+      *source = TensorSource(data_edge->src(), data_edge->src_output());
+    } else {
+      *source = TensorSource(edge->src(), edge->src_output());
+    }
+    return Status::OK();
+  };
+
+  for (size_t i = 0; i < region.merges.size(); i++) {
+    Node* merge = region.merges[i];
+    TensorSource false_value, true_value;
+    TF_RETURN_IF_ERROR(get_source(region.merge_inputs[i].first, &false_value));
+    TF_RETURN_IF_ERROR(get_source(region.merge_inputs[i].second, &true_value));
+
+    Node* select;
+    TF_RETURN_IF_ERROR(
+        NodeBuilder(merge->name(), "Select")
+            .Input(region.predicate.first, region.predicate.second)
+            .Input(true_value.first, true_value.second)
+            .Input(false_value.first, false_value.second)
+            .Device(merge->requested_device())
+            .Finalize(graph, &select));
+    select->set_assigned_device_name(merge->assigned_device_name());
+    NGRAPH_VLOG(4) << "Replacing " << merge->name() << " [Merge] with Select";
+
+    ReplaceOutEdges(graph, merge, select);
+    graph->RemoveNode(merge);
+  }
+
+  for (Node* node : region.switches) {
+    const Edge* data_edge;
+    TF_RETURN_IF_ERROR(node->input_edge(0, &data_edge));
+    Node* data = data_edge->src();
+    std::vector<Node*> control_inputs;
+    for (const Edge* edge : node->in_edges()) {
+      if (edge->IsControlEdge()) {
+        control_inputs.push_back(edge->src());
+      }
+    }
+
+    std::vector<const Edge*> out_edges(node->out_edges().begin(),
+                                       node->out_edges().end());
+    for (const Edge* edge : out_edges) {
+      if (edge->IsControlEdge()) {
+        graph->AddControlEdge(data, edge->dst());
+      } else {
+        graph->AddEdge(data, data_edge->src_output(), edge->dst(),
+                       edge->dst_input());
+      }
+      for (Node* control_input : control_inputs) {
+        graph->AddControlEdge(control_input, edge->dst());
+      }
+    }
+    graph->RemoveNode(node);
+  }
+  return Status::OK();
+}
+
+// If-converts the conditionals that can be. Sets *changed if any was.
+Status FlattenConditionals(Graph* graph,
+                           const std::set<string>& skip_these_nodes,
+                           bool* changed) {
+  // Switch nodes grouped by predicate, keyed by (node id, output) so that the
+  // order of the rewrites does not depend on pointer values
+  std::map<std::pair<int, int>, CondRegion> regions;
+  for (Node* node : graph->op_nodes()) {
+    if (!node->IsSwitch() || IsRefOp(node)) {
+      continue;
+    }
+    const Edge* pred_edge;
+    TF_RETURN_IF_ERROR(node->input_edge(1, &pred_edge));
+    // Loop switches are handled by FlattenLoops
+    if (pred_edge->src()->IsLoopCond()) {
+      continue;
+    }
+    regions[std::make_pair(pred_edge->src()->id(), pred_edge->src_output())]
+        .switches.push_back(node);
+  }
+
+  for (auto& it : regions) {
+    CondRegion& region = it.second;
+    // The predicate may be the Merge of a region converted before this one,
+    // replaced by a Select since
+    const Edge* pred_edge;
+    TF_RETURN_IF_ERROR(region.switches[0]->input_edge(1, &pred_edge));
+    region.predicate = TensorSource(pred_edge->src(), pred_edge->src_output());
+    if (!CollectCondRegion(skip_these_nodes, &region)) {
+      NGRAPH_VLOG(3) << "Cannot if-convert conditional on "
+                     << region.predicate.first->name();
+      continue;
+    }
+    NGRAPH_VLOG(3) << "If-converting conditional on "
+                   << region.predicate.first->name() << ": "
+                   << region.branch[0].size() + region.branch[1].size()
+                   << " ops, " << region.merges.size() << " outputs";
+    TF_RETURN_IF_ERROR(ConvertCondRegion(graph, region));
+    *changed = true;
+  }
+  return Status::OK();
+}
+
+//------------------------------------------------------------------------------
+// Loops
+//------------------------------------------------------------------------------
+
+// A while loop frame. The vectors below Enter are indexed by loop variable.
+struct LoopFrame {
+  string name;
+  // Enter nodes of the loop invariants (is_constant = true)
+  std::vector<Node*> invariants;
+  std::vector<Node*> enters;
+  std::vector<Node*> merges;
+  std::vector<Node*> switches;
+  std::vector<Node*> next_iterations;
+  std::vector<Node*> exits;
+  Node* loop_cond = nullptr;
+  // ops computing the loop condition
+  std::set<Node*> cond;
+  // ops of the loop body, not including the NextIteration nodes
+  std::set<Node*> body;
+};
+
+// Gets the single consumer of the given output of the node, nullptr if there
+// is not exactly one
+Node* GetSingleConsumer(const Node* node, int output) {
+  Node* consumer = nullptr;
+  for (const Edge* edge : node->out_edges()) {
+    if (edge->IsControlEdge() || edge->src_output() != output) {
+      continue;
+    }
+    if (consumer != nullptr) {
+      return nullptr;
+    }
+    consumer = edge->dst();
+  }
+  return consumer;
+}
+
+// Checks the structure of the frame (Enter -> Merge -> Switch -> Exit for
+// each loop variable, NextIteration -> Merge for the back edge) and collects
+// the ops of its condition and body. Returns false if it cannot be unrolled.
+bool CollectLoopFrame(const std::set<string>& skip_these_nodes,
+                      LoopFrame* frame) {
+  for (Node* node : frame->invariants) {
+    if (IsRefOp(node) || HasControlInputs(node)) {
+      return false;
+    }
+  }
+
+  std::set<Node*> frame_switches;
+  std::set<Node*> frame_next_iterations;
+  for (Node* enter : frame->enters) {
+    if (IsRefOp(enter) || HasControlInputs(enter)) {
+      return false;
+    }
+    for (const Edge* edge : enter->out_edges()) {
+      if (edge->IsControlEdge()) {
+        return false;
+      }
+    }
+    Node* merge = GetSingleConsumer(enter, 0);
+    if (merge == nullptr || !merge->IsMerge() || IsRefOp(merge) ||
+        HasControlInputs(merge) || merge->num_inputs() != 2) {
+      return false;
+    }
+    Node* next_iteration = nullptr;
+    for (const Edge* edge : merge->in_edges()) {
+      if (!edge->IsControlEdge() && edge->src() != enter) {
+        next_iteration = edge->src();
+      }
+    }
+    if (next_iteration == nullptr || !next_iteration->IsNextIteration() ||
+        HasControlInputs(next_iteration)) {
+      return false;
+    }
+
+    Node* switch_node = nullptr;
+    for (const Edge* edge : merge->out_edges()) {
+      if (!edge->IsControlEdge() && edge->src_output() == 1) {
+        return false;
+      }
+      if (!edge->IsControlEdge() && edge->dst()->IsSwitch()) {
+        if (switch_node != nullptr) {
+          return false;
+        }
+        switch_node = edge->dst();
+      }
+    }
+    if (switch_node == nullptr || IsRefOp(switch_node) ||
+        HasControlInputs(switch_node)) {
+      return false;
+    }
+    const Edge* pred_edge;
+    if (!switch_node->input_edge(1, &pred_edge).ok() ||
+        !pred_edge->src()->IsLoopCond()) {
+      return false;
+    }
+    if (frame->loop_cond == nullptr) {
+      frame->loop_cond = pred_edge->src();
+    } else if (frame->loop_cond != pred_edge->src()) {
+      return false;
+    }
+
+    Node* exit = GetSingleConsumer(switch_node, 0);
+    if (exit == nullptr || !exit->IsExit() || IsRefOp(exit)) {
+      return false;
+    }
+    for (const Edge* edge : switch_node->out_edges()) {
+      if (edge->IsControlEdge()) {
+        return false;
+      }
+    }
+
+    frame->merges.push_back(merge);
+    frame->switches.push_back(switch_node);
+    frame->next_iterations.push_back(next_iteration);
+    frame->exits.push_back(exit);
+    frame_switches.insert(switch_node);
+    frame_next_iterations.insert(next_iteration);
+  }
+  if (frame->loop_cond == nullptr || HasControlInputs(frame->loop_cond)) {
+    return false;
+  }
+
+  // The condition: everything computed from the Merge nodes before the Switch
+  // nodes. It must only feed the LoopCond.
+  {
+    std::deque<Node*> queue;
+    auto visit = [&](Node* node) {
+      if (node->IsSink() || node == frame->loop_cond ||
+          frame_switches.count(node)) {
+        return true;
+      }
+      if (!CanSpeculate(node, skip_these_nodes)) {
+        return false;
+      }
+      if (frame->cond.insert(node).second) {
+        queue.push_back(node);
+      }
+      return true;
+    };
+    for (Node* merge : frame->merges) {
+      for (const Edge* edge : merge->out_edges()) {
+        if (!visit(edge->dst())) {
+          return false;
+        }
+      }
+    }
+    while (!queue.empty()) {
+      Node* node = queue.front();
+      queue.pop_front();
+      for (const Edge* edge : node->out_edges()) {
+        if (frame_switches.count(edge->dst()) || !visit(edge->dst())) {
+          return false;
+        }
+      }
+    }
+    for (const Edge* edge : frame->loop_cond->out_edges()) {
+      if (!frame_switches.count(edge->dst()) && !edge->dst()->IsSink()) {
+        return false;
+      }
+    }
+  }
+
+  // The body: everything computed from the true outputs of the Switch nodes,
+  // up to the NextIteration nodes
+  {
+    std::deque<Node*> queue;
+    auto visit = [&](Node* node) {
+      if (node->IsSink() || frame_next_iterations.count(node)) {
+        return true;
+      }
+      if (!CanSpeculate(node, skip_these_nodes) || frame->cond.count(node)) {
+        return false;
+      }
+      if (frame->body.insert(node).second) {
+        queue.push_back(node);
+      }
+      return true;
+    };
+    for (Node* switch_node : frame->switches) {
+      for (const Edge* edge : switch_node->out_edges()) {
+        if (edge->src_output() == 1 && !visit(edge->dst())) {
+          return false;
+        }
+      }
+    }
+    while (!queue.empty()) {
+      Node* node = queue.front();
+      queue.pop_front();
+      for (const Edge* edge : node->out_edges()) {
+        if (!visit(edge->dst())) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Gets the value of an integer scalar constant, looking through Identity and
+// loop invariant Enter nodes
+bool GetConstScalar(const Node* node, int64* value) {
+  while (node->type_string() == "Identity" ||
+         (node->IsEnter() && !IsRefOp(node))) {
+    if (node->IsEnter()) {
+      bool is_constant = false;
+      if (!GetNodeAttr(node->attrs(), "is_constant", &is_constant).ok() ||
+          !is_constant) {
+        return false;
+      }
+    }
+    const Edge* edge;
+    if (!node->input_edge(0, &edge).ok()) {
+      return false;
+    }
+    node = edge->src();
+  }
+  if (node->type_string() != "Const") {
+    return false;
+  }
+  const TensorProto* proto;
+  Tensor tensor;
+  if (!GetNodeAttr(node->attrs(), "value", &proto).ok() ||
+      !tensor.FromProto(*proto) || tensor.NumElements() != 1) {
+    return false;
+  }
+  if (tensor.dtype() == DT_INT32) {
+    *value = tensor.flat<int32>()(0);
+  } else if (tensor.dtype() == DT_INT64) {
+    *value = tensor.flat<int64>()(0);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Gets the initial value and the increment of a loop variable that is a
+// counter: starts at a constant and is incremented by a positive constant
+bool GetCounter(const LoopFrame& frame, int var, int64* start, int64* step) {
+  const Edge* edge;
+  if (!frame.enters[var]->input_edge(0, &edge).ok() ||
+      !GetConstScalar(edge->src(), start)) {
+    return false;
+  }
+
+  // next = Add(var, step), var being the true output of the Switch, possibly
+  // through an Identity
+  if (!frame.next_iterations[var]->input_edge(0, &edge).ok()) {
+    return false;
+  }
+  const Node* add = edge->src();
+  if (add->type_string() != "Add" && add->type_string() != "AddV2") {
+    return false;
+  }
+  auto is_var = [&](const Edge* input) {
+    const Node* src = input->src();
+    if (src->type_string() == "Identity" && src->input_edge(0, &input).ok()) {
+      src = input->src();
+    }
+    return src == frame.switches[var] && input->src_output() == 1;
+  };
+  for (int i = 0; i < 2; i++) {
+    const Edge* var_edge;
+    const Edge* step_edge;
+    if (add->input_edge(i, &var_edge).ok() &&
+        add->input_edge(1 - i, &step_edge).ok() && is_var(var_edge) &&
+        GetConstScalar(step_edge->src(), step)) {
+      return *step > 0;
+    }
+  }
+  return false;
+}
+
+// Gets the number of iterations for which the condition computed by `node`
+// holds
+bool GetTripCount(const LoopFrame& frame, const Node* node,
+                  int64* trip_count) {
+  const Edge* lhs;
+  const Edge* rhs;
+  if (!node->input_edge(0, &lhs).ok() || !node->input_edge(1, &rhs).ok()) {
+    return false;
+  }
+
+  if (node->type_string() == "LogicalAnd") {
+    int64 lhs_count, rhs_count;
+    if (!GetTripCount(frame, lhs->src(), &lhs_count) ||
+        !GetTripCount(frame, rhs->src(), &rhs_count)) {
+      return false;
+    }
+    *trip_count = std::min(lhs_count, rhs_count);
+    return true;
+  }
+
+  bool is_less = node->type_string() == "Less";
+  if (!is_less && node->type_string() != "LessEqual") {
+    return false;
+  }
+  auto var_it = std::find(frame.merges.begin(), frame.merges.end(), lhs->src());
+  int64 limit, start, step;
+  if (var_it == frame.merges.end() || lhs->src_output() != 0 ||
+      !GetConstScalar(rhs->src(), &limit) ||
+      !GetCounter(frame, var_it - frame.merges.begin(), &start, &step)) {
+    return false;
+  }
+  if (!is_less) {
+    limit++;
+  }
+  *trip_count = limit > start ? (limit - start + step - 1) / step : 0;
+  return true;
+}
+
+// Replaces the frame with trip_count copies of its body
+Status UnrollLoopFrame(Graph* graph, const LoopFrame& frame,
+                       int64 trip_count) {
+  std::map<Node*, int> switch_index;
+  for (size_t i = 0; i < frame.switches.size(); i++) {
+    switch_index[frame.switches[i]] = i;
+  }
+  std::map<Node*, TensorSource> invariant_source;
+  for (Node* node : frame.invariants) {
+    const Edge* edge;
+    TF_RETURN_IF_ERROR(node->input_edge(0, &edge));
+    invariant_source[node] = TensorSource(edge->src(), edge->src_output());
+  }
+
+  // Body ops in topological order
+  std::vector<Node*> body_order;
+  {
+    std::unordered_map<Node*, int> pending_inputs;
+    std::deque<Node*> ready;
+    for (Node* node : frame.body) {
+      int count = 0;
+      for (const Edge* edge : node->in_edges()) {
+        count += frame.body.count(edge->src());
+      }
+      pending_inputs[node] = count;
+      if (count == 0) {
+        ready.push_back(node);
+      }
+    }
+    while (!ready.empty()) {
+      Node* node = ready.front();
+      ready.pop_front();
+      body_order.push_back(node);
+      for (const Edge* edge : node->out_edges()) {
+        if (frame.body.count(edge->dst()) &&
+            --pending_inputs[edge->dst()] == 0) {
+          ready.push_back(edge->dst());
+        }
+      }
+    }
+    if (body_order.size() != frame.body.size()) {
+      return errors::Internal("Loop body of frame ", frame.name,
+                              " is not acyclic");
+    }
+  }
+
+  // Current value of each loop variable, starting with the Enter inputs
+  std::vector<TensorSource> values;
+  for (Node* enter : frame.enters) {
+    const Edge* edge;
+    TF_RETURN_IF_ERROR(enter->input_edge(0, &edge));
+    values.push_back(TensorSource(edge->src(), edge->src_output()));
+  }
+
+  for (int64 iteration = 0; iteration < trip_count; iteration++) {
+    std::unordered_map<Node*, Node*> clones;
+    // Source of a tensor of the original body, in this iteration
+    auto resolve = [&](const Node* node, int output) {
+      Node* src = const_cast<Node*>(node);
+      auto clone_it = clones.find(src);
+      if (clone_it != clones.end()) {
+        return TensorSource(clone_it->second, output);
+      }
+      auto switch_it = switch_index.find(src);
+      if (switch_it != switch_index.end()) {
+        return values[switch_it->second];
+      }
+      auto invariant_it = invariant_source.find(src);
+      if (invariant_it != invariant_source.end()) {
+        return invariant_it->second;
+      }
+      return TensorSource(src, output);
+    };
+
+    for (Node* node : body_order) {
+      NodeDef def = node->def();
+      def.set_name(graph->NewName(
+          strings::StrCat(node->name(), "/ngraph_unrolled_", iteration)));
+      def.clear_input();
+      Status status;
+      Node* clone = graph->AddNode(def, &status);
+      TF_RETURN_IF_ERROR(status);
+      clone->set_assigned_device_name(node->assigned_device_name());
+
+      for (const Edge* edge : node->in_edges()) {
+        TensorSource src = resolve(edge->src(), edge->src_output());
+        if (edge->IsControlEdge()) {
+          if (!src.first->IsSource()) {
+            graph->AddControlEdge(src.first, clone);
+          }
+        } else {
+          graph->AddEdge(src.first, src.second, clone, edge->dst_input());
+        }
+      }
+      clones[node] = clone;
+    }
+
+    std::vector<TensorSource> next_values;
+    for (Node* next_iteration : frame.next_iterations) {
+      const Edge* edge;
+      TF_RETURN_IF_ERROR(next_iteration->input_edge(0, &edge));
+      next_values.push_back(resolve(edge->src(), edge->src_output()));
+    }
+    values = std::move(next_values);
+  }
+
+  // The Exit nodes become Identity nodes of the final values, keeping their
+  // names for the consumers (and fetches) of the loop outputs
+  for (size_t i = 0; i < frame.exits.size(); i++) {
+    Node* exit = frame.exits[i];
+    Node* identity;
+    TF_RETURN_IF_ERROR(NodeBuilder(exit->name(), "Identity")
+                           .Input(values[i].first, values[i].second)
+                           .Device(exit->requested_device())
+                           .Finalize(graph, &identity));
+    identity->set_assigned_device_name(exit->assigned_device_name());
+    ReplaceOutEdges(graph, exit, identity);
+    graph->RemoveNode(exit);
+  }
+
+  // Ops of the frame that are only fed by loop invariants stay, reading the
+  // invariants directly
+  for (Node* node : frame.invariants) {
+    std::vector<const Edge*> out_edges(node->out_edges().begin(),
+                                       node->out_edges().end());
+    const TensorSource& src = invariant_source[node];
+    for (const Edge* edge : out_edges) {
+      if (edge->IsControlEdge()) {
+        graph->AddControlEdge(src.first, edge->dst());
+      } else {
+        graph->AddEdge(src.first, src.second, edge->dst(), edge->dst_input());
+      }
+    }
+    graph->RemoveNode(node);
+  }
+
+  for (Node* node : frame.body) {
+    graph->RemoveNode(node);
+  }
+  for (Node* node : frame.cond) {
+    graph->RemoveNode(node);
+  }
+  graph->RemoveNode(frame.loop_cond);
+  for (size_t i = 0; i < frame.enters.size(); i++) {
+    graph->RemoveNode(frame.next_iterations[i]);
+    graph->RemoveNode(frame.switches[i]);
+    graph->RemoveNode(frame.merges[i]);
+    graph->RemoveNode(frame.enters[i]);
+  }
+  return Status::OK();
+}
+
+// Unrolls the loops that can be. Sets *changed if any was.
+Status FlattenLoops(Graph* graph, const std::set<string>& skip_these_nodes,
+                    bool* changed) {
+  std::map<string, LoopFrame> frames;
+  for (Node* node : graph->op_nodes()) {
+    if (!node->IsEnter()) {
+      continue;
+    }
+    string frame_name;
+    bool is_constant;
+    TF_RETURN_IF_ERROR(GetNodeAttr(node->attrs(), "frame_name", &frame_name));
+    TF_RETURN_IF_ERROR(GetNodeAttr(node->attrs(), "is_constant", &is_constant));
+    LoopFrame& frame = frames[frame_name];
+    frame.name = frame_name;
+    (is_constant ? frame.invariants : frame.enters).push_back(node);
+  }
+
+  for (auto& it : frames) {
+    LoopFrame& frame = it.second;
+    if (!CollectLoopFrame(skip_these_nodes, &frame)) {
+      NGRAPH_VLOG(3) << "Cannot unroll loop " << frame.name;
+      continue;
+    }
+    const Edge* cond_edge;
+    TF_RETURN_IF_ERROR(frame.loop_cond->input_edge(0, &cond_edge));
+    int64 trip_count;
+    if (!GetTripCount(frame, cond_edge->src(), &trip_count)) {
+      NGRAPH_VLOG(3) << "Cannot unroll loop " << frame.name
+                     << ": trip count is not static";
+      continue;
+    }
+    if (trip_count > MAX_UNROLLED_ITERATIONS ||
+        trip_count * static_cast<int64>(frame.body.size()) >
+            MAX_UNROLLED_NODES) {
+      NGRAPH_VLOG(3) << "Not unrolling loop " << frame.name << ": "
+                     << trip_count << " iterations of " << frame.body.size()
+                     << " ops";
+      continue;
+    }
+    NGRAPH_VLOG(3) << "Unrolling loop " << frame.name << ": " << trip_count
+                   << " iterations of " << frame.body.size() << " ops";
+    TF_RETURN_IF_ERROR(UnrollLoopFrame(graph, frame, trip_count));
+    *changed = true;
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+Status FlattenControlFlow(Graph* graph,
+                          const std::set<string>& skip_these_nodes) {
+  if (std::getenv("NGRAPH_TF_CLUSTER_CONTROL_FLOW") == nullptr) {
+    return Status::OK();
+  }
+
+  // Rewriting a region can make the one enclosing it rewritable (e.g. a
+  // conditional inside a loop body), so iterate until nothing changes
+  int num_rounds = 0;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    TF_RETURN_IF_ERROR(
+        FlattenConditionals(graph, skip_these_nodes, &changed));
+    TF_RETURN_IF_ERROR(FlattenLoops(graph, skip_these_nodes, &changed));
+    num_rounds++;
+  }
+  NGRAPH_VLOG(1) << "FlattenControlFlow done after " << num_rounds
+                 << " rounds";
+  return Status::OK();
+}
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef NGRAPH_TF_BRIDGE_FLATTEN_CONTROL_FLOW_H_
+#define NGRAPH_TF_BRIDGE_FLATTEN_CONTROL_FLOW_H_
+#pragma once
+
+#include <set>
+#include <string>
+
+#include "tensorflow/core/graph/graph.h"
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Rewrites structured TF (v1) control flow into plain data flow, so that the
+// clustering passes can put a whole conditional or loop into one encapsulate
+// instead of stopping at every Switch and Merge:
+//
+//   - a conditional (the Switch nodes sharing a predicate, and the Merge nodes
+//     joining their two branches) is if-converted: both branches are computed
+//     and each Merge becomes a Select on the predicate.
+//   - a while loop whose trip count is known statically (its condition is
+//     `i < N` or `i <= N`, or a conjunction of these, with i starting at a
+//     constant and incremented by a positive constant) is unrolled.
+//
+// Only regions whose ops are stateless and not in skip_these_nodes are
+// rewritten. Nested regions are handled innermost first. Merge and Exit nodes
+// are replaced by nodes of the same name, so they can still be fetched.
+//
+// Computing both sides of a conditional is only correct if neither branch can
+// fail on the values the other branch would be taken for (and both produce
+// the same shape), so this is opt-in: the pass does nothing unless
+// NGRAPH_TF_CLUSTER_CONTROL_FLOW is set.
+Status FlattenControlFlow(Graph* graph,
+                          const std::set<string>& skip_these_nodes);
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
+
+#endif  // NGRAPH_TF_BRIDGE_FLATTEN_CONTROL_FLOW_H_
@@ -0,0 +1,194 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+#include "ngraph_bridge/ngraph_fragmentation_report.h"
+#include "ngraph_bridge/ngraph_mark_for_clustering.h"
+#include "ngraph_bridge/ngraph_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// The number of edges listed for each cause
+static const size_t MAX_EXAMPLES = 3;
+
+static string JsonString(const string& s) {
+  string quoted = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      quoted.push_back('\\');
+      quoted.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      quoted += " ";
+    } else {
+      quoted.push_back(c);
+    }
+  }
+  return quoted + "\"";
+}
+
+// JSON has no literal for infinities and NaNs, so they are written as null
+static string JsonNumber(double value) {
+  if (!std::isfinite(value)) {
+    return "null";
+  }
+  ostringstream number;
+  number << value;
+  return number.str();
+}
+
+FragmentationReport::FragmentationReport(
+    const DefaultClusterCostModel::Parameters& parameters, GraphShapes shapes)
+    : m_parameters(parameters), m_shapes(std::move(shapes)) {}
+
+void FragmentationReport::AddBreak(const Edge* edge, const string& reason,
+                                   int src_cluster, int dst_cluster) {
+  if (src_cluster == dst_cluster || !edge->src()->IsOp() ||
+      !edge->dst()->IsOp()) {
+    return;
+  }
+  bool src_marked = NodeIsMarkedForClustering(edge->src());
+  bool dst_marked = NodeIsMarkedForClustering(edge->dst());
+  if (!src_marked && !dst_marked) {
+    return;
+  }
+
+  Break graph_break;
+  graph_break.edge = edge;
+  graph_break.reason = reason;
+  // The op that is not supported, or the one the cluster of src could not
+  // grow into
+  graph_break.op_type = (src_marked ? edge->dst() : edge->src())->type_string();
+  graph_break.clusters = make_pair(src_cluster, dst_cluster);
+  graph_break.num_ngraph_ends = (src_marked ? 1 : 0) + (dst_marked ? 1 : 0);
+  m_breaks.push_back(graph_break);
+  m_breaks_per_pair[graph_break.clusters]++;
+}
+
+string FragmentationReport::ToJson() const {
+  struct Cause {
+    string reason;
+    string op_type;
+    int num_breaks = 0;
+    // the number of tensors crossing the breaks whose size is not known
+    int num_unknown_sizes = 0;
+    double bytes = 0;
+    double transfer_us = 0;
+    double overhead_us = 0;
+    vector<string> examples;
+    double CostUs() const { return transfer_us + overhead_us; }
+  };
+  map<pair<string, string>, Cause> causes;
+
+  // A tensor consumed by several ops on the other side of a break is only
+  // transferred once
+  set<tuple<int, int, const Node*, int>> transferred;
+  for (auto& graph_break : m_breaks) {
+    Cause& cause = causes[make_pair(graph_break.reason, graph_break.op_type)];
+    cause.reason = graph_break.reason;
+    cause.op_type = graph_break.op_type;
+    cause.num_breaks++;
+    // An extra encapsulate call per pair of clusters, half of it for each
+    // encapsulate end
+    cause.overhead_us += m_parameters.encapsulate_overhead_us *
+                         graph_break.num_ngraph_ends / 2.0 /
+                         m_breaks_per_pair.at(graph_break.clusters);
+
+    const Node* src = graph_break.edge->src();
+    int src_output = graph_break.edge->src_output();
+    if (!graph_break.edge->IsControlEdge() &&
+        transferred
+            .insert(make_tuple(graph_break.clusters.first,
+                               graph_break.clusters.second, src, src_output))
+            .second) {
+      double bytes;
+      if (ClusterCostModel::EstimateOutputBytes(src, src_output, &bytes,
+                                                &m_shapes)) {
+        cause.bytes += bytes;
+        cause.transfer_us += bytes * graph_break.num_ngraph_ends /
+                             m_parameters.transfer_bytes_per_us;
+      } else {
+        cause.num_unknown_sizes++;
+      }
+    }
+    if (cause.examples.size() < MAX_EXAMPLES) {
+      cause.examples.push_back(src->name() + " -> " +
+                               graph_break.edge->dst()->name());
+    }
+  }
+
+  vector<const Cause*> ranked;
+  double total_cost_us = 0;
+  for (auto& itr : causes) {
+    ranked.push_back(&itr.second);
+    total_cost_us += itr.second.CostUs();
+  }
+  stable_sort(ranked.begin(), ranked.end(),
+              [](const Cause* a, const Cause* b) {
+                return a->CostUs() > b->CostUs();
+              });
+
+  ostringstream json;
+  json << "{\n"
+       << "  \"num_breaks\": " << m_breaks.size() << ",\n"
+       << "  \"encapsulate_overhead_us\": "
+       << JsonNumber(m_parameters.encapsulate_overhead_us) << ",\n"
+       << "  \"transfer_bytes_per_us\": "
+       << JsonNumber(m_parameters.transfer_bytes_per_us) << ",\n"
+       << "  \"estimated_cost_us\": " << JsonNumber(total_cost_us) << ",\n"
+       << "  \"causes\": [";
+  for (size_t i = 0; i < ranked.size(); i++) {
+    const Cause& cause = *ranked[i];
+    json << (i == 0 ? "\n" : ",\n") << "    {\n"
+         << "      \"reason\": " << JsonString(cause.reason) << ",\n"
+         << "      \"op_type\": " << JsonString(cause.op_type) << ",\n"
+         << "      \"num_breaks\": " << cause.num_breaks << ",\n"
+         << "      \"bytes\": " << JsonNumber(cause.bytes) << ",\n"
+         << "      \"num_unknown_sizes\": " << cause.num_unknown_sizes << ",\n"
+         << "      \"transfer_us\": " << JsonNumber(cause.transfer_us) << ",\n"
+         << "      \"overhead_us\": " << JsonNumber(cause.overhead_us) << ",\n"
+         << "      \"estimated_cost_us\": " << JsonNumber(cause.CostUs())
+         << ",\n"
+         << "      \"examples\": [";
+    for (size_t j = 0; j < cause.examples.size(); j++) {
+      json << (j == 0 ? "" : ", ") << JsonString(cause.examples[j]);
+    }
+    json << "]\n    }";
+  }
+  json << (ranked.empty() ? "]\n" : "\n  ]\n") << "}\n";
+  return json.str();
+}
+
+string FragmentationReport::GetFileName(int index) {
+  const char* prefix = std::getenv("NGRAPH_TF_FRAGMENTATION_REPORT");
+  if (prefix == nullptr) {
+    return "";
+  }
+  return GraphFilenamePrefix(prefix, index) + ".json";
+}
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef NGRAPH_TF_BRIDGE_FRAGMENTATION_REPORT_H_
+#define NGRAPH_TF_BRIDGE_FRAGMENTATION_REPORT_H_
+#pragma once
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/graph/graph.h"
+
+#include "ngraph_bridge/ngraph_cluster_cost_model.h"
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Aggregates the edges AssignClusters could not contract into a report of
+// what splits the graph into several encapsulates and TF ops, ranked by the
+// estimated cost of each cause per step.
+//
+// The cause of a break is its non-contraction reason and an op type: the
+// type of the op that is not supported for UNSUPPORTED breaks, and the type
+// of the destination op otherwise. Each break costs the transfer of its
+// tensor out of and into the encapsulates at its ends, and a share of the
+// per call overhead of one encapsulate for each pair of clusters it
+// separates. Both come from the parameters of the default cluster cost
+// model, so a timing profile given with NGRAPH_TF_CLUSTER_COST_PROFILE is
+// taken into account. The bytes crossing a break come from the
+// "_output_shapes" of the graph, or else from the shapes inferred for it.
+class FragmentationReport {
+ public:
+  explicit FragmentationReport(
+      const DefaultClusterCostModel::Parameters& parameters,
+      GraphShapes shapes = {});
+
+  // Records the edge between the clusters src_cluster and dst_cluster, which
+  // was not contracted for the given reason. Edges that do not touch an op
+  // marked for clustering, or within one cluster, are ignored.
+  void AddBreak(const Edge* edge, const std::string& reason, int src_cluster,
+                int dst_cluster);
+
+  int NumBreaks() const { return m_breaks.size(); }
+
+  std::string ToJson() const;
+
+  // Returns the file name the report of the index-th clustered graph goes
+  // to, or "" if NGRAPH_TF_FRAGMENTATION_REPORT, the prefix of the file
+  // names, is not set
+  static std::string GetFileName(int index);
+
+ private:
+  struct Break {
+    const Edge* edge;
+    std::string reason;
+    std::string op_type;
+    std::pair<int, int> clusters;
+    // the number of ends of the edge that are in nGraph clusters
+    int num_ngraph_ends;
+  };
+
+  DefaultClusterCostModel::Parameters m_parameters;
+  GraphShapes m_shapes;
+  std::vector<Break> m_breaks;
+  // the number of breaks between each pair of clusters
+  std::map<std::pair<int, int>, int> m_breaks_per_pair;
+};
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
+
+#endif  // NGRAPH_TF_BRIDGE_FRAGMENTATION_REPORT_H_
@@ -0,0 +1,338 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <cmath>
+#include <set>
+
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/tensor.h"
+
+#include "ngraph_bridge/ngraph_fused_patterns.h"
+
+using namespace std;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Relative tolerance on the constants of the patterns
+static const double CONSTANT_TOLERANCE = 1e-4;
+
+static const Edge* InputEdge(const Node* node, int index) {
+  const Edge* edge;
+  if (node == nullptr || !node->input_edge(index, &edge).ok()) {
+    return nullptr;
+  }
+  return edge;
+}
+
+static const Node* InputNode(const Node* node, int index) {
+  const Edge* edge = InputEdge(node, index);
+  return edge == nullptr ? nullptr : edge->src();
+}
+
+static bool IsOp(const Node* node, const string& type) {
+  return node != nullptr && node->type_string() == type;
+}
+
+static bool IsAdd(const Node* node) {
+  return IsOp(node, "Add") || IsOp(node, "AddV2");
+}
+
+static bool IsSameTensor(const Edge* a, const Edge* b) {
+  return a != nullptr && b != nullptr && a->src() == b->src() &&
+         a->src_output() == b->src_output();
+}
+
+// The input of the binary op node other than operand, or nullptr if operand
+// is not an input of node
+static const Edge* OtherInput(const Node* node, const Node* operand) {
+  if (InputNode(node, 0) == operand) {
+    return InputEdge(node, 1);
+  }
+  if (InputNode(node, 1) == operand) {
+    return InputEdge(node, 0);
+  }
+  return nullptr;
+}
+
+// The input of the binary op node that is one of the given types
+static const Node* InputOfType(const Node* node, const string& type) {
+  for (int i = 0; i < 2; i++) {
+    const Node* input = InputNode(node, i);
+    if (IsOp(input, type)) {
+      return input;
+    }
+  }
+  return nullptr;
+}
+
+static bool GetConstTensor(const Node* node, Tensor* tensor) {
+  return IsOp(node, "Const") &&
+         GetNodeAttr(node->attrs(), "value", tensor).ok();
+}
+
+static bool GetScalarConst(const Node* node, double* value) {
+  Tensor tensor;
+  if (!GetConstTensor(node, &tensor) || tensor.NumElements() != 1) {
+    return false;
+  }
+  switch (tensor.dtype()) {
+    case DT_FLOAT:
+      *value = tensor.flat<float>()(0);
+      return true;
+    case DT_DOUBLE:
+      *value = tensor.flat<double>()(0);
+      return true;
+    default:
+      return false;
+  }
+}
+
+static bool IsScalarConst(const Node* node, double expected) {
+  double value;
+  return GetScalarConst(node, &value) &&
+         std::abs(value - expected) <= CONSTANT_TOLERANCE * std::abs(expected);
+}
+
+// If one of the inputs of the binary op node is a scalar constant close to
+// expected, returns the other one
+static const Edge* InputOtherThanConst(const Node* node, double expected) {
+  for (int i = 0; i < 2; i++) {
+    if (IsScalarConst(InputNode(node, i), expected)) {
+      return InputEdge(node, 1 - i);
+    }
+  }
+  return nullptr;
+}
+
+// The constant reduction axes of a Mean that keeps the reduced dimensions
+static bool GetMeanAxes(const Node* mean, std::vector<int64>* axes) {
+  bool keep_dims;
+  if (!GetNodeAttr(mean->attrs(), "keep_dims", &keep_dims).ok() ||
+      !keep_dims) {
+    return false;
+  }
+  Tensor tensor;
+  if (!GetConstTensor(InputNode(mean, 1), &tensor)) {
+    return false;
+  }
+  axes->clear();
+  for (int64 i = 0; i < tensor.NumElements(); i++) {
+    if (tensor.dtype() == DT_INT32) {
+      axes->push_back(tensor.flat<int32>()(i));
+    } else if (tensor.dtype() == DT_INT64) {
+      axes->push_back(tensor.flat<int64>()(i));
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether the outputs of the interior ops are only used inside the pattern
+static bool IsSelfContained(const FusedPattern& pattern) {
+  std::set<const Node*> nodes(pattern.interior.begin(),
+                              pattern.interior.end());
+  nodes.insert(pattern.anchor);
+  for (auto node : pattern.interior) {
+    for (auto edge : node->out_edges()) {
+      if (!edge->IsControlEdge() && nodes.count(edge->dst()) == 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// anchor = x * inv + (beta - mean * inv), where
+//   mean = reduce_mean(x, axes, keep_dims=True)
+//   variance = reduce_mean(squared_difference(x, stop_gradient(mean)), axes,
+//                          keep_dims=True)
+//   inv = rsqrt(variance + epsilon) * gamma
+static bool MatchLayerNorm(const Node* anchor, FusedPattern* pattern) {
+  if (!IsAdd(anchor)) {
+    return false;
+  }
+  const Node* shift = InputOfType(anchor, "Sub");
+  const Edge* scaled_edge = OtherInput(anchor, shift);
+  if (shift == nullptr || scaled_edge == nullptr ||
+      !IsOp(scaled_edge->src(), "Mul")) {
+    return false;
+  }
+  const Node* scaled = scaled_edge->src();
+  const Edge* beta = InputEdge(shift, 0);
+  const Node* scaled_mean = InputNode(shift, 1);
+  if (!IsOp(scaled_mean, "Mul")) {
+    return false;
+  }
+
+  const Node* mean = InputOfType(scaled_mean, "Mean");
+  const Edge* inv_edge = OtherInput(scaled_mean, mean);
+  if (mean == nullptr || inv_edge == nullptr ||
+      !IsOp(inv_edge->src(), "Mul")) {
+    return false;
+  }
+  const Node* inv = inv_edge->src();
+  const Edge* x = OtherInput(scaled, inv);
+  if (x == nullptr) {
+    return false;
+  }
+
+  const Node* rsqrt = InputOfType(inv, "Rsqrt");
+  const Edge* gamma = OtherInput(inv, rsqrt);
+  const Node* variance_epsilon = InputNode(rsqrt, 0);
+  if (rsqrt == nullptr || gamma == nullptr || !IsAdd(variance_epsilon)) {
+    return false;
+  }
+  const Node* variance = InputOfType(variance_epsilon, "Mean");
+  const Edge* epsilon_edge = OtherInput(variance_epsilon, variance);
+  double epsilon;
+  if (variance == nullptr || epsilon_edge == nullptr ||
+      !GetScalarConst(epsilon_edge->src(), &epsilon)) {
+    return false;
+  }
+
+  const Node* squared_difference = InputNode(variance, 0);
+  if (!IsOp(squared_difference, "SquaredDifference") ||
+      !IsSameTensor(InputEdge(squared_difference, 0), x) ||
+      !IsSameTensor(InputEdge(mean, 0), x)) {
+    return false;
+  }
+  const Node* stop_gradient = InputNode(squared_difference, 1);
+  if (stop_gradient == mean) {
+    stop_gradient = nullptr;
+  } else if (!(IsOp(stop_gradient, "StopGradient") ||
+               IsOp(stop_gradient, "Identity")) ||
+             InputNode(stop_gradient, 0) != mean) {
+    return false;
+  }
+
+  std::vector<int64> mean_axes, variance_axes;
+  if (!GetMeanAxes(mean, &mean_axes) ||
+      !GetMeanAxes(variance, &variance_axes) || mean_axes != variance_axes) {
+    return false;
+  }
+
+  pattern->type = FusedPattern::Type::LAYER_NORM;
+  pattern->anchor = anchor;
+  pattern->interior = {mean};
+  if (stop_gradient != nullptr) {
+    pattern->interior.push_back(stop_gradient);
+  }
+  pattern->interior.insert(pattern->interior.end(),
+                           {squared_difference, variance, variance_epsilon,
+                            rsqrt, inv, scaled, scaled_mean, shift});
+  pattern->inputs = {x, gamma, beta};
+  pattern->axes = mean_axes;
+  pattern->epsilon = epsilon;
+  return IsSelfContained(*pattern);
+}
+
+// x / sqrt(2) or x * (1 / sqrt(2)), returns x
+static const Edge* MatchScaledToUnitVariance(const Node* node) {
+  if (IsOp(node, "RealDiv")) {
+    const Node* divisor = InputNode(node, 1);
+    if (IsScalarConst(divisor, std::sqrt(2.0)) ||
+        (IsOp(divisor, "Sqrt") && IsScalarConst(InputNode(divisor, 0), 2.0))) {
+      return InputEdge(node, 0);
+    }
+    return nullptr;
+  }
+  if (IsOp(node, "Mul")) {
+    return InputOtherThanConst(node, std::sqrt(0.5));
+  }
+  return nullptr;
+}
+
+// anchor = (0.5 * x) * (1 + erf(x / sqrt(2))), or
+// anchor = x * (0.5 * (1 + erf(x / sqrt(2))))
+static bool MatchGelu(const Node* anchor, FusedPattern* pattern) {
+  if (!IsOp(anchor, "Mul")) {
+    return false;
+  }
+  for (int i = 0; i < 2; i++) {
+    const Node* operand = InputNode(anchor, i);
+    const Node* one_plus_erf = nullptr;
+    const Node* half = nullptr;
+    const Edge* x = nullptr;
+    if (IsAdd(operand)) {
+      one_plus_erf = operand;
+      half = InputNode(anchor, 1 - i);
+      x = IsOp(half, "Mul") ? InputOtherThanConst(half, 0.5) : nullptr;
+    } else if (IsOp(operand, "Mul")) {
+      half = operand;
+      const Edge* one_plus_erf_edge = InputOtherThanConst(half, 0.5);
+      one_plus_erf =
+          one_plus_erf_edge == nullptr ? nullptr : one_plus_erf_edge->src();
+      x = InputEdge(anchor, 1 - i);
+    }
+    if (x == nullptr || !IsAdd(one_plus_erf)) {
+      continue;
+    }
+    const Edge* erf_edge = InputOtherThanConst(one_plus_erf, 1.0);
+    const Node* erf = erf_edge == nullptr ? nullptr : erf_edge->src();
+    if (!IsOp(erf, "Erf")) {
+      continue;
+    }
+    const Node* scaled = InputNode(erf, 0);
+    if (!IsSameTensor(MatchScaledToUnitVariance(scaled), x)) {
+      continue;
+    }
+
+    pattern->type = FusedPattern::Type::GELU;
+    pattern->anchor = anchor;
+    // half only depends on x in the first form, and on one_plus_erf in the
+    // second one
+    pattern->interior = {scaled, erf, one_plus_erf, half};
+    pattern->inputs = {x};
+    pattern->axes.clear();
+    pattern->epsilon = 0;
+    if (IsSelfContained(*pattern)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MatchFusedPattern(const Node* anchor, FusedPattern* pattern) {
+  return MatchLayerNorm(anchor, pattern) || MatchGelu(anchor, pattern);
+}
+
+void FindFusedPatterns(const std::vector<const Node*>& ops,
+                       std::vector<FusedPattern>* patterns) {
+  std::set<const Node*> claimed;
+  for (auto op : ops) {
+    FusedPattern pattern;
+    if (claimed.count(op) != 0 || !MatchFusedPattern(op, &pattern)) {
+      continue;
+    }
+    bool overlaps = false;
+    for (auto node : pattern.interior) {
+      overlaps |= claimed.count(node) != 0;
+    }
+    if (overlaps) {
+      continue;
+    }
+    claimed.insert(pattern.interior.begin(), pattern.interior.end());
+    claimed.insert(op);
+    patterns->push_back(pattern);
+  }
+}
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
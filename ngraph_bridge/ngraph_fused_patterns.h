@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef NGRAPH_TF_BRIDGE_FUSED_PATTERNS_H_
+#define NGRAPH_TF_BRIDGE_FUSED_PATTERNS_H_
+#pragma once
+
+#include <vector>
+
+#include "tensorflow/core/graph/graph.h"
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// A subgraph of TF ops computing a function that nGraph has a fused op for.
+// The ops are those generated by the Python layers, so the pattern is
+// recognized by its structure and constants.
+struct FusedPattern {
+  enum class Type {
+    // tf.nn.moments followed by tf.nn.batch_normalization over the last
+    // axis (tf.contrib.layers.layer_norm, Keras LayerNormalization):
+    //   (x - mean) * rsqrt(variance + epsilon) * gamma + beta
+    LAYER_NORM,
+    // 0.5 * x * (1 + erf(x / sqrt(2)))
+    GELU
+  };
+
+  Type type;
+  // The op whose output is the result of the pattern
+  const Node* anchor;
+  // The ops between the inputs and the anchor, in topological order. None of
+  // them is used outside of the pattern.
+  std::vector<const Node*> interior;
+  // x, followed by gamma and beta for LAYER_NORM
+  std::vector<const Edge*> inputs;
+  // LAYER_NORM only
+  std::vector<int64> axes;
+  double epsilon;
+};
+
+// Matches the patterns whose result is the output of anchor
+bool MatchFusedPattern(const Node* anchor, FusedPattern* pattern);
+
+// Finds the non-overlapping patterns among ops (in topological order)
+void FindFusedPatterns(const std::vector<const Node*>& ops,
+                       std::vector<FusedPattern>* patterns);
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
+
+#endif  // NGRAPH_TF_BRIDGE_FUSED_PATTERNS_H_
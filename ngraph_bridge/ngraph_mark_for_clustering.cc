@@ -14,8 +14,14 @@
  * limitations under the License.
  *******************************************************************************/
 
+#include <mutex>
+
 #include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
 
+#include "ngraph/op/fused/gelu.hpp"
 #include "ngraph/runtime/backend.hpp"
 #include "ngraph/runtime/backend_manager.hpp"
 #include "ngraph_bridge/ngraph_api.h"
@@ -62,7 +68,7 @@ static Status NGraphPlacementRequested(Node*, bool& placement_ok) {
 }
 
 static Status CheckIfOutputNode(const Node* node,
-                                const std::set<string> skip_these_nodes,
+                                const std::set<string>& skip_these_nodes,
                                 bool& skip_it) {
   skip_it = skip_these_nodes.find(node->name()) != skip_these_nodes.end();
   return Status::OK();
@@ -189,6 +195,7 @@ const std::map<std::string, SetAttributesFunction>& GetAttributeSetters() {
     set_attributes_map["ArgMax"] = SetStaticInputs({1});
     set_attributes_map["ArgMin"] = SetStaticInputs({1});
     set_attributes_map["AvgPoolGrad"] = SetStaticInputs({0});
+    set_attributes_map["BroadcastTo"] = SetStaticInputs({1});
     set_attributes_map["ConcatV2"] = SetStaticInputs({-1});
     set_attributes_map["CombinedNonMaxSuppression"] =
         SetStaticInputs({2, 3, 4, 5});
@@ -200,6 +207,7 @@ const std::map<std::string, SetAttributesFunction>& GetAttributeSetters() {
     set_attributes_map["Max"] = SetStaticInputs({1});
     set_attributes_map["Mean"] = SetStaticInputs({1});
     set_attributes_map["Min"] = SetStaticInputs({1});
+    set_attributes_map["MirrorPad"] = SetStaticInputs({1});
     set_attributes_map["NonMaxSuppressionV4"] = SetStaticInputs({2, 3, 4});
     set_attributes_map["OneHot"] = SetStaticInputs({1});
     set_attributes_map["Pad"] = SetStaticInputs({1});
@@ -229,6 +237,8 @@ const std::map<std::string, SetAttributesFunction>& GetAttributeSetters() {
     set_attributes_map["RandomUniform"] = SetStaticInputs({0});
     set_attributes_map["Reshape"] = SetStaticInputs({1});
     set_attributes_map["ResizeBilinear"] = SetStaticInputs({1});
+    set_attributes_map["ResizeNearestNeighbor"] = SetStaticInputs({1});
+    set_attributes_map["ReverseV2"] = SetStaticInputs({1});
     set_attributes_map["ScatterNd"] = SetStaticInputs({2});
     set_attributes_map["Slice"] = SetStaticInputs({1, 2});
     set_attributes_map["Split"] = SetStaticInputs({0});
@@ -286,7 +296,9 @@ const std::map<std::string, ConfirmationFunction>& GetConfirmationMap() {
     confirmation_function_map["BatchMatMulV2"] = SimpleConfirmationFunction();
     confirmation_function_map["BiasAdd"] = SimpleConfirmationFunction();
     confirmation_function_map["BiasAddGrad"] = SimpleConfirmationFunction();
+    confirmation_function_map["BroadcastTo"] = SimpleConfirmationFunction();
     confirmation_function_map["Cast"] = SimpleConfirmationFunction();
+    confirmation_function_map["ClipByValue"] = SimpleConfirmationFunction();
     confirmation_function_map["ConcatV2"] = SimpleConfirmationFunction();
     confirmation_function_map["Const"] = SimpleConfirmationFunction();
     confirmation_function_map["Conv2D"] = SimpleConfirmationFunction();
@@ -313,7 +325,20 @@ const std::map<std::string, ConfirmationFunction>& GetConfirmationMap() {
       *result = (mode.compare("SCALED") == 0);
       return Status::OK();
     };
+    // Einsum is translated if it is a (batched) matrix multiplication, up to
+    // transposes and sums
+    confirmation_function_map["Einsum"] = [](Node* n, bool* result) {
+      std::string equation;
+      TF_RETURN_IF_ERROR(GetNodeAttr(n->attrs(), "equation", &equation));
+      std::vector<std::string> input_labels;
+      std::string output_labels;
+      *result = n->num_inputs() <= 2 &&
+                ParseEinsumEquation(equation, &input_labels, &output_labels)
+                    .ok();
+      return Status::OK();
+    };
     confirmation_function_map["Equal"] = SimpleConfirmationFunction();
+    confirmation_function_map["Erf"] = SimpleConfirmationFunction();
     confirmation_function_map["Exp"] = SimpleConfirmationFunction();
     confirmation_function_map["ExpandDims"] = SimpleConfirmationFunction();
     confirmation_function_map["Fill"] = SimpleConfirmationFunction();
@@ -353,6 +378,7 @@ const std::map<std::string, ConfirmationFunction>& GetConfirmationMap() {
     confirmation_function_map["IsFinite"] = SimpleConfirmationFunction();
     confirmation_function_map["L2Loss"] = SimpleConfirmationFunction();
     confirmation_function_map["LogSoftmax"] = SimpleConfirmationFunction();
+    confirmation_function_map["LeakyRelu"] = SimpleConfirmationFunction();
     confirmation_function_map["Less"] = SimpleConfirmationFunction();
     confirmation_function_map["LessEqual"] = SimpleConfirmationFunction();
     confirmation_function_map["Log"] = SimpleConfirmationFunction();
@@ -369,6 +395,7 @@ const std::map<std::string, ConfirmationFunction>& GetConfirmationMap() {
     confirmation_function_map["Mean"] = SimpleConfirmationFunction();
     confirmation_function_map["Min"] = SimpleConfirmationFunction();
     confirmation_function_map["Minimum"] = SimpleConfirmationFunction();
+    confirmation_function_map["MirrorPad"] = SimpleConfirmationFunction();
     confirmation_function_map["Mul"] = SimpleConfirmationFunction();
     confirmation_function_map["Neg"] = SimpleConfirmationFunction();
     confirmation_function_map["NoOp"] = SimpleConfirmationFunction();
@@ -419,10 +446,15 @@ const std::map<std::string, ConfirmationFunction>& GetConfirmationMap() {
     confirmation_function_map["ReluGrad"] = SimpleConfirmationFunction();
     confirmation_function_map["Reshape"] = SimpleConfirmationFunction();
     confirmation_function_map["ResizeBilinear"] = SimpleConfirmationFunction();
+    confirmation_function_map["ResizeNearestNeighbor"] =
+        SimpleConfirmationFunction();
+    confirmation_function_map["ReverseV2"] = SimpleConfirmationFunction();
+    confirmation_function_map["Round"] = SimpleConfirmationFunction();
     confirmation_function_map["Rsqrt"] = SimpleConfirmationFunction();
     confirmation_function_map["RsqrtGrad"] = SimpleConfirmationFunction();
     confirmation_function_map["ScatterNd"] = SimpleConfirmationFunction();
     confirmation_function_map["Select"] = SimpleConfirmationFunction();
+    confirmation_function_map["SelectV2"] = SimpleConfirmationFunction();
     confirmation_function_map["Shape"] = SimpleConfirmationFunction();
     confirmation_function_map["Sigmoid"] = SimpleConfirmationFunction();
     confirmation_function_map["SigmoidGrad"] = SimpleConfirmationFunction();
@@ -446,6 +478,7 @@ const std::map<std::string, ConfirmationFunction>& GetConfirmationMap() {
     confirmation_function_map["SquaredDifference"] =
         SimpleConfirmationFunction();
     confirmation_function_map["Squeeze"] = SimpleConfirmationFunction();
+    confirmation_function_map["StopGradient"] = SimpleConfirmationFunction();
     confirmation_function_map["StridedSlice"] = SimpleConfirmationFunction();
     confirmation_function_map["StridedSliceGrad"] =
         SimpleConfirmationFunction();
@@ -509,8 +542,11 @@ const TypeConstraintMap& GetTypeConstraintMap() {
     type_constraint_map["BatchMatMulV2"]["T"] = NGraphNumericDTypes();
     type_constraint_map["BiasAdd"]["T"] = NGraphNumericDTypes();
     type_constraint_map["BiasAddGrad"]["T"] = NGraphNumericDTypes();
+    type_constraint_map["BroadcastTo"]["T"] = NGraphDTypes();
+    type_constraint_map["BroadcastTo"]["Tidx"] = NGraphIndexDTypes();
     type_constraint_map["Cast"]["SrcT"] = NGraphDTypes();
     type_constraint_map["Cast"]["DstT"] = NGraphDTypes();
+    type_constraint_map["ClipByValue"]["T"] = NGraphNumericDTypes();
     type_constraint_map["ConcatV2"]["T"] = NGraphDTypes();
     type_constraint_map["ConcatV2"]["Tidx"] = NGraphIndexDTypes();
     type_constraint_map["Const"]["dtype"] = NGraphDTypes();
@@ -524,17 +560,23 @@ const TypeConstraintMap& GetTypeConstraintMap() {
     type_constraint_map["DepthToSpace"]["T"] = NGraphDTypes();
     type_constraint_map["DepthwiseConv2dNative"]["T"] = NGraphNumericDTypes();
     type_constraint_map["Dequantize"]["T"] = NGraphSupportedQuantizedDTypes();
+    type_constraint_map["Einsum"]["T"] = NGraphRealDTypes();
     type_constraint_map["Equal"]["T"] = NGraphDTypes();
+    type_constraint_map["Erf"]["T"] = NGraphRealDTypes();
     type_constraint_map["Exp"]["T"] = NGraphNumericDTypes();
     type_constraint_map["ExpandDims"]["T"] = NGraphDTypes();
     type_constraint_map["Floor"]["T"] = NGraphNumericDTypes();
     type_constraint_map["FloorDiv"]["T"] = NGraphNumericDTypes();
     type_constraint_map["FloorMod"]["T"] = NGraphNumericDTypes();
     type_constraint_map["FusedBatchNorm"]["T"] = NGraphNumericDTypes();
-    // TODO (mingshan): FusedBatchNormV2, V3 supports DT_HALF,DT_BFLOAT16,
-    // DT_FLOAT
-    type_constraint_map["FusedBatchNormV2"]["T"] = {DT_FLOAT};
-    type_constraint_map["FusedBatchNormV3"]["T"] = {DT_FLOAT};
+    // The half and bfloat16 inputs of FusedBatchNormV2 and V3 are normalized
+    // in float
+    type_constraint_map["FusedBatchNormV2"]["T"] = {DT_FLOAT, DT_HALF,
+                                                    DT_BFLOAT16};
+    type_constraint_map["FusedBatchNormV2"]["U"] = {DT_FLOAT};
+    type_constraint_map["FusedBatchNormV3"]["T"] = {DT_FLOAT, DT_HALF,
+                                                    DT_BFLOAT16};
+    type_constraint_map["FusedBatchNormV3"]["U"] = {DT_FLOAT};
     type_constraint_map["FusedBatchNormGrad"]["T"] = NGraphNumericDTypes();
     type_constraint_map["GatherNd"]["Tparams"] = {DT_FLOAT};  // NGraphDTypes();
     type_constraint_map["GatherNd"]["Tindices"] = NGraphIndexDTypes();
@@ -553,6 +595,7 @@ const TypeConstraintMap& GetTypeConstraintMap() {
     type_constraint_map["Identity"]["T"] = NGraphDTypes();
     type_constraint_map["IsFinite"]["T"] = NGraphRealDTypes();
     type_constraint_map["L2Loss"]["T"] = NGraphNumericDTypes();
+    type_constraint_map["LeakyRelu"]["T"] = NGraphRealDTypes();
     type_constraint_map["LogSoftmax"]["T"] = NGraphRealDTypes();
     type_constraint_map["Less"]["T"] = NGraphDTypes();
     type_constraint_map["LessEqual"]["T"] = NGraphDTypes();
@@ -572,6 +615,8 @@ const TypeConstraintMap& GetTypeConstraintMap() {
     type_constraint_map["Min"]["T"] = NGraphNumericDTypes();
     type_constraint_map["Min"]["Tidx"] = NGraphIndexDTypes();
     type_constraint_map["Minimum"]["T"] = NGraphNumericDTypes();
+    type_constraint_map["MirrorPad"]["T"] = NGraphDTypes();
+    type_constraint_map["MirrorPad"]["Tpaddings"] = NGraphIndexDTypes();
     type_constraint_map["Mul"]["T"] = NGraphNumericDTypes();
     type_constraint_map["Neg"]["T"] = NGraphNumericDTypes();
     type_constraint_map["NonMaxSuppressionV4"]["T"] = {
@@ -634,11 +679,16 @@ const TypeConstraintMap& GetTypeConstraintMap() {
     type_constraint_map["Reshape"]["T"] = NGraphDTypes();
     type_constraint_map["Reshape"]["Tshape"] = NGraphIndexDTypes();
     type_constraint_map["ResizeBilinear"]["T"] = NGraphNumericDTypes();
+    type_constraint_map["ResizeNearestNeighbor"]["T"] = NGraphNumericDTypes();
+    type_constraint_map["ReverseV2"]["T"] = NGraphDTypes();
+    type_constraint_map["ReverseV2"]["Tidx"] = NGraphIndexDTypes();
+    type_constraint_map["Round"]["T"] = NGraphNumericDTypes();
     type_constraint_map["Rsqrt"]["T"] = NGraphDTypes();
     type_constraint_map["RsqrtGrad"]["T"] = NGraphRealDTypes();
     type_constraint_map["ScatterNd"]["T"] = NGraphDTypes();
     type_constraint_map["ScatterNd"]["Tindices"] = NGraphIndexDTypes();
     type_constraint_map["Select"]["T"] = NGraphDTypes();
+    type_constraint_map["SelectV2"]["T"] = NGraphDTypes();
     type_constraint_map["Shape"]["T"] = NGraphDTypes();
     type_constraint_map["Shape"]["out_type"] = NGraphIndexDTypes();
     type_constraint_map["Sigmoid"]["T"] = NGraphNumericDTypes();
@@ -668,6 +718,7 @@ const TypeConstraintMap& GetTypeConstraintMap() {
     type_constraint_map["Square"]["T"] = NGraphDTypes();
     type_constraint_map["SquaredDifference"]["T"] = NGraphDTypes();
     type_constraint_map["Squeeze"]["T"] = NGraphDTypes();
+    type_constraint_map["StopGradient"]["T"] = NGraphDTypes();
     type_constraint_map["StridedSlice"]["T"] = NGraphDTypes();
     type_constraint_map["StridedSlice"]["Index"] = NGraphIndexDTypes();
     type_constraint_map["StridedSliceGrad"]["T"] = NGraphDTypes();
@@ -740,7 +791,14 @@ GetTFToNgOpMap() {
          {std::make_shared<ngraph::op::Add>(),
           std::make_shared<ngraph::op::Broadcast>()}},
         {"BiasAddGrad", {std::make_shared<ngraph::op::Sum>(), constant}},
+        {"BroadcastTo",
+         {std::make_shared<ngraph::op::Reshape>(),
+          std::make_shared<ngraph::op::Broadcast>()}},
         {"Cast", {std::make_shared<ngraph::op::Convert>()}},
+        {"ClipByValue",
+         {std::make_shared<ngraph::op::Maximum>(),
+          std::make_shared<ngraph::op::Minimum>(),
+          std::make_shared<ngraph::op::Broadcast>()}},
         {"ConcatV2", {std::make_shared<ngraph::op::Concat>()}},
         {"Const", {constant}}, {"Conv2D",
                                 {std::make_shared<ngraph::op::Reshape>(),
@@ -768,7 +826,15 @@ GetTFToNgOpMap() {
           std::make_shared<ngraph::op::Divide>(),
           std::make_shared<ngraph::op::Maximum>(),
           std::make_shared<ngraph::op::Abs>()}},
+        {"Einsum",
+         {std::make_shared<ngraph::op::Sum>(),
+          std::make_shared<ngraph::op::Reshape>(),
+          std::make_shared<ngraph::op::Dot>(),
+          std::make_shared<ngraph::op::BatchMatMulTranspose>()}},
         {"Equal", {std::make_shared<ngraph::op::Equal>()}},
+        {"Erf",
+         {std::make_shared<ngraph::op::Erf>(),
+          std::make_shared<ngraph::op::Gelu>()}},
         {"Exp", {std::make_shared<ngraph::op::Exp>()}},
         {"ExpandDims", {std::make_shared<ngraph::op::Reshape>()}},
         {"Fill", {std::make_shared<ngraph::op::Broadcast>()}},
@@ -842,6 +908,11 @@ GetTFToNgOpMap() {
           std::make_shared<ngraph::op::Exp>(),
           std::make_shared<ngraph::op::Log>(),
           std::make_shared<ngraph::op::Sum>(), constant}},
+        {"LeakyRelu",
+         {constant, std::make_shared<ngraph::op::Broadcast>(),
+          std::make_shared<ngraph::op::Greater>(),
+          std::make_shared<ngraph::op::Multiply>(),
+          std::make_shared<ngraph::op::Select>()}},
         {"Less", {std::make_shared<ngraph::op::Less>()}},
         {"LessEqual", {std::make_shared<ngraph::op::LessEq>()}},
         {"Log", {std::make_shared<ngraph::op::Log>()}},
@@ -875,6 +946,7 @@ GetTFToNgOpMap() {
         {"Minimum",
          {std::make_shared<ngraph::op::Minimum>(),
           std::make_shared<ngraph::op::Broadcast>()}},
+        {"MirrorPad", {constant, std::make_shared<ngraph::op::Pad>()}},
         {"Mul", {std::make_shared<ngraph::op::Multiply>()}},
         {"Neg", {std::make_shared<ngraph::op::Negative>()}},
         {"OneHot",
@@ -992,6 +1064,18 @@ GetTFToNgOpMap() {
         {"ResizeBilinear",
          {std::make_shared<ngraph::op::Convert>(),
           std::make_shared<ngraph::op::Interpolate>()}},
+        {"ResizeNearestNeighbor",
+         {constant, std::make_shared<ngraph::op::Gather>()}},
+        {"ReverseV2", {std::make_shared<ngraph::op::Reverse>()}},
+        {"Round",
+         {constant, std::make_shared<ngraph::op::Broadcast>(),
+          std::make_shared<ngraph::op::Floor>(),
+          std::make_shared<ngraph::op::Add>(),
+          std::make_shared<ngraph::op::Subtract>(),
+          std::make_shared<ngraph::op::Multiply>(),
+          std::make_shared<ngraph::op::Equal>(),
+          std::make_shared<ngraph::op::Less>(),
+          std::make_shared<ngraph::op::Select>()}},
         {"Rsqrt", {constant, std::make_shared<ngraph::op::Power>()}},
         {"RsqrtGrad",
          {constant, std::make_shared<ngraph::op::Power>(),
@@ -1000,6 +1084,10 @@ GetTFToNgOpMap() {
          {std::make_shared<ngraph::op::Reshape>(),
           std::make_shared<ngraph::op::Broadcast>(),
           std::make_shared<ngraph::op::Select>()}},
+        {"SelectV2",
+         {std::make_shared<ngraph::op::Reshape>(),
+          std::make_shared<ngraph::op::Broadcast>(),
+          std::make_shared<ngraph::op::Select>()}},
         {"Reshape", {std::make_shared<ngraph::op::Reshape>()}},
         {"ScatterNd", {constant, std::make_shared<ngraph::op::ScatterNDAdd>()}},
         {"Shape", {constant}}, {"Sigmoid",
@@ -1051,6 +1139,7 @@ GetTFToNgOpMap() {
           std::make_shared<ngraph::op::Multiply>(),
           std::make_shared<ngraph::op::Broadcast>()}},
         {"Squeeze", {std::make_shared<ngraph::op::Reshape>()}},
+        {"StopGradient", {}},
         {"StridedSlice",
          {std::make_shared<ngraph::op::Reverse>(),
           std::make_shared<ngraph::op::Slice>(),
@@ -1087,6 +1176,112 @@ GetTFToNgOpMap() {
   return TFtoNgraphOpMap;
 }
 
+// Outcome of the marking checks for a single node
+enum class MarkingDecision {
+  ACCEPT,
+  VARIABLE,           // nGraph variable type, only gets the backend attribute
+  REJECT,             // output node or placement not requested
+  NO_SUPPORT,         // no confirmation function for the op
+  FAIL_CONFIRMATION,  // confirmation function refused the node
+  FAIL_CONSTRAINT,    // input type constraints not met
+  FAIL_BACKEND        // not supported by the backend
+};
+
+// Graphs smaller than this are marked on the calling thread
+static const size_t MIN_NODES_FOR_PARALLEL_MARKING = 1024;
+// Rough cost of the checks for one node, used to shard the nodes among threads
+static const int64 MARKING_COST_PER_NODE = 10000;
+
+// Runs all the marking checks for a node without modifying it, so that it can
+// be called for different nodes concurrently. Backend queries are serialized
+// with backend_mutex, since backends do not promise a thread safe
+// is_supported, and their answers are memoized per (backend, op type).
+static Status DecideNodeMarking(
+    Node* node, const std::set<string>& skip_these_nodes,
+    const TypeConstraintMap& type_constraint_map,
+    std::map<std::string, ConfirmationFunction>& confirmation_function_map,
+    const ng::runtime::Backend* op_backend, const string& ng_backend_type,
+    const std::map<std::string, std::set<std::shared_ptr<ngraph::Node>>>&
+        TFtoNgraphOpMap,
+    std::mutex& backend_mutex, MarkingDecision* decision) {
+  *decision = MarkingDecision::REJECT;
+
+  if (IsNGVariableType(node->type_string())) {
+    *decision = MarkingDecision::VARIABLE;
+    return Status::OK();
+  }
+
+  // check if output node
+  bool skip_it = false;
+  TF_RETURN_IF_ERROR(CheckIfOutputNode(node, skip_these_nodes, skip_it));
+  if (skip_it) {
+    NGRAPH_VLOG(5) << "NGTF_OPTIMIZER: Found Output Node: " << node->name()
+                   << " - skip marking it for clustering";
+    return Status::OK();
+  }
+
+  // check placement
+  bool placement_ok = false;
+  TF_RETURN_IF_ERROR(NGraphPlacementRequested(node, placement_ok));
+  if (!placement_ok) {
+    NGRAPH_VLOG(5) << "Placement not requested: " << node->name();
+    return Status::OK();
+  }
+
+  // check node's confirmation constraints
+  bool confirmation_constraint_ok = false;
+  TF_RETURN_IF_ERROR(ConfirmationOk(node, confirmation_function_map,
+                                    confirmation_constraint_ok));
+  if (!confirmation_constraint_ok) {
+    NGRAPH_VLOG(5) << "Node does not meet confirmation constraints: "
+                   << node->name();
+    if (confirmation_function_map.find(node->type_string()) ==
+        confirmation_function_map.end()) {
+      // not found
+      *decision = MarkingDecision::NO_SUPPORT;
+    } else {
+      // found
+      *decision = MarkingDecision::FAIL_CONFIRMATION;
+    }
+    return Status::OK();
+  }
+
+  // check input type constraints
+  bool type_constraint_ok = false;
+  TF_RETURN_IF_ERROR(
+      TypeConstraintOk(node, type_constraint_map, type_constraint_ok));
+  if (!type_constraint_ok) {
+    NGRAPH_VLOG(5) << "Inputs do not meet type constraints: " << node->name();
+    *decision = MarkingDecision::FAIL_CONSTRAINT;
+    return Status::OK();
+  }
+
+  // Check if op is supported by backend. The answer only depends on the
+  // backend and the op type, so it is looked up in the process wide cache
+  // first
+  bool is_supported = false;
+  if (!BackendManager::GetCachedOpSupport(ng_backend_type, node->type_string(),
+                                          &is_supported)) {
+    std::lock_guard<std::mutex> lock(backend_mutex);
+    TF_RETURN_IF_ERROR(IsSupportedByBackend(node, op_backend, TFtoNgraphOpMap,
+                                            is_supported));
+    BackendManager::CacheOpSupport(ng_backend_type, node->type_string(),
+                                   is_supported);
+  }
+
+  if (!is_supported) {
+    NGRAPH_VLOG(5) << "TF Op " << node->name() << " of type "
+                   << node->type_string()
+                   << " is not supported by backend: " << ng_backend_type;
+    *decision = MarkingDecision::FAIL_BACKEND;
+    return Status::OK();
+  }
+
+  // if all constraints are met, mark for clustering
+  *decision = MarkingDecision::ACCEPT;
+  return Status::OK();
+}
+
 //
 // Main entry point for the marking pass.
 //
@@ -1176,80 +1371,61 @@ Status MarkForClustering(Graph* graph, const std::set<string> skip_these_nodes,
   ng::runtime::Backend* op_backend =
       BackendManager::GetBackend(ng_backend_type);
 
+  // The checks only read the nodes, so the decisions for all the nodes are
+  // computed in parallel into a side table, and the attributes are written
+  // in one serial pass afterwards
+  vector<Node*> op_nodes;
   for (auto node : graph->op_nodes()) {
-    bool mark_for_clustering = false;
-
-    if (IsNGVariableType(node->type_string())) {
-      variable_type_nodes.push_back(node);
-      continue;
+    op_nodes.push_back(node);
+  }
+  vector<MarkingDecision> decisions(op_nodes.size());
+  vector<Status> decision_status(op_nodes.size());
+  std::mutex backend_mutex;
+
+  auto decide = [&](int64 begin, int64 end) {
+    for (int64 i = begin; i < end; i++) {
+      decision_status[i] = DecideNodeMarking(
+          op_nodes[i], skip_these_nodes, type_constraint_map,
+          confirmation_function_map, op_backend, ng_backend_type,
+          TFtoNgraphOpMap, backend_mutex, &decisions[i]);
     }
+  };
 
-    do {
-      // check if output node
-      bool skip_it = false;
-      TF_RETURN_IF_ERROR(CheckIfOutputNode(node, skip_these_nodes, skip_it));
-      if (skip_it) {
-        NGRAPH_VLOG(5) << "NGTF_OPTIMIZER: Found Output Node: " << node->name()
-                       << " - skip marking it for clustering";
-        break;
-      }
+  if (op_nodes.size() < MIN_NODES_FOR_PARALLEL_MARKING) {
+    decide(0, op_nodes.size());
+  } else {
+    int num_threads = port::NumSchedulableCPUs();
+    NGRAPH_VLOG(2) << "Marking " << op_nodes.size() << " nodes using "
+                   << num_threads << " threads";
+    thread::ThreadPool pool(Env::Default(), "ngraph_mark_for_clustering",
+                            num_threads);
+    pool.ParallelFor(op_nodes.size(), MARKING_COST_PER_NODE, decide);
+  }
 
-      // check placement
-      bool placement_ok = false;
-      TF_RETURN_IF_ERROR(NGraphPlacementRequested(node, placement_ok));
-      if (!placement_ok) {
-        NGRAPH_VLOG(5) << "Placement not requested: " << node->name();
-        break;
-      }
+  for (size_t i = 0; i < op_nodes.size(); i++) {
+    TF_RETURN_IF_ERROR(decision_status[i]);
 
-      // check node's confirmation constraints
-      bool confirmation_constraint_ok = false;
-      TF_RETURN_IF_ERROR(ConfirmationOk(node, confirmation_function_map,
-                                        confirmation_constraint_ok));
-      if (!confirmation_constraint_ok) {
-        NGRAPH_VLOG(5) << "Node does not meet confirmation constraints: "
-                       << node->name();
-        if (confirmation_function_map.find(node->type_string()) ==
-            confirmation_function_map.end()) {
-          // not found
-          no_support_histogram[node->type_string()]++;
-        } else {
-          // found
-          fail_confirmation_histogram[node->type_string()]++;
-        }
+    Node* node = op_nodes[i];
+    switch (decisions[i]) {
+      case MarkingDecision::VARIABLE:
+        variable_type_nodes.push_back(node);
+        continue;
+      case MarkingDecision::NO_SUPPORT:
+        no_support_histogram[node->type_string()]++;
         break;
-      }
-
-      // check input type constraints
-      bool type_constraint_ok = false;
-      TF_RETURN_IF_ERROR(
-          TypeConstraintOk(node, type_constraint_map, type_constraint_ok));
-      if (!type_constraint_ok) {
-        NGRAPH_VLOG(5) << "Inputs do not meet type constraints: "
-                       << node->name();
+      case MarkingDecision::FAIL_CONFIRMATION:
+        fail_confirmation_histogram[node->type_string()]++;
+        break;
+      case MarkingDecision::FAIL_CONSTRAINT:
         fail_constraint_histogram[node->type_string()]++;
         break;
-      }
-
-      // Check if op is supported by backend
-      bool is_supported = false;
-      TF_RETURN_IF_ERROR(IsSupportedByBackend(node, op_backend, TFtoNgraphOpMap,
-                                              is_supported));
-
-      if (!is_supported) {
-        NGRAPH_VLOG(5) << "TF Op " << node->name() << " of type "
-                       << node->type_string()
-                       << " is not supported by backend: " << ng_backend_type;
+      default:
         break;
-      }
-
-      // if all constraints are met, mark for clustering
-      mark_for_clustering = true;
-    } while (false);
+    }
 
     // Set the _ngraph_marked_for_clustering attribute if all constraints
     // are satisfied
-    if (mark_for_clustering) {
+    if (decisions[i] == MarkingDecision::ACCEPT) {
       NGRAPH_VLOG(4) << "Accepting: " << node->name() << "["
                      << node->type_string() << "]";
       nodes_marked_for_clustering.push_back(node);
@@ -1313,7 +1489,8 @@ bool InputIsStatic(const Node* node, int index) {
   return std::find(inputs.begin(), inputs.end(), index) != inputs.end();
 }
 
-Status GetStaticInputs(Graph* graph, std::vector<int32>* static_input_indexes) {
+Status GetStaticInputs(const Graph* graph,
+                       std::vector<int32>* static_input_indexes) {
   static_input_indexes->clear();
   for (auto node : graph->nodes()) {
     if (node->type_string() == "_Arg") {
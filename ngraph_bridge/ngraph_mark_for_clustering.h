@@ -45,7 +45,8 @@ void GetStaticInputs(const Node* node,
 bool InputIsStatic(const Node* node, int index);
 
 // Returns the static input indexes of the graph in vector static_input_indexes
-Status GetStaticInputs(Graph* graph, std::vector<int32>* static_input_indexes);
+Status GetStaticInputs(const Graph* graph,
+                       std::vector<int32>* static_input_indexes);
 
 Status GetNodeBackend(const Node* node, string* backend_name);
 void SetNodeBackend(Node* node, const string& backend_name);
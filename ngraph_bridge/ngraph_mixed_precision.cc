@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <set>
+#include <string>
+
+#include "tensorflow/core/lib/core/errors.h"
+
+#include "logging/ngraph_log.h"
+#include "ngraph_bridge/ngraph_builder.h"
+#include "ngraph_bridge/ngraph_mixed_precision.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+Status GetMixedPrecisionType(ng::element::Type* ng_et) {
+  const char* env_value = std::getenv("NGRAPH_TF_MIXED_PRECISION");
+  if (env_value == nullptr) {
+    *ng_et = ng::element::dynamic;
+    return Status::OK();
+  }
+  string precision(env_value);
+  if (precision == "bf16") {
+    *ng_et = ng::element::bf16;
+  } else if (precision == "f16") {
+    *ng_et = ng::element::f16;
+  } else {
+    return errors::InvalidArgument(
+        "NGRAPH_TF_MIXED_PRECISION must be bf16 or f16, got ", precision);
+  }
+  return Status::OK();
+}
+
+static bool IsLowered(const shared_ptr<ng::Node>& node) {
+  static const set<string> lowered{"BatchMatMul", "BatchMatMulTranspose",
+                                   "Convolution", "Dot", "GroupConvolution"};
+  if (lowered.count(node->description()) == 0 ||
+      node->get_output_size() != 1 ||
+      node->get_output_element_type(0) != ng::element::f32) {
+    return false;
+  }
+  for (auto arg : node->get_arguments()) {
+    if (arg->get_element_type() != ng::element::f32) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns arg converted to ng_et. The conversion back of a lowered op is
+// dropped instead.
+static shared_ptr<ng::Node> ConvertArg(const string& op_name,
+                                       const shared_ptr<ng::Node>& arg,
+                                       const ng::element::Type& ng_et) {
+  if (arg->description() == "Convert" &&
+      arg->get_argument(0)->get_element_type() == ng_et) {
+    return arg->get_argument(0);
+  }
+  auto convert = make_shared<ng::op::Convert>(arg, ng_et);
+  Builder::SetTracingInfo(op_name, convert);
+  return convert;
+}
+
+int LowerPrecision(const shared_ptr<ng::Function>& ng_function,
+                   const ng::element::Type& ng_et) {
+  int num_lowered = 0;
+  for (auto node : ng_function->get_ordered_ops()) {
+    if (!IsLowered(node)) {
+      continue;
+    }
+    const string& op_name = node->get_friendly_name();
+    ng::NodeVector new_args;
+    for (auto arg : node->get_arguments()) {
+      new_args.push_back(ConvertArg(op_name, arg, ng_et));
+    }
+    auto new_node = node->copy_with_new_args(new_args);
+    Builder::SetTracingInfo(op_name, new_node);
+    auto convert = make_shared<ng::op::Convert>(new_node, ng::element::f32);
+    Builder::SetTracingInfo(op_name, convert);
+    ng::replace_node(node, convert);
+    num_lowered++;
+  }
+  NGRAPH_VLOG(3) << "Computing " << num_lowered << " ops of "
+                 << ng_function->get_friendly_name() << " in " << ng_et;
+  return num_lowered;
+}
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
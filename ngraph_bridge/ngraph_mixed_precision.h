@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef NGRAPH_TF_BRIDGE_MIXED_PRECISION_H_
+#define NGRAPH_TF_BRIDGE_MIXED_PRECISION_H_
+#pragma once
+
+#include <memory>
+
+#include "tensorflow/core/lib/core/status.h"
+
+#include "ngraph/ngraph.hpp"
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Returns in *ng_et the element type the matrix multiplications and
+// convolutions of fp32 models are computed in, set with
+// NGRAPH_TF_MIXED_PRECISION=bf16 or NGRAPH_TF_MIXED_PRECISION=f16, or
+// ngraph::element::dynamic if the variable is not set.
+Status GetMixedPrecisionType(ngraph::element::Type* ng_et);
+
+// Converts the inputs of the fp32 Dot, BatchMatMul and Convolution ops of
+// the function to ng_et, and their outputs back to fp32, so that these ops
+// read half as many bytes. The other ops (reductions, normalizations,
+// softmax...) still compute in fp32. Conversions of constants are left to
+// FoldConstants, which stores the converted weights.
+//
+// Returns the number of ops lowered.
+int LowerPrecision(const std::shared_ptr<ngraph::Function>& ng_function,
+                   const ngraph::element::Type& ng_et);
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
+
+#endif  // NGRAPH_TF_BRIDGE_MIXED_PRECISION_H_
@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/shape_refiner.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/shape_inference.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/graph/algorithm.h"
+
+#include "logging/ngraph_log.h"
+#include "ngraph_bridge/ngraph_cluster_manager.h"
+#include "ngraph_bridge/ngraph_propagate_shapes.h"
+
+using namespace std;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+using shape_inference::InferenceContext;
+using shape_inference::ShapeHandle;
+
+static PartialTensorShape ToPartialTensorShape(InferenceContext* ctx,
+                                               ShapeHandle shape) {
+  if (!ctx->RankKnown(shape)) {
+    return PartialTensorShape();
+  }
+  std::vector<int64> dims(ctx->Rank(shape));
+  for (int i = 0; i < dims.size(); i++) {
+    dims[i] = ctx->Value(ctx->Dim(shape, i));
+  }
+  return PartialTensorShape(dims);
+}
+
+// Shape of the tensor feeding the index-th input of node, unknown if the
+// refiner could not infer it
+static PartialTensorShape GetInputShape(const ShapeRefiner& refiner,
+                                        const Node* node, int index) {
+  InferenceContext* ctx = refiner.GetContext(node);
+  if (ctx == nullptr) {
+    return PartialTensorShape();
+  }
+  return ToPartialTensorShape(ctx, ctx->input(index));
+}
+
+// Infers the output shapes of the cluster graph from the shapes of its
+// _Arg nodes
+static Status InferClusterOutputShapes(
+    const Graph& cluster_graph, const std::vector<PartialTensorShape>& inputs,
+    std::vector<PartialTensorShape>* outputs) {
+  ShapeRefiner refiner(cluster_graph.versions(), cluster_graph.op_registry());
+  refiner.set_require_shape_inference_fns(false);
+
+  std::vector<Node*> order;
+  GetReversePostOrder(cluster_graph, &order);
+  for (auto node : order) {
+    if (!node->IsOp()) {
+      continue;
+    }
+    Status status = refiner.AddNode(node);
+    if (!status.ok()) {
+      NGRAPH_VLOG(5) << "Could not infer shapes of " << node->name() << ": "
+                     << status.error_message();
+      continue;
+    }
+
+    int index;
+    if (node->type_string() == "_Arg") {
+      TF_RETURN_IF_ERROR(GetNodeAttr(node->attrs(), "index", &index));
+      if (index < 0 || index >= inputs.size()) {
+        return errors::Internal("Arg ", node->name(), " has index ", index,
+                                " but the encapsulate has ", inputs.size(),
+                                " inputs");
+      }
+      InferenceContext* ctx = refiner.GetContext(node);
+      ShapeHandle shape;
+      TF_RETURN_IF_ERROR(
+          ctx->MakeShapeFromPartialTensorShape(inputs[index], &shape));
+      TF_RETURN_IF_ERROR(refiner.SetShape(node, 0, shape));
+    } else if (node->type_string() == "_Retval") {
+      TF_RETURN_IF_ERROR(GetNodeAttr(node->attrs(), "index", &index));
+      if (index < 0 || index >= outputs->size()) {
+        return errors::Internal("Retval ", node->name(), " has index ", index,
+                                " but the encapsulate has ", outputs->size(),
+                                " outputs");
+      }
+      (*outputs)[index] = GetInputShape(refiner, node, 0);
+    }
+  }
+  return Status::OK();
+}
+
+bool IsShapePropagationEnabled() {
+  return std::getenv("NGRAPH_TF_DISABLE_SHAPE_PROPAGATION") == nullptr;
+}
+
+void InferGraphShapes(const Graph& graph, GraphShapes* shapes) {
+  ShapeRefiner refiner(graph.versions(), graph.op_registry());
+  refiner.set_require_shape_inference_fns(false);
+
+  shapes->assign(graph.num_node_ids(), {});
+  std::vector<Node*> order;
+  GetReversePostOrder(graph, &order);
+  for (auto node : order) {
+    if (!node->IsOp()) {
+      continue;
+    }
+    (*shapes)[node->id()].resize(node->num_outputs());
+    Status status = refiner.AddNode(node);
+    if (!status.ok()) {
+      NGRAPH_VLOG(5) << "Could not infer shapes of " << node->name() << ": "
+                     << status.error_message();
+      continue;
+    }
+    InferenceContext* ctx = refiner.GetContext(node);
+    for (int i = 0; i < node->num_outputs(); i++) {
+      (*shapes)[node->id()][i] = ToPartialTensorShape(ctx, ctx->output(i));
+    }
+  }
+}
+
+Status PropagateStaticShapes(Graph* graph) {
+  ShapeRefiner refiner(graph->versions(), graph->op_registry());
+  // The ops registered by the bridge have no shape functions, their outputs
+  // are unknown unless set below
+  refiner.set_require_shape_inference_fns(false);
+
+  std::vector<Node*> order;
+  GetReversePostOrder(*graph, &order);
+  for (auto node : order) {
+    if (!node->IsOp()) {
+      continue;
+    }
+    // Nodes whose shapes cannot be inferred are skipped, their consumers see
+    // unknown shapes
+    Status status = refiner.AddNode(node);
+    if (!status.ok()) {
+      NGRAPH_VLOG(5) << "Could not infer shapes of " << node->name() << ": "
+                     << status.error_message();
+      continue;
+    }
+    if (node->type_string() != "NGraphEncapsulate") {
+      continue;
+    }
+
+    std::vector<PartialTensorShape> input_shapes(node->num_inputs());
+    for (int i = 0; i < node->num_inputs(); i++) {
+      input_shapes[i] = GetInputShape(refiner, node, i);
+    }
+    std::vector<PartialTensorShape> output_shapes(node->num_outputs());
+
+    int cluster_idx;
+    TF_RETURN_IF_ERROR(
+        GetNodeAttr(node->attrs(), "ngraph_cluster", &cluster_idx));
+    std::shared_ptr<const Graph> cluster_graph;
+    TF_RETURN_IF_ERROR(
+        NGraphClusterManager::GetClusterTFGraph(cluster_idx, &cluster_graph));
+    if (cluster_graph != nullptr) {
+      TF_RETURN_IF_ERROR(InferClusterOutputShapes(*cluster_graph, input_shapes,
+                                                  &output_shapes));
+    }
+
+    InferenceContext* ctx = refiner.GetContext(node);
+    for (int i = 0; i < output_shapes.size(); i++) {
+      ShapeHandle shape;
+      TF_RETURN_IF_ERROR(
+          ctx->MakeShapeFromPartialTensorShape(output_shapes[i], &shape));
+      TF_RETURN_IF_ERROR(refiner.SetShape(node, i, shape));
+    }
+
+    if (NGRAPH_VLOG_IS_ON(4)) {
+      for (int i = 0; i < input_shapes.size(); i++) {
+        NGRAPH_VLOG(4) << node->name() << " input " << i << ": "
+                       << input_shapes[i].DebugString();
+      }
+      for (int i = 0; i < output_shapes.size(); i++) {
+        NGRAPH_VLOG(4) << node->name() << " output " << i << ": "
+                       << output_shapes[i].DebugString();
+      }
+    }
+    // Not prefixed with _ngraph_, which would make it part of the backend
+    // config
+    node->ClearAttr("_input_shapes");
+    node->AddAttr("_input_shapes", input_shapes);
+    node->ClearAttr("_output_shapes");
+    node->AddAttr("_output_shapes", output_shapes);
+  }
+  return Status::OK();
+}
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef NGRAPH_TF_BRIDGE_PROPAGATE_SHAPES_H_
+#define NGRAPH_TF_BRIDGE_PROPAGATE_SHAPES_H_
+#pragma once
+
+#include <vector>
+
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/graph/graph.h"
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Runs TF shape inference over a graph that has been through
+// EncapsulateClusters, so that what is statically known about shapes
+// (Placeholder shapes, dataset output_shapes, constant inputs like the shape
+// of a Reshape) reaches every NGraphEncapsulate. Shapes are propagated
+// through the encapsulates too, by inferring the shapes of their cluster
+// graphs.
+//
+// Each NGraphEncapsulate gets the (possibly partial) shapes of its inputs in
+// _input_shapes and of its outputs in _output_shapes. Shapes that cannot be
+// inferred are left unknown; this pass never fails because of shape
+// inference.
+//
+// EncapsulateClusters skips this pass if NGRAPH_TF_DISABLE_SHAPE_PROPAGATION
+// is set.
+Status PropagateStaticShapes(Graph* graph);
+
+// False if NGRAPH_TF_DISABLE_SHAPE_PROPAGATION is set, in which case no shape
+// inference is run over whole graphs
+bool IsShapePropagationEnabled();
+
+// The shapes of the outputs of the nodes of a graph, indexed by node id and
+// then by output index
+using GraphShapes = std::vector<std::vector<PartialTensorShape>>;
+
+// Infers the output shapes of all the nodes of a graph with TF shape
+// inference. Shapes that cannot be inferred are left unknown.
+void InferGraphShapes(const Graph& graph, GraphShapes* shapes);
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
+
+#endif  // NGRAPH_TF_BRIDGE_PROPAGATE_SHAPES_H_
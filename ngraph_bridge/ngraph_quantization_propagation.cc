@@ -0,0 +1,176 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <cstring>
+#include <set>
+#include <string>
+
+#include "logging/ngraph_log.h"
+#include "ngraph_bridge/ngraph_builder.h"
+#include "ngraph_bridge/ngraph_quantization_propagation.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Whether a and b are the same constant value
+static bool SameConstant(const shared_ptr<ng::Node>& a,
+                         const shared_ptr<ng::Node>& b) {
+  if (a == b) {
+    return true;
+  }
+  auto constant_a = dynamic_pointer_cast<ng::op::Constant>(a);
+  auto constant_b = dynamic_pointer_cast<ng::op::Constant>(b);
+  if (constant_a == nullptr || constant_b == nullptr ||
+      constant_a->get_element_type() != constant_b->get_element_type() ||
+      constant_a->get_shape() != constant_b->get_shape()) {
+    return false;
+  }
+  size_t bytes = ng::shape_size(constant_a->get_shape()) *
+                 constant_a->get_element_type().size();
+  return memcmp(constant_a->get_data_ptr(), constant_b->get_data_ptr(),
+                bytes) == 0;
+}
+
+// Whether dequantize maps the quantized values to floats in increasing
+// order, so that it commutes with max pooling, maximum and minimum
+static bool IsIncreasing(const shared_ptr<ng::op::Dequantize>& dequantize) {
+  auto scale =
+      dynamic_pointer_cast<ng::op::Constant>(dequantize->get_argument(1));
+  if (scale == nullptr) {
+    return false;
+  }
+  for (auto value : scale->cast_vector<double>()) {
+    if (!(value > 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool SameQuantization(const shared_ptr<ng::op::Dequantize>& a,
+                             const shared_ptr<ng::op::Dequantize>& b) {
+  return a->get_argument(0)->get_element_type() ==
+             b->get_argument(0)->get_element_type() &&
+         a->get_element_type() == b->get_element_type() &&
+         a->get_axes() == b->get_axes() &&
+         SameConstant(a->get_argument(1), b->get_argument(1)) &&
+         SameConstant(a->get_argument(2), b->get_argument(2));
+}
+
+// Whether op(dequantize(x)) == dequantize(op(x)) for the ops of this type
+static bool CommutesWithDequantize(const shared_ptr<ng::Node>& node) {
+  static const set<string> data_movement{"Concat", "Reshape", "Reverse",
+                                         "Slice"};
+  static const set<string> order_preserving{"Max", "MaxPool", "Maximum",
+                                            "Min", "Minimum"};
+  return data_movement.count(node->description()) != 0 ||
+         order_preserving.count(node->description()) != 0;
+}
+
+// Moves the Dequantize ops feeding node below it. Returns true if the
+// function changed.
+static bool SinkDequantize(const shared_ptr<ng::Node>& node) {
+  if (!CommutesWithDequantize(node) || node->get_output_size() != 1) {
+    return false;
+  }
+  shared_ptr<ng::op::Dequantize> first;
+  ng::NodeVector new_args;
+  for (auto arg : node->get_arguments()) {
+    auto dequantize = dynamic_pointer_cast<ng::op::Dequantize>(arg);
+    // Per channel scales do not follow the axes of the op
+    if (dequantize == nullptr || !dequantize->get_axes().empty() ||
+        !IsIncreasing(dequantize) ||
+        (first != nullptr && !SameQuantization(first, dequantize))) {
+      return false;
+    }
+    if (first == nullptr) {
+      first = dequantize;
+    }
+    new_args.push_back(dequantize->get_argument(0));
+  }
+  if (first == nullptr) {
+    return false;
+  }
+
+  const string& op_name = node->get_friendly_name();
+  auto new_node = node->copy_with_new_args(new_args);
+  Builder::SetTracingInfo(op_name, new_node);
+  auto dequantize = make_shared<ng::op::Dequantize>(
+      new_node, first->get_argument(1), first->get_argument(2),
+      first->get_element_type(), first->get_axes());
+  Builder::SetTracingInfo(op_name, dequantize);
+  ng::replace_node(node, dequantize);
+  return true;
+}
+
+// Replaces a Quantize of a Dequantize with the same parameters with the
+// quantized tensor. Returns true if the function changed.
+static bool DropQuantizeOfDequantize(const shared_ptr<ng::Node>& node) {
+  auto quantize = dynamic_pointer_cast<ng::op::Quantize>(node);
+  if (quantize == nullptr) {
+    return false;
+  }
+  auto dequantize =
+      dynamic_pointer_cast<ng::op::Dequantize>(quantize->get_argument(0));
+  if (dequantize == nullptr ||
+      quantize->get_element_type() !=
+          dequantize->get_argument(0)->get_element_type() ||
+      quantize->get_axes() != dequantize->get_axes() ||
+      !SameConstant(quantize->get_argument(1), dequantize->get_argument(1)) ||
+      !SameConstant(quantize->get_argument(2), dequantize->get_argument(2))) {
+    return false;
+  }
+  ng::replace_node(quantize, dequantize->get_argument(0));
+  return true;
+}
+
+static int CountQuantizeOps(const shared_ptr<ng::Function>& ng_function) {
+  int count = 0;
+  for (auto node : ng_function->get_ordered_ops()) {
+    if (dynamic_pointer_cast<ng::op::Quantize>(node) != nullptr ||
+        dynamic_pointer_cast<ng::op::Dequantize>(node) != nullptr) {
+      count++;
+    }
+  }
+  return count;
+}
+
+int PropagateQuantization(const shared_ptr<ng::Function>& ng_function) {
+  int num_quantize_ops = CountQuantizeOps(ng_function);
+  // In topological order, each op sees the Dequantize ops already moved below
+  // its arguments, so a single pass is enough
+  for (auto node : ng_function->get_ordered_ops()) {
+    // Nodes replaced earlier in this pass are no longer in the function
+    if (node->get_users().empty() && !node->is_output()) {
+      continue;
+    }
+    if (!SinkDequantize(node)) {
+      DropQuantizeOfDequantize(node);
+    }
+  }
+  int removed = num_quantize_ops - CountQuantizeOps(ng_function);
+  NGRAPH_VLOG(3) << "Removed " << removed << " quantize ops from "
+                 << ng_function->get_friendly_name();
+  return removed;
+}
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef NGRAPH_TF_BRIDGE_QUANTIZATION_PROPAGATION_H_
+#define NGRAPH_TF_BRIDGE_QUANTIZATION_PROPAGATION_H_
+#pragma once
+
+#include <memory>
+
+#include "ngraph/ngraph.hpp"
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Quantized graphs dequantize around every op that has no quantized TF
+// kernel (Dequantize -> Reshape -> MaxPool -> QuantizeV2, say), and
+// QuantizeAndDequantizeV2 leaves a Quantize/Dequantize pair behind each fake
+// quantized tensor, so the int8 tensors make round trips through float.
+//
+// This pass moves Dequantize ops down through the ops that commute with
+// them exactly: data movement (concat, reshape, reverse, slice) and the
+// maximum and minimum ops (max pooling, reductions, elementwise), when all
+// their operands are dequantized with the same positive scale and offset.
+// These ops then run on the int8 tensors. It also drops a Quantize of a
+// Dequantize when both use the same (constant) scale, offset and type.
+//
+// Runs after FoldConstants, so that the scales computed from the min and max
+// inputs are constants.
+//
+// Returns the number of Quantize and Dequantize ops removed.
+int PropagateQuantization(const std::shared_ptr<ngraph::Function>& ng_function);
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
+
+#endif  // NGRAPH_TF_BRIDGE_QUANTIZATION_PROPAGATION_H_
@@ -30,6 +30,7 @@
 #include "ngraph_bridge/ngraph_deassign_clusters.h"
 #include "ngraph_bridge/ngraph_encapsulate_clusters.h"
 #include "ngraph_bridge/ngraph_enter_prefetch_in_catalog.h"
+#include "ngraph_bridge/ngraph_flatten_control_flow.h"
 #include "ngraph_bridge/ngraph_mark_for_clustering.h"
 #include "ngraph_bridge/ngraph_utils.h"
 
@@ -67,6 +68,7 @@ mutex NGraphRewritePass::s_serial_counter_mutex;
 //
 // The pass has several phases, each executed in the below sequence:
 //
+//   0. Control Flow Flattening, opt-in [ngraph_flatten_control_flow.cc]
 //   1. Marking [ngraph_mark_for_clustering.cc]
 //   2. Cluster Assignment [ngraph_assign_clusters.cc]
 //   3. Cluster Deassignment [ngraph_deassign_clusters.cc]
@@ -83,6 +85,10 @@ mutex NGraphRewritePass::s_serial_counter_mutex;
 //   NGRAPH_TF_DUMP_ENCAPSULATED_GRAPHS=1  dumps graphs after phase 4
 //   NGRAPH_TF_DUMP_GRAPHS=1               all of the above
 //
+// Setting NGRAPH_TF_FRAGMENTATION_REPORT=<prefix> writes the edges phase 2
+// could not contract, ranked by their estimated cost, to <prefix>_<n>.json
+// [ngraph_fragmentation_report.h].
+//
 class NGraphEncapsulationPass : public NGraphRewritePass {
  public:
   Status Run(const GraphOptimizationPassOptions& options) override {
@@ -115,7 +121,6 @@ class NGraphEncapsulationPass : public NGraphRewritePass {
       NGRAPH_VLOG(1) << std::string("Rewrite pass will not run because ") +
                             (already_processed ? "graph is already preprocessed"
                                                : "ngraph is disabled");
-      NGraphClusterManager::EvictAllClusters();
       return Status::OK();
     }
 
@@ -139,8 +144,12 @@ class NGraphEncapsulationPass : public NGraphRewritePass {
 
     // Now Process the Graph
 
-    // 1. Mark for clustering then, if requested, dump the graphs.
+    // 0. Flatten control flow (only if NGRAPH_TF_CLUSTER_CONTROL_FLOW is set)
     std::set<string> skip_these_nodes = {};
+    TF_RETURN_IF_ERROR(
+        FlattenControlFlow(options.graph->get(), skip_these_nodes));
+
+    // 1. Mark for clustering then, if requested, dump the graphs.
     TF_RETURN_IF_ERROR(MarkForClustering(options.graph->get(), skip_these_nodes,
                                          backend_creation_string));
     if (DumpMarkedGraphs()) {
@@ -170,6 +179,13 @@ class NGraphEncapsulationPass : public NGraphRewritePass {
     }
     // TODO: not using fdeflib_new in this path. Only grappler path uses it
     delete (fdeflib_new);
+    // Ties the clusters to the session running the graph
+    if (options.device_set != nullptr &&
+        options.device_set->client_device() != nullptr) {
+      TF_RETURN_IF_ERROR(NGraphClusterManager::HoldClusters(
+          options.graph->get(),
+          options.device_set->client_device()->resource_manager()));
+    }
     if (DumpEncapsulatedGraphs()) {
       DumpGraphs(options, idx, "encapsulated",
                  "Graph with Clusters Encapsulated");
@@ -0,0 +1,163 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <cstring>
+
+#include "logging/ngraph_log.h"
+#include "ngraph_bridge/ngraph_builder.h"
+#include "ngraph_bridge/ngraph_sparse_updates.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Whether all the bytes of the constant are zero
+static bool IsZero(const shared_ptr<ng::Node>& node) {
+  auto constant = dynamic_pointer_cast<ng::op::Constant>(node);
+  if (constant == nullptr) {
+    return false;
+  }
+  const char* data = static_cast<const char*>(constant->get_data_ptr());
+  size_t bytes = ng::shape_size(constant->get_shape()) *
+                 constant->get_element_type().size();
+  for (size_t i = 0; i < bytes; i++) {
+    if (data[i] != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// If node is a ScatterAdd of updates into zeros only used by user, returns
+// it
+static shared_ptr<ng::op::ScatterAdd> GetSparseTensor(
+    const shared_ptr<ng::Node>& node, const shared_ptr<ng::Node>& user) {
+  auto scatter_add = dynamic_pointer_cast<ng::op::ScatterAdd>(node);
+  if (scatter_add == nullptr || !IsZero(scatter_add->get_argument(0))) {
+    return nullptr;
+  }
+  for (auto node_user : node->get_users()) {
+    if (node_user != user) {
+      return nullptr;
+    }
+  }
+  return scatter_add;
+}
+
+// If node is a broadcast scalar or a constant with all elements equal,
+// returns the scalar
+static shared_ptr<ng::Node> GetScalar(const shared_ptr<ng::Node>& node) {
+  auto broadcast = dynamic_pointer_cast<ng::op::Broadcast>(node);
+  if (broadcast != nullptr) {
+    auto arg = broadcast->get_argument(0);
+    return arg->get_shape().empty() ? arg : nullptr;
+  }
+  auto constant = dynamic_pointer_cast<ng::op::Constant>(node);
+  if (constant == nullptr || ng::shape_size(constant->get_shape()) == 0) {
+    return nullptr;
+  }
+  const char* data = static_cast<const char*>(constant->get_data_ptr());
+  size_t element_size = constant->get_element_type().size();
+  size_t n_elements = ng::shape_size(constant->get_shape());
+  for (size_t i = 1; i < n_elements; i++) {
+    if (memcmp(data, data + i * element_size, element_size) != 0) {
+      return nullptr;
+    }
+  }
+  auto scalar = make_shared<ng::op::Constant>(constant->get_element_type(),
+                                              ng::Shape{}, data);
+  Builder::SetTracingInfo(constant->get_friendly_name(), scalar);
+  return scalar;
+}
+
+// Rewrites an Add, Subtract or Multiply of a sparse tensor. Returns true if
+// the function changed.
+static bool FuseSparseUpdate(const shared_ptr<ng::Node>& node) {
+  bool is_add = node->description() == "Add";
+  bool is_subtract = node->description() == "Subtract";
+  bool is_multiply = node->description() == "Multiply";
+  if (!is_add && !is_subtract && !is_multiply) {
+    return false;
+  }
+  auto lhs = node->get_argument(0);
+  auto rhs = node->get_argument(1);
+  if (lhs->get_shape() != rhs->get_shape()) {
+    return false;
+  }
+  // Only the left operand of a subtraction can be dense
+  auto sparse = GetSparseTensor(rhs, node);
+  auto dense = lhs;
+  if (sparse == nullptr && !is_subtract) {
+    sparse = GetSparseTensor(lhs, node);
+    dense = rhs;
+  }
+  if (sparse == nullptr) {
+    return false;
+  }
+
+  const string& op_name = node->get_friendly_name();
+  auto indices = sparse->get_argument(1);
+  auto updates = sparse->get_argument(2);
+  shared_ptr<ng::Node> new_node;
+  if (is_multiply) {
+    auto scalar = GetScalar(dense);
+    if (scalar == nullptr) {
+      return false;
+    }
+    ng::AxisSet broadcast_axes;
+    for (size_t i = 0; i < updates->get_shape().size(); i++) {
+      broadcast_axes.insert(i);
+    }
+    auto factor = make_shared<ng::op::Broadcast>(
+        scalar, updates->get_shape(), broadcast_axes);
+    Builder::SetTracingInfo(op_name, factor);
+    auto scaled_updates = make_shared<ng::op::Multiply>(factor, updates);
+    Builder::SetTracingInfo(op_name, scaled_updates);
+    new_node = make_shared<ng::op::ScatterAdd>(sparse->get_argument(0),
+                                               indices, scaled_updates);
+  } else if (is_subtract) {
+    auto negated_updates = make_shared<ng::op::Negative>(updates);
+    Builder::SetTracingInfo(op_name, negated_updates);
+    new_node =
+        make_shared<ng::op::ScatterAdd>(dense, indices, negated_updates);
+  } else {
+    new_node = make_shared<ng::op::ScatterAdd>(dense, indices, updates);
+  }
+  Builder::SetTracingInfo(op_name, new_node);
+  ng::replace_node(node, new_node);
+  return true;
+}
+
+int FuseSparseUpdates(const shared_ptr<ng::Function>& ng_function) {
+  int num_fused = 0;
+  // In topological order, the scaling of a sparse gradient is rewritten
+  // before the update that uses it
+  for (auto node : ng_function->get_ordered_ops()) {
+    if (FuseSparseUpdate(node)) {
+      num_fused++;
+    }
+  }
+  NGRAPH_VLOG(3) << "Rewrote " << num_fused << " dense updates of "
+                 << ng_function->get_friendly_name();
+  return num_fused;
+}
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
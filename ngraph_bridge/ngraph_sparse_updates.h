@@ -0,0 +1,49 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef NGRAPH_TF_BRIDGE_SPARSE_UPDATES_H_
+#define NGRAPH_TF_BRIDGE_SPARSE_UPDATES_H_
+#pragma once
+
+#include <memory>
+
+#include "ngraph/ngraph.hpp"
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// The gradient of an embedding lookup (GatherV2) is made dense with an
+// UnsortedSegmentSum, which is translated to a ScatterAdd of the looked up
+// rows into a zero tensor of the size of the table. The optimizer then
+// scales it and subtracts it from the table, so every step reads and writes
+// the whole table several times, whatever the number of rows looked up.
+//
+// This pass rewrites
+//   x + ScatterAdd(0, ids, u)  into  ScatterAdd(x, ids, u)
+//   x - ScatterAdd(0, ids, u)  into  ScatterAdd(x, ids, -u)
+//   s * ScatterAdd(0, ids, u)  into  ScatterAdd(0, ids, s * u)
+// for scalar (broadcast or splat constant) s, so that the update only
+// computes the rows that were looked up.
+//
+// Returns the number of ops rewritten.
+int FuseSparseUpdates(const std::shared_ptr<ngraph::Function>& ng_function);
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
+
+#endif  // NGRAPH_TF_BRIDGE_SPARSE_UPDATES_H_
@@ -52,6 +52,7 @@ void NGraphTensorManager::Initialize() {
         auto shared_name = NGraphCatalog::GetInputVariableSharedName(
             m_ng_encap_graph_id, m_ng_encap_node_name, index);
         input_variable_shared_name_map.insert({index, shared_name});
+        m_input_variable_shared_names.push_back(shared_name);
       } catch (const std::exception& exp) {
         throw runtime_error(
             "Could not find variable shared name in catalog for input index " +
@@ -73,6 +74,10 @@ void NGraphTensorManager::Initialize() {
             NGraphCatalog::GetInfoFromEncapOutputInfoMap(
                 m_ng_encap_graph_id, m_ng_encap_node_name, index);
         output_variable_info_map.insert({index, shared_name_update_tf_tensor});
+        m_output_variable_shared_names.push_back(
+            get<0>(shared_name_update_tf_tensor));
+        m_output_variables_update_tf_tensor.push_back(
+            get<1>(shared_name_update_tf_tensor));
       } catch (const std::exception& exp) {
         throw runtime_error(
             "Could not find variable shared name and update_tf_tensor "
@@ -233,5 +238,43 @@ Status NGraphTensorManager::GetOutputVariableUpdateTFTensor(
   return Status::OK();
 }
 
+//---------------------------------------------------------------------------
+//  NGraphTensorManager::MakeExecutionPlan
+//---------------------------------------------------------------------------
+Status NGraphTensorManager::MakeExecutionPlan(
+    const shared_ptr<ng::runtime::Executable>& ng_exec,
+    shared_ptr<const NGraphExecutionPlan>* plan) {
+  const auto& parameters = ng_exec->get_parameters();
+  const auto& results = ng_exec->get_results();
+  if (parameters.size() != m_number_of_inputs) {
+    return errors::Internal("Num of inputs from TensorManager ",
+                            m_number_of_inputs, " and num of parameters from ",
+                            "exec ", parameters.size(), " do not match");
+  }
+  if (results.size() != m_number_of_outputs) {
+    return errors::Internal("Num of outputs from TensorManager ",
+                            m_number_of_outputs, " and number of exec outputs ",
+                            results.size(), " do not match");
+  }
+
+  auto new_plan = make_shared<NGraphExecutionPlan>();
+  for (int input_index : m_pipelined_input_indexes) {
+    const auto& parameter = parameters[input_index];
+    new_plan->pipelined_input_bytes.push_back(
+        ng::shape_size(parameter->get_shape()) *
+        parameter->get_element_type().size());
+  }
+  for (const auto& result : results) {
+    TensorShape tf_shape;
+    for (auto dim : result->get_shape()) {
+      tf_shape.AddDim(dim);
+    }
+    new_plan->output_shapes.push_back(tf_shape);
+    new_plan->output_element_types.push_back(result->get_element_type());
+  }
+  *plan = new_plan;
+  return Status::OK();
+}
+
 }  // namespace ngraph_bridge
 }  // namespace tensorflow
\ No newline at end of file
@@ -23,8 +23,10 @@
 #include <vector>
 
 #include "tensorflow/core/common_runtime/dma_helper.h"
+#include "tensorflow/core/framework/tensor_shape.h"
 
 #include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/backend.hpp"
 
 using namespace std;
 namespace ng = ngraph;
@@ -32,6 +34,16 @@ namespace tensorflow {
 
 namespace ngraph_bridge {
 
+// What Compute needs to bind the tensors of one signature, worked out once
+// when its executable is created rather than on every step
+struct NGraphExecutionPlan {
+  // Bytes copied into each pipelined input, wrt pipelined inputs
+  vector<size_t> pipelined_input_bytes;
+  // Shape and element type of each output
+  vector<TensorShape> output_shapes;
+  vector<ng::element::Type> output_element_types;
+};
+
 class NGraphTensorManager {
  public:
   explicit NGraphTensorManager(const string ng_encap_node_name,
@@ -109,6 +121,26 @@ class NGraphTensorManager {
   Status GetOutputVariableUpdateTFTensor(const int& output_index,
                                          bool* output_var_update_tf_tensor);
 
+  // shared names of the ng-variables, in the order of
+  // GetInputIndexesFedByVariables
+  const vector<string>& GetInputVariableSharedNames() {
+    return m_input_variable_shared_names;
+  }
+
+  // shared names and update_tf_tensor info of the ng-variables, in the order
+  // of GetOutputIndexesAssigningVariables
+  const vector<string>& GetOutputVariableSharedNames() {
+    return m_output_variable_shared_names;
+  }
+  const vector<bool>& GetOutputVariablesUpdateTFTensor() {
+    return m_output_variables_update_tf_tensor;
+  }
+
+  // Checks the executable against the inputs and outputs of the encapsulate
+  // and makes its execution plan
+  Status MakeExecutionPlan(const shared_ptr<ng::runtime::Executable>& ng_exec,
+                           shared_ptr<const NGraphExecutionPlan>* plan);
+
   void Print();
 
  private:
@@ -150,6 +182,11 @@ class NGraphTensorManager {
   // Book-keeping for weights-on-device optimizations
   unordered_map<int, string> input_variable_shared_name_map;
   unordered_map<int, tuple<string, bool>> output_variable_info_map;
+
+  // The same, flattened for Compute
+  vector<string> m_input_variable_shared_names;
+  vector<string> m_output_variable_shared_names;
+  vector<bool> m_output_variables_update_tf_tensor;
 };
 
 }  // namespace ngraph_bridge
@@ -0,0 +1,260 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "ngraph/op/util/binary_elementwise_arithmetic.hpp"
+#include "ngraph/op/util/binary_elementwise_comparison.hpp"
+#include "ngraph/op/util/unary_elementwise_arithmetic.hpp"
+
+#include "logging/ngraph_log.h"
+#include "ngraph_bridge/ngraph_builder.h"
+#include "ngraph_bridge/ngraph_transpose_sinking.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// Upper bound on the passes over the function, each pass moves every
+// transpose at least one op down or stops
+static const int MAX_SINKING_PASSES = 1000;
+
+// If node is a Reshape that only permutes the axes of its argument, returns
+// true and the permutation in *order
+static bool GetTransposeOrder(const shared_ptr<ng::Node>& node,
+                              ng::AxisVector* order) {
+  auto reshape = dynamic_pointer_cast<ng::op::Reshape>(node);
+  if (reshape == nullptr || !reshape->get_is_transpose()) {
+    return false;
+  }
+  const ng::Shape& arg_shape = reshape->get_argument(0)->get_shape();
+  const ng::AxisVector& input_order = reshape->get_input_order();
+  if (input_order.size() != arg_shape.size()) {
+    return false;
+  }
+  ng::Shape permuted_shape(arg_shape.size());
+  for (size_t i = 0; i < input_order.size(); i++) {
+    permuted_shape[i] = arg_shape[input_order[i]];
+  }
+  if (permuted_shape != reshape->get_shape()) {
+    return false;
+  }
+  *order = input_order;
+  return true;
+}
+
+static ng::AxisVector InvertOrder(const ng::AxisVector& order) {
+  ng::AxisVector inverse(order.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    inverse[order[i]] = i;
+  }
+  return inverse;
+}
+
+static bool IsIdentityOrder(const ng::AxisVector& order) {
+  for (size_t i = 0; i < order.size(); i++) {
+    if (order[i] != i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Transposes arg (in the layout before a transpose of the given order)
+static shared_ptr<ng::Node> MakeTranspose(const string& op_name,
+                                          const shared_ptr<ng::Node>& arg,
+                                          const ng::AxisVector& order) {
+  const ng::Shape& arg_shape = arg->get_shape();
+  ng::Shape shape(order.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    shape[i] = arg_shape[order[i]];
+  }
+  auto transpose = make_shared<ng::op::Reshape>(arg, order, shape);
+  Builder::SetTracingInfo(op_name, transpose);
+  return transpose;
+}
+
+// Whether all the users of node are user
+static bool HasSingleUser(const shared_ptr<ng::Node>& node,
+                          const shared_ptr<ng::Node>& user) {
+  for (auto node_user : node->get_users()) {
+    if (node_user != user) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the operand of an elementwise op in the layout before a transpose
+// of the given order (so that transposing it gives operand), or nullptr if
+// that would take more than a transpose of a constant
+static shared_ptr<ng::Node> UntransposeOperand(
+    const shared_ptr<ng::Node>& operand, const ng::AxisVector& order,
+    const shared_ptr<ng::Node>& elementwise_op) {
+  ng::AxisVector operand_order;
+  if (GetTransposeOrder(operand, &operand_order) && operand_order == order &&
+      HasSingleUser(operand, elementwise_op)) {
+    return operand->get_argument(0);
+  }
+
+  const string& op_name = elementwise_op->get_friendly_name();
+  if (operand->is_constant()) {
+    // Left to constant folding
+    return MakeTranspose(op_name, operand, InvertOrder(order));
+  }
+
+  // A scalar or vector broadcast (a bias, say) is broadcast to the other
+  // layout instead. Axis i of operand is axis order[i] before the transpose.
+  auto broadcast = dynamic_pointer_cast<ng::op::Broadcast>(operand);
+  if (broadcast != nullptr &&
+      broadcast->get_argument(0)->get_shape().size() <= 1 &&
+      HasSingleUser(operand, elementwise_op)) {
+    const ng::Shape& shape = broadcast->get_shape();
+    ng::Shape untransposed_shape(shape.size());
+    for (size_t i = 0; i < shape.size(); i++) {
+      untransposed_shape[order[i]] = shape[i];
+    }
+    ng::AxisSet untransposed_axes;
+    for (auto axis : broadcast->get_broadcast_axes()) {
+      untransposed_axes.insert(order[axis]);
+    }
+    auto untransposed = make_shared<ng::op::Broadcast>(
+        broadcast->get_argument(0), untransposed_shape, untransposed_axes);
+    Builder::SetTracingInfo(broadcast->get_friendly_name(), untransposed);
+    return untransposed;
+  }
+  return nullptr;
+}
+
+static bool IsElementwise(const shared_ptr<ng::Node>& node) {
+  if (dynamic_pointer_cast<ng::op::util::UnaryElementwiseArithmetic>(node) !=
+      nullptr) {
+    return true;
+  }
+  // Implicitly broadcasting ops are left alone
+  auto arithmetic =
+      dynamic_pointer_cast<ng::op::util::BinaryElementwiseArithmetic>(node);
+  if (arithmetic != nullptr) {
+    return arithmetic->get_autob().m_type == ng::op::AutoBroadcastType::NONE;
+  }
+  auto comparison =
+      dynamic_pointer_cast<ng::op::util::BinaryElementwiseComparison>(node);
+  if (comparison != nullptr) {
+    return comparison->get_autob().m_type == ng::op::AutoBroadcastType::NONE;
+  }
+  return false;
+}
+
+// Moves a transpose of a non constant tensor feeding the elementwise op below
+// it. Returns true if the function changed.
+static bool SinkThroughElementwise(const shared_ptr<ng::Node>& node) {
+  ng::AxisVector order;
+  bool found = false;
+  for (auto arg : node->get_arguments()) {
+    if (GetTransposeOrder(arg, &order) &&
+        !arg->get_argument(0)->is_constant() && HasSingleUser(arg, node)) {
+      found = true;
+      break;
+    }
+  }
+  if (!found) {
+    return false;
+  }
+
+  ng::NodeVector new_args;
+  for (auto arg : node->get_arguments()) {
+    auto new_arg = UntransposeOperand(arg, order, node);
+    if (new_arg == nullptr) {
+      return false;
+    }
+    new_args.push_back(new_arg);
+  }
+
+  const string& op_name = node->get_friendly_name();
+  auto new_node = node->copy_with_new_args(new_args);
+  Builder::SetTracingInfo(op_name, new_node);
+  ng::replace_node(node, MakeTranspose(op_name, new_node, order));
+  return true;
+}
+
+// Merges a transpose of a transpose into one, or none if they cancel out.
+// Returns true if the function changed.
+static bool MergeTransposes(const shared_ptr<ng::Node>& node) {
+  ng::AxisVector order, arg_order;
+  if (!GetTransposeOrder(node, &order)) {
+    return false;
+  }
+  auto arg = node->get_argument(0);
+  if (!GetTransposeOrder(arg, &arg_order)) {
+    return false;
+  }
+
+  // Axis i of node is axis order[i] of arg, which is axis arg_order[order[i]]
+  // of the argument of arg
+  ng::AxisVector merged_order(order.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    merged_order[i] = arg_order[order[i]];
+  }
+  auto source = arg->get_argument(0);
+  if (IsIdentityOrder(merged_order)) {
+    ng::replace_node(node, source);
+  } else {
+    ng::replace_node(node, MakeTranspose(node->get_friendly_name(), source,
+                                         merged_order));
+  }
+  return true;
+}
+
+static int CountTransposes(const shared_ptr<ng::Function>& ng_function) {
+  int count = 0;
+  ng::AxisVector order;
+  for (auto node : ng_function->get_ordered_ops()) {
+    if (GetTransposeOrder(node, &order)) {
+      count++;
+    }
+  }
+  return count;
+}
+
+int SinkTransposes(const shared_ptr<ng::Function>& ng_function) {
+  int num_transposes = CountTransposes(ng_function);
+  for (int pass = 0; pass < MAX_SINKING_PASSES; pass++) {
+    bool changed = false;
+    for (auto node : ng_function->get_ordered_ops()) {
+      // Nodes replaced earlier in this pass are no longer in the function
+      if (node->get_users().empty() && !node->is_output()) {
+        continue;
+      }
+      if (IsElementwise(node)) {
+        changed |= SinkThroughElementwise(node);
+      } else {
+        changed |= MergeTransposes(node);
+      }
+    }
+    if (!changed) {
+      break;
+    }
+  }
+  int removed = num_transposes - CountTransposes(ng_function);
+  NGRAPH_VLOG(3) << "Removed " << removed << " transposes from "
+                 << ng_function->get_friendly_name();
+  return removed;
+}
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
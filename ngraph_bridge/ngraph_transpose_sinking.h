@@ -0,0 +1,48 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef NGRAPH_TF_BRIDGE_TRANSPOSE_SINKING_H_
+#define NGRAPH_TF_BRIDGE_TRANSPOSE_SINKING_H_
+#pragma once
+
+#include <memory>
+
+#include "ngraph/ngraph.hpp"
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+// The NHWC conv, pool and batch norm translators transpose their input to
+// NCHW and their output back to NHWC (see BatchToNGraph and
+// BatchToTensorflow), so consecutive layers leave a pair of inverse
+// transposes around every elementwise op between them.
+//
+// This pass moves transposes of non constant tensors down through
+// elementwise ops (unary ops, and binary ops whose other operand is
+// transposed the same way, a constant, or a broadcast vector), and merges
+// consecutive transposes, dropping those that cancel out. The elementwise ops
+// then run in the layout of the producing layer, and tensors stay in NCHW
+// from one layer to the next.
+//
+// Returns the number of transposes removed.
+int SinkTransposes(const std::shared_ptr<ngraph::Function>& ng_function);
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
+
+#endif  // NGRAPH_TF_BRIDGE_TRANSPOSE_SINKING_H_
@@ -14,9 +14,11 @@
  * limitations under the License.
  *******************************************************************************/
 
+#include <cctype>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <set>
 #include <sstream>
 
 #include "tensorflow/core/common_runtime/dma_helper.h"
@@ -220,9 +222,7 @@ Status TensorToStream(std::ostream& ostream, const Tensor& tensor) {
       TensorDataToStream<bool>(ostream, n_elements, data);
       break;
     case DT_BFLOAT16:
-      return errors::Internal(
-          "TensorToStream got data type bfloat16. No compatible standard C++ "
-          "data type.");
+      TensorDataToStream<bfloat16>(ostream, n_elements, data);
       break;
     default:
       return errors::Internal("TensorToStream got unsupported data type ",
@@ -241,6 +241,9 @@ Status TFDataTypeToNGraphElementType(DataType tf_dt,
     case DataType::DT_DOUBLE:
       *ng_et = ng::element::f64;
       break;
+    case DataType::DT_HALF:
+      *ng_et = ng::element::f16;
+      break;
     case DataType::DT_INT32:
       *ng_et = ng::element::i32;
       break;
@@ -273,6 +276,7 @@ Status TFDataTypeToNGraphElementType(DataType tf_dt,
       break;
     case DataType::DT_QINT32:
       *ng_et = ng::element::i32;
+      break;
     case DataType::DT_BFLOAT16:
       *ng_et = ng::element::bf16;
       break;
@@ -382,6 +386,53 @@ Status CheckAxisDimInRange(std::vector<int64> axes, size_t rank) {
   return Status::OK();
 }
 
+// Whether the term only has letters, each at most once
+static bool IsSupportedEinsumTerm(const string& term) {
+  std::set<char> labels;
+  for (char label : term) {
+    if (!std::isalpha(label) || !labels.insert(label).second) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status ParseEinsumEquation(const string& equation,
+                           std::vector<string>* input_labels,
+                           string* output_labels) {
+  string compact;
+  for (char c : equation) {
+    if (c != ' ') {
+      compact.push_back(c);
+    }
+  }
+  auto arrow = compact.find("->");
+  if (arrow == string::npos) {
+    return errors::Unimplemented(
+        "Einsum equation without an explicit output: ", equation);
+  }
+  *input_labels = str_util::Split(compact.substr(0, arrow), ',');
+  *output_labels = compact.substr(arrow + 2);
+
+  std::set<char> all_input_labels;
+  for (const auto& term : *input_labels) {
+    if (!IsSupportedEinsumTerm(term)) {
+      return errors::Unimplemented("Unsupported Einsum equation: ", equation);
+    }
+    all_input_labels.insert(term.begin(), term.end());
+  }
+  if (!IsSupportedEinsumTerm(*output_labels)) {
+    return errors::Unimplemented("Unsupported Einsum equation: ", equation);
+  }
+  for (char label : *output_labels) {
+    if (all_input_labels.count(label) == 0) {
+      return errors::InvalidArgument("Einsum output label ", label,
+                                     " is not in the inputs of ", equation);
+    }
+  }
+  return Status::OK();
+}
+
 Status NgraphSerialize(const std::string& file_name,
                        const std::shared_ptr<ngraph::Function>& ng_function) {
   int json_indentation = 4;
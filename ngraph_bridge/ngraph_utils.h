@@ -330,6 +330,14 @@ const gtl::ArraySlice<DataType>& NGraphBiasDTypes();
 // Returns error if axis is out of range. Otherwise returns Status::OK().
 Status CheckAxisDimInRange(std::vector<int64> axes, size_t rank);
 
+// Splits an Einsum equation ("ij,jk->ik") into the labels of each input and
+// of the output. Returns errors::Unimplemented for the forms the translation
+// does not support: ellipses, implicit outputs and labels repeated within a
+// term (traces and diagonals).
+Status ParseEinsumEquation(const std::string& equation,
+                           std::vector<std::string>* input_labels,
+                           std::string* output_labels);
+
 // Serialize a ngraph function into a file
 Status NgraphSerialize(const std::string&,
                        const std::shared_ptr<ngraph::Function>&);
@@ -237,6 +237,23 @@ class PredicateFactory {
   Predicate* MakeTrue() { return MakeAndPredicate({}); }
   Predicate* MakeFalse() { return MakeOrPredicate({}); }
 
+  // Returns the handle of `pred`, assigning the next free one if no
+  // structurally equal predicate has been interned before. The structural
+  // comparison is paid once here, handles are then compared as integers.
+  int32 Intern(Predicate* pred) {
+    auto it = interned_ids_.find(pred);
+    if (it != interned_ids_.end()) {
+      return it->second;
+    }
+    int32 pred_id = interned_predicates_.size();
+    interned_predicates_.push_back(pred);
+    interned_ids_.insert({pred, pred_id});
+    return pred_id;
+  }
+  Predicate* Lookup(int32 pred_id) const {
+    return interned_predicates_[pred_id];
+  }
+
  private:
   template <typename PredicateT, typename... Args>
   Predicate* Make(Args... args) {
@@ -246,21 +263,52 @@ class PredicateFactory {
     return predicate_storage_.back().get();
   }
   Predicate* MakeAndOrImpl(gtl::ArraySlice<Predicate*> operands, bool is_and);
+  Predicate* SimplifyAndOr(gtl::ArraySlice<Predicate*> operands, bool is_and);
+  struct OperandsHash {
+    size_t operator()(const std::vector<Predicate*>& operands) const {
+      uint64 hash = operands.size();
+      for (Predicate* op : operands) {
+        hash = Hash64Combine(hash, reinterpret_cast<uintptr_t>(op));
+      }
+      return hash;
+    }
+  };
   struct PredicatePtrHash {
     size_t operator()(const Predicate* pred) const { return pred->hash(); }
   };
   struct PredicatePtrEq {
     size_t operator()(const Predicate* a, const Predicate* b) const {
-      return *a == *b;
+      return a == b || *a == *b;
     }
   };
   using PredicateSet =
       gtl::FlatSet<Predicate*, PredicatePtrHash, PredicatePtrEq>;
   std::vector<std::unique_ptr<Predicate>> predicate_storage_;
+  // handle -> predicate, and predicate (compared structurally) -> handle
+  std::vector<Predicate*> interned_predicates_;
+  gtl::FlatMap<Predicate*, int32, PredicatePtrHash, PredicatePtrEq>
+      interned_ids_;
+  // Operands (by address, in the order given) -> their simplified And/Or.
+  // Most nodes have the same incoming predicates as their inputs, so most
+  // merges are a lookup instead of a simplification and a new predicate.
+  gtl::FlatMap<std::vector<Predicate*>, Predicate*, OperandsHash> and_cache_;
+  gtl::FlatMap<std::vector<Predicate*>, Predicate*, OperandsHash> or_cache_;
 };
 // Common code to create AndPredicate or OrPredicate instances.
 Predicate* PredicateFactory::MakeAndOrImpl(gtl::ArraySlice<Predicate*> operands,
                                            bool is_and) {
+  auto& cache = is_and ? and_cache_ : or_cache_;
+  std::vector<Predicate*> key(operands.begin(), operands.end());
+  auto it = cache.find(key);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  Predicate* pred = SimplifyAndOr(operands, is_and);
+  cache.insert({std::move(key), pred});
+  return pred;
+}
+Predicate* PredicateFactory::SimplifyAndOr(gtl::ArraySlice<Predicate*> operands,
+                                           bool is_and) {
   Predicate::Kind pred_kind =
       is_and ? Predicate::Kind::kAnd : Predicate::Kind::kOr;
   PredicateSet simplified_ops_set;
@@ -308,11 +356,17 @@ Predicate* PredicateFactory::MakeAndOrImpl(gtl::ArraySlice<Predicate*> operands,
 class DeadnessAnalysisImpl : public DeadnessAnalysis {
  public:
   explicit DeadnessAnalysisImpl(const Graph* graph)
-      : graph_(*graph), vlog_(VLOG_IS_ON(2)) {}
+      : graph_(*graph), vlog_(VLOG_IS_ON(2)) {
+    // The first interned predicate is True, so that its handle is
+    // TRUE_PRED_ID
+    CHECK_EQ(predicate_factory_.Intern(predicate_factory_.MakeTrue()),
+             TRUE_PRED_ID);
+  }
   Status Populate();
   bool HasInputsWithMismatchingDeadness(const Node& node) override;
   void Print() const override;
-  Status GetNodePredicate(const Node& node, string& pred_string) override;
+  Status GetNodePredicate(const Node& node, PredicateId* pred_id) override;
+  string PredicateToString(PredicateId pred_id) const override;
 
  private:
   enum class EdgeKind { kDataAndControl, kDataOnly, kControlOnly };
@@ -470,9 +524,9 @@ bool DeadnessAnalysisImpl::HasInputsWithMismatchingDeadness(const Node& node) {
 }
 
 Status DeadnessAnalysisImpl::GetNodePredicate(const Node& node,
-                                              string& pred_string) {
+                                              PredicateId* pred_id) {
   if (node.IsSource() || node.IsSink() || node.IsControlFlow()) {
-    DeadnessAnalysis::GetControlFlowPredString(pred_string);
+    *pred_id = CONTROL_FLOW_PRED_ID;
     return Status::OK();
   }
 
@@ -490,13 +544,24 @@ Status DeadnessAnalysisImpl::GetNodePredicate(const Node& node,
     pred = it->second;
   }
 
-  // All outputs have the same predicate
-  if (pred != nullptr) {
-    pred_string = pred->ToString();
+  // All outputs have the same predicate. A node without out edges gets the
+  // predicate of its control output
+  if (pred == nullptr) {
+    auto it = predicate_map_.find(TensorId(node.name(), Graph::kControlSlot));
+    CHECK(it != predicate_map_.end()) << node.name();
+    pred = it->second;
   }
+  *pred_id = predicate_factory_.Intern(pred);
   return Status::OK();
 }
 
+string DeadnessAnalysisImpl::PredicateToString(PredicateId pred_id) const {
+  if (IsControlFlowPred(pred_id)) {
+    return "#control_flow";
+  }
+  return predicate_factory_.Lookup(pred_id)->ToString();
+}
+
 void DeadnessAnalysisImpl::Print() const {
   std::vector<TensorId> tensor_ids;
   for (const auto& kv_pair : predicate_map_) {
@@ -525,10 +590,11 @@ DeadnessAnalysis::~DeadnessAnalysis() {}
   return Status::OK();
 }
 
-/*static*/ const std::string DeadnessAnalysis::CONTROL_FLOW_PRED_STRING =
-    "#control_flow";
-// Same as the True predicate used in AndPredicate
-/*static*/ const std::string DeadnessAnalysis::TRUE_PRED_STRING = "#true";
+/*static*/ const DeadnessAnalysis::PredicateId
+    DeadnessAnalysis::CONTROL_FLOW_PRED_ID = -1;
+// Handle of the True predicate (empty AndPredicate), interned first
+/*static*/ const DeadnessAnalysis::PredicateId DeadnessAnalysis::TRUE_PRED_ID =
+    0;
 
 }  // namespace ngraph_bridge
 
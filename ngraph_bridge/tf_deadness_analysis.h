@@ -88,33 +88,33 @@ class DeadnessAnalysis {
   static Status Run(const Graph& graph,
                     std::unique_ptr<DeadnessAnalysis>* result);
 
-  // For Data Flow ops, updates predicate_string
+  // Handle of a predicate interned by the analysis. Structurally equal
+  // predicates share the same handle, so predicates can be compared in O(1)
+  // however large they get (e.g. inside nested while loops).
+  typedef int32 PredicateId;
+
+  // For Data Flow ops, updates pred_id
   // Deadness is typically introduced by control flow ops. So, all the outgoing
   // edges from the data flow op have the same deadness predicate ('And'
-  // Predicate of all its input predicates) and we can attach a predicate string
-  // to the data-flow node (predicate of its output edge). Control flow ops are
-  // assigned a placeholder predicate string (CONTROL_FLOW_PRED_STRING) .
-  virtual Status GetNodePredicate(const Node& node, string& pred_string) = 0;
+  // Predicate of all its input predicates) and we can attach a predicate to
+  // the data-flow node (predicate of its output edge). Control flow ops are
+  // assigned a placeholder predicate (CONTROL_FLOW_PRED_ID).
+  virtual Status GetNodePredicate(const Node& node, PredicateId* pred_id) = 0;
 
-  inline static bool IsControlFlowPredString(const string& predicate) {
-    return CONTROL_FLOW_PRED_STRING == predicate;
-  }
+  // Human readable form of the predicate, for logging and error messages
+  virtual string PredicateToString(PredicateId pred_id) const = 0;
 
-  inline static bool IsTruePredString(const string& predicate) {
-    return TRUE_PRED_STRING == predicate;
+  inline static bool IsControlFlowPred(PredicateId pred_id) {
+    return CONTROL_FLOW_PRED_ID == pred_id;
   }
 
-  inline static void GetControlFlowPredString(string& predicate) {
-    predicate = CONTROL_FLOW_PRED_STRING;
+  inline static bool IsTruePred(PredicateId pred_id) {
+    return TRUE_PRED_ID == pred_id;
   }
 
-  inline static void GetTruePredString(string& predicate) {
-    predicate = TRUE_PRED_STRING;
-  }
+  static const PredicateId CONTROL_FLOW_PRED_ID;
+  static const PredicateId TRUE_PRED_ID;
 
- private:
-  static const std::string CONTROL_FLOW_PRED_STRING;
-  static const std::string TRUE_PRED_STRING;
 };
 
 }  // namespace ngraph_bridge
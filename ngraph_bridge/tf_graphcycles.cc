@@ -38,7 +38,10 @@ File: tensorflow/tensorflow/compiler/jit/graphcycles/graphcycles.cc
 // (3) Otherwise: adjust ranks in the neighborhood of x and y.
 
 #include <algorithm>
+#include <iterator>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/platform/logging.h"
@@ -51,7 +54,53 @@ namespace ngraph_bridge {
 
 namespace {
 
-typedef std::unordered_set<int32> NodeSet;
+// Set of node ids, kept sorted in a flat vector: lookups are binary searches
+// and iterating is a scan over contiguous memory. A single insert or erase
+// shifts the vector, which is linear in the size of the set, so the sets of
+// the nodes merged by ContractEdge are merged in bulk with insert_all.
+class NodeSet {
+ public:
+  typedef std::vector<int32>::const_iterator const_iterator;
+
+  // Returns false if v was already in the set
+  bool insert(int32 v) {
+    auto it = std::lower_bound(ids_.begin(), ids_.end(), v);
+    if (it != ids_.end() && *it == v) {
+      return false;
+    }
+    ids_.insert(it, v);
+    return true;
+  }
+
+  void erase(int32 v) {
+    auto it = std::lower_bound(ids_.begin(), ids_.end(), v);
+    if (it != ids_.end() && *it == v) {
+      ids_.erase(it);
+    }
+  }
+
+  // Inserts all the ids of other, in time linear in the size of both sets
+  void insert_all(const NodeSet& other) {
+    std::vector<int32> merged;
+    merged.reserve(ids_.size() + other.ids_.size());
+    std::set_union(ids_.begin(), ids_.end(), other.ids_.begin(),
+                   other.ids_.end(), std::back_inserter(merged));
+    ids_.swap(merged);
+  }
+
+  bool contains(int32 v) const {
+    return std::binary_search(ids_.begin(), ids_.end(), v);
+  }
+
+  void clear() { ids_.clear(); }
+  size_t size() const { return ids_.size(); }
+  const_iterator begin() const { return ids_.begin(); }
+  const_iterator end() const { return ids_.end(); }
+
+ private:
+  std::vector<int32> ids_;
+};
+
 template <typename T>
 struct VecStruct {
   typedef gtl::InlinedVector<T, 4> type;
@@ -60,12 +109,7 @@ template <typename T>
 using Vec = typename VecStruct<T>::type;
 
 struct Node {
-  Node()
-      : rank(-1),
-        visited(false),
-        data(0),
-        in(4),
-        out(4) {}  // Small hashtables for in/out edges
+  Node() : rank(-1), visited(false), data(0) {}
 
   int32 rank;    // rank number assigned by Pearce-Kelly algorithm
   bool visited;  // Temporary marker used by depth-first-search
@@ -99,7 +143,7 @@ GraphCycles::~GraphCycles() {
 
 bool GraphCycles::CheckInvariants() const {
   Rep* r = rep_;
-  NodeSet ranks;  // Set of ranks seen so far.
+  std::unordered_set<int32> ranks;  // Set of ranks seen so far.
   for (Vec<Node*>::size_type x = 0; x < r->nodes_.size(); x++) {
     Node* nx = r->nodes_[x];
     if (nx->visited) {
@@ -159,7 +203,7 @@ void GraphCycles::SetNodeData(int32 node, void* data) {
 }
 
 bool GraphCycles::HasEdge(int32 x, int32 y) const {
-  return rep_->nodes_[x]->out.find(y) != rep_->nodes_[x]->out.end();
+  return rep_->nodes_[x]->out.contains(y);
 }
 
 void GraphCycles::RemoveEdge(int32 x, int32 y) {
@@ -180,7 +224,7 @@ bool GraphCycles::InsertEdge(int32 x, int32 y) {
   if (x == y) return false;
   Rep* r = rep_;
   Node* nx = r->nodes_[x];
-  if (!nx->out.insert(y).second) {
+  if (!nx->out.insert(y)) {
     // Edge already exists.
     return true;
   }
@@ -314,7 +358,7 @@ int GraphCycles::FindPath(int32 x, int32 y, int max_path_len,
   int path_len = 0;
 
   Rep* r = rep_;
-  NodeSet seen;
+  std::unordered_set<int32> seen;
   r->stack_.clear();
   r->stack_.push_back(x);
   while (!r->stack_.empty()) {
@@ -389,32 +433,125 @@ bool GraphCycles::ContractEdge(int32 a, int32 b) {
     return false;
   }
 
+  Node* na = rep_->nodes_[a];
   Node* nb = rep_->nodes_[b];
-  std::unordered_set<int32> out = std::move(nb->out);
-  std::unordered_set<int32> in = std::move(nb->in);
-  for (auto y : out) {
-    rep_->nodes_[y]->in.erase(b);
-  }
-  for (auto y : in) {
-    rep_->nodes_[y]->out.erase(b);
-  }
+  NodeSet out = std::move(nb->out);
+  NodeSet in = std::move(nb->in);
+  nb->out.clear();
+  nb->in.clear();
   rep_->free_nodes_.push_back(b);
 
+  // a is ranked before b, so the successors of b are ranked after a and
+  // their edges keep the rank order
   for (auto y : out) {
-    InsertEdge(a, y);
+    NodeSet& y_in = rep_->nodes_[y]->in;
+    y_in.erase(b);
+    y_in.insert(a);
   }
+  na->out.insert_all(out);
+
+  // The edges from the predecessors of b ranked before a keep it too. The
+  // others are inserted one by one, reordering the nodes ranked in between.
+  NodeSet early_in;
+  std::vector<int32> late_in;
   for (auto y : in) {
-    InsertEdge(y, a);
+    Node* ny = rep_->nodes_[y];
+    ny->out.erase(b);
+    if (ny->rank < na->rank) {
+      ny->out.insert(a);
+      early_in.insert(y);
+    } else {
+      late_in.push_back(y);
+    }
+  }
+  na->in.insert_all(early_in);
+  for (auto y : late_in) {
+    // Cannot make a cycle: a does not reach b other than through the
+    // contracted edge
+    CHECK(InsertEdge(y, a));
   }
   return true;
 }
 
+std::vector<bool> GraphCycles::CanContractEdges(
+    const std::vector<std::pair<int32, int32>>& edges) {
+  Rep* r = rep_;
+  std::vector<bool> can_contract(edges.size(), true);
+
+  // Group the queries by source node
+  std::vector<size_t> order(edges.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&edges](size_t x, size_t y) {
+    return edges[x].first < edges[y].first;
+  });
+
+  size_t group_begin = 0;
+  while (group_begin < order.size()) {
+    int32 a = edges[order[group_begin]].first;
+    size_t group_end = group_begin;
+    int32 max_rank = -1;
+    for (; group_end < order.size() && edges[order[group_end]].first == a;
+         group_end++) {
+      int32 b = edges[order[group_end]].second;
+      CHECK(HasEdge(a, b)) << "No edge exists from " << a << " to " << b;
+      max_rank = std::max(max_rank, r->nodes_[b]->rank);
+    }
+
+    // b can be reached from a through something else than the edge a->b iff
+    // one of b's other predecessors can be reached from a successor of a. So
+    // search forward from all the successors of a at once, through nodes
+    // ranked below the highest ranked target only (nothing else can lead to a
+    // target), and then look at the predecessors of each target.
+    r->deltaf_.clear();
+    r->stack_.clear();
+    for (auto w : r->nodes_[a]->out) {
+      if (r->nodes_[w]->rank < max_rank) {
+        r->stack_.push_back(w);
+      }
+    }
+    while (!r->stack_.empty()) {
+      int32 n = r->stack_.back();
+      r->stack_.pop_back();
+      Node* nn = r->nodes_[n];
+      if (nn->visited) continue;
+
+      nn->visited = true;
+      r->deltaf_.push_back(n);
+
+      for (auto w : nn->out) {
+        Node* nw = r->nodes_[w];
+        if (!nw->visited && nw->rank < max_rank) {
+          r->stack_.push_back(w);
+        }
+      }
+    }
+
+    for (size_t i = group_begin; i < group_end; i++) {
+      int32 b = edges[order[i]].second;
+      for (auto p : r->nodes_[b]->in) {
+        if (p != a && r->nodes_[p]->visited) {
+          can_contract[order[i]] = false;
+          break;
+        }
+      }
+    }
+
+    ClearVisitedBits(r, r->deltaf_);
+    group_begin = group_end;
+  }
+  return can_contract;
+}
+
 std::unordered_set<int32> GraphCycles::Successors(int32 node) {
-  return rep_->nodes_[node]->out;
+  const NodeSet& out = rep_->nodes_[node]->out;
+  return std::unordered_set<int32>(out.begin(), out.end());
 }
 
 std::unordered_set<int32> GraphCycles::Predecessors(int32 node) {
-  return rep_->nodes_[node]->in;
+  const NodeSet& in = rep_->nodes_[node]->in;
+  return std::unordered_set<int32>(in.begin(), in.end());
 }
 
 }  // namespace ngraph_bridge
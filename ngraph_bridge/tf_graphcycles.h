@@ -45,8 +45,12 @@ File: tensorflow/tensorflow/compiler/jit/graphcycles/graphcycles.h
 //   otherwise.
 //   FindPath() is linear in the size of the graph.
 // The current implementation uses O(|V|+|E|) space.
+// The in/out edges of a node are kept in flat sorted vectors rather than hash
+// sets (this differs from the TF copy).
 
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/types.h"
@@ -98,6 +102,14 @@ class GraphCycles {
   // Return true if can contract edge, otherwise return false.
   bool CanContractEdge(int32 a, int32 b);
 
+  // Batched CanContractEdge. Every (a, b) pair in edges must be an existing
+  // edge; the i-th result tells whether edges[i] could be contracted in the
+  // current graph. Nothing is modified, so the answers only hold until the
+  // next change to the graph. Queries sharing a source node are answered by a
+  // single search.
+  std::vector<bool> CanContractEdges(
+      const std::vector<std::pair<int32, int32>>& edges);
+
   // Return whether dest_node is reachable from source_node
   // by following edges.
   bool IsReachable(int32 source_node, int32 dest_node) const;
@@ -20,6 +20,7 @@
 
 #include "logging/tf_graph_writer.h"
 #include "ngraph_bridge/ngraph_assign_clusters.h"
+#include "ngraph_bridge/ngraph_timer.h"
 #include "ngraph_bridge/ngraph_utils.h"
 #include "test/test_utilities.h"
 
@@ -168,6 +169,179 @@ TEST(AssignClusters, Cone) {
   ASSERT_EQ(node3_cluster, -1);
 }
 
+// Given a graph of this form:
+//
+//  Node1--->Node2
+//    \       ^
+//     \      : (control)
+//      \     :
+//       -->Node3
+//
+// the edge Node1->Node2 is tried first and refused, because of the longer path
+// through Node3. Once Node1->Node3 is contracted it must be tried again, so
+// that all three nodes end up in the same cluster.
+TEST(AssignClusters, RetryAfterMerge) {
+  Graph g(OpRegistry::Global());
+
+  Tensor t(DT_FLOAT, TensorShape{2, 3});
+
+  Node* node1;
+  ASSERT_OK(NodeBuilder("node1", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t)
+                .Attr("_ngraph_marked_for_clustering", true)
+                .Finalize(&g, &node1));
+
+  Node* node2;
+  ASSERT_OK(NodeBuilder("node2", "Abs")
+                .Input(node1, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ngraph_marked_for_clustering", true)
+                .Finalize(&g, &node2));
+
+  Node* node3;
+  ASSERT_OK(NodeBuilder("node3", "Abs")
+                .Input(node1, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ngraph_marked_for_clustering", true)
+                .Finalize(&g, &node3));
+
+  g.AddControlEdge(node3, node2);
+
+  Node* source = g.source_node();
+  Node* sink = g.sink_node();
+  g.AddEdge(source, Graph::kControlSlot, node1, Graph::kControlSlot);
+  g.AddEdge(node2, Graph::kControlSlot, sink, Graph::kControlSlot);
+
+  ASSERT_OK(AssignClusters(&g));
+
+  int node1_cluster, node2_cluster, node3_cluster;
+  ASSERT_OK(GetNodeCluster(node1, &node1_cluster));
+  ASSERT_OK(GetNodeCluster(node2, &node2_cluster));
+  ASSERT_OK(GetNodeCluster(node3, &node3_cluster));
+
+  ASSERT_EQ(node1_cluster, node2_cluster);
+  ASSERT_EQ(node1_cluster, node3_cluster);
+}
+
+//   Node1 --------------> Node2 --> Node4
+//     |                     ^
+//     |        (ctrl)       |
+//     --> Node3 -------------
+//
+// Node1->Node2 is parked on the clusters of both its ends, because of the
+// path through Node3. Node2->Node4 then requeues it, which must take it off
+// the pending list of Node1's cluster as well, so that contracting
+// Node1->Node3 does not requeue it a second time.
+TEST(AssignClusters, ParkedEdgeRequeuedOnce) {
+  Graph g(OpRegistry::Global());
+
+  Tensor t(DT_FLOAT, TensorShape{2, 3});
+
+  Node* node1;
+  ASSERT_OK(NodeBuilder("node1", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t)
+                .Attr("_ngraph_marked_for_clustering", true)
+                .Finalize(&g, &node1));
+
+  Node* node2;
+  ASSERT_OK(NodeBuilder("node2", "Abs")
+                .Input(node1, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ngraph_marked_for_clustering", true)
+                .Finalize(&g, &node2));
+
+  Node* node4;
+  ASSERT_OK(NodeBuilder("node4", "Abs")
+                .Input(node2, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ngraph_marked_for_clustering", true)
+                .Finalize(&g, &node4));
+
+  Node* node3;
+  ASSERT_OK(NodeBuilder("node3", "Abs")
+                .Input(node1, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ngraph_marked_for_clustering", true)
+                .Finalize(&g, &node3));
+
+  g.AddControlEdge(node3, node2);
+
+  Node* source = g.source_node();
+  Node* sink = g.sink_node();
+  g.AddEdge(source, Graph::kControlSlot, node1, Graph::kControlSlot);
+  g.AddEdge(node4, Graph::kControlSlot, sink, Graph::kControlSlot);
+
+  AssignClustersStats stats;
+  ASSERT_OK(AssignClusters(&g, &stats));
+  ASSERT_EQ(stats.num_parked, 1);
+  ASSERT_EQ(stats.num_requeued, 1);
+
+  int node1_cluster, node2_cluster, node3_cluster, node4_cluster;
+  ASSERT_OK(GetNodeCluster(node1, &node1_cluster));
+  ASSERT_OK(GetNodeCluster(node2, &node2_cluster));
+  ASSERT_OK(GetNodeCluster(node3, &node3_cluster));
+  ASSERT_OK(GetNodeCluster(node4, &node4_cluster));
+  ASSERT_EQ(node1_cluster, node2_cluster);
+  ASSERT_EQ(node1_cluster, node3_cluster);
+  ASSERT_EQ(node1_cluster, node4_cluster);
+}
+
+// Builds a chain of num_nodes Abs ops in which every third node is an Add that
+// also reads the node two steps back (creating lots of diamonds), and every
+// 64th node is left unmarked so that the graph ends up in several clusters.
+static void BuildClusteringBenchmarkGraph(Graph* g, int num_nodes) {
+  Tensor t(DT_FLOAT, TensorShape{2, 3});
+
+  Node* prev_prev;
+  ASSERT_OK(NodeBuilder("const", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t)
+                .Attr("_ngraph_marked_for_clustering", true)
+                .Finalize(g, &prev_prev));
+  Node* prev = prev_prev;
+
+  for (int i = 1; i < num_nodes; i++) {
+    string name = "node" + to_string(i);
+    bool marked = (i % 64) != 0;
+    Node* node;
+    if (i % 3 == 0) {
+      ASSERT_OK(NodeBuilder(name, "Add")
+                    .Input(prev, 0)
+                    .Input(prev_prev, 0)
+                    .Attr("T", DT_FLOAT)
+                    .Attr("_ngraph_marked_for_clustering", marked)
+                    .Finalize(g, &node));
+    } else {
+      ASSERT_OK(NodeBuilder(name, "Abs")
+                    .Input(prev, 0)
+                    .Attr("T", DT_FLOAT)
+                    .Attr("_ngraph_marked_for_clustering", marked)
+                    .Finalize(g, &node));
+    }
+    prev_prev = prev;
+    prev = node;
+  }
+}
+
+// Scaling benchmark for the contraction, not run by default. Use
+// --gtest_also_run_disabled_tests --gtest_filter=*ContractionScaling* to
+// get the timings.
+TEST(AssignClusters, DISABLED_ContractionScaling) {
+  for (int num_nodes : {1000, 10000, 100000, 1000000}) {
+    Graph g(OpRegistry::Global());
+    BuildClusteringBenchmarkGraph(&g, num_nodes);
+
+    Timer assign_clusters_timer;
+    ASSERT_OK(AssignClusters(&g));
+    int time_ms = assign_clusters_timer.ElapsedInMS();
+
+    cout << "AssignClusters: " << num_nodes << " nodes, " << g.num_edges()
+         << " edges: " << time_ms << " ms" << endl;
+  }
+}
+
 }  // namespace testing
 
 }  // namespace ngraph_bridge
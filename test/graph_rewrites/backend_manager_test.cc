@@ -250,6 +250,41 @@ TEST(BackendManager, GetBackendCreationString) {
   ASSERT_EQ(gpu_backend, "GPU:678");
 }
 
+// Test the op support cache and its invalidation by SetConfig
+TEST(BackendManager, OpSupportCache) {
+  ASSERT_OK(BackendManager::CreateBackend("INTERPRETER"));
+  BackendManager::ClearOpSupportCache("INTERPRETER");
+
+  bool is_supported = false;
+  ASSERT_FALSE(
+      BackendManager::GetCachedOpSupport("INTERPRETER", "Add", &is_supported));
+
+  BackendManager::CacheOpSupport("INTERPRETER", "Add", true);
+  BackendManager::CacheOpSupport("INTERPRETER", "Foo", false);
+  ASSERT_TRUE(
+      BackendManager::GetCachedOpSupport("INTERPRETER", "Add", &is_supported));
+  ASSERT_TRUE(is_supported);
+  ASSERT_TRUE(
+      BackendManager::GetCachedOpSupport("INTERPRETER", "Foo", &is_supported));
+  ASSERT_FALSE(is_supported);
+  // Entries are per backend
+  ASSERT_FALSE(BackendManager::GetCachedOpSupport("CPU", "Add", &is_supported));
+
+  // Changing the config drops the cached answers
+  BackendManager::SetConfig("INTERPRETER", {{"_ngraph_device_config", "1"}});
+  ASSERT_FALSE(
+      BackendManager::GetCachedOpSupport("INTERPRETER", "Add", &is_supported));
+
+  // Setting the same config again keeps them
+  BackendManager::CacheOpSupport("INTERPRETER", "Add", true);
+  BackendManager::SetConfig("INTERPRETER", {{"_ngraph_device_config", "1"}});
+  ASSERT_TRUE(
+      BackendManager::GetCachedOpSupport("INTERPRETER", "Add", &is_supported));
+
+  BackendManager::ClearOpSupportCache("INTERPRETER");
+  BackendManager::ReleaseBackend("INTERPRETER");
+}
+
 }  // namespace testing
 }  // namespace ngraph_bridge
 }  // namespace tensorflow
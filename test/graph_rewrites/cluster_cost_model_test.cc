@@ -0,0 +1,199 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "ngraph_bridge/ngraph_cluster_cost_model.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+namespace testing {
+
+// A small elementwise island fed by large tensors from outside the cluster
+// costs more in transfers than it saves
+TEST(ClusterCostModel, ElementwiseIslandIsDeassigned) {
+  Graph g(OpRegistry::Global());
+  std::vector<PartialTensorShape> shape{PartialTensorShape({1000, 1000})};
+
+  Node* x;
+  ASSERT_OK(NodeBuilder("x", "Placeholder")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("_output_shapes", shape)
+                .Finalize(&g, &x));
+  Node* y;
+  ASSERT_OK(NodeBuilder("y", "Placeholder")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("_output_shapes", shape)
+                .Finalize(&g, &y));
+  Node* add;
+  ASSERT_OK(NodeBuilder("add", "Add")
+                .Input(x, 0)
+                .Input(y, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_output_shapes", shape)
+                .Finalize(&g, &add));
+  Node* relu;
+  ASSERT_OK(NodeBuilder("relu", "Relu")
+                .Input(add, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_output_shapes", shape)
+                .Finalize(&g, &relu));
+  Node* out;
+  ASSERT_OK(NodeBuilder("out", "Identity")
+                .Input(relu, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &out));
+
+  std::set<Node*> cluster{add, relu};
+  ClusterCostEstimate estimate = ClusterCostModel::EstimateCluster(cluster);
+  ASSERT_TRUE(estimate.is_complete);
+  ASSERT_EQ(estimate.num_ops, 2);
+  ASSERT_EQ(estimate.bytes_in, 2 * 1000 * 1000 * 4);
+  ASSERT_EQ(estimate.bytes_out, 1000 * 1000 * 4);
+
+  DefaultClusterCostModel cost_model;
+  bool deassign = false;
+  ASSERT_OK(cost_model.ShouldDeassign(cluster, nullptr, &deassign));
+  ASSERT_TRUE(deassign);
+}
+
+// A large MatMul on constants is compute bound, and is kept
+TEST(ClusterCostModel, MatMulIsKept) {
+  Graph g(OpRegistry::Global());
+  Tensor t(DT_FLOAT, TensorShape{1000, 1000});
+
+  Node* a;
+  ASSERT_OK(NodeBuilder("a", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t)
+                .Finalize(&g, &a));
+  Node* b;
+  ASSERT_OK(NodeBuilder("b", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t)
+                .Finalize(&g, &b));
+  Node* matmul;
+  ASSERT_OK(NodeBuilder("matmul", "MatMul")
+                .Input(a, 0)
+                .Input(b, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_output_shapes",
+                      std::vector<PartialTensorShape>{
+                          PartialTensorShape({1000, 1000})})
+                .Finalize(&g, &matmul));
+
+  std::set<Node*> cluster{a, b, matmul};
+  ClusterCostEstimate estimate = ClusterCostModel::EstimateCluster(cluster);
+  ASSERT_TRUE(estimate.is_complete);
+  ASSERT_EQ(estimate.flops, 2.0 * 1000 * 1000 * 1000);
+
+  DefaultClusterCostModel cost_model;
+  bool deassign = true;
+  ASSERT_OK(cost_model.ShouldDeassign(cluster, nullptr, &deassign));
+  ASSERT_FALSE(deassign);
+}
+
+// Shapes missing from the graph are taken from the inferred ones
+TEST(ClusterCostModel, InferredShapes) {
+  Graph g(OpRegistry::Global());
+
+  Node* x;
+  ASSERT_OK(NodeBuilder("x", "Placeholder")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("shape", TensorShape({1000, 1000}))
+                .Finalize(&g, &x));
+  Node* abs;
+  ASSERT_OK(NodeBuilder("abs", "Abs")
+                .Input(x, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &abs));
+  FixupSourceAndSinkEdges(&g);
+
+  std::set<Node*> cluster{abs};
+  ASSERT_FALSE(ClusterCostModel::EstimateCluster(cluster).is_complete);
+
+  GraphShapes shapes;
+  InferGraphShapes(g, &shapes);
+  ClusterCostEstimate estimate =
+      ClusterCostModel::EstimateCluster(cluster, &shapes);
+  ASSERT_TRUE(estimate.is_complete);
+  ASSERT_EQ(estimate.bytes_in, 4.0 * 1000 * 1000);
+  ASSERT_EQ(estimate.bytes_out, 4.0 * 1000 * 1000);
+
+  DefaultClusterCostModel cost_model;
+  bool deassign = false;
+  ASSERT_OK(cost_model.ShouldDeassign(cluster, &shapes, &deassign));
+  ASSERT_TRUE(deassign);
+}
+
+// Ops and tensors of unknown shapes are given the default costs, so a lone
+// op is deassigned and a long chain of them is kept
+TEST(ClusterCostModel, UnknownShapesUseDefaults) {
+  Graph g(OpRegistry::Global());
+
+  Node* x;
+  ASSERT_OK(NodeBuilder("x", "Placeholder")
+                .Attr("dtype", DT_FLOAT)
+                .Finalize(&g, &x));
+  std::vector<Node*> chain;
+  Node* input = x;
+  for (int i = 0; i < 50; i++) {
+    Node* abs;
+    ASSERT_OK(NodeBuilder("abs_" + to_string(i), "Abs")
+                  .Input(input, 0)
+                  .Attr("T", DT_FLOAT)
+                  .Finalize(&g, &abs));
+    chain.push_back(abs);
+    input = abs;
+  }
+  FixupSourceAndSinkEdges(&g);
+
+  GraphShapes shapes;
+  InferGraphShapes(g, &shapes);
+  DefaultClusterCostModel cost_model;
+
+  std::set<Node*> lone{chain.front()};
+  ClusterCostEstimate estimate =
+      ClusterCostModel::EstimateCluster(lone, &shapes);
+  ASSERT_FALSE(estimate.is_complete);
+  ASSERT_EQ(estimate.num_unknown_ops, 1);
+  ASSERT_EQ(estimate.num_unknown_tensors, 2);
+  bool deassign = false;
+  ASSERT_OK(cost_model.ShouldDeassign(lone, &shapes, &deassign));
+  ASSERT_TRUE(deassign);
+
+  std::set<Node*> all(chain.begin(), chain.end());
+  estimate = ClusterCostModel::EstimateCluster(all, &shapes);
+  ASSERT_EQ(estimate.num_unknown_ops, 50);
+  ASSERT_EQ(estimate.num_unknown_tensors, 1);
+  deassign = true;
+  ASSERT_OK(cost_model.ShouldDeassign(all, &shapes, &deassign));
+  ASSERT_FALSE(deassign);
+}
+
+}  // namespace testing
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
@@ -33,6 +33,7 @@
 #include "ngraph_bridge/ngraph_assign_clusters.h"
 #include "ngraph_bridge/ngraph_mark_for_clustering.h"
 #include "ngraph_bridge/ngraph_utils.h"
+#include "ngraph_bridge/tf_deadness_analysis.h"
 #include "test/test_utilities.h"
 
 #if !defined(NGRAPH_TF_DISABLE_DEADNESS_CHECK)
@@ -494,6 +495,42 @@ TEST(DeadnessCheck, DTestG5) {
   ASSERT_NE(A_cluster, N5_Add_cluster);
 }
 
+// Predicate handles: nodes on the same side of the same switch share a handle,
+// the two sides differ and data flow nodes outside the switch are True
+TEST(DeadnessCheck, PredicateIds) {
+  Scope root = Scope::NewRootScope();
+
+  auto A = ops::Placeholder(root.WithOpName("A"), DataType::DT_FLOAT);
+  auto B = ops::Placeholder(root.WithOpName("B"), DataType::DT_FLOAT);
+  auto pred = ops::Placeholder(root.WithOpName("pred"), DataType::DT_BOOL);
+
+  auto S = ops::Switch(root.WithOpName("S"), A, pred);
+  auto T1 = ops::Abs(root.WithOpName("T1"), S.output_true);
+  auto T2 = ops::Neg(root.WithOpName("T2"), S.output_true);
+  auto F1 = ops::Abs(root.WithOpName("F1"), S.output_false);
+  auto L = ops::Abs(root.WithOpName("L"), B);
+
+  Graph graph(OpRegistry::Global());
+  TF_CHECK_OK(root.ToGraph(&graph));
+
+  std::unique_ptr<DeadnessAnalysis> deadness_analyzer;
+  ASSERT_OK(DeadnessAnalysis::Run(graph, &deadness_analyzer));
+
+  std::map<std::string, DeadnessAnalysis::PredicateId> preds;
+  for (auto node : graph.op_nodes()) {
+    ASSERT_OK(
+        deadness_analyzer->GetNodePredicate(*node, &preds[node->name()]));
+  }
+
+  ASSERT_TRUE(DeadnessAnalysis::IsControlFlowPred(preds["S"]));
+  ASSERT_TRUE(DeadnessAnalysis::IsTruePred(preds["L"]));
+  ASSERT_TRUE(DeadnessAnalysis::IsTruePred(preds["A"]));
+  ASSERT_EQ(preds["T1"], preds["T2"]);
+  ASSERT_NE(preds["T1"], preds["F1"]);
+  ASSERT_FALSE(DeadnessAnalysis::IsTruePred(preds["T1"]));
+  ASSERT_FALSE(DeadnessAnalysis::IsTruePred(preds["F1"]));
+}
+
 }  // namespace testing
 }  // namespace ngraph_bridge
 }  // namespace tensorflow
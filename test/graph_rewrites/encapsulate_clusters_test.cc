@@ -16,10 +16,12 @@
 
 #include "gtest/gtest.h"
 
+#include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/graph/node_builder.h"
 
 #include "ngraph_bridge/ngraph_cluster_manager.h"
 #include "ngraph_bridge/ngraph_encapsulate_clusters.h"
+#include "ngraph_bridge/ngraph_timer.h"
 #include "ngraph_bridge/version.h"
 #include "test/test_utilities.h"
 
@@ -47,19 +49,8 @@ TEST(EncapsulateClusters, EncapsulatorFail) {
 //                 |
 // const(0) ---> add(1) <---const(1)
 TEST(EncapsulateClusters, EncapsulatorPass) {
-  auto num_graphs_in_cluster_manager = []() {
-    int num = 0;
-    while (true) {
-      if (NGraphClusterManager::GetClusterGraph(num) == nullptr) {
-        break;
-      } else {
-        num++;
-      }
-    }
-    return num;
-  };
   NGraphClusterManager::EvictAllClusters();
-  ASSERT_EQ(num_graphs_in_cluster_manager(), 0);
+  ASSERT_EQ(NGraphClusterManager::NumClusters(), 0);
   Graph g(OpRegistry::Global());
 
   Tensor t_input_0(DT_FLOAT, TensorShape{2, 3});
@@ -80,7 +71,7 @@ TEST(EncapsulateClusters, EncapsulatorPass) {
                 .Finalize(&g, &node1));
 
   int cluster_idx_1 = NGraphClusterManager::NewCluster();
-  ASSERT_EQ(num_graphs_in_cluster_manager(), 2);
+  ASSERT_EQ(NGraphClusterManager::NumClusters(), 2);
 
   Node* node2;
   ASSERT_OK(NodeBuilder("node2", "Const")
@@ -120,15 +111,17 @@ TEST(EncapsulateClusters, EncapsulatorPass) {
   Encapsulator enc(&g);
 
   // Initially ClusterManager is empty
-  for (int i = 0; i < 2; i++) {
+  for (int i : {cluster_idx_0, cluster_idx_1}) {
     ASSERT_EQ(NGraphClusterManager::GetClusterGraph(i)->node_size(), 0);
   }
   ASSERT_OK(enc.AnalysisPass());
   // After AnalysisPass ClusterManager is populated
   // const and retval
-  ASSERT_EQ(NGraphClusterManager::GetClusterGraph(0)->node_size(), 2);
+  ASSERT_EQ(NGraphClusterManager::GetClusterGraph(cluster_idx_0)->node_size(),
+            2);
   // arg, const, add and retval
-  ASSERT_EQ(NGraphClusterManager::GetClusterGraph(1)->node_size(), 4);
+  ASSERT_EQ(NGraphClusterManager::GetClusterGraph(cluster_idx_1)->node_size(),
+            4);
   // But the graph structure stays same. No rewriting yet
   ASSERT_EQ(g.num_edges(), 7);
   ASSERT_EQ(g.num_op_nodes(), 4);
@@ -136,14 +129,13 @@ TEST(EncapsulateClusters, EncapsulatorPass) {
 
   set<int> newly_created_cluster_ids;
   ASSERT_OK(enc.GetNewClusterIDs(newly_created_cluster_ids));
-  set<int> expected{0, 1};
+  set<int> expected{cluster_idx_0, cluster_idx_1};
   ASSERT_EQ(newly_created_cluster_ids, expected);
 
-  auto subgraph_0 = NGraphClusterManager::GetClusterGraph(0);
-  auto subgraph_1 = NGraphClusterManager::GetClusterGraph(1);
-  auto subgraph_2 = NGraphClusterManager::GetClusterGraph(2);
+  auto subgraph_0 = NGraphClusterManager::GetClusterGraph(cluster_idx_0);
+  auto subgraph_1 = NGraphClusterManager::GetClusterGraph(cluster_idx_1);
   // Assert that there are only 2 subgraphs
-  ASSERT_EQ(subgraph_2, nullptr);
+  ASSERT_EQ(NGraphClusterManager::NumClusters(), 2);
 
   int num_encapsulates = 0;
   int num_tf_nodes = 0;
@@ -207,11 +199,16 @@ TEST(EncapsulateClusters, EncapsulatorPass) {
   // Number of encapsulates == number of functions
   ASSERT_EQ(num_encapsulates, fdeflib_new->function_size());
 
-  // After RewritePass, the number of clusters is still 2 and it contains
-  // populated graphdefs
-  ASSERT_EQ(num_graphs_in_cluster_manager(), 2);
-  ASSERT_EQ(NGraphClusterManager::GetClusterGraph(0)->node_size(), 2);
-  ASSERT_EQ(NGraphClusterManager::GetClusterGraph(1)->node_size(), 4);
+  // After RewritePass, the number of clusters is still 2 and they have been
+  // converted to Graphs, which dropped their graphdefs
+  ASSERT_EQ(NGraphClusterManager::NumClusters(), 2);
+  std::shared_ptr<const Graph> graph_0, graph_1;
+  ASSERT_OK(NGraphClusterManager::GetClusterTFGraph(cluster_idx_0, &graph_0));
+  ASSERT_OK(NGraphClusterManager::GetClusterTFGraph(cluster_idx_1, &graph_1));
+  ASSERT_EQ(graph_0->num_op_nodes(), 2);
+  ASSERT_EQ(graph_1->num_op_nodes(), 4);
+  ASSERT_EQ(NGraphClusterManager::GetClusterGraph(cluster_idx_0), nullptr);
+  ASSERT_EQ(NGraphClusterManager::GetClusterGraph(cluster_idx_1), nullptr);
 
   // The graph structure should have changed after RewritePass
   ASSERT_EQ(g.num_edges(), 6);
@@ -221,6 +218,83 @@ TEST(EncapsulateClusters, EncapsulatorPass) {
   free(fdeflib_new);
 }
 
+// The Graph of a cluster is built once, replaces its GraphDef, and outlives
+// the eviction of the cluster for as long as it is used
+TEST(EncapsulateClusters, ClusterManagerSharesGraph) {
+  NGraphClusterManager::EvictAllClusters();
+  int cluster_idx = NGraphClusterManager::NewCluster();
+
+  Tensor t(DT_FLOAT, TensorShape{2});
+  NodeDef* node_def =
+      NGraphClusterManager::GetClusterGraph(cluster_idx)->add_node();
+  ASSERT_OK(NodeDefBuilder("node1", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t)
+                .Finalize(node_def));
+
+  std::shared_ptr<const Graph> graph_0, graph_1;
+  ASSERT_OK(NGraphClusterManager::GetClusterTFGraph(cluster_idx, &graph_0));
+  ASSERT_OK(NGraphClusterManager::GetClusterTFGraph(cluster_idx, &graph_1));
+  ASSERT_NE(graph_0, nullptr);
+  ASSERT_EQ(graph_0, graph_1);
+  ASSERT_EQ(graph_0->num_op_nodes(), 1);
+  ASSERT_EQ(NGraphClusterManager::GetClusterGraph(cluster_idx), nullptr);
+  ASSERT_EQ(NGraphClusterManager::NumClusters(), 1);
+
+  NGraphClusterManager::EvictAllClusters();
+  std::shared_ptr<const Graph> graph_2;
+  ASSERT_OK(NGraphClusterManager::GetClusterTFGraph(cluster_idx, &graph_2));
+  ASSERT_EQ(graph_2, nullptr);
+  ASSERT_EQ(graph_0->num_op_nodes(), 1);
+
+  // Indices are not reused after an eviction
+  ASSERT_GT(NGraphClusterManager::NewCluster(), cluster_idx);
+  NGraphClusterManager::EvictAllClusters();
+}
+
+// The clusters of a graph held in a ResourceMgr are dropped with it, though
+// no kernel was created for them
+TEST(EncapsulateClusters, ClustersHeldByResourceMgr) {
+  NGraphClusterManager::EvictAllClusters();
+  Graph g(OpRegistry::Global());
+  int cluster_idx = NGraphClusterManager::NewCluster();
+
+  Tensor t(DT_FLOAT, TensorShape{2, 3});
+  Node* node1;
+  ASSERT_OK(NodeBuilder("node1", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t)
+                .Attr("_ngraph_marked_for_clustering", true)
+                .Attr("_ngraph_cluster", cluster_idx)
+                .Attr("_ngraph_backend", "CPU")
+                .Finalize(&g, &node1));
+  Node* node2;
+  ASSERT_OK(NodeBuilder("node2", "Abs")
+                .Input(node1, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ngraph_marked_for_clustering", true)
+                .Attr("_ngraph_cluster", cluster_idx)
+                .Attr("_ngraph_backend", "CPU")
+                .Finalize(&g, &node2));
+  Node* node3;
+  ASSERT_OK(NodeBuilder("node3", "Abs")
+                .Input(node2, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &node3));
+
+  FunctionDefLibrary fdeflib;
+  ASSERT_OK(EncapsulateClusters(&g, 0, &fdeflib, {{"ngraph_device_id", ""}},
+                                {0, {}}));
+  ASSERT_EQ(NGraphClusterManager::NumClusters(), 1);
+
+  {
+    ResourceMgr resource_mgr;
+    ASSERT_OK(NGraphClusterManager::HoldClusters(&g, &resource_mgr));
+    ASSERT_EQ(NGraphClusterManager::NumClusters(), 1);
+  }
+  ASSERT_EQ(NGraphClusterManager::NumClusters(), 0);
+}
+
 // const(0) ---> add(0) <---const(0)
 TEST(EncapsulateClusters, PopulateLibrary) {
   NGraphClusterManager::EvictAllClusters();
@@ -826,6 +900,79 @@ TEST(EncapsulateClusters, AOT4) {
   free(fdeflib_new);
 }
 
+// A chain of num_clusters clusters, cluster i being const(i) ---> add(i).
+// add(i) reads add(i-1) and is also read by an unclustered abs:
+//
+//   const ---> add(0) ---> add(1) ---> ... ---> add(n-1)
+//                |           |                     |
+//                v           v                     v
+//               abs         abs                   abs
+static void BuildEncapsulateBenchmarkGraph(Graph* g, int num_clusters) {
+  Tensor t(DT_FLOAT, TensorShape{2});
+  AssignInputValues<float>(t, {1.0f, 2.0f});
+
+  Node* prev;
+  ASSERT_OK(NodeBuilder("input", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t)
+                .Finalize(g, &prev));
+  for (int i = 0; i < num_clusters; i++) {
+    int cluster_idx = NGraphClusterManager::NewCluster();
+    Node* c;
+    ASSERT_OK(NodeBuilder(strings::StrCat("const_", i), "Const")
+                  .Attr("dtype", DT_FLOAT)
+                  .Attr("value", t)
+                  .Attr("_ngraph_marked_for_clustering", true)
+                  .Attr("_ngraph_cluster", cluster_idx)
+                  .Attr("_ngraph_backend", "CPU")
+                  .Finalize(g, &c));
+    Node* add;
+    ASSERT_OK(NodeBuilder(strings::StrCat("add_", i), "Add")
+                  .Input(prev, 0)
+                  .Input(c, 0)
+                  .Attr("T", DT_FLOAT)
+                  .Attr("_ngraph_marked_for_clustering", true)
+                  .Attr("_ngraph_cluster", cluster_idx)
+                  .Attr("_ngraph_backend", "CPU")
+                  .Finalize(g, &add));
+    Node* abs;
+    ASSERT_OK(NodeBuilder(strings::StrCat("abs_", i), "Abs")
+                  .Input(add, 0)
+                  .Attr("T", DT_FLOAT)
+                  .Finalize(g, &abs));
+    prev = add;
+  }
+}
+
+// Scaling benchmark for the Encapsulator, not run by default. Use
+// --gtest_also_run_disabled_tests --gtest_filter=*EncapsulateScaling* to
+// get the timings.
+TEST(EncapsulateClusters, DISABLED_EncapsulateScaling) {
+  for (int num_clusters : {100, 1000, 10000}) {
+    NGraphClusterManager::EvictAllClusters();
+    Graph g(OpRegistry::Global());
+    BuildEncapsulateBenchmarkGraph(&g, num_clusters);
+    int num_edges = g.num_edges();
+
+    FunctionDefLibrary fdeflib;
+    Encapsulator enc(&g);
+    Timer analysis_timer;
+    ASSERT_OK(enc.AnalysisPass());
+    int analysis_ms = analysis_timer.ElapsedInMS();
+    Timer rewrite_timer;
+    ASSERT_OK(enc.RewritePass(&fdeflib, 0, {{"ngraph_device_id", ""}}));
+    int rewrite_ms = rewrite_timer.ElapsedInMS();
+
+    ASSERT_EQ(fdeflib.function_size(), num_clusters);
+    // input, then an encapsulate and an abs per cluster
+    ASSERT_EQ(g.num_op_nodes(), 2 * num_clusters + 1);
+
+    cout << "Encapsulator: " << num_clusters << " clusters, " << num_edges
+         << " edges: analysis " << analysis_ms << " ms, rewrite "
+         << rewrite_ms << " ms" << endl;
+  }
+}
+
 // Test cases for AOT:
 // TODO: 1. what of scalar inputs. placeholder shape is {}?
 // 2. Shape hints that cause errors in TranslateGraph?. eg trying to add [2,2]
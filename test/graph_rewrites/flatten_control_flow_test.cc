@@ -0,0 +1,246 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/cc/ops/while_loop.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/public/session.h"
+
+#include "ngraph_bridge/ngraph_flatten_control_flow.h"
+#include "ngraph_bridge/ngraph_utils.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+namespace testing {
+
+static int CountControlFlowOps(const Graph& graph) {
+  int count = 0;
+  for (auto node : graph.op_nodes()) {
+    if (node->IsControlFlow() || node->IsLoopCond()) {
+      count++;
+    }
+  }
+  return count;
+}
+
+// Runs the graph with plain TF and returns the fetched tensor
+static Status RunGraph(const Graph& graph,
+                       const std::vector<std::pair<string, Tensor>>& inputs,
+                       const string& fetch, Tensor* output) {
+  GraphDef gdef;
+  graph.ToGraphDef(&gdef);
+  std::unique_ptr<Session> session(NewSession(SessionOptions()));
+  TF_RETURN_IF_ERROR(session->Create(gdef));
+  std::vector<Tensor> outputs;
+  TF_RETURN_IF_ERROR(session->Run(inputs, {fetch}, {}, &outputs));
+  *output = outputs[0];
+  return Status::OK();
+}
+
+//  x ---> Switch(p) -- false --> Neg --> Merge --> out
+//                   -- true  --> Abs -->
+TEST(FlattenControlFlow, IfConversion) {
+  Scope root = Scope::NewRootScope();
+  auto x = ops::Placeholder(root.WithOpName("x"), DT_FLOAT);
+  auto p = ops::Placeholder(root.WithOpName("p"), DT_BOOL);
+  auto sw = ops::Switch(root.WithOpName("sw"), x, p);
+  auto f = ops::Neg(root.WithOpName("f"), sw.output_false);
+  auto t = ops::Abs(root.WithOpName("t"), sw.output_true);
+  auto m = ops::Merge(root.WithOpName("m"), std::initializer_list<Input>{f, t});
+  auto out = ops::Identity(root.WithOpName("out"), m.output);
+
+  Graph graph(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&graph));
+
+  // Nothing happens unless requested
+  UnsetEnvVariable("NGRAPH_TF_CLUSTER_CONTROL_FLOW");
+  ASSERT_OK(FlattenControlFlow(&graph, {}));
+  ASSERT_EQ(CountControlFlowOps(graph), 2);
+
+  SetEnvVariable("NGRAPH_TF_CLUSTER_CONTROL_FLOW", "1");
+  ASSERT_OK(FlattenControlFlow(&graph, {}));
+  UnsetEnvVariable("NGRAPH_TF_CLUSTER_CONTROL_FLOW");
+  ASSERT_EQ(CountControlFlowOps(graph), 0);
+
+  // The Merge is replaced by a Select of the same name
+  bool found_select = false;
+  for (auto node : graph.op_nodes()) {
+    if (node->name() == "m") {
+      ASSERT_EQ(node->type_string(), "Select");
+      found_select = true;
+    }
+  }
+  ASSERT_TRUE(found_select);
+
+  Tensor x_val(DT_FLOAT, TensorShape({2}));
+  AssignInputValues<float>(x_val, {-2.0f, 3.0f});
+  Tensor p_val(DT_BOOL, TensorShape({}));
+
+  DeactivateNGraph();
+  Tensor result;
+  p_val.scalar<bool>()() = true;
+  ASSERT_OK(RunGraph(graph, {{"x", x_val}, {"p", p_val}}, "out", &result));
+  ASSERT_EQ(result.flat<float>()(0), 2.0f);
+  ASSERT_EQ(result.flat<float>()(1), 3.0f);
+
+  p_val.scalar<bool>()() = false;
+  ASSERT_OK(RunGraph(graph, {{"x", x_val}, {"p", p_val}}, "out", &result));
+  ASSERT_EQ(result.flat<float>()(0), 2.0f);
+  ASSERT_EQ(result.flat<float>()(1), -3.0f);
+  ActivateNGraph();
+}
+
+// The predicate of a conditional is computed by another one:
+// tf.cond(tf.cond(p, lambda: q, lambda: !q), lambda: abs(x), lambda: -x)
+TEST(FlattenControlFlow, IfConversionOfNestedPredicate) {
+  Scope root = Scope::NewRootScope();
+  auto x = ops::Placeholder(root.WithOpName("x"), DT_FLOAT);
+  auto p = ops::Placeholder(root.WithOpName("p"), DT_BOOL);
+  auto q = ops::Placeholder(root.WithOpName("q"), DT_BOOL);
+  auto sw_p = ops::Switch(root.WithOpName("sw_p"), q, p);
+  auto not_q = ops::LogicalNot(root.WithOpName("not_q"), sw_p.output_false);
+  auto same_q = ops::Identity(root.WithOpName("same_q"), sw_p.output_true);
+  auto pred = ops::Merge(root.WithOpName("pred"),
+                         std::initializer_list<Input>{not_q, same_q});
+  auto sw = ops::Switch(root.WithOpName("sw"), x, pred.output);
+  auto f = ops::Neg(root.WithOpName("f"), sw.output_false);
+  auto t = ops::Abs(root.WithOpName("t"), sw.output_true);
+  auto m = ops::Merge(root.WithOpName("m"), std::initializer_list<Input>{f, t});
+  auto out = ops::Identity(root.WithOpName("out"), m.output);
+
+  Graph graph(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&graph));
+
+  SetEnvVariable("NGRAPH_TF_CLUSTER_CONTROL_FLOW", "1");
+  ASSERT_OK(FlattenControlFlow(&graph, {}));
+  UnsetEnvVariable("NGRAPH_TF_CLUSTER_CONTROL_FLOW");
+  ASSERT_EQ(CountControlFlowOps(graph), 0);
+
+  Tensor x_val(DT_FLOAT, TensorShape({1}));
+  AssignInputValues<float>(x_val, {-2.0f});
+  Tensor p_val(DT_BOOL, TensorShape({}));
+  Tensor q_val(DT_BOOL, TensorShape({}));
+  q_val.scalar<bool>()() = true;
+
+  DeactivateNGraph();
+  Tensor result;
+  p_val.scalar<bool>()() = true;
+  ASSERT_OK(RunGraph(graph, {{"x", x_val}, {"p", p_val}, {"q", q_val}}, "out",
+                     &result));
+  ASSERT_EQ(result.flat<float>()(0), 2.0f);
+
+  p_val.scalar<bool>()() = false;
+  x_val.flat<float>()(0) = 5.0f;
+  ASSERT_OK(RunGraph(graph, {{"x", x_val}, {"p", p_val}, {"q", q_val}}, "out",
+                     &result));
+  ASSERT_EQ(result.flat<float>()(0), -5.0f);
+  ActivateNGraph();
+}
+
+// for (i = 0; i < 5; i++) x = x * 2
+TEST(FlattenControlFlow, StaticLoopIsUnrolled) {
+  Scope root = Scope::NewRootScope();
+  auto x = ops::Placeholder(root.WithOpName("x"), DT_FLOAT);
+  auto i = ops::Const(root.WithOpName("i"), 0);
+
+  auto cond = [](const Scope& s, const std::vector<Output>& inputs,
+                 Output* output) {
+    *output = ops::Less(s, inputs[0], 5);
+    return s.status();
+  };
+  auto body = [](const Scope& s, const std::vector<Output>& inputs,
+                 std::vector<Output>* outputs) {
+    outputs->push_back(ops::Add(s, inputs[0], 1));
+    outputs->push_back(ops::Mul(s, inputs[1], 2.0f));
+    return s.status();
+  };
+  ops::OutputList outputs;
+  ASSERT_OK(ops::BuildWhileLoop(root, {i, x}, cond, body, "loop", &outputs,
+                                /*create_while_ctx=*/false));
+  auto out = ops::Identity(root.WithOpName("out"), outputs[1]);
+  string exit_name = outputs[1].node()->name();
+
+  Graph graph(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&graph));
+
+  SetEnvVariable("NGRAPH_TF_CLUSTER_CONTROL_FLOW", "1");
+  ASSERT_OK(FlattenControlFlow(&graph, {}));
+  UnsetEnvVariable("NGRAPH_TF_CLUSTER_CONTROL_FLOW");
+  ASSERT_EQ(CountControlFlowOps(graph), 0);
+
+  int num_mul = 0;
+  bool found_exit = false;
+  for (auto node : graph.op_nodes()) {
+    num_mul += node->type_string() == "Mul";
+    found_exit |= node->name() == exit_name;
+  }
+  ASSERT_EQ(num_mul, 5);
+  ASSERT_TRUE(found_exit);
+
+  Tensor x_val(DT_FLOAT, TensorShape({}));
+  x_val.scalar<float>()() = 1.5f;
+  DeactivateNGraph();
+  Tensor result;
+  ASSERT_OK(RunGraph(graph, {{"x", x_val}}, "out", &result));
+  ASSERT_EQ(result.scalar<float>()(), 48.0f);
+  ActivateNGraph();
+}
+
+// The trip count depends on a placeholder, so the loop stays
+TEST(FlattenControlFlow, DynamicLoopIsKept) {
+  Scope root = Scope::NewRootScope();
+  auto n = ops::Placeholder(root.WithOpName("n"), DT_INT32);
+  auto i = ops::Const(root.WithOpName("i"), 0);
+
+  auto cond = [](const Scope& s, const std::vector<Output>& inputs,
+                 Output* output) {
+    *output = ops::Less(s, inputs[0], inputs[1]);
+    return s.status();
+  };
+  auto body = [](const Scope& s, const std::vector<Output>& inputs,
+                 std::vector<Output>* outputs) {
+    outputs->push_back(ops::Add(s, inputs[0], 1));
+    outputs->push_back(ops::Identity(s, inputs[1]));
+    return s.status();
+  };
+  ops::OutputList outputs;
+  ASSERT_OK(ops::BuildWhileLoop(root, {i, n}, cond, body, "loop", &outputs,
+                                /*create_while_ctx=*/false));
+
+  Graph graph(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&graph));
+  int num_control_flow_ops = CountControlFlowOps(graph);
+
+  SetEnvVariable("NGRAPH_TF_CLUSTER_CONTROL_FLOW", "1");
+  ASSERT_OK(FlattenControlFlow(&graph, {}));
+  UnsetEnvVariable("NGRAPH_TF_CLUSTER_CONTROL_FLOW");
+  ASSERT_EQ(CountControlFlowOps(graph), num_control_flow_ops);
+}
+
+}  // namespace testing
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
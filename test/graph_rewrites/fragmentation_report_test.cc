@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "ngraph_bridge/ngraph_fragmentation_report.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+namespace testing {
+
+static const Edge* FindEdge(const Node* src, const Node* dst) {
+  for (auto edge : src->out_edges()) {
+    if (edge->dst() == dst) {
+      return edge;
+    }
+  }
+  return nullptr;
+}
+
+// x -> abs -> sin, abs -> neg, where Sin is not supported and neg could not
+// join the cluster of abs because of deadness
+TEST(FragmentationReport, RanksCauses) {
+  Graph g(OpRegistry::Global());
+  std::vector<PartialTensorShape> shape{PartialTensorShape({100, 100})};
+
+  Node* x;
+  ASSERT_OK(NodeBuilder("x", "Placeholder")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("_output_shapes", shape)
+                .Finalize(&g, &x));
+  Node* abs;
+  ASSERT_OK(NodeBuilder("abs", "Abs")
+                .Input(x, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_output_shapes", shape)
+                .Attr("_ngraph_marked_for_clustering", true)
+                .Finalize(&g, &abs));
+  Node* sin;
+  ASSERT_OK(NodeBuilder("sin", "Sin")
+                .Input(abs, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_output_shapes", shape)
+                .Finalize(&g, &sin));
+  Node* sin2;
+  ASSERT_OK(NodeBuilder("sin2", "Sin")
+                .Input(x, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &sin2));
+  Node* neg;
+  ASSERT_OK(NodeBuilder("neg", "Neg")
+                .Input(abs, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_output_shapes", shape)
+                .Attr("_ngraph_marked_for_clustering", true)
+                .Finalize(&g, &neg));
+
+  DefaultClusterCostModel::Parameters parameters;
+  parameters.encapsulate_overhead_us = 50;
+  parameters.transfer_bytes_per_us = 4000;
+  FragmentationReport report(parameters);
+  // Between two TF ops, and within one cluster: not breaks of interest
+  report.AddBreak(FindEdge(x, sin2), "UNSUPPORTED", 0, 3);
+  report.AddBreak(FindEdge(abs, neg), "SAMECLUSTER", 1, 1);
+  ASSERT_EQ(report.NumBreaks(), 0);
+
+  // 40000 bytes out of one encapsulate and half of a call: 10 + 25 us
+  report.AddBreak(FindEdge(abs, sin), "UNSUPPORTED", 1, 2);
+  // 40000 bytes out of one encapsulate and into the other, and one more
+  // call: 20 + 50 us
+  report.AddBreak(FindEdge(abs, neg), "DEADNESS", 1, 4);
+  ASSERT_EQ(report.NumBreaks(), 2);
+
+  string json = report.ToJson();
+  ASSERT_NE(json.find("\"num_breaks\": 2,"), string::npos);
+  ASSERT_NE(json.find("\"estimated_cost_us\": 105,"), string::npos);
+  auto neg_pos = json.find("\"op_type\": \"Neg\"");
+  auto sin_pos = json.find("\"op_type\": \"Sin\"");
+  ASSERT_NE(neg_pos, string::npos);
+  ASSERT_NE(sin_pos, string::npos);
+  ASSERT_LT(neg_pos, sin_pos);
+  ASSERT_NE(json.find("\"examples\": [\"abs -> sin\"]"), string::npos);
+}
+
+// Breaks whose tensors have no known shape are counted, but cost no transfer
+TEST(FragmentationReport, UnknownSizes) {
+  Graph g(OpRegistry::Global());
+  Node* x;
+  ASSERT_OK(NodeBuilder("x", "Placeholder")
+                .Attr("dtype", DT_FLOAT)
+                .Finalize(&g, &x));
+  Node* abs;
+  ASSERT_OK(NodeBuilder("abs", "Abs")
+                .Input(x, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ngraph_marked_for_clustering", true)
+                .Finalize(&g, &abs));
+
+  FragmentationReport report(DefaultClusterCostModel::Parameters{});
+  report.AddBreak(FindEdge(x, abs), "UNSUPPORTED", 0, 1);
+  string json = report.ToJson();
+  ASSERT_NE(json.find("\"op_type\": \"Placeholder\""), string::npos);
+  ASSERT_NE(json.find("\"num_unknown_sizes\": 1,"), string::npos);
+  ASSERT_NE(json.find("\"transfer_us\": 0,"), string::npos);
+}
+
+// Shapes missing from the graph are taken from the inferred ones, and costs
+// that are not finite are written as null
+TEST(FragmentationReport, InferredSizes) {
+  Graph g(OpRegistry::Global());
+  Node* x;
+  ASSERT_OK(NodeBuilder("x", "Placeholder")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("shape", TensorShape({2, 3}))
+                .Finalize(&g, &x));
+  Node* abs;
+  ASSERT_OK(NodeBuilder("abs", "Abs")
+                .Input(x, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ngraph_marked_for_clustering", true)
+                .Finalize(&g, &abs));
+  FixupSourceAndSinkEdges(&g);
+
+  GraphShapes shapes;
+  InferGraphShapes(g, &shapes);
+  DefaultClusterCostModel::Parameters parameters;
+  parameters.transfer_bytes_per_us = 0;
+  FragmentationReport report(parameters, shapes);
+  report.AddBreak(FindEdge(x, abs), "UNSUPPORTED", 0, 1);
+  string json = report.ToJson();
+  ASSERT_NE(json.find("\"bytes\": 24,"), string::npos);
+  ASSERT_NE(json.find("\"num_unknown_sizes\": 0,"), string::npos);
+  ASSERT_NE(json.find("\"transfer_us\": null,"), string::npos);
+  ASSERT_NE(json.find("\"estimated_cost_us\": null,"), string::npos);
+}
+
+}  // namespace testing
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
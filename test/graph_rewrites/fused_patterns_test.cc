@@ -0,0 +1,180 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "ngraph_bridge/ngraph_fused_patterns.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+namespace testing {
+
+// The ops of tf.nn.moments followed by tf.nn.batch_normalization
+static Output LayerNorm(const Scope& s, Output x, Output gamma, Output beta) {
+  auto axes = ops::Const(s, {-1});
+  auto mean = ops::Mean(s.WithOpName("mean"), x, axes,
+                        ops::Mean::KeepDims(true));
+  auto squared_difference =
+      ops::SquaredDifference(s, x, ops::StopGradient(s, mean));
+  auto variance = ops::Mean(s, squared_difference, axes,
+                            ops::Mean::KeepDims(true));
+  auto inv = ops::Mul(
+      s, ops::Rsqrt(s, ops::AddV2(s, variance, ops::Const(s, 1e-3f))), gamma);
+  return ops::AddV2(s.WithOpName("layer_norm"), ops::Mul(s, x, inv),
+                    ops::Sub(s, beta, ops::Mul(s, mean, inv)));
+}
+
+// 0.5 * x * (1 + erf(x / sqrt(2)))
+static Output Gelu(const Scope& s, Output x) {
+  auto erf = ops::Erf(s.WithOpName("erf"),
+                      ops::RealDiv(s, x, ops::Const(s, 1.4142135f)));
+  return ops::Mul(s.WithOpName("gelu"), ops::Mul(s, ops::Const(s, 0.5f), x),
+                  ops::AddV2(s, ops::Const(s, 1.0f), erf));
+}
+
+static const Node* FindNode(const Graph& g, const string& name) {
+  for (auto node : g.op_nodes()) {
+    if (node->name() == name) {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+TEST(FusedPatterns, LayerNorm) {
+  Scope root = Scope::NewRootScope();
+  auto x = ops::Placeholder(root.WithOpName("x"), DT_FLOAT);
+  auto gamma = ops::Placeholder(root, DT_FLOAT);
+  auto beta = ops::Placeholder(root, DT_FLOAT);
+  LayerNorm(root, x, gamma, beta);
+  Graph g(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&g));
+
+  FusedPattern pattern;
+  ASSERT_TRUE(MatchFusedPattern(FindNode(g, "layer_norm"), &pattern));
+  ASSERT_EQ(pattern.type, FusedPattern::Type::LAYER_NORM);
+  ASSERT_EQ(pattern.interior.size(), 10);
+  ASSERT_EQ(pattern.inputs.size(), 3);
+  ASSERT_EQ(pattern.inputs[0]->src(), FindNode(g, "x"));
+  ASSERT_EQ(pattern.axes, vector<int64>{-1});
+  ASSERT_NEAR(pattern.epsilon, 1e-3, 1e-7);
+}
+
+// The mean is used outside of the pattern, so it has to be computed anyway
+TEST(FusedPatterns, LayerNormSharedMean) {
+  Scope root = Scope::NewRootScope();
+  auto x = ops::Placeholder(root, DT_FLOAT);
+  auto gamma = ops::Placeholder(root, DT_FLOAT);
+  auto beta = ops::Placeholder(root, DT_FLOAT);
+  LayerNorm(root, x, gamma, beta);
+  Graph g(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&g));
+
+  const Node* mean = FindNode(g, "mean");
+  ASSERT_NE(mean, nullptr);
+  g.AddEdge(const_cast<Node*>(mean), 0, g.sink_node(), Graph::kControlSlot);
+  FusedPattern pattern;
+  ASSERT_TRUE(MatchFusedPattern(FindNode(g, "layer_norm"), &pattern));
+
+  Node* identity;
+  ASSERT_OK(NodeBuilder("mean_identity", "Identity")
+                .Input(const_cast<Node*>(mean), 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &identity));
+  ASSERT_FALSE(MatchFusedPattern(FindNode(g, "layer_norm"), &pattern));
+}
+
+TEST(FusedPatterns, Gelu) {
+  Scope root = Scope::NewRootScope();
+  auto x = ops::Placeholder(root.WithOpName("x"), DT_FLOAT);
+  Gelu(root, x);
+  Graph g(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&g));
+
+  FusedPattern pattern;
+  ASSERT_TRUE(MatchFusedPattern(FindNode(g, "gelu"), &pattern));
+  ASSERT_EQ(pattern.type, FusedPattern::Type::GELU);
+  ASSERT_EQ(pattern.interior.size(), 4);
+  ASSERT_EQ(pattern.inputs[0]->src(), FindNode(g, "x"));
+}
+
+// x * (0.5 * (1 + erf(x * (1 / sqrt(2)))))
+TEST(FusedPatterns, GeluOtherForm) {
+  Scope root = Scope::NewRootScope();
+  auto x = ops::Placeholder(root.WithOpName("x"), DT_FLOAT);
+  auto erf = ops::Erf(root.WithOpName("erf"),
+                      ops::Mul(root, x, ops::Const(root, 0.70710678f)));
+  auto cdf = ops::Mul(root, ops::Const(root, 0.5f),
+                      ops::Add(root, erf, ops::Const(root, 1.0f)));
+  ops::Mul(root.WithOpName("gelu"), x, cdf);
+  Graph g(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&g));
+
+  FusedPattern pattern;
+  ASSERT_TRUE(MatchFusedPattern(FindNode(g, "gelu"), &pattern));
+  ASSERT_EQ(pattern.type, FusedPattern::Type::GELU);
+}
+
+// A GELU of the wrong constants
+TEST(FusedPatterns, NoGelu) {
+  Scope root = Scope::NewRootScope();
+  auto x = ops::Placeholder(root, DT_FLOAT);
+  auto erf = ops::Erf(root, ops::RealDiv(root, x, ops::Const(root, 2.0f)));
+  ops::Mul(root.WithOpName("not_gelu"),
+           ops::Mul(root, ops::Const(root, 0.5f), x),
+           ops::AddV2(root, ops::Const(root, 1.0f), erf));
+  Graph g(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&g));
+
+  FusedPattern pattern;
+  ASSERT_FALSE(MatchFusedPattern(FindNode(g, "not_gelu"), &pattern));
+}
+
+// A transformer feed forward block: LayerNorm followed by GELU
+TEST(FusedPatterns, FindAll) {
+  Scope root = Scope::NewRootScope();
+  auto x = ops::Placeholder(root, DT_FLOAT);
+  auto gamma = ops::Placeholder(root, DT_FLOAT);
+  auto beta = ops::Placeholder(root, DT_FLOAT);
+  Gelu(root, LayerNorm(root, x, gamma, beta));
+  Graph g(OpRegistry::Global());
+  ASSERT_OK(root.ToGraph(&g));
+
+  vector<Node*> ordered;
+  GetReversePostOrder(g, &ordered);
+  vector<const Node*> tf_ops(ordered.begin(), ordered.end());
+  vector<FusedPattern> patterns;
+  FindFusedPatterns(tf_ops, &patterns);
+  ASSERT_EQ(patterns.size(), 2);
+  ASSERT_EQ(patterns[0].anchor, FindNode(g, "layer_norm"));
+  ASSERT_EQ(patterns[1].anchor, FindNode(g, "gelu"));
+}
+
+}  // namespace testing
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "ngraph_bridge/tf_graphcycles.h"
+
+using namespace std;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+namespace testing {
+
+// Graph:
+//
+//   0 ---> 1 ---> 2
+//   |             ^
+//   +-------------+
+//   |
+//   +----> 3 ---> 4
+//
+// 0->2 cannot be contracted (path through 1), the other edges can.
+TEST(GraphCycles, CanContractEdges) {
+  GraphCycles gc;
+  for (int i = 0; i < 5; i++) {
+    ASSERT_EQ(gc.NewNode(), i);
+  }
+  ASSERT_TRUE(gc.InsertEdge(0, 1));
+  ASSERT_TRUE(gc.InsertEdge(1, 2));
+  ASSERT_TRUE(gc.InsertEdge(0, 2));
+  ASSERT_TRUE(gc.InsertEdge(0, 3));
+  ASSERT_TRUE(gc.InsertEdge(3, 4));
+
+  std::vector<std::pair<int32, int32>> edges{
+      {0, 1}, {1, 2}, {0, 2}, {0, 3}, {3, 4}};
+  std::vector<bool> expected{true, true, false, true, true};
+  ASSERT_EQ(gc.CanContractEdges(edges), expected);
+
+  // Batched and single queries agree, and nothing was modified
+  for (size_t i = 0; i < edges.size(); i++) {
+    ASSERT_EQ(gc.CanContractEdge(edges[i].first, edges[i].second),
+              expected[i]);
+  }
+  ASSERT_TRUE(gc.CheckInvariants());
+
+  // Once 0->1 is contracted, 0->2 is a plain edge
+  ASSERT_TRUE(gc.ContractEdge(0, 1));
+  ASSERT_TRUE(gc.HasEdge(0, 2));
+  ASSERT_FALSE(gc.HasEdge(0, 1));
+  ASSERT_EQ(gc.CanContractEdges({{0, 2}, {0, 3}}),
+            std::vector<bool>({true, true}));
+  ASSERT_TRUE(gc.CheckInvariants());
+}
+
+// c ---> b ---> d
+//        ^
+// a -----+
+//
+// c is ranked after a, so contracting a->b reorders them
+TEST(GraphCycles, ContractEdgeReorders) {
+  GraphCycles gc;
+  int32 a = gc.NewNode();
+  int32 b = gc.NewNode();
+  int32 c = gc.NewNode();
+  int32 d = gc.NewNode();
+  ASSERT_TRUE(gc.InsertEdge(a, b));
+  ASSERT_TRUE(gc.InsertEdge(c, b));
+  ASSERT_TRUE(gc.InsertEdge(b, d));
+
+  ASSERT_TRUE(gc.ContractEdge(a, b));
+  ASSERT_EQ(gc.Predecessors(a), std::unordered_set<int32>({c}));
+  ASSERT_EQ(gc.Successors(a), std::unordered_set<int32>({d}));
+  ASSERT_EQ(gc.Successors(c), std::unordered_set<int32>({a}));
+  ASSERT_EQ(gc.Predecessors(d), std::unordered_set<int32>({a}));
+  ASSERT_FALSE(gc.InsertEdge(a, c));
+  ASSERT_TRUE(gc.CheckInvariants());
+}
+
+// Contracting many nodes into one, each with its own predecessor and the
+// same successor
+TEST(GraphCycles, ContractEdgesIntoOneNode) {
+  GraphCycles gc;
+  int32 hub = gc.NewNode();
+  int32 sink = gc.NewNode();
+  std::unordered_set<int32> predecessors;
+  for (int i = 0; i < 20; i++) {
+    int32 node = gc.NewNode();
+    int32 predecessor = gc.NewNode();
+    ASSERT_TRUE(gc.InsertEdge(hub, node));
+    ASSERT_TRUE(gc.InsertEdge(predecessor, node));
+    ASSERT_TRUE(gc.InsertEdge(node, sink));
+    predecessors.insert(predecessor);
+  }
+  for (auto node : gc.Successors(hub)) {
+    if (node != sink) {
+      ASSERT_TRUE(gc.ContractEdge(hub, node));
+    }
+  }
+  ASSERT_EQ(gc.Predecessors(hub), predecessors);
+  ASSERT_EQ(gc.Successors(hub), std::unordered_set<int32>({sink}));
+  ASSERT_TRUE(gc.CheckInvariants());
+}
+
+TEST(GraphCycles, InsertEdgeRejectsCycle) {
+  GraphCycles gc;
+  int32 a = gc.NewNode();
+  int32 b = gc.NewNode();
+  int32 c = gc.NewNode();
+  ASSERT_TRUE(gc.InsertEdge(a, b));
+  ASSERT_TRUE(gc.InsertEdge(b, c));
+  ASSERT_FALSE(gc.InsertEdge(c, a));
+  ASSERT_FALSE(gc.HasEdge(c, a));
+  ASSERT_TRUE(gc.IsReachable(a, c));
+  ASSERT_EQ(gc.Successors(a), std::unordered_set<int32>({b}));
+  ASSERT_EQ(gc.Predecessors(c), std::unordered_set<int32>({b}));
+  ASSERT_TRUE(gc.CheckInvariants());
+}
+
+}  // namespace testing
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
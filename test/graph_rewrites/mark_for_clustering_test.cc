@@ -97,6 +97,50 @@ TEST(MarkForClustering, SimpleTest) {
     ASSERT_FALSE(NodeIsMarkedForClustering(node));
   }
 }
+
+// Large enough for the per-node checks to be run on the thread pool
+TEST(MarkForClustering, LargeGraph) {
+  Graph g(OpRegistry::Global());
+
+  Tensor t_input(DT_FLOAT, TensorShape{2, 3});
+
+  Node* prev;
+  ASSERT_OK(NodeBuilder("node0", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t_input)
+                .Finalize(&g, &prev));
+  Node* source = g.source_node();
+  g.AddEdge(source, Graph::kControlSlot, prev, Graph::kControlSlot);
+
+  // every 100th node is an output node, which must not be marked
+  set<string> skip_these_nodes;
+  for (int i = 1; i < 5000; i++) {
+    string name = "node" + to_string(i);
+    Node* node;
+    ASSERT_OK(NodeBuilder(name, "Abs")
+                  .Input(prev, 0)
+                  .Attr("T", DT_FLOAT)
+                  .Finalize(&g, &node));
+    if (i % 100 == 0) {
+      skip_these_nodes.insert(name);
+    }
+    prev = node;
+  }
+  g.AddEdge(prev, Graph::kControlSlot, g.sink_node(), Graph::kControlSlot);
+
+  const char* ng_backend_env_value = std::getenv("NGRAPH_TF_BACKEND");
+  string expected_backend{"CPU"};
+  if (ng_backend_env_value != nullptr) {
+    expected_backend = std::string(ng_backend_env_value);
+  }
+  ASSERT_OK(MarkForClustering(&g, skip_these_nodes, expected_backend));
+
+  for (auto node : g.op_nodes()) {
+    ASSERT_EQ(skip_these_nodes.find(node->name()) == skip_these_nodes.end(),
+              NodeIsMarkedForClustering(node))
+        << node->name();
+  }
+}
+}
 }
 }
-}
\ No newline at end of file
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "ngraph_bridge/ngraph_cluster_manager.h"
+#include "ngraph_bridge/ngraph_encapsulate_clusters.h"
+#include "ngraph_bridge/ngraph_propagate_shapes.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+namespace testing {
+
+// x ---> add(0) <--- const(0)
+//          |
+//          v
+//         abs ---> add(1) <--- const(1)
+//
+// Builds the graph above with x of the given shape, encapsulates it, and
+// returns the encapsulates of cluster 0 and cluster 1
+static void BuildAndEncapsulate(Graph* g, const PartialTensorShape& x_shape,
+                                Node** encap_0, Node** encap_1) {
+  NGraphClusterManager::EvictAllClusters();
+  Tensor t(DT_FLOAT, TensorShape{2, 3});
+  AssignInputValues<float>(t, 1.0f);
+
+  Node* x;
+  ASSERT_OK(NodeBuilder("x", "Placeholder")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("shape", x_shape)
+                .Finalize(g, &x));
+
+  Node* prev = x;
+  std::vector<int> cluster_idxs;
+  for (int i = 0; i < 2; i++) {
+    int cluster_idx = NGraphClusterManager::NewCluster();
+    cluster_idxs.push_back(cluster_idx);
+    Node* c;
+    ASSERT_OK(NodeBuilder("const_" + to_string(i), "Const")
+                  .Attr("dtype", DT_FLOAT)
+                  .Attr("value", t)
+                  .Attr("_ngraph_marked_for_clustering", true)
+                  .Attr("_ngraph_cluster", cluster_idx)
+                  .Attr("_ngraph_backend", "CPU")
+                  .Finalize(g, &c));
+    Node* add;
+    ASSERT_OK(NodeBuilder("add_" + to_string(i), "Add")
+                  .Input(prev, 0)
+                  .Input(c, 0)
+                  .Attr("T", DT_FLOAT)
+                  .Attr("_ngraph_marked_for_clustering", true)
+                  .Attr("_ngraph_cluster", cluster_idx)
+                  .Attr("_ngraph_backend", "CPU")
+                  .Finalize(g, &add));
+    ASSERT_OK(NodeBuilder("abs_" + to_string(i), "Abs")
+                  .Input(add, 0)
+                  .Attr("T", DT_FLOAT)
+                  .Finalize(g, &prev));
+  }
+
+  FunctionDefLibrary fdeflib;
+  ASSERT_OK(EncapsulateClusters(g, 0, &fdeflib, {{"ngraph_device_id", ""}},
+                                {0, {}}));
+
+  for (auto node : g->op_nodes()) {
+    if (node->name() == "ngraph_cluster_" + to_string(cluster_idxs[0])) {
+      *encap_0 = node;
+    } else if (node->name() ==
+               "ngraph_cluster_" + to_string(cluster_idxs[1])) {
+      *encap_1 = node;
+    }
+  }
+}
+
+static void ExpectShapes(const Node* node, const string& attr_name,
+                         const PartialTensorShape& expected) {
+  std::vector<PartialTensorShape> shapes;
+  ASSERT_OK(GetNodeAttr(node->attrs(), attr_name, &shapes));
+  ASSERT_EQ(shapes.size(), 1);
+  ASSERT_TRUE(shapes[0].IsIdenticalTo(expected))
+      << node->name() << " " << attr_name << ": " << shapes[0].DebugString()
+      << " expected: " << expected.DebugString();
+}
+
+// The shape of x reaches the second encapsulate through the first one
+TEST(PropagateShapes, ThroughEncapsulates) {
+  Graph g(OpRegistry::Global());
+  Node* encap_0 = nullptr;
+  Node* encap_1 = nullptr;
+  BuildAndEncapsulate(&g, PartialTensorShape({2, 3}), &encap_0, &encap_1);
+  ASSERT_NE(encap_0, nullptr);
+  ASSERT_NE(encap_1, nullptr);
+
+  PartialTensorShape expected({2, 3});
+  ExpectShapes(encap_0, "_input_shapes", expected);
+  ExpectShapes(encap_0, "_output_shapes", expected);
+  ExpectShapes(encap_1, "_input_shapes", expected);
+  ExpectShapes(encap_1, "_output_shapes", expected);
+}
+
+// Partially known shapes are refined by the encapsulated ops: add(0)
+// broadcasts x against a [2, 3] constant
+TEST(PropagateShapes, PartialShapes) {
+  Graph g(OpRegistry::Global());
+  Node* encap_0 = nullptr;
+  Node* encap_1 = nullptr;
+  BuildAndEncapsulate(&g, PartialTensorShape({-1, 3}), &encap_0, &encap_1);
+  ASSERT_NE(encap_0, nullptr);
+  ASSERT_NE(encap_1, nullptr);
+
+  ExpectShapes(encap_0, "_input_shapes", PartialTensorShape({-1, 3}));
+  ExpectShapes(encap_0, "_output_shapes", PartialTensorShape({2, 3}));
+  ExpectShapes(encap_1, "_input_shapes", PartialTensorShape({2, 3}));
+}
+
+// Unknown shapes stay unknown
+TEST(PropagateShapes, UnknownShapes) {
+  Graph g(OpRegistry::Global());
+  Node* encap_0 = nullptr;
+  Node* encap_1 = nullptr;
+  BuildAndEncapsulate(&g, PartialTensorShape(), &encap_0, &encap_1);
+  ASSERT_NE(encap_0, nullptr);
+
+  ExpectShapes(encap_0, "_input_shapes", PartialTensorShape());
+}
+
+// NGRAPH_TF_DISABLE_SHAPE_PROPAGATION skips the pass
+TEST(PropagateShapes, Disabled) {
+  auto env_map = StoreEnv({"NGRAPH_TF_DISABLE_SHAPE_PROPAGATION"});
+  SetEnvVariable("NGRAPH_TF_DISABLE_SHAPE_PROPAGATION", "1");
+  Graph g(OpRegistry::Global());
+  Node* encap_0 = nullptr;
+  Node* encap_1 = nullptr;
+  BuildAndEncapsulate(&g, PartialTensorShape({2, 3}), &encap_0, &encap_1);
+  RestoreEnv(env_map);
+  ASSERT_NE(encap_0, nullptr);
+
+  std::vector<PartialTensorShape> shapes;
+  ASSERT_FALSE(GetNodeAttr(encap_0->attrs(), "_input_shapes", &shapes).ok());
+}
+
+}  // namespace testing
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
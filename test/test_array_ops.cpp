@@ -50,6 +50,27 @@ namespace testing {
 // Use only Tensors and ops::Const() to provide input to the test op
 // Please ensure the alphabetical order while adding the test functions
 
+// Test op: BroadcastTo, the input has dimensions of size 1 and a lower rank
+TEST(ArrayOps, BroadcastTo) {
+  Scope root = Scope::NewRootScope();
+
+  Tensor input(DT_FLOAT, TensorShape({3, 1}));
+  AssignInputValuesRandom<float>(input, -5, 5);
+
+  Tensor shape(DT_INT32, TensorShape({3}));
+  AssignInputValues<int>(shape, {2, 3, 4});
+
+  vector<int> static_input_indexes = {1};
+  auto R = ops::BroadcastTo(root, input, shape);
+  vector<DataType> output_datatypes = {DT_FLOAT};
+  std::vector<Output> sess_run_fetchoutputs = {R};
+
+  OpExecuter opexecuter(root, "BroadcastTo", static_input_indexes,
+                        output_datatypes, sess_run_fetchoutputs);
+
+  opexecuter.RunTest();
+}  // end of op BroadcastTo
+
 // Test DepthToSpace with NHWC data format
 TEST(ArrayOps, DepthToSpaceNHWC) {
   std::map<std::vector<int64>, int> input_map;
@@ -440,6 +461,29 @@ TEST(ArrayOps, GatherV2TensorAxis2) {
 
 }  // end of test op GatherV2
 
+// Test op: MirrorPad
+TEST(ArrayOps, MirrorPad) {
+  for (auto mode : {"REFLECT", "SYMMETRIC"}) {
+    Scope root = Scope::NewRootScope();
+
+    Tensor input(DT_FLOAT, TensorShape({3, 4}));
+    AssignInputValuesRandom<float>(input, -5, 5);
+
+    Tensor paddings(DT_INT32, TensorShape({2, 2}));
+    AssignInputValues<int>(paddings, {1, 2, 2, 0});
+
+    vector<int> static_input_indexes = {1};
+    auto R = ops::MirrorPad(root, input, paddings, mode);
+    vector<DataType> output_datatypes = {DT_FLOAT};
+    std::vector<Output> sess_run_fetchoutputs = {R};
+
+    OpExecuter opexecuter(root, "MirrorPad", static_input_indexes,
+                          output_datatypes, sess_run_fetchoutputs);
+
+    opexecuter.RunTest();
+  }
+}  // end of op MirrorPad
+
 // Test op: OneHot
 TEST(ArrayOps, OneHot1dNegAxis) {
   Scope root = Scope::NewRootScope();
@@ -1002,6 +1046,27 @@ TEST(ArrayOps, Rank) {
   opexecuter.RunTest();
 }  // end of RankOp
 
+// Test op: ReverseV2, with a negative axis
+TEST(ArrayOps, ReverseV2) {
+  Scope root = Scope::NewRootScope();
+
+  Tensor input(DT_FLOAT, TensorShape({2, 3, 4}));
+  AssignInputValuesRandom<float>(input, -5, 5);
+
+  Tensor axis(DT_INT32, TensorShape({2}));
+  AssignInputValues<int>(axis, {0, -1});
+
+  vector<int> static_input_indexes = {1};
+  auto R = ops::Reverse(root, input, axis);
+  vector<DataType> output_datatypes = {DT_FLOAT};
+  std::vector<Output> sess_run_fetchoutputs = {R};
+
+  OpExecuter opexecuter(root, "ReverseV2", static_input_indexes,
+                        output_datatypes, sess_run_fetchoutputs);
+
+  opexecuter.RunTest();
+}  // end of op ReverseV2
+
 // Test op: ScatterNd Op
 TEST(ArrayOps, ScatterNd1D) {
   Tensor indices(DT_INT32, TensorShape({4, 1}));
@@ -1090,6 +1155,30 @@ TEST(ArrayOps, ScatterNd3D) {
   opexecuter.RunTest();
 }  // end of test op ScatterNd
 
+// Test op: SelectV2, the three inputs are broadcast to a common shape
+TEST(ArrayOps, SelectV2) {
+  Scope root = Scope::NewRootScope();
+
+  Tensor condition(DT_BOOL, TensorShape({3, 1}));
+  AssignInputValues<bool>(condition, {true, false, true});
+
+  Tensor then_input(DT_FLOAT, TensorShape({4}));
+  AssignInputValuesRandom<float>(then_input, -5, 5);
+
+  Tensor else_input(DT_FLOAT, TensorShape({2, 1, 1}));
+  AssignInputValuesRandom<float>(else_input, -5, 5);
+
+  vector<int> static_input_indexes = {};
+  auto R = ops::SelectV2(root, condition, then_input, else_input);
+  vector<DataType> output_datatypes = {DT_FLOAT};
+  std::vector<Output> sess_run_fetchoutputs = {R};
+
+  OpExecuter opexecuter(root, "SelectV2", static_input_indexes,
+                        output_datatypes, sess_run_fetchoutputs);
+
+  opexecuter.RunTest();
+}  // end of op SelectV2
+
 // Test op: Shape, outputs the shape of a tensor
 TEST(ArrayOps, Shape2D) {
   Scope root = Scope::NewRootScope();
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+
+#include "ngraph_bridge/ngraph_constant_folding.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+namespace testing {
+
+// x * transpose(c0 + c1) becomes x * c
+TEST(ConstantFolding, Arithmetic) {
+  auto x = make_shared<ng::op::Parameter>(ng::element::f32, ng::Shape{2, 2});
+  auto c0 = make_shared<ng::op::Constant>(ng::element::f32, ng::Shape{2, 2},
+                                          vector<float>{1, 2, 3, 4});
+  auto c1 = make_shared<ng::op::Constant>(ng::element::f32, ng::Shape{2, 2},
+                                          vector<float>{10, 20, 30, 40});
+  auto add = make_shared<ng::op::Add>(c0, c1);
+  auto transpose = make_shared<ng::op::Reshape>(add, ng::AxisVector{1, 0},
+                                                ng::Shape{2, 2});
+  auto mul = make_shared<ng::op::Multiply>(x, transpose);
+  auto ng_function =
+      make_shared<ng::Function>(ng::NodeVector{mul}, ng::ParameterVector{x});
+
+  ASSERT_EQ(FoldConstants(ng_function), 2);
+  auto folded = dynamic_pointer_cast<ng::op::Constant>(mul->get_argument(1));
+  ASSERT_NE(folded, nullptr);
+  ASSERT_EQ(folded->get_vector<float>(), (vector<float>{11, 33, 22, 44}));
+  ASSERT_EQ(ng_function->get_ordered_ops().size(), 4);
+}
+
+// A Fill of a large shape stays a broadcast of a scalar, but the scalar
+// arithmetic feeding it is folded
+TEST(ConstantFolding, NoLargeBroadcasts) {
+  ng::Shape shape{1024, 1024};
+  auto x = make_shared<ng::op::Parameter>(ng::element::f32, shape);
+  auto c0 = ng::op::Constant::create(ng::element::f32, ng::Shape{}, {1.0f});
+  auto c1 = ng::op::Constant::create(ng::element::f32, ng::Shape{}, {2.0f});
+  auto add = make_shared<ng::op::Add>(c0, c1);
+  auto broadcast =
+      make_shared<ng::op::Broadcast>(add, shape, ng::AxisSet{0, 1});
+  auto mul = make_shared<ng::op::Multiply>(x, broadcast);
+  auto ng_function =
+      make_shared<ng::Function>(ng::NodeVector{mul}, ng::ParameterVector{x});
+
+  ASSERT_EQ(FoldConstants(ng_function), 1);
+  ASSERT_EQ(mul->get_argument(1), broadcast);
+  auto folded =
+      dynamic_pointer_cast<ng::op::Constant>(broadcast->get_argument(0));
+  ASSERT_NE(folded, nullptr);
+  ASSERT_EQ(folded->get_vector<float>(), vector<float>{3.0f});
+}
+
+// The transpose of a weight larger than the budget of a function is left to
+// run time, and the weight is neither copied nor left with extra users by
+// the evaluation
+TEST(ConstantFolding, NoLargeWeights) {
+  ng::Shape shape{1024, 2048};
+  auto x = make_shared<ng::op::Parameter>(ng::element::f32,
+                                          ng::Shape{2048, 1024});
+  auto weights = make_shared<ng::op::Constant>(
+      ng::element::f32, shape, vector<float>(ng::shape_size(shape), 1.0f));
+  auto transpose = make_shared<ng::op::Reshape>(
+      weights, ng::AxisVector{1, 0}, ng::Shape{2048, 1024});
+  auto mul = make_shared<ng::op::Multiply>(x, transpose);
+  auto ng_function =
+      make_shared<ng::Function>(ng::NodeVector{mul}, ng::ParameterVector{x});
+
+  // Retracing folds the same function again
+  ASSERT_EQ(FoldConstants(ng_function), 0);
+  ASSERT_EQ(FoldConstants(ng_function), 0);
+  ASSERT_EQ(mul->get_argument(1), transpose);
+  ASSERT_EQ(transpose->get_argument(0), weights);
+  ASSERT_EQ(weights->get_users().size(), 1);
+}
+
+// A Constant used by a folded op is evaluated in place: once the folded
+// function is gone, it is only used by the ops of the original function
+TEST(ConstantFolding, ConstantsNotCloned) {
+  auto x = make_shared<ng::op::Parameter>(ng::element::f32, ng::Shape{2});
+  auto c = ng::op::Constant::create(ng::element::f32, ng::Shape{2}, {1, 2});
+  auto neg = make_shared<ng::op::Negative>(c);
+  auto add = make_shared<ng::op::Add>(x, c);
+  auto mul = make_shared<ng::op::Multiply>(add, neg);
+  auto ng_function =
+      make_shared<ng::Function>(ng::NodeVector{mul}, ng::ParameterVector{x});
+
+  ASSERT_EQ(FoldConstants(ng_function), 1);
+  ASSERT_EQ(add->get_argument(1), c);
+  ASSERT_EQ(c->get_users().size(), 2);
+  neg.reset();
+  ASSERT_EQ(c->get_users().size(), 1);
+}
+
+// Nothing to fold
+TEST(ConstantFolding, NoConstants) {
+  auto x = make_shared<ng::op::Parameter>(ng::element::f32, ng::Shape{2});
+  auto relu = make_shared<ng::op::Relu>(x);
+  auto ng_function =
+      make_shared<ng::Function>(ng::NodeVector{relu}, ng::ParameterVector{x});
+  ASSERT_EQ(FoldConstants(ng_function), 0);
+}
+
+}  // namespace testing
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
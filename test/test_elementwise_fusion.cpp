@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <functional>
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/op/experimental/compiled_kernel.hpp"
+
+#include "ngraph_bridge/ngraph_elementwise_fusion.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+namespace testing {
+
+static vector<shared_ptr<ng::op::CompiledKernel>> GetKernels(
+    const shared_ptr<ng::Function>& ng_function) {
+  vector<shared_ptr<ng::op::CompiledKernel>> kernels;
+  for (auto node : ng_function->get_ordered_ops()) {
+    auto kernel = dynamic_pointer_cast<ng::op::CompiledKernel>(node);
+    if (kernel != nullptr) {
+      kernels.push_back(kernel);
+    }
+  }
+  return kernels;
+}
+
+// Whether a node of the function is computed from itself
+static bool HasCycle(const shared_ptr<ng::Function>& ng_function) {
+  // Nodes being visited are false, visited ones true
+  unordered_map<ng::Node*, bool> done;
+  function<bool(ng::Node*)> visit = [&](ng::Node* node) {
+    auto itr = done.find(node);
+    if (itr != done.end()) {
+      return !itr->second;
+    }
+    done[node] = false;
+    for (auto arg : node->get_arguments()) {
+      if (visit(arg.get())) {
+        return true;
+      }
+    }
+    done[node] = true;
+    return false;
+  };
+  for (auto result : ng_function->get_results()) {
+    if (visit(result.get())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// x, bias ---> add ---> relu ---> mul ---> sum
+//                ^                  ^
+//          broadcast(bias)          y
+//
+// The broadcast, add, relu and mul become one kernel feeding the sum
+TEST(ElementwiseFusion, Chain) {
+  ng::Shape shape{2, 3};
+  auto x = make_shared<ng::op::Parameter>(ng::element::f32, shape);
+  auto y = make_shared<ng::op::Parameter>(ng::element::f32, shape);
+  auto bias = make_shared<ng::op::Parameter>(ng::element::f32, ng::Shape{3});
+  auto bias_broadcast =
+      make_shared<ng::op::Broadcast>(bias, shape, ng::AxisSet{0});
+  auto add = make_shared<ng::op::Add>(x, bias_broadcast);
+  auto relu = make_shared<ng::op::Relu>(add);
+  auto mul = make_shared<ng::op::Multiply>(relu, y);
+  auto sum = make_shared<ng::op::Sum>(mul, ng::AxisSet{1});
+  auto ng_function = make_shared<ng::Function>(
+      ng::NodeVector{sum}, ng::ParameterVector{x, y, bias});
+
+  ASSERT_EQ(FuseElementwise(ng_function), 1);
+  auto kernels = GetKernels(ng_function);
+  ASSERT_EQ(kernels.size(), 1);
+  ASSERT_EQ(kernels[0]->get_node_list().size(), 4);
+  ASSERT_EQ(kernels[0]->get_kernel_outputs().size(), 1);
+  ASSERT_EQ(kernels[0]->get_arguments().size(), 3);
+  ASSERT_EQ(sum->get_argument(0), kernels[0]);
+}
+
+// Intermediate results used outside of the kernel become kernel outputs
+TEST(ElementwiseFusion, MultipleOutputs) {
+  ng::Shape shape{4};
+  auto x = make_shared<ng::op::Parameter>(ng::element::f32, shape);
+  auto neg = make_shared<ng::op::Negative>(x);
+  auto exp = make_shared<ng::op::Exp>(neg);
+  auto ng_function = make_shared<ng::Function>(ng::NodeVector{neg, exp},
+                                               ng::ParameterVector{x});
+
+  ASSERT_EQ(FuseElementwise(ng_function), 1);
+  auto kernels = GetKernels(ng_function);
+  ASSERT_EQ(kernels.size(), 1);
+  ASSERT_EQ(kernels[0]->get_kernel_outputs().size(), 2);
+  ASSERT_EQ(ng_function->get_output_shape(0), shape);
+  ASSERT_EQ(ng_function->get_output_shape(1), shape);
+}
+
+// relu ---> transpose ---> add
+//   |                       ^
+//   +-----------------------+
+//
+// Fusing the add with the relu would make the kernel both feed and consume
+// the transpose
+TEST(ElementwiseFusion, NoCycles) {
+  ng::Shape shape{3, 3};
+  auto x = make_shared<ng::op::Parameter>(ng::element::f32, shape);
+  auto relu = make_shared<ng::op::Relu>(x);
+  auto transpose =
+      make_shared<ng::op::Reshape>(relu, ng::AxisVector{1, 0}, shape);
+  auto add = make_shared<ng::op::Add>(relu, transpose);
+  auto ng_function =
+      make_shared<ng::Function>(ng::NodeVector{add}, ng::ParameterVector{x});
+
+  ASSERT_EQ(FuseElementwise(ng_function), 0);
+  ASSERT_EQ(GetKernels(ng_function).size(), 0);
+}
+
+// p = relu(x1), v = relu(x2), t = p + v, q = sum(p), r = v + q
+//
+// t and r may not go in the kernels of p and v respectively: each kernel
+// would need an output of the other
+TEST(ElementwiseFusion, NoCyclesThroughGroups) {
+  ng::Shape shape{3};
+  auto x1 = make_shared<ng::op::Parameter>(ng::element::f32, shape);
+  auto x2 = make_shared<ng::op::Parameter>(ng::element::f32, shape);
+  auto p = make_shared<ng::op::Relu>(x1);
+  auto v = make_shared<ng::op::Relu>(x2);
+  auto t = make_shared<ng::op::Add>(p, v);
+  auto q = make_shared<ng::op::Sum>(p, ng::AxisSet{});
+  auto r = make_shared<ng::op::Add>(v, q);
+  auto ng_function = make_shared<ng::Function>(ng::NodeVector{t, r},
+                                               ng::ParameterVector{x1, x2});
+
+  ASSERT_EQ(FuseElementwise(ng_function), 1);
+  ASSERT_FALSE(HasCycle(ng_function));
+  ASSERT_EQ(GetKernels(ng_function).size(), 1);
+}
+
+// Fusion is opt-in
+TEST(ElementwiseFusion, DisabledByDefault) {
+  unsetenv("NGRAPH_TF_FUSE_ELEMENTWISE");
+  auto backend = ng::runtime::Backend::create("INTERPRETER");
+  ASSERT_FALSE(IsElementwiseFusionEnabled(backend.get()));
+}
+
+}  // namespace testing
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
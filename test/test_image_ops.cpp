@@ -99,6 +99,44 @@ TEST(ImageOps, DISABLED_ResizeBilinear) {
     opexecuter.RunTest();
   }
 }
+
+// Test op: ResizeNearestNeighbor, upsampling and downsampling
+TEST(ImageOps, ResizeNearestNeighbor) {
+  vector<vector<int>> new_dims = {{9, 13}, {3, 2}, {1, 1}};
+  for (auto align : {true, false}) {
+    for (auto half_pixel_centers : {true, false}) {
+      // TF does not allow both
+      if (align && half_pixel_centers) {
+        continue;
+      }
+      for (auto dims : new_dims) {
+        Scope root = Scope::NewRootScope();
+        // [batch, height, width, channels]
+        Tensor images(DT_FLOAT, TensorShape({2, 5, 7, 3}));
+        AssignInputValuesRandom(images);
+
+        // new_height, new_width
+        Tensor size(DT_INT32, TensorShape({2}));
+        AssignInputValues(size, dims);
+
+        auto attr = ops::ResizeNearestNeighbor::Attrs()
+                        .AlignCorners(align)
+                        .HalfPixelCenters(half_pixel_centers);
+
+        vector<int> static_input_indexes = {1};
+        auto R = ops::ResizeNearestNeighbor(root, images, size, attr);
+        vector<DataType> output_datatypes = {DT_FLOAT};
+
+        std::vector<Output> sess_run_fetchoutputs = {R};
+        OpExecuter opexecuter(root, "ResizeNearestNeighbor",
+                              static_input_indexes, output_datatypes,
+                              sess_run_fetchoutputs);
+
+        opexecuter.RunTest();
+      }
+    }
+  }
+}
 }
 }
 }
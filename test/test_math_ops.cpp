@@ -1271,6 +1271,29 @@ TEST(MathOps, Cast2D) {
   opexecuter.RunTest();
 }  // end of test op Cast
 
+// Test op: ClipByValue
+TEST(MathOps, ClipByValue) {
+  Scope root = Scope::NewRootScope();
+  Tensor A(DT_FLOAT, TensorShape({2, 3}));
+  AssignInputValues<float>(A, {-3.0, -0.5, 0.0, 0.5, 2.0, 7.0});
+
+  // The lower bound is a scalar and the upper bound has the input's shape
+  Tensor lower(DT_FLOAT, TensorShape({}));
+  AssignInputValues<float>(lower, -1.0);
+  Tensor upper(DT_FLOAT, TensorShape({2, 3}));
+  AssignInputValues<float>(upper, {1.0, 1.0, 1.0, 0.2, 3.0, 3.0});
+
+  vector<int> static_input_indexes = {};
+  auto R = ops::ClipByValue(root, A, lower, upper);
+
+  vector<DataType> output_datatypes = {DT_FLOAT};
+  std::vector<Output> sess_run_fetchoutputs = {R};
+  OpExecuter opexecuter(root, "ClipByValue", static_input_indexes,
+                        output_datatypes, sess_run_fetchoutputs);
+
+  opexecuter.RunTest();
+}  // end of test op ClipByValue
+
 // Test op: Cos
 TEST(MathOps, Cos) {
   Scope root = Scope::NewRootScope();
@@ -1293,6 +1316,50 @@ TEST(MathOps, Cos) {
   opexecuter.RunTest();
 }  // end of test op Cos
 
+// Test op: Einsum
+TEST(MathOps, Einsum) {
+  // Matrix multiplication, batched matrix multiplication with transposed
+  // operands, and a contraction where the labels b and e are summed away
+  // before it
+  vector<string> equations = {"ij,jk->ik", "bji,bkj->bik", "abc,cde->ad"};
+  vector<vector<int64>> lhs_shapes = {{2, 3}, {2, 4, 3}, {2, 3, 4}};
+  vector<vector<int64>> rhs_shapes = {{3, 5}, {2, 5, 4}, {4, 2, 3}};
+  for (size_t i = 0; i < equations.size(); i++) {
+    Scope root = Scope::NewRootScope();
+    Tensor lhs(DT_FLOAT, TensorShape(lhs_shapes[i]));
+    Tensor rhs(DT_FLOAT, TensorShape(rhs_shapes[i]));
+    AssignInputValuesRandom<float>(lhs, -5, 5);
+    AssignInputValuesRandom<float>(rhs, -5, 5);
+
+    vector<int> static_input_indexes = {};
+    auto R = ops::Einsum(root, {lhs, rhs}, equations[i]);
+
+    vector<DataType> output_datatypes = {DT_FLOAT};
+    std::vector<Output> sess_run_fetchoutputs = {R};
+    OpExecuter opexecuter(root, "Einsum", static_input_indexes,
+                          output_datatypes, sess_run_fetchoutputs);
+
+    opexecuter.RunTest();
+  }
+}  // end of test op Einsum
+
+// Test op: Erf
+TEST(MathOps, Erf) {
+  Scope root = Scope::NewRootScope();
+  Tensor A(DT_FLOAT, TensorShape({2, 4}));
+  AssignInputValues<float>(A, {-3.0, -1.0, -0.5, 0.0, 0.1, 0.5, 1.0, 3.0});
+
+  vector<int> static_input_indexes = {};
+  auto R = ops::Erf(root, A);
+
+  vector<DataType> output_datatypes = {DT_FLOAT};
+  std::vector<Output> sess_run_fetchoutputs = {R};
+  OpExecuter opexecuter(root, "Erf", static_input_indexes, output_datatypes,
+                        sess_run_fetchoutputs);
+
+  opexecuter.RunTest();
+}  // end of test op Erf
+
 // Test op: Exp
 TEST(MathOps, Exp1D) {
   Scope root = Scope::NewRootScope();
@@ -2013,6 +2080,24 @@ TEST(MathOps, Rsqrt) {
   opexecuter.RunTest();
 }  // end of test op Rsqrt
 
+// Test op: Round, halves are rounded to even
+TEST(MathOps, Round) {
+  Scope root = Scope::NewRootScope();
+  Tensor A(DT_FLOAT, TensorShape({2, 5}));
+  AssignInputValues<float>(
+      A, {-2.5, -1.5, -0.5, 0.5, 1.5, 2.5, -1.7, 0.2, 1.49, 3.51});
+
+  vector<int> static_input_indexes = {};
+  auto R = ops::Round(root, A);
+
+  vector<DataType> output_datatypes = {DT_FLOAT};
+  std::vector<Output> sess_run_fetchoutputs = {R};
+  OpExecuter opexecuter(root, "Round", static_input_indexes, output_datatypes,
+                        sess_run_fetchoutputs);
+
+  opexecuter.RunTest();
+}  // end of test op Round
+
 // Test op: Sin
 TEST(MathOps, Sin) {
   Scope root = Scope::NewRootScope();
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+
+#include "ngraph_bridge/ngraph_mixed_precision.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+namespace testing {
+
+static int CountConverts(const shared_ptr<ng::Function>& ng_function) {
+  int count = 0;
+  for (auto node : ng_function->get_ordered_ops()) {
+    if (node->description() == "Convert") {
+      count++;
+    }
+  }
+  return count;
+}
+
+// Two consecutive matmuls pass the bf16 product from one to the other
+TEST(MixedPrecision, Dot) {
+  auto x = make_shared<ng::op::Parameter>(ng::element::f32, ng::Shape{2, 3});
+  auto w0 = ng::op::Constant::create(ng::element::f32, ng::Shape{3, 4},
+                                     vector<float>(12, 0.5f));
+  auto w1 = ng::op::Constant::create(ng::element::f32, ng::Shape{4, 5},
+                                     vector<float>(20, 0.25f));
+  auto dot0 = make_shared<ng::op::Dot>(x, w0);
+  auto dot1 = make_shared<ng::op::Dot>(dot0, w1);
+  auto sum = make_shared<ng::op::Sum>(dot1, ng::AxisSet{1});
+  auto ng_function =
+      make_shared<ng::Function>(ng::NodeVector{sum}, ng::ParameterVector{x});
+
+  ASSERT_EQ(LowerPrecision(ng_function, ng::element::bf16), 2);
+  // x, w0, w1 to bf16, and the second product back to f32
+  ASSERT_EQ(CountConverts(ng_function), 4);
+  auto convert = sum->get_argument(0);
+  ASSERT_EQ(convert->description(), "Convert");
+  ASSERT_EQ(convert->get_element_type(), ng::element::f32);
+  auto lowered_dot1 = convert->get_argument(0);
+  ASSERT_EQ(lowered_dot1->description(), "Dot");
+  ASSERT_EQ(lowered_dot1->get_element_type(), ng::element::bf16);
+  ASSERT_EQ(lowered_dot1->get_argument(0)->description(), "Dot");
+  ASSERT_EQ(ng_function->get_output_element_type(0), ng::element::f32);
+}
+
+// Integer and reduction ops are left alone
+TEST(MixedPrecision, OtherOps) {
+  auto x = make_shared<ng::op::Parameter>(ng::element::i32, ng::Shape{2, 3});
+  auto y = make_shared<ng::op::Parameter>(ng::element::i32, ng::Shape{3, 4});
+  auto dot = make_shared<ng::op::Dot>(x, y);
+  auto sum = make_shared<ng::op::Sum>(dot, ng::AxisSet{1});
+  auto ng_function =
+      make_shared<ng::Function>(ng::NodeVector{sum}, ng::ParameterVector{x, y});
+
+  ASSERT_EQ(LowerPrecision(ng_function, ng::element::bf16), 0);
+  ASSERT_EQ(CountConverts(ng_function), 0);
+}
+
+TEST(MixedPrecision, Env) {
+  ng::element::Type ng_et;
+  unsetenv("NGRAPH_TF_MIXED_PRECISION");
+  ASSERT_OK(GetMixedPrecisionType(&ng_et));
+  ASSERT_TRUE(ng_et.is_dynamic());
+
+  setenv("NGRAPH_TF_MIXED_PRECISION", "bf16", 1);
+  ASSERT_OK(GetMixedPrecisionType(&ng_et));
+  ASSERT_EQ(ng_et, ng::element::bf16);
+
+  setenv("NGRAPH_TF_MIXED_PRECISION", "f8", 1);
+  ASSERT_NOT_OK(GetMixedPrecisionType(&ng_et));
+  unsetenv("NGRAPH_TF_MIXED_PRECISION");
+}
+
+}  // namespace testing
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
@@ -15,15 +15,22 @@
  *******************************************************************************/
 #include "gtest/gtest.h"
 
+#include "tensorflow/core/framework/function.pb.h"
 #include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/graph/algorithm.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/graph/graph_constructor.h"
+#include "tensorflow/core/graph/node_builder.h"
 #include "tensorflow/core/platform/env.h"
 
+#include "ngraph_bridge/ngraph_assign_clusters.h"
 #include "ngraph_bridge/ngraph_builder.h"
+#include "ngraph_bridge/ngraph_cluster_manager.h"
+#include "ngraph_bridge/ngraph_encapsulate_clusters.h"
+#include "ngraph_bridge/ngraph_mark_for_clustering.h"
 #include "ngraph_bridge/ngraph_pipelined_tensors.h"
+#include "ngraph_bridge/ngraph_timer.h"
 #include "ngraph_bridge/ngraph_utils.h"
 
 #include "test/test_utilities.h"
@@ -531,6 +538,199 @@ TEST_F(NGraphExecTest, FindNumberOfNodesUtil2) {
   ASSERT_EQ(number_of_sub, 1);
 }
 
+// The nGraph Constants are built from the decoded Const tensors, with the
+// same values for every signature
+TEST_F(NGraphExecTest, ConstValues) {
+  Graph input_graph(OpRegistry::Global());
+  ASSERT_OK(LoadGraph("test_general_graph.pbtxt", &input_graph));
+  int number_of_const = FindNumberOfNodes(&input_graph, "Const");
+
+  // Values of the Const tensors, by name
+  std::map<string, std::vector<float>> expected;
+  for (auto node : input_graph.op_nodes()) {
+    if (node->type_string() == "Const") {
+      Tensor t;
+      const TensorProto* proto;
+      ASSERT_OK(GetNodeAttr(node->attrs(), "value", &proto));
+      ASSERT_TRUE(t.FromProto(*proto));
+      auto flat = t.flat<float>();
+      expected[node->name()].assign(flat.data(), flat.data() + flat.size());
+    }
+  }
+  ASSERT_EQ(expected.size(), number_of_const);
+
+  std::vector<const Tensor*> static_input_map(3, nullptr);
+  for (auto dims : {std::vector<int64>{2, 3}, std::vector<int64>{1, 1}}) {
+    std::vector<TensorShape> tf_input_shapes(3, TensorShape(dims));
+    shared_ptr<ngraph::Function> ng_function;
+    ASSERT_OK(Builder::TranslateGraph(tf_input_shapes, static_input_map,
+                                      &input_graph, ng_function));
+    std::map<string, std::vector<float>> constants;
+    for (auto node : ng_function->get_ops()) {
+      auto constant = std::dynamic_pointer_cast<ngraph::op::Constant>(node);
+      if (constant != nullptr) {
+        constants[node->get_friendly_name()] = constant->get_vector<float>();
+      }
+    }
+    ASSERT_EQ(constants, expected);
+  }
+}
+
+// Builds num_chains independent chains of chain_length Neg ops, from an
+// _Arg to a _Retval each
+static void BuildNegChains(Graph* graph, int num_chains, int chain_length) {
+  for (int i = 0; i < num_chains; i++) {
+    Node* prev;
+    ASSERT_OK(NodeBuilder("arg_" + to_string(i), "_Arg")
+                  .Attr("T", DT_FLOAT)
+                  .Attr("index", i)
+                  .Finalize(graph, &prev));
+    for (int j = 0; j < chain_length; j++) {
+      ASSERT_OK(NodeBuilder("neg_" + to_string(i) + "_" + to_string(j), "Neg")
+                    .Input(prev, 0)
+                    .Attr("T", DT_FLOAT)
+                    .Finalize(graph, &prev));
+    }
+    Node* retval;
+    ASSERT_OK(NodeBuilder("retval_" + to_string(i), "_Retval")
+                  .Input(prev, 0)
+                  .Attr("T", DT_FLOAT)
+                  .Attr("index", i)
+                  .Finalize(graph, &retval));
+  }
+}
+
+// Large clusters made of independent subgraphs are translated concurrently,
+// and give the same function as a serial translation would
+TEST_F(NGraphExecTest, ParallelTranslation) {
+  const int num_chains = 4;
+  const int chain_length = 100;
+  Graph input_graph(OpRegistry::Global());
+  BuildNegChains(&input_graph, num_chains, chain_length);
+
+  std::vector<TensorShape> tf_input_shapes(num_chains, TensorShape({2, 3}));
+  shared_ptr<ngraph::Function> ng_function;
+  ASSERT_OK(TranslateTFGraphNoStatic(tf_input_shapes, input_graph,
+                                     ng_function));
+  ASSERT_EQ(ng_function->get_parameters().size(), num_chains);
+  ASSERT_EQ(ng_function->get_results().size(), num_chains);
+  ASSERT_EQ(ng_function->get_ordered_ops().size(),
+            num_chains * (chain_length + 2));
+
+  // Each result is fed by the chain of its parameter
+  for (int i = 0; i < num_chains; i++) {
+    std::shared_ptr<ngraph::Node> node = ng_function->get_results()[i];
+    for (int j = 0; j <= chain_length; j++) {
+      node = node->get_argument(0);
+    }
+    ASSERT_EQ(node, ng_function->get_parameters()[i]);
+  }
+}
+
+// A cluster made by the clustering passes, of two chains reading the same
+// input and the same Const, is translated as two subgraphs, into a function
+// whose chains share the one parameter
+TEST_F(NGraphExecTest, ParallelTranslationOfCluster) {
+  // Translations only run in parallel on the compile thread pool
+  list<string> env_vars{"NGRAPH_TF_PARALLEL_COMPILE"};
+  const unordered_map<string, string>& env_map = StoreEnv(env_vars);
+  SetEnvVariable("NGRAPH_TF_PARALLEL_COMPILE", "2");
+
+  const int chain_length = 150;
+  Graph graph(OpRegistry::Global());
+  Node* x;
+  ASSERT_OK(NodeBuilder("x", "Placeholder")
+                .Attr("dtype", DT_FLOAT)
+                .Finalize(&graph, &x));
+  Tensor t(DT_FLOAT, TensorShape({2, 3}));
+  AssignInputValues<float>(t, 1.0f);
+  Node* c;
+  ASSERT_OK(NodeBuilder("c", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t)
+                .Finalize(&graph, &c));
+  for (string chain : {"a", "b"}) {
+    Node* prev;
+    ASSERT_OK(NodeBuilder(chain + "_add", "Add")
+                  .Input(x, 0)
+                  .Input(c, 0)
+                  .Attr("T", DT_FLOAT)
+                  .Finalize(&graph, &prev));
+    for (int i = 0; i < chain_length; i++) {
+      ASSERT_OK(NodeBuilder(chain + "_neg_" + to_string(i), "Neg")
+                    .Input(prev, 0)
+                    .Attr("T", DT_FLOAT)
+                    .Finalize(&graph, &prev));
+    }
+    Node* out;
+    ASSERT_OK(NodeBuilder(chain + "_out", "Abs")
+                  .Input(prev, 0)
+                  .Attr("T", DT_FLOAT)
+                  .Finalize(&graph, &out));
+  }
+
+  ASSERT_OK(MarkForClustering(&graph, {"a_out", "b_out"}, "CPU"));
+  ASSERT_OK(AssignClusters(&graph));
+  FunctionDefLibrary fdeflib;
+  ASSERT_OK(EncapsulateClusters(&graph, 0, &fdeflib,
+                                {{"ngraph_device_id", ""}}, {0, {}}));
+
+  std::shared_ptr<const Graph> cluster_graph;
+  for (auto node : graph.op_nodes()) {
+    if (node->type_string() == "NGraphEncapsulate") {
+      ASSERT_EQ(cluster_graph, nullptr);
+      int cluster_idx;
+      ASSERT_OK(GetNodeAttr(node->attrs(), "ngraph_cluster", &cluster_idx));
+      ASSERT_OK(
+          NGraphClusterManager::GetClusterTFGraph(cluster_idx, &cluster_graph));
+    }
+  }
+  ASSERT_NE(cluster_graph, nullptr);
+  ASSERT_EQ(FindNumberOfNodes(cluster_graph.get(), "_Arg"), 1);
+
+  std::vector<std::vector<const Node*>> subgraphs;
+  Builder::GetIndependentSubgraphs(cluster_graph.get(), &subgraphs);
+  ASSERT_EQ(subgraphs.size(), 2);
+  ASSERT_EQ(subgraphs[0].size(), chain_length + 1);
+  ASSERT_EQ(subgraphs[1].size(), chain_length + 1);
+
+  std::vector<const Tensor*> static_input_map(1, nullptr);
+  shared_ptr<ngraph::Function> ng_function;
+  ASSERT_OK(Builder::TranslateGraph({TensorShape({2, 3})}, static_input_map,
+                                    cluster_graph.get(), ng_function));
+  ASSERT_EQ(ng_function->get_results().size(), 2);
+  ASSERT_EQ(ng_function->get_parameters().size(), 1);
+  // No stand-in is left
+  int num_parameters = 0;
+  for (auto node : ng_function->get_ordered_ops()) {
+    num_parameters += node->description() == "Parameter" ? 1 : 0;
+  }
+  ASSERT_EQ(num_parameters, 1);
+  ASSERT_EQ(ng_function->get_parameters()[0]->get_users().size(), 2);
+
+  RestoreEnv(env_map);
+}
+
+// Measures TranslateGraph of a large cluster, as done for every new signature
+TEST_F(NGraphExecTest, DISABLED_TranslationBenchmark) {
+  const int num_repeats = 10;
+  for (int num_ops : {1000, 10000}) {
+    Graph input_graph(OpRegistry::Global());
+    // A single chain is translated on one thread
+    BuildNegChains(&input_graph, 1, num_ops);
+
+    std::vector<TensorShape> tf_input_shapes{TensorShape({2, 3})};
+    Timer timer;
+    for (int i = 0; i < num_repeats; i++) {
+      shared_ptr<ngraph::Function> ng_function;
+      ASSERT_OK(TranslateTFGraphNoStatic(tf_input_shapes, input_graph,
+                                         ng_function));
+    }
+    cout << "TranslateGraph: " << num_ops << " ops: "
+         << timer.ElapsedInMS() / num_repeats << " ms" << endl;
+  }
+}
+
 }  // namespace testing
 }  // namespace ngraph_bridge
 }  // namespace tensorflow
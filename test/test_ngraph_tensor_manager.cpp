@@ -522,6 +522,14 @@ TEST_F(NGraphTensorManagerTest, SharedName) {
     ASSERT_OK(tensor_manager.GetOutputVariableUpdateTFTensor(0, &copy_to_tf));
     ASSERT_FALSE(copy_to_tf);
 
+    // the same, in the order of the indexes
+    ASSERT_EQ(tensor_manager.GetInputVariableSharedNames(),
+              (vector<string>{"A", "C"}));
+    ASSERT_EQ(tensor_manager.GetOutputVariableSharedNames(),
+              (vector<string>{"Z", "X", "Y"}));
+    ASSERT_EQ(tensor_manager.GetOutputVariablesUpdateTFTensor(),
+              (vector<bool>{false, false, true}));
+
   } else {
     string shared_name;
     bool copy_to_tf;
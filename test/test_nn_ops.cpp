@@ -17,6 +17,7 @@
 #include "gtest/gtest.h"
 
 #include "tensorflow/cc/client/client_session.h"
+#include "tensorflow/cc/ops/nn_ops_internal.h"
 #include "tensorflow/cc/ops/standard_ops.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
 #include "tensorflow/core/framework/graph.pb.h"
@@ -1258,6 +1259,24 @@ TEST(NNOps, L2Loss) {
   }
 }
 
+// Test Op :"LeakyRelu"
+TEST(NNOps, LeakyRelu) {
+  Scope root = Scope::NewRootScope();
+  Tensor input_data(DT_FLOAT, TensorShape({3, 4}));
+  AssignInputValuesRandom<float>(input_data, -5, 5);
+
+  vector<int> static_input_indexes = {};
+  auto attrs = ops::internal::LeakyRelu::Alpha(0.3f);
+  auto R = ops::internal::LeakyRelu(root, input_data, attrs);
+  vector<DataType> output_datatypes = {DT_FLOAT};
+  std::vector<Output> sess_run_fetchoutputs = {R};
+
+  OpExecuter opexecuter(root, "LeakyRelu", static_input_indexes,
+                        output_datatypes, sess_run_fetchoutputs);
+
+  opexecuter.RunTest();
+}
+
 // Test Op :"LogSoftmax"
 TEST(NNOps, LogSoftmax) {
   std::vector<std::vector<int64>> input_sizes = {
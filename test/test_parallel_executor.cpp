@@ -22,6 +22,8 @@
 #include "tensorflow/core/public/session.h"
 
 #include "ngraph_bridge/ngraph_backend_manager.h"
+#include "ngraph_bridge/ngraph_compile_pool.h"
+#include "ngraph_bridge/ngraph_executable_cache.h"
 #include "ngraph_bridge/ngraph_executor.h"
 #include "ngraph_bridge/ngraph_utils.h"
 #include "ngraph_bridge/version.h"
@@ -532,6 +534,207 @@ TEST(ParallelExecutor, E2E8Bit) {
   session->Close();
 }
 
+// Loads test_axpy_launchop.pbtxt with every node renamed, and optionally with
+// the Add turned into a Sub
+static Status LoadRenamedAxpyGraph(const string& prefix, bool use_sub,
+                                   unique_ptr<tf::Graph>& new_graph) {
+  tensorflow::GraphDef graph_def;
+  TF_RETURN_IF_ERROR(
+      ReadTextProto(Env::Default(), "test_axpy_launchop.pbtxt", &graph_def));
+  for (auto& node : *graph_def.mutable_node()) {
+    node.set_name(prefix + node.name());
+    if (use_sub && node.op() == "Add") {
+      node.set_op("Sub");
+    }
+    for (auto& input : *node.mutable_input()) {
+      input = (input[0] == '^') ? "^" + prefix + input.substr(1)
+                                : prefix + input;
+    }
+  }
+
+  GraphConstructorOptions opts;
+  opts.allow_internal_ops = true;
+  new_graph.reset(new tf::Graph(OpRegistry::Global()));
+  return ConvertGraphDefToGraph(opts, graph_def, new_graph.get());
+}
+
+TEST(ParallelExecutor, ClusterHash) {
+  unique_ptr<tf::Graph> graph;
+  ASSERT_OK(LoadGraphFromPbTxt("test_axpy_launchop.pbtxt", graph));
+  unique_ptr<tf::Graph> renamed_graph;
+  ASSERT_OK(LoadRenamedAxpyGraph("layer_1/", false, renamed_graph));
+  unique_ptr<tf::Graph> sub_graph;
+  ASSERT_OK(LoadRenamedAxpyGraph("layer_1/", true, sub_graph));
+
+  // Names do not matter, ops do
+  ASSERT_EQ(ComputeClusterHash(graph.get()),
+            ComputeClusterHash(renamed_graph.get()));
+  ASSERT_NE(ComputeClusterHash(graph.get()),
+            ComputeClusterHash(sub_graph.get()));
+
+  // Hits of the executable cache are checked against the graphs themselves
+  ASSERT_TRUE(ClusterGraphsEqual(graph.get(), renamed_graph.get()));
+  ASSERT_FALSE(ClusterGraphsEqual(graph.get(), sub_graph.get()));
+}
+
+// Two encapsulates of the same structure compile once
+TEST(ParallelExecutor, SharedExecutable) {
+  unique_ptr<tf::Graph> graph_0;
+  ASSERT_OK(LoadRenamedAxpyGraph("layer_0/", false, graph_0));
+  unique_ptr<tf::Graph> graph_1;
+  ASSERT_OK(LoadRenamedAxpyGraph("layer_1/", false, graph_1));
+
+  tf::ngraph_bridge::BackendManager::CreateBackend("INTERPRETER");
+  size_t num_cached = NGraphExecutableCache::Size();
+  unique_ptr<NGraphExecutor> executor_0(new NGraphExecutor(
+      100, 500, 600, graph_0, "INTERPRETER", "layer_0", 16));
+  unique_ptr<NGraphExecutor> executor_1(new NGraphExecutor(
+      101, 501, 600, graph_1, "INTERPRETER", "layer_1", 16));
+
+  Tensor x(DT_FLOAT, TensorShape({2, 3}));
+  Tensor y(DT_FLOAT, TensorShape({2, 3}));
+  std::vector<Tensor> tf_input_tensors{x, y};
+
+  shared_ptr<ngraph::runtime::Executable> ng_exec_0, ng_exec_1;
+  shared_ptr<PipelinedTensorsStore> pts_0, pts_1;
+  std::string ser_ng_func;
+  bool cache_hit = false;
+  ASSERT_OK(executor_0->GetExecutableFunctionAndTensors(
+      tf_input_tensors, ng_exec_0, ser_ng_func, pts_0, cache_hit));
+  ASSERT_FALSE(cache_hit);
+  ASSERT_EQ(NGraphExecutableCache::Size(), num_cached + 1);
+
+  // A miss for the cache of executor_1, but served from the shared cache
+  ASSERT_OK(executor_1->GetExecutableFunctionAndTensors(
+      tf_input_tensors, ng_exec_1, ser_ng_func, pts_1, cache_hit));
+  ASSERT_FALSE(cache_hit);
+  ASSERT_EQ(ng_exec_0, ng_exec_1);
+  ASSERT_EQ(NGraphExecutableCache::Size(), num_cached + 1);
+  // Each executor still has its own pipelined tensors
+  ASSERT_NE(pts_0, pts_1);
+
+  // The executable lives as long as one of its users
+  ng_exec_1.reset();
+  executor_1.reset();
+  ASSERT_EQ(NGraphExecutableCache::Size(), num_cached + 1);
+  ng_exec_0.reset();
+  executor_0.reset();
+  ASSERT_EQ(NGraphExecutableCache::Size(), num_cached);
+}
+
+// Encapsulates of the same structure but a different backend config compile
+// separately
+TEST(ParallelExecutor, NoSharedExecutableAcrossConfigs) {
+  unique_ptr<tf::Graph> graph_0;
+  ASSERT_OK(LoadRenamedAxpyGraph("layer_0/", false, graph_0));
+  unique_ptr<tf::Graph> graph_1;
+  ASSERT_OK(LoadRenamedAxpyGraph("layer_1/", false, graph_1));
+
+  tf::ngraph_bridge::BackendManager::CreateBackend("INTERPRETER");
+  size_t num_cached = NGraphExecutableCache::Size();
+  unique_ptr<NGraphExecutor> executor_0(new NGraphExecutor(
+      100, 500, 600, graph_0, "INTERPRETER", "layer_0", 16));
+  unique_ptr<NGraphExecutor> executor_1(new NGraphExecutor(
+      101, 501, 600, graph_1, "INTERPRETER", "layer_1", 16));
+
+  google::protobuf::Map<string, AttrValue> attrs;
+  attrs["_ngraph_device_config"].set_s("1");
+  std::unordered_map<std::string, std::string> additional_attribute_map;
+  ASSERT_OK(executor_1->ParseNodeAttributes(attrs, &additional_attribute_map));
+  ASSERT_EQ(additional_attribute_map["device_config"], "1");
+
+  Tensor x(DT_FLOAT, TensorShape({2, 3}));
+  Tensor y(DT_FLOAT, TensorShape({2, 3}));
+  std::vector<Tensor> tf_input_tensors{x, y};
+
+  shared_ptr<ngraph::runtime::Executable> ng_exec_0, ng_exec_1;
+  shared_ptr<PipelinedTensorsStore> pts_0, pts_1;
+  std::string ser_ng_func;
+  bool cache_hit = false;
+  ASSERT_OK(executor_0->GetExecutableFunctionAndTensors(
+      tf_input_tensors, ng_exec_0, ser_ng_func, pts_0, cache_hit));
+  ASSERT_OK(executor_1->GetExecutableFunctionAndTensors(
+      tf_input_tensors, ng_exec_1, ser_ng_func, pts_1, cache_hit));
+  ASSERT_NE(ng_exec_0, ng_exec_1);
+  ASSERT_EQ(NGraphExecutableCache::Size(), num_cached + 2);
+
+  ng_exec_0.reset();
+  ng_exec_1.reset();
+  executor_0.reset();
+  executor_1.reset();
+  ASSERT_EQ(NGraphExecutableCache::Size(), num_cached);
+}
+
+// A precompiled signature is a cache hit on the first call
+TEST(ParallelExecutor, Precompile) {
+  unique_ptr<tf::Graph> graph;
+  ASSERT_OK(LoadGraphFromPbTxt("test_axpy_launchop.pbtxt", graph));
+
+  tf::ngraph_bridge::BackendManager::CreateBackend("INTERPRETER");
+  NGraphExecutor executor(100, 500, 600, graph, "INTERPRETER", "axpy", 16);
+
+  std::vector<TensorShape> input_shapes{TensorShape({2, 3}),
+                                        TensorShape({2, 3})};
+  std::vector<std::function<Status()>> tasks{
+      [&executor, &input_shapes]() {
+        return executor.Precompile(input_shapes);
+      },
+      []() { return Status::OK(); }};
+  ASSERT_OK(RunCompileTasks(tasks));
+
+  Tensor x(DT_FLOAT, TensorShape({2, 3}));
+  Tensor y(DT_FLOAT, TensorShape({2, 3}));
+  std::vector<Tensor> tf_input_tensors{x, y};
+  shared_ptr<ngraph::runtime::Executable> ng_exec;
+  shared_ptr<PipelinedTensorsStore> pts;
+  std::string ser_ng_func;
+  bool cache_hit = false;
+  ASSERT_OK(executor.GetExecutableFunctionAndTensors(
+      tf_input_tensors, ng_exec, ser_ng_func, pts, cache_hit));
+  ASSERT_TRUE(cache_hit);
+
+  // A wrong number of shapes is reported
+  std::vector<std::function<Status()>> bad_tasks{[&executor]() {
+    return executor.Precompile({TensorShape({2, 3})});
+  }};
+  ASSERT_FALSE(RunCompileTasks(bad_tasks).ok());
+}
+
+// The execution plan is made with the executable and kept with it
+TEST(ParallelExecutor, ExecutionPlan) {
+  unique_ptr<tf::Graph> graph;
+  ASSERT_OK(LoadGraphFromPbTxt("test_axpy_launchop.pbtxt", graph));
+
+  tf::ngraph_bridge::BackendManager::CreateBackend("INTERPRETER");
+  NGraphExecutor executor(100, 500, 600, graph, "INTERPRETER", "axpy", 16);
+
+  Tensor x(DT_FLOAT, TensorShape({2, 3}));
+  Tensor y(DT_FLOAT, TensorShape({2, 3}));
+  std::vector<Tensor> tf_input_tensors{x, y};
+  shared_ptr<ngraph::runtime::Executable> ng_exec;
+  shared_ptr<PipelinedTensorsStore> pts;
+  shared_ptr<const NGraphExecutionPlan> plan;
+  std::string ser_ng_func;
+  bool cache_hit = false;
+  ASSERT_OK(executor.GetExecutableFunctionAndTensors(
+      tf_input_tensors, ng_exec, ser_ng_func, pts, plan, cache_hit));
+  ASSERT_FALSE(cache_hit);
+  ASSERT_NE(plan, nullptr);
+  ASSERT_EQ(plan->pipelined_input_bytes, (vector<size_t>{24, 24}));
+  ASSERT_EQ(plan->output_shapes.size(), 2);
+  ASSERT_EQ(plan->output_element_types.size(), 2);
+  for (int i = 0; i < 2; i++) {
+    ASSERT_EQ(plan->output_shapes[i], TensorShape({2, 3}));
+    ASSERT_EQ(plan->output_element_types[i], ng::element::f32);
+  }
+
+  shared_ptr<const NGraphExecutionPlan> cached_plan;
+  ASSERT_OK(executor.GetExecutableFunctionAndTensors(
+      tf_input_tensors, ng_exec, ser_ng_func, pts, cached_plan, cache_hit));
+  ASSERT_TRUE(cache_hit);
+  ASSERT_EQ(cached_plan, plan);
+}
+
 }  // namespace testing
 }  // namespace ngraph_bridge
 }  // namespace tensorflow
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+
+#include "ngraph_bridge/ngraph_quantization_propagation.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+namespace testing {
+
+static shared_ptr<ng::Node> Scale(float scale) {
+  return ng::op::Constant::create(ng::element::f32, ng::Shape{}, {scale});
+}
+
+static shared_ptr<ng::Node> Offset() {
+  return ng::op::Constant::create(ng::element::i8, ng::Shape{}, {0});
+}
+
+static shared_ptr<ng::Node> Dequantize(const shared_ptr<ng::Node>& arg,
+                                       float scale) {
+  return make_shared<ng::op::Dequantize>(arg, Scale(scale), Offset(),
+                                         ng::element::f32, ng::AxisSet{});
+}
+
+static shared_ptr<ng::Node> Quantize(const shared_ptr<ng::Node>& arg,
+                                     float scale) {
+  return make_shared<ng::op::Quantize>(
+      arg, Scale(scale), Offset(), ng::element::i8, ng::AxisSet{},
+      ng::op::Quantize::RoundMode::ROUND_NEAREST_TOWARD_EVEN);
+}
+
+// The scale and offset constants are different nodes with the same values
+TEST(QuantizationPropagation, QuantizeOfDequantize) {
+  auto x = make_shared<ng::op::Parameter>(ng::element::i8, ng::Shape{2, 3});
+  auto q = Quantize(Dequantize(x, 0.5f), 0.5f);
+  auto ng_function =
+      make_shared<ng::Function>(ng::NodeVector{q}, ng::ParameterVector{x});
+
+  ASSERT_EQ(PropagateQuantization(ng_function), 2);
+  ASSERT_EQ(ng_function->get_results()[0]->get_argument(0), x);
+}
+
+// Dequantize -> MaxPool -> Reshape -> Quantize runs in int8
+TEST(QuantizationPropagation, ThroughMaxPoolAndReshape) {
+  auto x =
+      make_shared<ng::op::Parameter>(ng::element::i8, ng::Shape{1, 1, 4, 4});
+  auto max_pool =
+      make_shared<ng::op::MaxPool>(Dequantize(x, 0.5f), ng::Shape{2, 2});
+  auto reshape = make_shared<ng::op::Reshape>(
+      max_pool, ng::AxisVector{0, 1, 2, 3}, ng::Shape{1, 4});
+  auto q = Quantize(reshape, 0.5f);
+  auto ng_function =
+      make_shared<ng::Function>(ng::NodeVector{q}, ng::ParameterVector{x});
+
+  ASSERT_EQ(PropagateQuantization(ng_function), 2);
+  for (auto node : ng_function->get_ordered_ops()) {
+    ASSERT_NE(node->description(), "Quantize");
+    ASSERT_NE(node->description(), "Dequantize");
+    ASSERT_EQ(node->get_output_element_type(0), ng::element::i8);
+  }
+  ASSERT_EQ(ng_function->get_output_shape(0), (ng::Shape{1, 4}));
+}
+
+// Requantizing to another scale is not a no-op
+TEST(QuantizationPropagation, DifferentScales) {
+  auto x = make_shared<ng::op::Parameter>(ng::element::i8, ng::Shape{2, 3});
+  auto q = Quantize(Dequantize(x, 0.5f), 0.25f);
+  auto ng_function =
+      make_shared<ng::Function>(ng::NodeVector{q}, ng::ParameterVector{x});
+
+  ASSERT_EQ(PropagateQuantization(ng_function), 0);
+  ASSERT_EQ(ng_function->get_results()[0]->get_argument(0), q);
+}
+
+// A concat of a dequantized and a float tensor stays in float
+TEST(QuantizationPropagation, MixedConcat) {
+  auto x = make_shared<ng::op::Parameter>(ng::element::i8, ng::Shape{2, 3});
+  auto y = make_shared<ng::op::Parameter>(ng::element::f32, ng::Shape{2, 3});
+  auto dq = Dequantize(x, 0.5f);
+  auto concat = make_shared<ng::op::Concat>(ng::NodeVector{dq, y}, 0);
+  auto ng_function = make_shared<ng::Function>(ng::NodeVector{concat},
+                                               ng::ParameterVector{x, y});
+
+  ASSERT_EQ(PropagateQuantization(ng_function), 0);
+  ASSERT_EQ(concat->get_argument(0), dq);
+}
+
+}  // namespace testing
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "ngraph/graph_util.hpp"
+#include "ngraph/ngraph.hpp"
+
+#include "ngraph_bridge/ngraph_sparse_updates.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+namespace testing {
+
+// Runs ng_function on the INTERPRETER backend
+static vector<float> Run(const shared_ptr<ng::Function>& ng_function,
+                         const vector<float>& table, const vector<int>& ids,
+                         const vector<float>& updates, float alpha) {
+  auto backend = ng::runtime::Backend::create("INTERPRETER");
+  auto params = ng_function->get_parameters();
+  vector<shared_ptr<ng::runtime::Tensor>> ng_inputs;
+  for (auto param : params) {
+    ng_inputs.push_back(backend->create_tensor(param->get_element_type(),
+                                               param->get_shape()));
+  }
+  ng_inputs[0]->write(table.data(), table.size() * sizeof(float));
+  ng_inputs[1]->write(ids.data(), ids.size() * sizeof(int));
+  ng_inputs[2]->write(updates.data(), updates.size() * sizeof(float));
+  ng_inputs[3]->write(&alpha, sizeof(float));
+  auto ng_output = backend->create_tensor(
+      ng_function->get_output_element_type(0),
+      ng_function->get_output_shape(0));
+
+  auto exec = backend->compile(ng_function);
+  exec->call({ng_output}, ng_inputs);
+
+  vector<float> output(ng::shape_size(ng_function->get_output_shape(0)));
+  ng_output->read(output.data(), output.size() * sizeof(float));
+  return output;
+}
+
+// table - alpha * UnsortedSegmentSum(updates, ids), as translated from
+// ApplyGradientDescent on the gradient of an embedding lookup
+TEST(SparseUpdates, GradientDescent) {
+  ng::Shape table_shape{100, 4};
+  auto table = make_shared<ng::op::Parameter>(ng::element::f32, table_shape);
+  auto ids = make_shared<ng::op::Parameter>(ng::element::i32, ng::Shape{3});
+  auto updates =
+      make_shared<ng::op::Parameter>(ng::element::f32, ng::Shape{3, 4});
+  auto alpha = make_shared<ng::op::Parameter>(ng::element::f32, ng::Shape{});
+  auto zeros = make_shared<ng::op::Constant>(
+      ng::element::f32, table_shape,
+      vector<float>(ng::shape_size(table_shape), 0.0f));
+  auto gradient = make_shared<ng::op::ScatterAdd>(zeros, ids, updates);
+  auto scaled_gradient = make_shared<ng::op::Multiply>(
+      make_shared<ng::op::Broadcast>(alpha, table_shape, ng::AxisSet{0, 1}),
+      gradient);
+  auto sub = make_shared<ng::op::Subtract>(table, scaled_gradient);
+  auto ng_function = make_shared<ng::Function>(
+      ng::NodeVector{sub}, ng::ParameterVector{table, ids, updates, alpha});
+  auto reference = ng::clone_function(*ng_function);
+
+  ASSERT_EQ(FuseSparseUpdates(ng_function), 2);
+  auto scatter_add = ng_function->get_results()[0]->get_argument(0);
+  ASSERT_EQ(scatter_add->description(), "ScatterAdd");
+  ASSERT_EQ(scatter_add->get_argument(0), table);
+  for (auto node : ng_function->get_ordered_ops()) {
+    ASSERT_NE(node, zeros);
+  }
+
+  vector<float> table_values(ng::shape_size(table_shape));
+  for (size_t i = 0; i < table_values.size(); i++) {
+    table_values[i] = static_cast<float>(i % 5);
+  }
+  // Row 7 is updated twice
+  vector<int> id_values{7, 42, 7};
+  vector<float> update_values{1, 2, 3, 4, 5, 6, 7, 8, -1, -2, -3, -4};
+  ASSERT_EQ(Run(ng_function, table_values, id_values, update_values, 0.5f),
+            Run(reference, table_values, id_values, update_values, 0.5f));
+}
+
+// A ScatterAdd into a non zero tensor, or one that is used elsewhere, is left
+// alone
+TEST(SparseUpdates, Dense) {
+  ng::Shape table_shape{10, 4};
+  auto table = make_shared<ng::op::Parameter>(ng::element::f32, table_shape);
+  auto ids = make_shared<ng::op::Parameter>(ng::element::i32, ng::Shape{3});
+  auto updates =
+      make_shared<ng::op::Parameter>(ng::element::f32, ng::Shape{3, 4});
+  auto ones = make_shared<ng::op::Constant>(
+      ng::element::f32, table_shape,
+      vector<float>(ng::shape_size(table_shape), 1.0f));
+  auto zeros = make_shared<ng::op::Constant>(
+      ng::element::f32, table_shape,
+      vector<float>(ng::shape_size(table_shape), 0.0f));
+  auto scatter_ones = make_shared<ng::op::ScatterAdd>(ones, ids, updates);
+  auto scatter_zeros = make_shared<ng::op::ScatterAdd>(zeros, ids, updates);
+  auto add0 = make_shared<ng::op::Add>(table, scatter_ones);
+  auto add1 = make_shared<ng::op::Add>(table, scatter_zeros);
+  auto ng_function = make_shared<ng::Function>(
+      ng::NodeVector{add0, add1, scatter_zeros},
+      ng::ParameterVector{table, ids, updates});
+
+  ASSERT_EQ(FuseSparseUpdates(ng_function), 0);
+}
+
+}  // namespace testing
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "ngraph/graph_util.hpp"
+#include "ngraph/ngraph.hpp"
+
+#include "ngraph_bridge/ngraph_transpose_sinking.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+namespace tensorflow {
+
+namespace ngraph_bridge {
+
+namespace testing {
+
+static shared_ptr<ng::Node> Transpose(const shared_ptr<ng::Node>& arg,
+                                      const ng::AxisVector& order) {
+  ng::Shape shape(order.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    shape[i] = arg->get_shape()[order[i]];
+  }
+  return make_shared<ng::op::Reshape>(arg, order, shape);
+}
+
+static int CountTransposes(const shared_ptr<ng::Function>& ng_function) {
+  int count = 0;
+  for (auto node : ng_function->get_ordered_ops()) {
+    if (dynamic_pointer_cast<ng::op::Reshape>(node) != nullptr) {
+      count++;
+    }
+  }
+  return count;
+}
+
+// Runs ng_function on the INTERPRETER backend with a single input
+static vector<float> Run(const shared_ptr<ng::Function>& ng_function,
+                         const vector<float>& input) {
+  auto backend = ng::runtime::Backend::create("INTERPRETER");
+  auto param = ng_function->get_parameters()[0];
+  auto ng_input = backend->create_tensor(param->get_element_type(),
+                                         param->get_shape());
+  ng_input->write(input.data(), input.size() * sizeof(float));
+  auto ng_output = backend->create_tensor(
+      ng_function->get_output_element_type(0),
+      ng_function->get_output_shape(0));
+
+  auto exec = backend->compile(ng_function);
+  exec->call({ng_output}, {ng_input});
+
+  vector<float> output(ng::shape_size(ng_function->get_output_shape(0)));
+  ng_output->read(output.data(), output.size() * sizeof(float));
+  return output;
+}
+
+// NHWC -> NCHW -> relu -> NHWC leaves no transpose behind
+TEST(TransposeSinking, InverseTransposesCancel) {
+  auto x = make_shared<ng::op::Parameter>(ng::element::f32,
+                                          ng::Shape{1, 4, 5, 3});
+  auto nchw = Transpose(x, ng::AxisVector{0, 3, 1, 2});
+  auto relu = make_shared<ng::op::Relu>(nchw);
+  auto nhwc = Transpose(relu, ng::AxisVector{0, 2, 3, 1});
+  auto ng_function =
+      make_shared<ng::Function>(ng::NodeVector{nhwc}, ng::ParameterVector{x});
+
+  ASSERT_EQ(SinkTransposes(ng_function), 2);
+  ASSERT_EQ(CountTransposes(ng_function), 0);
+  ASSERT_EQ(ng_function->get_output_shape(0), (ng::Shape{1, 4, 5, 3}));
+}
+
+// A transpose feeding an op that is not elementwise stays where it is
+TEST(TransposeSinking, StopsAtOtherOps) {
+  auto x = make_shared<ng::op::Parameter>(ng::element::f32,
+                                          ng::Shape{1, 4, 5, 3});
+  auto nchw = Transpose(x, ng::AxisVector{0, 3, 1, 2});
+  auto sum = make_shared<ng::op::Sum>(nchw, ng::AxisSet{1});
+  auto ng_function =
+      make_shared<ng::Function>(ng::NodeVector{sum}, ng::ParameterVector{x});
+
+  ASSERT_EQ(SinkTransposes(ng_function), 0);
+  ASSERT_EQ(CountTransposes(ng_function), 1);
+}
+
+// NCHW -> NHWC -> add bias -> relu -> NCHW, as between two layers, reduces to
+// the add and the relu in NCHW and computes the same values
+TEST(TransposeSinking, BiasAdd) {
+  ng::Shape shape{2, 3, 4, 5};
+  auto x = make_shared<ng::op::Parameter>(ng::element::f32, shape);
+  auto nhwc = Transpose(x, ng::AxisVector{0, 2, 3, 1});
+  auto bias = make_shared<ng::op::Constant>(ng::element::f32, ng::Shape{3},
+                                            vector<float>{-1.0f, 0.5f, 2.0f});
+  auto bias_broadcast = make_shared<ng::op::Broadcast>(
+      bias, nhwc->get_shape(), ng::AxisSet{0, 1, 2});
+  auto add = make_shared<ng::op::Add>(nhwc, bias_broadcast);
+  auto relu = make_shared<ng::op::Relu>(add);
+  auto nchw = Transpose(relu, ng::AxisVector{0, 3, 1, 2});
+  auto ng_function =
+      make_shared<ng::Function>(ng::NodeVector{nchw}, ng::ParameterVector{x});
+  auto reference = ng::clone_function(*ng_function);
+
+  ASSERT_EQ(SinkTransposes(ng_function), 2);
+  ASSERT_EQ(CountTransposes(ng_function), 0);
+  ASSERT_EQ(ng_function->get_output_shape(0), shape);
+
+  vector<float> input(ng::shape_size(shape));
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = static_cast<float>(i % 7) - 3.0f;
+  }
+  ASSERT_EQ(Run(ng_function, input), Run(reference, input));
+}
+
+}  // namespace testing
+
+}  // namespace ngraph_bridge
+
+}  // namespace tensorflow
@@ -28,7 +28,9 @@
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/public/session.h"
 
+#include "ngraph_bridge/ngraph_backend_manager.h"
 #include "ngraph_bridge/ngraph_builder.h"
+#include "ngraph_bridge/ngraph_cluster_manager.h"
 #include "ngraph_bridge/ngraph_utils.h"
 #include "ngraph_bridge/version.h"
 #include "test/test_utilities.h"
@@ -179,6 +181,64 @@ TEST(TFExec, axpy) {
   }
 }
 
+// The clusters of a session are dropped from NGraphClusterManager when the
+// session is destroyed
+TEST(TFExec, ClustersDroppedWithSession) {
+  NGraphClusterManager::EvictAllClusters();
+
+  Tensor x(DT_FLOAT, TensorShape({2, 3}));
+  AssignInputValues<float>(x, 1.0f);
+  Tensor y(DT_FLOAT, TensorShape({2, 3}));
+  AssignInputValues<float>(y, 1.0f);
+  std::vector<Tensor> outputs;
+
+  unique_ptr<Session> session_0;
+  ASSERT_OK(CreateSession("test_axpy.pbtxt", "CPU", session_0));
+  ASSERT_OK(session_0->Run({{"x", x}, {"y", y}}, {"add"}, {}, &outputs));
+  size_t num_clusters_0 = NGraphClusterManager::NumClusters();
+  ASSERT_GT(num_clusters_0, 0);
+
+  unique_ptr<Session> session_1;
+  ASSERT_OK(CreateSession("test_axpy.pbtxt", "CPU", session_1));
+  ASSERT_OK(session_1->Run({{"x", x}, {"y", y}}, {"add"}, {}, &outputs));
+  ASSERT_EQ(NGraphClusterManager::NumClusters(), 2 * num_clusters_0);
+
+  session_0.reset();
+  ASSERT_EQ(NGraphClusterManager::NumClusters(), num_clusters_0);
+  session_1.reset();
+  ASSERT_EQ(NGraphClusterManager::NumClusters(), 0);
+}
+
+// A session that re-creates the backend with the same config keeps the op
+// support answers cached by the previous one
+TEST(TFExec, OpSupportCacheSharedBySessions) {
+  Tensor x(DT_FLOAT, TensorShape({2, 3}));
+  AssignInputValues<float>(x, 1.0f);
+  Tensor y(DT_FLOAT, TensorShape({2, 3}));
+  AssignInputValues<float>(y, 1.0f);
+  std::vector<Tensor> outputs;
+
+  unique_ptr<Session> session_0;
+  ASSERT_OK(CreateSession("test_axpy.pbtxt", "CPU", session_0));
+  ASSERT_OK(session_0->Run({{"x", x}, {"y", y}}, {"add"}, {}, &outputs));
+  session_0.reset();
+
+  bool is_supported = false;
+  ASSERT_TRUE(BackendManager::GetCachedOpSupport("CPU", "Add", &is_supported));
+  ASSERT_TRUE(is_supported);
+  // Only a cleared cache would lose this entry
+  BackendManager::CacheOpSupport("CPU", "NGraphTestOp", false);
+
+  unique_ptr<Session> session_1;
+  ASSERT_OK(CreateSession("test_axpy.pbtxt", "CPU", session_1));
+  ASSERT_OK(session_1->Run({{"x", x}, {"y", y}}, {"add"}, {}, &outputs));
+  session_1.reset();
+
+  ASSERT_TRUE(
+      BackendManager::GetCachedOpSupport("CPU", "NGraphTestOp", &is_supported));
+  ASSERT_FALSE(is_supported);
+}
+
 TEST(tf_exec, DISABLED_BatchMatMul_0D) {
   Scope root = Scope::NewRootScope();
   auto dev_scope = root.WithDevice("/device:NGRAPH:0");